@@ -146,6 +146,11 @@ void AppInterface::readProject()
   return mApp->readProjectFile();
 }
 
+void AppInterface::cancelProjectLoad()
+{
+  return mApp->cancelProjectLoad();
+}
+
 QString AppInterface::readProjectEntry( const QString &scope, const QString &key, const QString &def ) const
 {
   return mApp->readProjectEntry( scope, key, def );
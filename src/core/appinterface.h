@@ -49,6 +49,11 @@ class AppInterface : public QObject
     Q_INVOKABLE bool loadFile( const QString &path, const QString &name = QString() );
     Q_INVOKABLE void reloadProject();
     Q_INVOKABLE void readProject();
+
+    /**
+     * Cancels the ongoing project load.
+     */
+    Q_INVOKABLE void cancelProjectLoad();
     Q_INVOKABLE void removeRecentProject( const QString &path );
 
     Q_INVOKABLE QString readProjectEntry( const QString &scope, const QString &key, const QString &def = QString() ) const;
@@ -167,6 +172,16 @@ class AppInterface : public QObject
      */
     void loadProjectEnded( const QString &path, const QString &name );
 
+    /**
+     * Emitted when an ongoing project load reports its \a progress along with its current \a stage.
+     */
+    void loadProjectProgress( double progress, const QString &stage );
+
+    /**
+     * Emitted when a project loading has been canceled.
+     */
+    void loadProjectCanceled( const QString &path, const QString &name );
+
     //! Requests QField to set its map to the provided \a extent.
     void setMapExtent( const QgsRectangle &extent );
 
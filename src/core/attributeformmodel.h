@@ -66,6 +66,7 @@ class AttributeFormModel : public QSortFilterProxyModel
       LabelColor,
       LabelOverrideFont,
       LabelFont,
+      EvaluationPending, //!< Returns TRUE while an expensive default value or constraint of the field is evaluated in the background
     };
 
     Q_ENUM( FeatureRoles )
@@ -82,12 +83,14 @@ class AttributeFormModel : public QSortFilterProxyModel
     bool constraintsSoftValid() const;
 
     /**
-     * Save the current (already existing) feature
+     * Save the current (already existing) feature. Pending background evaluations are
+     * completed first, FALSE is returned when hard constraints are not satisfied.
      */
     Q_INVOKABLE bool save();
 
     /**
-     * Create the current (not existing yet) feature
+     * Create the current (not existing yet) feature. Pending background evaluations are
+     * completed first, FALSE is returned when hard constraints are not satisfied.
      */
     Q_INVOKABLE bool create();
 
@@ -18,7 +18,9 @@
 #include "attributeformmodelbase.h"
 
 #include <QDirIterator>
+#include <QFutureWatcher>
 #include <QRegularExpression>
+#include <QtConcurrent>
 #include <qgsattributeeditorelement.h>
 #include <qgsattributeeditorfield.h>
 #include <qgsattributeeditorhtmlelement.h>
@@ -32,10 +34,26 @@
 #include <qgsproject.h>
 #include <qgsrelationmanager.h>
 #include <qgsvaluerelationfieldformatter.h>
+#include <qgsvariantutils.h>
 #include <qgsvectorlayer.h>
 #include <qgsvectorlayerutils.h>
 
 Q_GLOBAL_STATIC( QStringList, sSupportedEditorWidgets );
+Q_GLOBAL_STATIC( QSet<QString>, sFormTemplateWatchedLayers );
+
+QHash<QString, std::shared_ptr<const AttributeFormModelBase::FormTemplate>> AttributeFormModelBase::sFormTemplates;
+
+//! Deep copies \a item and its children, recording the copy of each item in \a clones
+static QStandardItem *cloneItem( const QStandardItem *item, QHash<const QStandardItem *, QStandardItem *> &clones )
+{
+  QStandardItem *clone = item->clone();
+  clones.insert( item, clone );
+  for ( int i = 0; i < item->rowCount(); ++i )
+  {
+    clone->appendRow( cloneItem( item->child( i ), clones ) );
+  }
+  return clone;
+}
 
 AttributeFormModelBase::AttributeFormModelBase( QObject *parent )
   : QStandardItemModel( 0, 1, parent )
@@ -46,6 +64,9 @@ AttributeFormModelBase::AttributeFormModelBase( QObject *parent )
     onMapThemeCollectionChanged();
   }
 
+  // Relations are part of autogenerated forms and of the relation reference widget setups
+  connect( QgsProject::instance()->relationManager(), &QgsRelationManager::changed, this, [] { invalidateFormTemplates(); } );
+
   if ( sSupportedEditorWidgets->isEmpty() )
   {
     QDirIterator it( ":qml/editorwidgets" );
@@ -97,6 +118,7 @@ QHash<int, QByteArray> AttributeFormModelBase::roleNames() const
   roles[AttributeFormModel::LabelColor] = "LabelColor";
   roles[AttributeFormModel::LabelOverrideFont] = "LabelOverrideFont";
   roles[AttributeFormModel::LabelFont] = "LabelFont";
+  roles[AttributeFormModel::EvaluationPending] = "EvaluationPending";
 
   return roles;
 }
@@ -116,7 +138,8 @@ bool AttributeFormModelBase::setData( const QModelIndex &index, const QVariant &
         int fieldIndex = item->data( AttributeFormModel::FieldIndex ).toInt();
         mFeatureModel->setData( mFeatureModel->index( fieldIndex ), value, FeatureModel::AttributeAllowEdit );
         item->setData( value, AttributeFormModel::AttributeAllowEdit );
-        updateVisibilityAndConstraints( fieldIndex );
+        if ( fieldIndex >= 0 && fieldIndex < mLayer->fields().size() )
+          updateVisibilityAndConstraints( QSet<QString>() << mLayer->fields().at( fieldIndex ).name() );
         break;
       }
 
@@ -138,8 +161,12 @@ bool AttributeFormModelBase::setData( const QModelIndex &index, const QVariant &
           mExpressionContext << QgsExpressionContextUtils::formScope( mFeatureModel->feature() );
           synchronizeFieldValue( fieldIndex, value );
         }
-        updateDefaultValues( fieldIndex );
-        updateVisibilityAndConstraints( fieldIndex );
+        const QSet<QString> updatedFields = updateDefaultValues( fieldIndex );
+        if ( !updatedFields.isEmpty() )
+        {
+          updateEditorWidgetCodes( updatedFields );
+          updateVisibilityAndConstraints( updatedFields );
+        }
         return changed;
       }
     }
@@ -177,9 +204,14 @@ void AttributeFormModelBase::setFeatureModel( FeatureModel *featureModel )
 
 void AttributeFormModelBase::resetModel()
 {
+  cancelBackgroundEvaluations();
   clear();
 
   mVisibilityExpressions.clear();
+  mDefaultValueExpressions.clear();
+  mVisibilityDependencies.clear();
+  mConstraintDependencies.clear();
+  mExpensiveConstraints.clear();
   mFields.clear();
   mEditorWidgetCodes.clear();
   mEditorWidgetCodesRequirements.clear();
@@ -195,84 +227,450 @@ void AttributeFormModelBase::resetModel()
 
   if ( mLayer )
   {
-    QgsAttributeEditorContainer *root;
-#if _QGIS_VERSION_INT >= 33100
-    if ( mLayer->editFormConfig().layout() == Qgis::AttributeFormLayout::DragAndDrop )
-#else
-    if ( mLayer->editFormConfig().layout() == QgsEditFormConfig::TabLayout )
-#endif
+    // Opening a feature only binds its values onto the form structure cached for the layer
+    const QString layerId = mLayer->id();
+    const auto formTemplate = sFormTemplates.constFind( layerId );
+    if ( formTemplate != sFormTemplates.constEnd() )
     {
-      root = mLayer->editFormConfig().invisibleRootContainer();
       mTemporaryContainer.reset();
+      applyFormTemplate( *formTemplate.value() );
     }
     else
     {
-      root = generateRootContainer();
-      mTemporaryContainer.reset( root );
+      const QList<QStandardItem *> containers = buildFormStructure();
+      sFormTemplates.insert( layerId, captureFormTemplate( containers ) );
+
+      if ( !sFormTemplateWatchedLayers->contains( layerId ) )
+      {
+        sFormTemplateWatchedLayers->insert( layerId );
+        QgsVectorLayer *layer = mLayer;
+        connect( layer, &QgsVectorLayer::editFormConfigChanged, layer, [layerId] { invalidateFormTemplates( layerId ); } );
+        connect( layer, &QgsVectorLayer::updatedFields, layer, [layerId] { invalidateFormTemplates( layerId ); } );
+        connect( layer, &QgsVectorLayer::willBeDeleted, layer, [layerId] {
+          invalidateFormTemplates( layerId );
+          sFormTemplateWatchedLayers->remove( layerId );
+        } );
+      }
     }
 
+    bindFeatureModel();
+  }
+}
+
+QList<QStandardItem *> AttributeFormModelBase::buildFormStructure()
+{
+  QgsAttributeEditorContainer *root;
+#if _QGIS_VERSION_INT >= 33100
+  if ( mLayer->editFormConfig().layout() == Qgis::AttributeFormLayout::DragAndDrop )
+#else
+  if ( mLayer->editFormConfig().layout() == QgsEditFormConfig::TabLayout )
+#endif
+  {
+    root = mLayer->editFormConfig().invisibleRootContainer();
+    mTemporaryContainer.reset();
+  }
+  else
+  {
+    root = generateRootContainer();
+    mTemporaryContainer.reset( root );
+  }
+
 #if _QGIS_VERSION_INT >= 33100
-    const bool hasTabs = !root->children().isEmpty() && Qgis::AttributeEditorType::Container == root->children().first()->type();
+  const bool hasTabs = !root->children().isEmpty() && Qgis::AttributeEditorType::Container == root->children().first()->type();
 #else
-    const bool hasTabs = !root->children().isEmpty() && QgsAttributeEditorElement::AeTypeContainer == root->children().first()->type();
+  const bool hasTabs = !root->children().isEmpty() && QgsAttributeEditorElement::AeTypeContainer == root->children().first()->type();
 #endif
 
-    invisibleRootItem()->setColumnCount( 1 );
-    QList<QStandardItem *> containers;
-    if ( hasTabs )
+  invisibleRootItem()->setColumnCount( 1 );
+  QList<QStandardItem *> containers;
+  if ( hasTabs )
+  {
+    const QList<QgsAttributeEditorElement *> children { root->children() };
+    int currentTab = 0;
+    for ( QgsAttributeEditorElement *element : children )
     {
-      const QList<QgsAttributeEditorElement *> children { root->children() };
-      int currentTab = 0;
-      for ( QgsAttributeEditorElement *element : children )
-      {
 #if _QGIS_VERSION_INT >= 33100
-        if ( element->type() == Qgis::AttributeEditorType::Container )
+      if ( element->type() == Qgis::AttributeEditorType::Container )
 #else
-        if ( element->type() == QgsAttributeEditorElement::AeTypeContainer )
+      if ( element->type() == QgsAttributeEditorElement::AeTypeContainer )
 #endif
-        {
-          QgsAttributeEditorContainer *container = static_cast<QgsAttributeEditorContainer *>( element );
-          const int columnCount = container->columnCount();
-
-          QStandardItem *item = new QStandardItem();
-          item->setData( element->name(), AttributeFormModel::Name );
-          item->setData( "container", AttributeFormModel::ElementType );
-          item->setData( QString(), AttributeFormModel::GroupName );
-          item->setData( QModelIndex(), AttributeFormModel::GroupIndex );
-          item->setData( true, AttributeFormModel::CurrentlyVisible );
-          item->setData( true, AttributeFormModel::ConstraintHardValid );
-          item->setData( true, AttributeFormModel::ConstraintSoftValid );
-
-          QString visibilityExpression;
-          if ( container->visibilityExpression().enabled() )
-          {
-            mVisibilityExpressions.append( qMakePair( container->visibilityExpression().data(), item ) );
-            visibilityExpression = container->visibilityExpression().data().expression();
-          }
+      {
+        QgsAttributeEditorContainer *container = static_cast<QgsAttributeEditorContainer *>( element );
+        const int columnCount = container->columnCount();
+
+        QStandardItem *item = new QStandardItem();
+        item->setData( element->name(), AttributeFormModel::Name );
+        item->setData( "container", AttributeFormModel::ElementType );
+        item->setData( QString(), AttributeFormModel::GroupName );
+        item->setData( QModelIndex(), AttributeFormModel::GroupIndex );
+        item->setData( true, AttributeFormModel::CurrentlyVisible );
+        item->setData( true, AttributeFormModel::ConstraintHardValid );
+        item->setData( true, AttributeFormModel::ConstraintSoftValid );
 
-          buildForm( container, item, visibilityExpression, containers, currentTab, columnCount );
-          invisibleRootItem()->appendRow( item );
-          setHasTabs( true );
-          currentTab++;
+        QString visibilityExpression;
+        if ( container->visibilityExpression().enabled() )
+        {
+          mVisibilityExpressions.append( { container->visibilityExpression().data(), item } );
+          visibilityExpression = container->visibilityExpression().data().expression();
         }
+
+        buildForm( container, item, visibilityExpression, containers, currentTab, columnCount );
+        invisibleRootItem()->appendRow( item );
+        setHasTabs( true );
+        currentTab++;
       }
     }
-    else
+  }
+  else
+  {
+    buildForm( invisibleRootContainer(), invisibleRootItem(), QString(), containers );
+  }
+
+  for ( QStandardItem *container : std::as_const( containers ) )
+  {
+    container->setData( container->index(), AttributeFormModel::GroupIndex );
+  }
+
+  buildExpressionDependencies();
+
+  return containers;
+}
+
+std::shared_ptr<const AttributeFormModelBase::FormTemplate> AttributeFormModelBase::captureFormTemplate( const QList<QStandardItem *> &containers ) const
+{
+  auto formTemplate = std::make_shared<FormTemplate>();
+  formTemplate->root = std::make_unique<QStandardItem>();
+
+  QHash<const QStandardItem *, QStandardItem *> clones;
+  QStandardItem *root = invisibleRootItem();
+  for ( int i = 0; i < root->rowCount(); ++i )
+  {
+    formTemplate->root->appendRow( cloneItem( root->child( i ), clones ) );
+  }
+
+  formTemplate->hasTabs = mHasTabs;
+  for ( QStandardItem *container : containers )
+    formTemplate->containers << clones.value( container );
+  for ( auto it = mFields.constBegin(); it != mFields.constEnd(); ++it )
+    formTemplate->fields.insert( clones.value( it.key() ), it.value() );
+  for ( auto it = mEditorWidgetCodes.constBegin(); it != mEditorWidgetCodes.constEnd(); ++it )
+    formTemplate->editorWidgetCodes.insert( clones.value( it.key() ), it.value() );
+  for ( const VisibilityExpression &visibilityExpression : mVisibilityExpressions )
+    formTemplate->visibilityExpressions.append( { visibilityExpression.expression, clones.value( visibilityExpression.item ) } );
+
+  formTemplate->defaultValueExpressions = mDefaultValueExpressions;
+  formTemplate->visibilityDependencies = mVisibilityDependencies;
+  formTemplate->constraintDependencies = mConstraintDependencies;
+  formTemplate->expensiveConstraints = mExpensiveConstraints;
+
+  return formTemplate;
+}
+
+void AttributeFormModelBase::applyFormTemplate( const FormTemplate &formTemplate )
+{
+  QHash<const QStandardItem *, QStandardItem *> clones;
+  QList<QStandardItem *> rows;
+  rows.reserve( formTemplate.root->rowCount() );
+  for ( int i = 0; i < formTemplate.root->rowCount(); ++i )
+  {
+    rows << cloneItem( formTemplate.root->child( i ), clones );
+  }
+
+  invisibleRootItem()->setColumnCount( 1 );
+  invisibleRootItem()->appendRows( rows );
+  setHasTabs( formTemplate.hasTabs );
+
+  for ( const QStandardItem *container : formTemplate.containers )
+  {
+    QStandardItem *item = clones.value( container );
+    item->setData( item->index(), AttributeFormModel::GroupIndex );
+  }
+  for ( auto it = formTemplate.fields.constBegin(); it != formTemplate.fields.constEnd(); ++it )
+    mFields.insert( clones.value( it.key() ), it.value() );
+  for ( auto it = formTemplate.editorWidgetCodes.constBegin(); it != formTemplate.editorWidgetCodes.constEnd(); ++it )
+    mEditorWidgetCodes.insert( clones.value( it.key() ), it.value() );
+  for ( const VisibilityExpression &visibilityExpression : formTemplate.visibilityExpressions )
+    mVisibilityExpressions.append( { visibilityExpression.expression, clones.value( visibilityExpression.item ) } );
+
+  mDefaultValueExpressions = formTemplate.defaultValueExpressions;
+  mVisibilityDependencies = formTemplate.visibilityDependencies;
+  mConstraintDependencies = formTemplate.constraintDependencies;
+  mExpensiveConstraints = formTemplate.expensiveConstraints;
+}
+
+void AttributeFormModelBase::bindFeatureModel()
+{
+  const QVector<bool> rememberedAttributes = mFeatureModel->rememberedAttributes();
+  for ( auto it = mFields.constBegin(); it != mFields.constEnd(); ++it )
+  {
+    it.key()->setData( rememberedAttributes.value( it.value() ) ? Qt::Checked : Qt::Unchecked, AttributeFormModel::RememberValue );
+  }
+
+  for ( int i = 0; i < invisibleRootItem()->rowCount(); ++i )
+  {
+    updateAttributeValue( invisibleRootItem()->child( i ) );
+  }
+}
+
+void AttributeFormModelBase::invalidateFormTemplates( const QString &layerId )
+{
+  if ( layerId.isEmpty() )
+    sFormTemplates.clear();
+  else
+    sFormTemplates.remove( layerId );
+}
+
+void AttributeFormModelBase::buildExpressionDependencies()
+{
+  for ( int i = 0; i < mVisibilityExpressions.size(); ++i )
+  {
+    const QSet<QString> referencedColumns = mVisibilityExpressions.at( i ).expression.referencedColumns();
+    for ( const QString &referencedColumn : referencedColumns )
+      mVisibilityDependencies[referencedColumn] << i;
+  }
+
+  const QgsFields fields = mLayer->fields();
+  QList<int> formFieldIndexes = mFields.values();
+  std::sort( formFieldIndexes.begin(), formFieldIndexes.end() );
+  formFieldIndexes.erase( std::unique( formFieldIndexes.begin(), formFieldIndexes.end() ), formFieldIndexes.end() );
+
+  QList<DefaultValueExpression> defaultValueExpressions;
+  for ( const int fieldIndex : std::as_const( formFieldIndexes ) )
+  {
+    const QgsField field = fields.at( fieldIndex );
+
+    // A field constraint always depends on its own value, expression constraints on the referenced fields as well
+    mConstraintDependencies[field.name()] << fieldIndex;
+    const QString constraintExpression = field.constraints().constraintExpression();
+    if ( !constraintExpression.isEmpty() )
+    {
+      const QgsExpression expression( constraintExpression );
+      const QSet<QString> referencedColumns = expression.referencedColumns();
+      for ( const QString &referencedColumn : referencedColumns )
+        mConstraintDependencies[referencedColumn] << fieldIndex;
+
+      if ( isExpensiveExpression( expression ) )
+        mExpensiveConstraints << fieldIndex;
+    }
+
+    const QgsDefaultValue defaultValueDefinition = field.defaultValueDefinition();
+    if ( defaultValueDefinition.isValid() && defaultValueDefinition.applyOnUpdate() )
     {
-      buildForm( invisibleRootContainer(), invisibleRootItem(), QString(), containers );
+      DefaultValueExpression defaultValueExpression;
+      defaultValueExpression.fieldIndex = fieldIndex;
+      defaultValueExpression.expression = QgsExpression( defaultValueDefinition.expression() );
+      defaultValueExpression.referencedColumns = defaultValueExpression.expression.referencedColumns();
+      defaultValueExpression.expensive = isExpensiveExpression( defaultValueExpression.expression );
+      defaultValueExpressions << defaultValueExpression;
     }
+  }
 
-    for ( QStandardItem *container : std::as_const( containers ) )
+  // Sort default values so that a default value is evaluated after the default values it depends on.
+  // Expressions caught in a dependency cycle keep their field order and are evaluated once.
+  while ( !defaultValueExpressions.isEmpty() )
+  {
+    int nextIndex = 0;
+    for ( int i = 0; i < defaultValueExpressions.size(); ++i )
     {
-      container->setData( container->index(), AttributeFormModel::GroupIndex );
+      const QSet<QString> &referencedColumns = defaultValueExpressions.at( i ).referencedColumns;
+      bool dependsOnPending = false;
+      for ( int j = 0; j < defaultValueExpressions.size() && !dependsOnPending; ++j )
+      {
+        dependsOnPending = j != i && referencedColumns.contains( fields.at( defaultValueExpressions.at( j ).fieldIndex ).name() );
+      }
+
+      if ( !dependsOnPending )
+      {
+        nextIndex = i;
+        break;
+      }
     }
+    mDefaultValueExpressions << defaultValueExpressions.takeAt( nextIndex );
+  }
+}
+
+bool AttributeFormModelBase::isExpensiveExpression( const QgsExpression &expression )
+{
+  static const QSet<QString> sExpensiveFunctions {
+    QStringLiteral( "aggregate" ),
+    QStringLiteral( "relation_aggregate" ),
+    QStringLiteral( "get_feature" ),
+    QStringLiteral( "get_feature_by_id" ),
+    QStringLiteral( "array_agg" ),
+    QStringLiteral( "collect" ),
+    QStringLiteral( "concatenate" ),
+    QStringLiteral( "concatenate_unique" ),
+    QStringLiteral( "count" ),
+    QStringLiteral( "count_distinct" ),
+    QStringLiteral( "count_missing" ),
+    QStringLiteral( "iqr" ),
+    QStringLiteral( "majority" ),
+    QStringLiteral( "max_length" ),
+    QStringLiteral( "maximum" ),
+    QStringLiteral( "mean" ),
+    QStringLiteral( "median" ),
+    QStringLiteral( "min_length" ),
+    QStringLiteral( "minimum" ),
+    QStringLiteral( "minority" ),
+    QStringLiteral( "q1" ),
+    QStringLiteral( "q3" ),
+    QStringLiteral( "range" ),
+    QStringLiteral( "stdev" ),
+    QStringLiteral( "sum" ),
+  };
+
+  const QSet<QString> functions = expression.referencedFunctions();
+  for ( const QString &function : functions )
+  {
+    if ( sExpensiveFunctions.contains( function ) || function.startsWith( QLatin1String( "overlay_" ) ) )
+      return true;
+  }
+
+  return false;
+}
+
+void AttributeFormModelBase::evaluateInBackground( const QString &key, int fieldIndex, const QString &expression, const QgsFeature &feature, const std::function<void( const QVariant & )> &apply )
+{
+  auto it = mBackgroundEvaluations.find( key );
+  if ( it != mBackgroundEvaluations.end() )
+    it->feedback->cancel();
+
+  BackgroundEvaluation evaluation;
+  evaluation.requestId = ++mBackgroundRequestId;
+  evaluation.fieldIndex = fieldIndex;
+  evaluation.expression = expression;
+  evaluation.context = mExpressionContext;
+  evaluation.context.setFeature( feature );
+  evaluation.apply = apply;
+  evaluation.feedback = std::make_shared<QgsFeedback>();
+  mBackgroundEvaluations.insert( key, evaluation );
+  updateEvaluationPending( fieldIndex );
+
+  auto watcher = new QFutureWatcher<QVariant>( this );
+  connect( watcher, &QFutureWatcher<QVariant>::finished, this, [this, watcher, key, requestId = evaluation.requestId] {
+    watcher->deleteLater();
+
+    // Results of canceled or superseded evaluations are discarded
+    auto it = mBackgroundEvaluations.find( key );
+    if ( it == mBackgroundEvaluations.end() || it->requestId != requestId )
+      return;
+
+    const BackgroundEvaluation evaluation = it.value();
+    mBackgroundEvaluations.erase( it );
+    updateEvaluationPending( evaluation.fieldIndex );
+    evaluation.apply( watcher->result() );
+  } );
+  watcher->setFuture( QtConcurrent::run( [expression, context = evaluation.context, feedback = evaluation.feedback]() mutable {
+    context.setFeedback( feedback.get() );
+    QgsExpression exp( expression );
+    exp.prepare( &context );
+    return exp.evaluate( &context );
+  } ) );
+}
+
+void AttributeFormModelBase::cancelBackgroundEvaluations()
+{
+  const QList<BackgroundEvaluation> evaluations = mBackgroundEvaluations.values();
+  mBackgroundEvaluations.clear();
+  for ( const BackgroundEvaluation &evaluation : evaluations )
+  {
+    evaluation.feedback->cancel();
+    updateEvaluationPending( evaluation.fieldIndex );
   }
 }
 
+void AttributeFormModelBase::flushBackgroundEvaluations()
+{
+  // Applied default values may trigger further evaluations, bail out of dependency cycles
+  int remainingIterations = 100;
+  while ( !mBackgroundEvaluations.isEmpty() && remainingIterations-- > 0 )
+  {
+    auto it = mBackgroundEvaluations.begin();
+    BackgroundEvaluation evaluation = it.value();
+    mBackgroundEvaluations.erase( it );
+    evaluation.feedback->cancel();
+    updateEvaluationPending( evaluation.fieldIndex );
+
+    QgsExpression exp( evaluation.expression );
+    exp.prepare( &evaluation.context );
+    evaluation.apply( exp.evaluate( &evaluation.context ) );
+  }
+
+  cancelBackgroundEvaluations();
+}
+
+void AttributeFormModelBase::updateEvaluationPending( int fieldIndex )
+{
+  if ( fieldIndex < 0 )
+    return;
+
+  const bool pending = std::any_of( mBackgroundEvaluations.cbegin(), mBackgroundEvaluations.cend(), [fieldIndex]( const BackgroundEvaluation &evaluation ) { return evaluation.fieldIndex == fieldIndex; } );
+  QMap<QStandardItem *, int>::ConstIterator fieldIterator( mFields.constBegin() );
+  for ( ; fieldIterator != mFields.constEnd(); ++fieldIterator )
+  {
+    if ( fieldIterator.value() == fieldIndex && fieldIterator.key()->data( AttributeFormModel::EvaluationPending ).toBool() != pending )
+      fieldIterator.key()->setData( pending, AttributeFormModel::EvaluationPending );
+  }
+}
+
+void AttributeFormModelBase::applyBackgroundDefaultValue( int fieldIndex, const QVariant &value )
+{
+  const QVariant previousValue = mFeatureModel->data( mFeatureModel->index( fieldIndex ), FeatureModel::AttributeValue );
+  const bool success = mFeatureModel->setData( mFeatureModel->index( fieldIndex ), value, FeatureModel::AttributeValue );
+  const QVariant updatedValue = mFeatureModel->data( mFeatureModel->index( fieldIndex ), FeatureModel::AttributeValue );
+  if ( !success || updatedValue == previousValue )
+    return;
+
+  mExpressionContext.popScope();
+  mExpressionContext << QgsExpressionContextUtils::formScope( mFeatureModel->feature() );
+  synchronizeFieldValue( fieldIndex, updatedValue );
+
+  const QSet<QString> updatedFields = updateDefaultValues( fieldIndex );
+  updateEditorWidgetCodes( updatedFields );
+  updateVisibilityAndConstraints( updatedFields );
+}
+
+bool AttributeFormModelBase::constraintsSatisfied( const QgsFeature &feature, int fieldIndex, QgsFieldConstraints::ConstraintStrength strength, bool expressionSatisfied ) const
+{
+  // Mirrors QgsVectorLayerUtils::validateAttribute() with an expression outcome computed beforehand
+  const QgsFieldConstraints constraints = mLayer->fields().at( fieldIndex ).constraints();
+  const QVariant value = feature.attribute( fieldIndex );
+
+  bool satisfied = true;
+  if ( ( constraints.constraints() & QgsFieldConstraints::ConstraintExpression ) && constraints.constraintStrength( QgsFieldConstraints::ConstraintExpression ) == strength )
+  {
+    satisfied = expressionSatisfied;
+  }
+  if ( satisfied && ( constraints.constraints() & QgsFieldConstraints::ConstraintNotNull ) && constraints.constraintStrength( QgsFieldConstraints::ConstraintNotNull ) == strength )
+  {
+    satisfied = !QgsVariantUtils::isNull( value );
+  }
+  if ( satisfied && ( constraints.constraints() & QgsFieldConstraints::ConstraintUnique ) && constraints.constraintStrength( QgsFieldConstraints::ConstraintUnique ) == strength )
+  {
+    satisfied = !QgsVectorLayerUtils::valueExists( mLayer, fieldIndex, value, QgsFeatureIds() << feature.id() );
+  }
+
+  return satisfied;
+}
+
+void AttributeFormModelBase::prepareExpressions()
+{
+  for ( VisibilityExpression &visibilityExpression : mVisibilityExpressions )
+    visibilityExpression.expression.prepare( &mExpressionContext );
+
+  for ( DefaultValueExpression &defaultValueExpression : mDefaultValueExpressions )
+    defaultValueExpression.expression.prepare( &mExpressionContext );
+}
+
 void AttributeFormModelBase::applyFeatureModel()
 {
+  // Pending evaluations belong to the previously applied feature
+  cancelBackgroundEvaluations();
+
   mExpressionContext = mFeatureModel->createExpressionContext();
   mExpressionContext << QgsExpressionContextUtils::formScope( mFeatureModel->feature() );
+  mExpressionContext.setFields( mFeatureModel->feature().fields() );
+  prepareExpressions();
 
   for ( int i = 0; i < invisibleRootItem()->rowCount(); ++i )
   {
@@ -464,7 +862,7 @@ void AttributeFormModelBase::buildForm( QgsAttributeEditorContainer *container,
         containers << item;
 
         if ( !visibilityExpression.isEmpty() )
-          mVisibilityExpressions.append( qMakePair( QgsExpression( visibilityExpression ), item ) );
+          mVisibilityExpressions.append( { QgsExpression( visibilityExpression ), item } );
         break;
       }
 
@@ -490,12 +888,11 @@ void AttributeFormModelBase::buildForm( QgsAttributeEditorContainer *container,
         item->setData( !mLayer->editFormConfig().readOnly( fieldIndex ) && setup.type() != QStringLiteral( "Binary" ), AttributeFormModel::AttributeEditable );
         item->setData( setup.type(), AttributeFormModel::EditorWidget );
         item->setData( setup.config(), AttributeFormModel::EditorWidgetConfig );
-        item->setData( mFeatureModel->rememberedAttributes().at( fieldIndex ) ? Qt::Checked : Qt::Unchecked, AttributeFormModel::RememberValue );
         item->setData( QgsField( field ), AttributeFormModel::Field );
         item->setData( "field", AttributeFormModel::ElementType );
         item->setData( fieldIndex, AttributeFormModel::FieldIndex );
         item->setData( true, AttributeFormModel::CurrentlyVisible );
-        item->setData( mFeatureModel->data( mFeatureModel->index( fieldIndex ), FeatureModel::AttributeAllowEdit ), AttributeFormModel::AttributeAllowEdit );
+        item->setData( false, AttributeFormModel::EvaluationPending );
 
         // create constraint description
         QStringList descriptions;
@@ -516,8 +913,6 @@ void AttributeFormModelBase::buildForm( QgsAttributeEditorContainer *container,
 
         item->setData( descriptions.join( ", " ), AttributeFormModel::ConstraintDescription );
 
-        updateAttributeValue( item );
-
         mFields.insert( item, fieldIndex );
 
         parent->appendRow( item );
@@ -565,8 +960,6 @@ void AttributeFormModelBase::buildForm( QgsAttributeEditorContainer *container,
         item->setData( false, AttributeFormModel::AttributeEditable );
         item->setData( false, AttributeFormModel::AttributeAllowEdit );
 
-
-        updateAttributeValue( item );
         parent->appendRow( item );
         mEditorWidgetCodes.insert( item, qmlElement->qmlCode() );
         break;
@@ -586,7 +979,6 @@ void AttributeFormModelBase::buildForm( QgsAttributeEditorContainer *container,
         item->setData( false, AttributeFormModel::AttributeEditable );
         item->setData( false, AttributeFormModel::AttributeAllowEdit );
 
-        updateAttributeValue( item );
         parent->appendRow( item );
         mEditorWidgetCodes.insert( item, htmlElement->htmlCode() );
         break;
@@ -603,7 +995,6 @@ void AttributeFormModelBase::buildForm( QgsAttributeEditorContainer *container,
         item->setData( false, AttributeFormModel::AttributeEditable );
         item->setData( false, AttributeFormModel::AttributeAllowEdit );
 
-        updateAttributeValue( item );
         parent->appendRow( item );
         mEditorWidgetCodes.insert( item, textElement->text() );
         break;
@@ -636,51 +1027,53 @@ void AttributeFormModelBase::synchronizeFieldValue( int fieldIndex, QVariant val
   }
 }
 
-void AttributeFormModelBase::updateDefaultValues( int fieldIndex, QVector<int> updatedFields )
+QSet<QString> AttributeFormModelBase::updateDefaultValues( int fieldIndex )
 {
+  QSet<QString> updatedFields;
   const QgsFields fields = mFeatureModel->feature().fields();
   if ( fieldIndex < 0 || fieldIndex >= fields.size() )
-    return;
-  const QString fieldName = fields.at( fieldIndex ).name();
+    return updatedFields;
+  updatedFields << fields.at( fieldIndex ).name();
 
   mExpressionContext.setFields( fields );
   mExpressionContext.setFeature( mFeatureModel->feature() );
 
-  QMap<QStandardItem *, int>::ConstIterator fieldIterator( mFields.constBegin() );
-  for ( ; fieldIterator != mFields.constEnd(); ++fieldIterator )
+  // Default value expressions are sorted in dependency order, a single pass propagates chained updates
+  for ( DefaultValueExpression &defaultValueExpression : mDefaultValueExpressions )
   {
-    QStandardItem *item = fieldIterator.key();
-    const int fidx = fieldIterator.value();
-    if ( fidx == fieldIndex || !fields.at( fidx ).defaultValueDefinition().isValid() || !fields.at( fidx ).defaultValueDefinition().applyOnUpdate() )
+    const int fidx = defaultValueExpression.fieldIndex;
+    if ( fidx == fieldIndex )
       continue;
 
-    QgsExpression exp( fields.at( fidx ).defaultValueDefinition().expression() );
-    exp.prepare( &mExpressionContext );
+    // avoid cost of value update if expression doesn't contain any of the updated fields
+    if ( !defaultValueExpression.referencedColumns.intersects( updatedFields ) && !defaultValueExpression.referencedColumns.contains( QgsFeatureRequest::ALL_ATTRIBUTES ) )
+      continue;
 
-    // avoid cost of value update if expression doesn't contain the field which triggered the default values update
-    if ( !exp.referencedColumns().contains( fieldName ) && !exp.referencedColumns().contains( QgsFeatureRequest::ALL_ATTRIBUTES ) )
+    if ( defaultValueExpression.expensive )
+    {
+      // Dependents of the field are updated once the value is applied
+      evaluateInBackground( QStringLiteral( "default:%1" ).arg( fidx ), fidx, defaultValueExpression.expression.expression(), mFeatureModel->feature(), [this, fidx]( const QVariant &value ) {
+        applyBackgroundDefaultValue( fidx, value );
+      } );
       continue;
+    }
 
-    const QVariant defaultValue = exp.evaluate( &mExpressionContext );
+    const QVariant defaultValue = defaultValueExpression.expression.evaluate( &mExpressionContext );
     const QVariant previousValue = mFeatureModel->data( mFeatureModel->index( fidx ), FeatureModel::AttributeValue );
     const bool success = mFeatureModel->setData( mFeatureModel->index( fidx ), defaultValue, FeatureModel::AttributeValue );
     const QVariant updatedValue = mFeatureModel->data( mFeatureModel->index( fidx ), FeatureModel::AttributeValue );
     if ( success && updatedValue != previousValue )
     {
       synchronizeFieldValue( fidx, updatedValue );
-      if ( !updatedFields.contains( fidx ) )
-      {
-        updatedFields.append( fidx );
-        updateDefaultValues( fidx, updatedFields );
-      }
-      updateVisibilityAndConstraints( fidx );
+      updatedFields << fields.at( fidx ).name();
+      mExpressionContext.setFeature( mFeatureModel->feature() );
     }
   }
 
-  updateEditorWidgetCodes( fieldName );
+  return updatedFields;
 }
 
-bool AttributeFormModelBase::codeRequiresUpdate( const QString &fieldName, const QString &code, const QRegularExpression &regEx )
+bool AttributeFormModelBase::codeRequiresUpdate( const QSet<QString> &fieldNames, const QString &code, const QRegularExpression &regEx )
 {
   if ( !mEditorWidgetCodesRequirements.contains( code ) )
   {
@@ -700,10 +1093,11 @@ bool AttributeFormModelBase::codeRequiresUpdate( const QString &fieldName, const
     mEditorWidgetCodesRequirements.insert( code, codeRequirements );
   }
 
-  return mEditorWidgetCodesRequirements[code].referencedColumns.contains( fieldName ) || mEditorWidgetCodesRequirements[code].referencedColumns.contains( QgsFeatureRequest::ALL_ATTRIBUTES ) || mEditorWidgetCodesRequirements[code].formScope;
+  const CodeRequirements &codeRequirements = mEditorWidgetCodesRequirements[code];
+  return codeRequirements.referencedColumns.intersects( fieldNames ) || codeRequirements.referencedColumns.contains( QgsFeatureRequest::ALL_ATTRIBUTES ) || codeRequirements.formScope;
 }
 
-void AttributeFormModelBase::updateEditorWidgetCodes( const QString &fieldName )
+void AttributeFormModelBase::updateEditorWidgetCodes( const QSet<QString> &fieldNames )
 {
   QMap<QStandardItem *, QString>::ConstIterator editorWidgetCodesIterator( mEditorWidgetCodes.constBegin() );
   for ( ; editorWidgetCodesIterator != mEditorWidgetCodes.constEnd(); editorWidgetCodesIterator++ )
@@ -717,7 +1111,7 @@ void AttributeFormModelBase::updateEditorWidgetCodes( const QString &fieldName )
     if ( item->data( AttributeFormModel::ElementType ) == QStringLiteral( "qml" ) || item->data( AttributeFormModel::ElementType ) == QStringLiteral( "html" ) )
     {
       const thread_local QRegularExpression sRegEx( "expression\\.evaluate\\(\\s*\\\"(.*?[^\\\\])\\\"\\s*\\)", QRegularExpression::MultilineOption | QRegularExpression::DotMatchesEverythingOption );
-      if ( codeRequiresUpdate( fieldName, code, sRegEx ) )
+      if ( codeRequiresUpdate( fieldNames, code, sRegEx ) )
       {
         QRegularExpressionMatch match = sRegEx.match( code );
         while ( match.hasMatch() )
@@ -755,7 +1149,7 @@ void AttributeFormModelBase::updateEditorWidgetCodes( const QString &fieldName )
     else if ( item->data( AttributeFormModel::ElementType ) == QStringLiteral( "text" ) )
     {
       const thread_local QRegularExpression sRegEx( QStringLiteral( "\\[%(.*?)%\\]" ), QRegularExpression::MultilineOption | QRegularExpression::DotMatchesEverythingOption );
-      if ( codeRequiresUpdate( fieldName, code, sRegEx ) )
+      if ( codeRequiresUpdate( fieldNames, code, sRegEx ) )
       {
         code = QgsExpression::replaceExpressionText( code, &mExpressionContext );
         item->setData( code, AttributeFormModel::EditorWidgetCode );
@@ -791,51 +1185,59 @@ void _checkChildrenValidity( QStandardItem *parent, bool &hardValidity, bool &so
   }
 };
 
-void AttributeFormModelBase::updateVisibilityAndConstraints( int fieldIndex )
+void AttributeFormModelBase::updateVisibilityAndConstraints( const QSet<QString> &fieldNames )
 {
-  const QString fieldName = fieldIndex > -1 && fieldIndex < mLayer->fields().size() ? mLayer->fields().at( fieldIndex ).name() : QString();
+  const bool updateAll = fieldNames.isEmpty();
   QgsFields fields = mFeatureModel->feature().fields();
   mExpressionContext.setFields( fields );
   mExpressionContext.setFeature( mFeatureModel->feature() );
 
-  bool visibilityChanged = false;
-  for ( const VisibilityExpression &it : std::as_const( mVisibilityExpressions ) )
+  // Collect the visibility expressions and field constraints depending on the updated fields
+  QList<int> visibilityExpressionIndexes;
+  QSet<int> constraintFieldIndexes;
+  if ( !updateAll )
   {
-    // If triggered by an updated field index (fieldIndex), check if the visibility
-    // expression refers to that field
-    if ( fieldIndex == -1 || it.first.referencedColumns().contains( fieldName ) || it.first.referencedColumns().contains( QgsFeatureRequest::ALL_ATTRIBUTES ) )
+    QSet<QString> dependencyKeys = fieldNames;
+    dependencyKeys << QgsFeatureRequest::ALL_ATTRIBUTES;
+    for ( const QString &dependencyKey : std::as_const( dependencyKeys ) )
     {
-      QgsExpression exp = it.first;
-      exp.prepare( &mExpressionContext );
+      visibilityExpressionIndexes << mVisibilityDependencies.value( dependencyKey );
+      constraintFieldIndexes.unite( mConstraintDependencies.value( dependencyKey ) );
+    }
+    // Keep the form order, nested containers follow their parents
+    std::sort( visibilityExpressionIndexes.begin(), visibilityExpressionIndexes.end() );
+    visibilityExpressionIndexes.erase( std::unique( visibilityExpressionIndexes.begin(), visibilityExpressionIndexes.end() ), visibilityExpressionIndexes.end() );
+  }
+  else
+  {
+    for ( int i = 0; i < mVisibilityExpressions.size(); ++i )
+      visibilityExpressionIndexes << i;
+  }
 
-      bool visible = exp.evaluate( &mExpressionContext ).toInt();
-      QStandardItem *item = it.second;
-      if ( item->data( AttributeFormModel::CurrentlyVisible ).toBool() != visible )
-      {
-        item->setData( visible, AttributeFormModel::CurrentlyVisible );
-        visibilityChanged = true;
-      }
+  bool visibilityChanged = false;
+  for ( const int visibilityExpressionIndex : std::as_const( visibilityExpressionIndexes ) )
+  {
+    VisibilityExpression &visibilityExpression = mVisibilityExpressions[visibilityExpressionIndex];
+    bool visible = visibilityExpression.expression.evaluate( &mExpressionContext ).toInt();
+    QStandardItem *item = visibilityExpression.item;
+    if ( item->data( AttributeFormModel::CurrentlyVisible ).toBool() != visible )
+    {
+      item->setData( visible, AttributeFormModel::CurrentlyVisible );
+      visibilityChanged = true;
     }
   }
 
   QMap<QStandardItem *, int>::ConstIterator fieldIterator( mFields.constBegin() );
   QMap<int, bool> hardConstraintsCache;
   QMap<int, bool> softConstraintsCache;
+  QSet<int> backgroundConstraints;
   bool validityChanged = false;
   for ( ; fieldIterator != mFields.constEnd(); ++fieldIterator )
   {
     QStandardItem *item = fieldIterator.key();
     int fidx = fieldIterator.value();
-    if ( fieldIndex != -1 && fidx != fieldIndex )
-    {
-      // Check whether the current field iterator index (fidx) has an expression constraints referencing the
-      // updated field index (fieldIndex) which triggered a constraints update
-      const QgsExpression expression = mLayer->fields().at( fidx ).constraints().constraintExpression();
-      if ( !expression.referencedColumns().contains( fieldName ) && !expression.referencedColumns().contains( QgsFeatureRequest::ALL_ATTRIBUTES ) )
-      {
-        continue;
-      }
-    }
+    if ( !updateAll && !constraintFieldIndexes.contains( fidx ) )
+      continue;
 
     if ( mFeatureModel->data( mFeatureModel->index( fidx ), FeatureModel::AttributeAllowEdit ) == true )
     {
@@ -854,6 +1256,38 @@ void AttributeFormModelBase::updateVisibilityAndConstraints( int fieldIndex )
         feature.setAttribute( fidx, defaultValueClause );
       }
 
+      if ( mExpensiveConstraints.contains( fidx ) )
+      {
+        // The field items keep their current validity until the constraint expression returns
+        if ( !backgroundConstraints.contains( fidx ) )
+        {
+          backgroundConstraints << fidx;
+          evaluateInBackground( QStringLiteral( "constraint:%1" ).arg( fidx ), fidx, mLayer->fields().at( fidx ).constraints().constraintExpression(), feature, [this, fidx, feature]( const QVariant &result ) {
+            const bool hardConstraintSatisfied = constraintsSatisfied( feature, fidx, QgsFieldConstraints::ConstraintStrengthHard, result.toBool() );
+            const bool softConstraintSatisfied = constraintsSatisfied( feature, fidx, QgsFieldConstraints::ConstraintStrengthSoft, result.toBool() );
+            bool validityChanged = false;
+            QMap<QStandardItem *, int>::ConstIterator fieldIterator( mFields.constBegin() );
+            for ( ; fieldIterator != mFields.constEnd(); ++fieldIterator )
+            {
+              QStandardItem *item = fieldIterator.key();
+              if ( fieldIterator.value() != fidx )
+                continue;
+
+              if ( item->data( AttributeFormModel::ConstraintHardValid ).toBool() != hardConstraintSatisfied || item->data( AttributeFormModel::ConstraintSoftValid ).toBool() != softConstraintSatisfied )
+              {
+                item->setData( hardConstraintSatisfied, AttributeFormModel::ConstraintHardValid );
+                item->setData( softConstraintSatisfied, AttributeFormModel::ConstraintSoftValid );
+                validityChanged = true;
+              }
+            }
+
+            if ( validityChanged )
+              updateContainersValidity();
+          } );
+        }
+        continue;
+      }
+
       bool hardConstraintSatisfied = false;
       if ( !hardConstraintsCache.contains( fidx ) )
       {
@@ -896,38 +1330,25 @@ void AttributeFormModelBase::updateVisibilityAndConstraints( int fieldIndex )
   // reset contrainsts status of containers
   if ( validityChanged || visibilityChanged )
   {
-    bool allConstraintsHardValid = true;
-    bool allConstraintsSoftValid = true;
+    updateContainersValidity();
+  }
+}
 
-    if ( mHasTabs )
-    {
-      QStandardItem *root = invisibleRootItem();
-      for ( int i = 0; i < root->rowCount(); i++ )
-      {
-        bool hardValidity = true;
-        bool softValidity = true;
+void AttributeFormModelBase::updateContainersValidity()
+{
+  bool allConstraintsHardValid = true;
+  bool allConstraintsSoftValid = true;
 
-        QStandardItem *tab = root->child( i, 0 );
-        _checkChildrenValidity( tab, hardValidity, softValidity );
-        if ( !hardValidity )
-        {
-          allConstraintsHardValid = false;
-        }
-        if ( !softValidity )
-        {
-          allConstraintsSoftValid = false;
-        }
-        tab->setData( hardValidity, AttributeFormModel::ConstraintHardValid );
-        tab->setData( softValidity, AttributeFormModel::ConstraintSoftValid );
-      }
-    }
-    else
+  if ( mHasTabs )
+  {
+    QStandardItem *root = invisibleRootItem();
+    for ( int i = 0; i < root->rowCount(); i++ )
     {
       bool hardValidity = true;
       bool softValidity = true;
-      QStandardItem *tab = invisibleRootItem();
-      _checkChildrenValidity( tab, hardValidity, softValidity );
 
+      QStandardItem *tab = root->child( i, 0 );
+      _checkChildrenValidity( tab, hardValidity, softValidity );
       if ( !hardValidity )
       {
         allConstraintsHardValid = false;
@@ -936,11 +1357,29 @@ void AttributeFormModelBase::updateVisibilityAndConstraints( int fieldIndex )
       {
         allConstraintsSoftValid = false;
       }
+      tab->setData( hardValidity, AttributeFormModel::ConstraintHardValid );
+      tab->setData( softValidity, AttributeFormModel::ConstraintSoftValid );
     }
+  }
+  else
+  {
+    bool hardValidity = true;
+    bool softValidity = true;
+    QStandardItem *tab = invisibleRootItem();
+    _checkChildrenValidity( tab, hardValidity, softValidity );
 
-    setConstraintsHardValid( allConstraintsHardValid );
-    setConstraintsSoftValid( allConstraintsSoftValid );
+    if ( !hardValidity )
+    {
+      allConstraintsHardValid = false;
+    }
+    if ( !softValidity )
+    {
+      allConstraintsSoftValid = false;
+    }
   }
+
+  setConstraintsHardValid( allConstraintsHardValid );
+  setConstraintsSoftValid( allConstraintsSoftValid );
 }
 
 bool AttributeFormModelBase::constraintsHardValid() const
@@ -1068,11 +1507,28 @@ void AttributeFormModelBase::setHasTabs( bool hasTabs )
 
 bool AttributeFormModelBase::save()
 {
+  flushBackgroundEvaluations();
+
+  // Hard constraints still pending when the form got confirmed may only now turn out to be invalid
+  if ( !mConstraintsHardValid )
+  {
+    emit constraintsHardValidChanged();
+    return false;
+  }
+
   return mFeatureModel->save();
 }
 
 bool AttributeFormModelBase::create()
 {
+  flushBackgroundEvaluations();
+
+  if ( !mConstraintsHardValid )
+  {
+    emit constraintsHardValidChanged();
+    return false;
+  }
+
   return mFeatureModel->create();
 }
 
@@ -23,6 +23,10 @@
 #include <qgsattributeeditorcontainer.h>
 #include <qgseditformconfig.h>
 #include <qgsexpressioncontext.h>
+#include <qgsfeedback.h>
+
+#include <functional>
+#include <memory>
 
 /**
  * \ingroup core
@@ -80,6 +84,51 @@ class AttributeFormModelBase : public QStandardItemModel
         bool formScope = false;
     };
 
+    //! A container visibility expression, prepared once per feature model application
+    struct VisibilityExpression
+    {
+        QgsExpression expression;
+        QStandardItem *item = nullptr;
+    };
+
+    //! An apply on update default value expression, prepared once per feature model application
+    struct DefaultValueExpression
+    {
+        int fieldIndex = -1;
+        QgsExpression expression;
+        QSet<QString> referencedColumns;
+        bool expensive = false;
+    };
+
+    //! An expression evaluated in the background, identified by a key and superseded by newer requests
+    struct BackgroundEvaluation
+    {
+        int requestId = 0;
+        int fieldIndex = -1;
+        QString expression;
+        QgsExpressionContext context;
+        std::function<void( const QVariant & )> apply;
+        std::shared_ptr<QgsFeedback> feedback;
+    };
+
+    /**
+     * The form structure built for a layer, cached across attribute form models until the
+     * layer fields or form configuration change. Item pointers refer to the template items.
+     */
+    struct FormTemplate
+    {
+        std::unique_ptr<QStandardItem> root;
+        bool hasTabs = false;
+        QList<QStandardItem *> containers;
+        QMap<QStandardItem *, int> fields;
+        QMap<QStandardItem *, QString> editorWidgetCodes;
+        QList<VisibilityExpression> visibilityExpressions;
+        QList<DefaultValueExpression> defaultValueExpressions;
+        QHash<QString, QList<int>> visibilityDependencies;
+        QHash<QString, QSet<int>> constraintDependencies;
+        QSet<int> expensiveConstraints;
+    };
+
     /**
      * Generates a root container for autogenerated layouts, so we can just use the same
      * form logic to deal with them.
@@ -101,17 +150,66 @@ class AttributeFormModelBase : public QStandardItemModel
     //! Synchronize all items linked to the \a fieldIndex to have the same \a value.
     void synchronizeFieldValue( int fieldIndex, QVariant value );
 
-    //! Update default values refering to the \a fieldIndex.
-    void updateDefaultValues( int fieldIndex = -1, QVector<int> updatedFields = QVector<int>() );
+    /**
+     * Update default values depending on the \a fieldIndex, following the dependency order of the
+     * default value expressions. Returns the names of the updated fields, including the \a fieldIndex one.
+     */
+    QSet<QString> updateDefaultValues( int fieldIndex );
+
+    //! Update QML, HTML, and text widget code depending on the \a fieldNames.
+    void updateEditorWidgetCodes( const QSet<QString> &fieldNames );
+
+    //! Check if the given \a code requires update when the \a fieldNames values changed.
+    bool codeRequiresUpdate( const QSet<QString> &fieldNames, const QString &code, const QRegularExpression &regEx );
+
+    /**
+     * Udate the visibility state of groups as well as constraints of field items depending
+     * on the \a fieldNames, all of them are updated when \a fieldNames is empty.
+     */
+    void updateVisibilityAndConstraints( const QSet<QString> &fieldNames = QSet<QString>() );
+
+    /**
+     * Builds the field to dependent expressions graph of the visibility, constraint and default
+     * value expressions of the form. Default value expressions are sorted in dependency order.
+     */
+    void buildExpressionDependencies();
+
+    //! Prepares the visibility and default value expressions against the form expression context
+    void prepareExpressions();
+
+    /**
+     * Returns TRUE if the \a expression calls functions which may be too slow to be evaluated
+     * while typing, such as aggregates, feature lookups or overlay functions.
+     */
+    static bool isExpensiveExpression( const QgsExpression &expression );
+
+    /**
+     * Evaluates \a expression against a snapshot of the form expression context on a worker thread,
+     * and calls \a apply with the result on the main thread. A pending evaluation sharing the same
+     * \a key is canceled.
+     */
+    void evaluateInBackground( const QString &key, int fieldIndex, const QString &expression, const QgsFeature &feature, const std::function<void( const QVariant & )> &apply );
+
+    //! Cancels all background evaluations, their results will be discarded
+    void cancelBackgroundEvaluations();
+
+    //! Synchronously evaluates and applies all pending background evaluations, used before saving
+    void flushBackgroundEvaluations();
+
+    //! Updates the pending state of the items of the field \a fieldIndex
+    void updateEvaluationPending( int fieldIndex );
 
-    //! Update QML, HTML, and text widget code.
-    void updateEditorWidgetCodes( const QString &fieldName );
+    //! Applies a default value computed in the background to the field \a fieldIndex and updates its dependents
+    void applyBackgroundDefaultValue( int fieldIndex, const QVariant &value );
 
-    //! Check if the given \a code requires update.
-    bool codeRequiresUpdate( const QString &fieldName, const QString &code, const QRegularExpression &regEx );
+    /**
+     * Returns TRUE if the constraints of \a strength of the field \a fieldIndex are satisfied by the \a feature,
+     * using \a expressionSatisfied as the outcome of the field constraint expression.
+     */
+    bool constraintsSatisfied( const QgsFeature &feature, int fieldIndex, QgsFieldConstraints::ConstraintStrength strength, bool expressionSatisfied ) const;
 
-    //! Udate the visibility state of groups as well as constraints of field items
-    void updateVisibilityAndConstraints( int fieldIndex = -1 );
+    //! Updates the constraints validity of containers and of the whole form
+    void updateContainersValidity();
 
     void setConstraintsHardValid( bool constraintsHardValid );
 
@@ -127,6 +225,24 @@ class AttributeFormModelBase : public QStandardItemModel
     //! Resets the attribute form model
     void resetModel();
 
+    //! Builds the form structure of the current layer, returns the group containers
+    QList<QStandardItem *> buildFormStructure();
+
+    //! Returns a template of the form structure currently held by the model
+    std::shared_ptr<const FormTemplate> captureFormTemplate( const QList<QStandardItem *> &containers ) const;
+
+    //! Instantiates the form structure of \a formTemplate into the model
+    void applyFormTemplate( const FormTemplate &formTemplate );
+
+    //! Binds the feature model values and remembered attributes onto the form structure
+    void bindFeatureModel();
+
+    //! Drops the cached form template of the layer \a layerId, or all templates if \a layerId is empty
+    static void invalidateFormTemplates( const QString &layerId = QString() );
+
+    //! Form templates keyed by layer id
+    static QHash<QString, std::shared_ptr<const FormTemplate>> sFormTemplates;
+
     //! Sets up a connection to listen to project map theme change
     void onMapThemeCollectionChanged();
 
@@ -135,8 +251,17 @@ class AttributeFormModelBase : public QStandardItemModel
     std::unique_ptr<QgsAttributeEditorContainer> mTemporaryContainer;
     bool mHasTabs = false;
 
-    typedef QPair<QgsExpression, QStandardItem *> VisibilityExpression;
     QList<VisibilityExpression> mVisibilityExpressions;
+    QList<DefaultValueExpression> mDefaultValueExpressions;
+    //! Indexes of visibility expressions depending on a field name
+    QHash<QString, QList<int>> mVisibilityDependencies;
+    //! Indexes of fields whose constraints depend on a field name
+    QHash<QString, QSet<int>> mConstraintDependencies;
+    //! Indexes of fields whose constraint expression is evaluated in the background
+    QSet<int> mExpensiveConstraints;
+
+    QHash<QString, BackgroundEvaluation> mBackgroundEvaluations;
+    int mBackgroundRequestId = 0;
     QMap<QStandardItem *, int> mFields;
     QMap<QStandardItem *, QString> mEditorWidgetCodes;
     QMap<QString, CodeRequirements> mEditorWidgetCodesRequirements;
@@ -14,7 +14,9 @@
  *                                                                         *
  ***************************************************************************/
 #include "badlayerhandler.h"
+#include "deferredlayerloader.h"
 
+#include <qgsmaplayer.h>
 #include <qgsproject.h>
 
 BadLayerHandler::BadLayerHandler( QObject *parent )
@@ -45,6 +47,10 @@ void BadLayerHandler::setProject( QgsProject *project )
   mProject = project;
 
   mProject->setBadLayerHandler( this );
+
+  // Projects read with deferred layer loading do not report bad layers, layers failing to load are reported as they are loaded
+  connect( mProject, &QgsProject::cleared, this, &BadLayerHandler::clear );
+  connect( DeferredLayerLoader::instance(), &DeferredLayerLoader::layerLoadFailed, this, &BadLayerHandler::onDeferredLayerLoadFailed );
   emit projectChanged();
 }
 
@@ -63,6 +69,16 @@ void BadLayerHandler::handleBadLayers( const QList<QDomNode> &layers )
   emit badLayersFound();
 }
 
+void BadLayerHandler::onDeferredLayerLoadFailed( QgsMapLayer *layer )
+{
+  QStandardItem *item = new QStandardItem();
+  item->setData( layer->publicSource(), DataSourceRole );
+  item->setData( layer->name(), LayerNameRole );
+  appendRow( item );
+
+  emit badLayersFound();
+}
+
 QString BadLayerHandler::layerName( const QDomNode &layerNode ) const
 {
   return layerNode.namedItem( "layername" ).toElement().text();
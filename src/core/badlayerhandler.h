@@ -49,6 +49,10 @@ class BadLayerHandler : public QStandardItemModel, public QgsProjectBadLayerHand
     void projectChanged();
     void badLayersFound();
 
+  private slots:
+    //! Reports a \a layer which could not be loaded after its loading was deferred
+    void onDeferredLayerLoadFailed( QgsMapLayer *layer );
+
   private:
     QString layerName( const QDomNode &layerNode ) const;
 
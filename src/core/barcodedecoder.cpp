@@ -16,36 +16,271 @@
 
 #include "barcodedecoder.h"
 
+#include <QMutex>
 #include <QVideoFrame>
 
 #include <ZXing/ReadBarcode.h>
 
-class BarcodeDecoderThread : public QThread
+//! Returns the ZXing image format matching the \a image format, ZXing::ImageFormat::None if there is no match
+static ZXing::ImageFormat imageFormatFromQImage( const QImage &image )
 {
+  switch ( image.format() )
+  {
+    case QImage::Format_ARGB32:
+    case QImage::Format_ARGB32_Premultiplied:
+    case QImage::Format_RGB32:
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+      return ZXing::ImageFormat::BGRX;
+#else
+      return ZXing::ImageFormat::XRGB;
+#endif
+    case QImage::Format_RGB888:
+      return ZXing::ImageFormat::RGB;
+    case QImage::Format_RGBX8888:
+    case QImage::Format_RGBA8888:
+    case QImage::Format_RGBA8888_Premultiplied:
+      return ZXing::ImageFormat::RGBX;
+    case QImage::Format_Grayscale8:
+      return ZXing::ImageFormat::Lum;
+    default:
+      return ZXing::ImageFormat::None;
+  }
+}
+
+/**
+ * Decodes the barcode of a \a width by \a height pixels buffer starting at \a data, only scanning the normalized
+ * \a regionOfInterest when not empty. Returns the decoded text, an empty string if no barcode was found.
+ */
+static QString decodeBuffer( const uchar *data, int width, int height, ZXing::ImageFormat format, int rowStride, int pixelStride, const QRectF &regionOfInterest )
+{
+  QRect region( 0, 0, width, height );
+  if ( !regionOfInterest.isEmpty() )
+  {
+    region &= QRectF( regionOfInterest.x() * width, regionOfInterest.y() * height, regionOfInterest.width() * width, regionOfInterest.height() * height ).toAlignedRect();
+  }
+
+  if ( region.isEmpty() )
+  {
+    return QString();
+  }
+
+  const uchar *firstPixel = data + static_cast<qsizetype>( region.top() ) * rowStride + static_cast<qsizetype>( region.left() ) * pixelStride;
+  ZXing::ImageView imageView( firstPixel, region.width(), region.height(), format, rowStride, pixelStride );
+
+#if ZXing_VERSION_MAJOR >= 2
+  ZXing::ReaderOptions options;
+  options.setFormats( ZXing::BarcodeFormat::Any );
+  options.setTryRotate( true );
+
+  ZXing::Result result = ZXing::ReadBarcode( imageView, options );
+  const std::string text = result.text();
+  return QString::fromStdString( text.c_str() );
+#else
+  ZXing::DecodeHints hints;
+  hints.setFormats( ZXing::BarcodeFormat::Any );
+  hints.setTryRotate( true );
+
+  ZXing::Result result = ZXing::ReadBarcode( imageView, hints );
+  const std::wstring text = result.text();
+  return QString::fromWCharArray( text.c_str() );
+#endif
+}
+
+//! Decodes the barcode of an \a image, only scanning the normalized \a regionOfInterest when not empty
+static QString decodeImageBuffer( QImage image, const QRectF &regionOfInterest )
+{
+  ZXing::ImageFormat format = imageFormatFromQImage( image );
+  if ( format == ZXing::ImageFormat::None )
+  {
+    image = image.convertToFormat( QImage::Format_Grayscale8 );
+    format = ZXing::ImageFormat::Lum;
+  }
+
+  if ( image.isNull() )
+  {
+    return QString();
+  }
+
+  return decodeBuffer( image.constBits(), image.width(), image.height(), format, static_cast<int>( image.bytesPerLine() ), image.depth() / 8, regionOfInterest );
+}
+
+/**
+ * Returns the normalized \a regionOfInterest of a presented video \a frame mapped into the frame buffer,
+ * undoing the mirroring and rotation applied when the frame is presented.
+ */
+static QRectF bufferRegionOfInterest( const QVideoFrame &frame, const QRectF &regionOfInterest )
+{
+  if ( regionOfInterest.isEmpty() )
+  {
+    return regionOfInterest;
+  }
+
+  QRectF region = regionOfInterest;
+
+  // Mirroring is applied after the rotation, around the vertical axis
+  if ( frame.mirrored() )
+  {
+    region = QRectF( 1.0 - region.right(), region.y(), region.width(), region.height() );
+  }
+
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 7, 0 )
+  const int rotation = static_cast<int>( frame.rotation() );
+#else
+  const int rotation = static_cast<int>( frame.rotationAngle() );
+#endif
+  switch ( rotation )
+  {
+    case 90:
+      region = QRectF( region.y(), 1.0 - region.right(), region.height(), region.width() );
+      break;
+    case 180:
+      region = QRectF( 1.0 - region.right(), 1.0 - region.bottom(), region.width(), region.height() );
+      break;
+    case 270:
+      region = QRectF( 1.0 - region.bottom(), region.x(), region.height(), region.width() );
+      break;
+    default:
+      break;
+  }
+
+  if ( frame.surfaceFormat().scanLineDirection() == QVideoFrameFormat::BottomToTop )
+  {
+    region = QRectF( region.x(), 1.0 - region.bottom(), region.width(), region.height() );
+  }
+
+  return region;
+}
+
+//! Decodes the barcode of a video \a frame, only scanning the normalized \a regionOfInterest of the presented frame when not empty
+static QString decodeFrame( QVideoFrame frame, const QRectF &regionOfInterest )
+{
+  if ( frame.map( QVideoFrame::ReadOnly ) )
+  {
+    // Offset and stride of the luminance samples within the first plane
+    int offset = 0;
+    int pixelStride = 0;
+    switch ( frame.pixelFormat() )
+    {
+      case QVideoFrameFormat::Format_NV12:
+      case QVideoFrameFormat::Format_NV21:
+      case QVideoFrameFormat::Format_YUV420P:
+      case QVideoFrameFormat::Format_YUV422P:
+      case QVideoFrameFormat::Format_YV12:
+      case QVideoFrameFormat::Format_IMC1:
+      case QVideoFrameFormat::Format_IMC2:
+      case QVideoFrameFormat::Format_IMC3:
+      case QVideoFrameFormat::Format_IMC4:
+      case QVideoFrameFormat::Format_Y8:
+        pixelStride = 1;
+        break;
+      case QVideoFrameFormat::Format_YUYV:
+        pixelStride = 2;
+        break;
+      case QVideoFrameFormat::Format_UYVY:
+        offset = 1;
+        pixelStride = 2;
+        break;
+      case QVideoFrameFormat::Format_AYUV:
+      case QVideoFrameFormat::Format_AYUV_Premultiplied:
+        offset = 1;
+        pixelStride = 4;
+        break;
+      default:
+        break;
+    }
+
+    if ( pixelStride > 0 )
+    {
+      // The luminance plane is all the decoder needs, it is read in place without any RGB conversion
+      // The buffer is not rotated nor mirrored like the presented frame the region of interest refers to
+      const QString text = decodeBuffer( frame.bits( 0 ) + offset, frame.width(), frame.height(), ZXing::ImageFormat::Lum, frame.bytesPerLine( 0 ), pixelStride, bufferRegionOfInterest( frame, regionOfInterest ) );
+      frame.unmap();
+      return text;
+    }
+
+    frame.unmap();
+  }
+
+  // Other pixel formats, such as RGB or texture backed frames, go through an image conversion which presents the frame
+  return decodeImageBuffer( frame.toImage(), regionOfInterest );
+}
+
+/**
+ * Decodes video frames on a long-lived thread. Posted frames land in a single slot mailbox,
+ * a frame posted while the previous one waits to be decoded replaces it.
+ */
+class BarcodeDecoderWorker : public QObject
+{
+    Q_OBJECT
+
   public:
-    explicit BarcodeDecoderThread( BarcodeDecoder *decoder, const QImage &image )
-      : QThread()
-      , mDecoder( decoder )
-      , mImage( image )
+    /**
+     * Posts a \a frame to be decoded, only scanning the normalized \a regionOfInterest when not empty.
+     * Returns TRUE if a frame waiting to be decoded got dropped.
+     * \note This can be called from any thread
+     */
+    bool postFrame( const QVideoFrame &frame, const QRectF &regionOfInterest )
     {
+      QMutexLocker locker( &mMutex );
+      const bool dropped = mPendingFrame.isValid();
+      mPendingFrame = frame;
+      mPendingRegionOfInterest = regionOfInterest;
+      mPendingTimer.start();
+      if ( !dropped )
+      {
+        QMetaObject::invokeMethod( this, &BarcodeDecoderWorker::decodePendingFrame, Qt::QueuedConnection );
+      }
+      return dropped;
     }
 
-  private:
-    void run() override
+  public slots:
+    //! Decodes the frame waiting in the mailbox
+    void decodePendingFrame()
     {
-      if ( mDecoder )
+      QVideoFrame frame;
+      QRectF regionOfInterest;
+      QElapsedTimer timer;
       {
-        mDecoder->decodeImage( mImage );
+        QMutexLocker locker( &mMutex );
+        std::swap( frame, mPendingFrame );
+        regionOfInterest = mPendingRegionOfInterest;
+        timer = mPendingTimer;
       }
+
+      if ( !frame.isValid() )
+      {
+        return;
+      }
+
+      const QString text = decodeFrame( frame, regionOfInterest );
+      emit frameDecoded( text, timer.nsecsElapsed() / 1000000.0 );
     }
 
-    BarcodeDecoder *mDecoder = nullptr;
-    QImage mImage;
+  signals:
+    //! Emitted when a frame was decoded into \a text, \a latency milliseconds after it was posted
+    void frameDecoded( const QString &text, double latency );
+
+  private:
+    QMutex mMutex;
+    QVideoFrame mPendingFrame;
+    QRectF mPendingRegionOfInterest;
+    QElapsedTimer mPendingTimer;
 };
 
 BarcodeDecoder::BarcodeDecoder( QObject *parent )
   : QObject( parent )
 {
+  mWorker = new BarcodeDecoderWorker();
+  mWorker->moveToThread( &mWorkerThread );
+  connect( &mWorkerThread, &QThread::finished, mWorker, &QObject::deleteLater );
+  connect( mWorker, &BarcodeDecoderWorker::frameDecoded, this, &BarcodeDecoder::onFrameDecoded );
+  mWorkerThread.start();
+}
+
+BarcodeDecoder::~BarcodeDecoder()
+{
+  mWorkerThread.quit();
+  mWorkerThread.wait();
 }
 
 void BarcodeDecoder::clearDecodedString()
@@ -60,60 +295,18 @@ void BarcodeDecoder::clearDecodedString()
   emit decodedStringChanged();
 }
 
-void BarcodeDecoder::decodeImage( const QImage &image )
+void BarcodeDecoder::setDecodedString( const QString &decodedString )
 {
-  auto imageFormatFromQImage = []( const QImage &img ) {
-    switch ( img.format() )
-    {
-      case QImage::Format_ARGB32:
-      case QImage::Format_RGB32:
-#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
-        return ZXing::ImageFormat::BGRX;
-#else
-        return ImageFormat::XRGB;
-#endif
-      case QImage::Format_RGB888:
-        return ZXing::ImageFormat::RGB;
-      case QImage::Format_RGBX8888:
-      case QImage::Format_RGBA8888:
-        return ZXing::ImageFormat::RGBX;
-      case QImage::Format_Grayscale8:
-        return ZXing::ImageFormat::Lum;
-      default:
-        return ZXing::ImageFormat::None;
-    }
-  };
-
-  ZXing::ImageFormat imageFormat = imageFormatFromQImage( image );
-  if ( imageFormat != ZXing::ImageFormat::None )
+  if ( !decodedString.isEmpty() && mDecodedString != decodedString )
   {
-    ZXing::ImageView imageView( image.bits(), image.width(), image.height(), imageFormat, static_cast<int>( image.bytesPerLine() ) );
-
-#if ZXing_VERSION_MAJOR >= 2
-    ZXing::ReaderOptions options;
-    options.setFormats( ZXing::BarcodeFormat::Any );
-    options.setTryRotate( true );
-
-    ZXing::Result result = ZXing::ReadBarcode( imageView, options );
-    const std::string text = result.text();
-    QString resultText = QString::fromStdString( text.c_str() );
-#else
-    ZXing::DecodeHints hints;
-    hints.setFormats( ZXing::BarcodeFormat::Any );
-    hints.setTryRotate( true );
-
-    ZXing::Result result = ZXing::ReadBarcode( imageView, hints );
-    const std::wstring text = result.text();
-    QString resultText = QString::fromWCharArray( text.c_str() );
-#endif
-    if ( !resultText.isEmpty() && mDecodedString != resultText )
-    {
-      mDecodedString = resultText;
-      emit decodedStringChanged();
-    }
+    mDecodedString = decodedString;
+    emit decodedStringChanged();
   }
+}
 
-  return;
+void BarcodeDecoder::decodeImage( const QImage &image )
+{
+  setDecodedString( decodeImageBuffer( image, mRegionOfInterest ) );
 }
 
 QVideoSink *BarcodeDecoder::videoSink() const
@@ -127,29 +320,60 @@ void BarcodeDecoder::setVideoSink( QVideoSink *sink )
     return;
 
   if ( mVideoSink )
-    disconnect( mVideoSink );
+    disconnect( mVideoSink, nullptr, this, nullptr );
 
   mVideoSink = sink;
-  connect( mVideoSink, &QVideoSink::videoFrameChanged, this, &BarcodeDecoder::decodeVideoFrame );
+  if ( mVideoSink )
+    connect( mVideoSink, &QVideoSink::videoFrameChanged, this, &BarcodeDecoder::decodeVideoFrame );
 
   emit videoSinkChanged();
 }
 
+void BarcodeDecoder::setRegionOfInterest( const QRectF &regionOfInterest )
+{
+  if ( mRegionOfInterest == regionOfInterest )
+    return;
+
+  mRegionOfInterest = regionOfInterest;
+
+  emit regionOfInterestChanged();
+}
+
 void BarcodeDecoder::decodeVideoFrame( const QVideoFrame &frame )
 {
-  if ( mDecodingThread || !frame.isValid() )
+  if ( !frame.isValid() )
     return;
 
-  QImage image = frame.toImage();
-  if ( !image.isNull() && image.format() != QImage::Format_ARGB32 )
+  if ( mWorker->postFrame( frame, mRegionOfInterest ) )
+  {
+    mDroppedFrameCount++;
+  }
+}
+
+void BarcodeDecoder::onFrameDecoded( const QString &text, double latency )
+{
+  setDecodedString( text );
+
+  mStatisticsFrameCount++;
+  mStatisticsLatencySum += latency;
+  if ( !mStatisticsTimer.isValid() )
   {
-    image = image.convertToFormat( QImage::Format_ARGB32 );
+    mStatisticsTimer.start();
+    return;
   }
 
-  mDecodingThread = new BarcodeDecoderThread( this, image );
-  connect( mDecodingThread, &QThread::finished, this, [=] {
-    mDecodingThread->deleteLater();
-    mDecodingThread = nullptr;
-  } );
-  mDecodingThread->start();
+  // Statistics are averaged over one second periods
+  const qint64 elapsed = mStatisticsTimer.elapsed();
+  if ( elapsed >= 1000 )
+  {
+    mDecodeRate = mStatisticsFrameCount * 1000.0 / elapsed;
+    mDecodeLatency = mStatisticsLatencySum / mStatisticsFrameCount;
+    mStatisticsFrameCount = 0;
+    mStatisticsLatencySum = 0.0;
+    mStatisticsTimer.restart();
+
+    emit statisticsChanged();
+  }
 }
+
+#include "barcodedecoder.moc"
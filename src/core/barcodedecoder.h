@@ -17,13 +17,22 @@
 #ifndef BARCODEDECODER_H
 #define BARCODEDECODER_H
 
+#include <QElapsedTimer>
 #include <QImage>
 #include <QObject>
 #include <QPointer>
+#include <QRectF>
 #include <QThread>
 #include <QVideoSink>
 
+class BarcodeDecoderWorker;
+
 /**
+ * Decodes barcodes from images and video frames.
+ *
+ * Video frames are decoded on a long-lived worker thread through a single frame mailbox:
+ * frames arriving while the worker is busy replace the waiting frame, which is dropped.
+ * The luminance plane of YUV frames is handed to the decoder as is, sparing RGB conversions.
  * \ingroup core
  */
 class BarcodeDecoder : public QObject
@@ -32,9 +41,14 @@ class BarcodeDecoder : public QObject
 
     Q_PROPERTY( QVideoSink *videoSink READ videoSink WRITE setVideoSink NOTIFY videoSinkChanged )
     Q_PROPERTY( QString decodedString READ decodedString NOTIFY decodedStringChanged )
+    Q_PROPERTY( QRectF regionOfInterest READ regionOfInterest WRITE setRegionOfInterest NOTIFY regionOfInterestChanged )
+    Q_PROPERTY( double decodeRate READ decodeRate NOTIFY statisticsChanged )
+    Q_PROPERTY( double decodeLatency READ decodeLatency NOTIFY statisticsChanged )
+    Q_PROPERTY( int droppedFrameCount READ droppedFrameCount NOTIFY statisticsChanged )
 
   public:
     explicit BarcodeDecoder( QObject *parent = nullptr );
+    ~BarcodeDecoder() override;
 
     /**
      * Returns the last barcode decoded string.
@@ -48,24 +62,62 @@ class BarcodeDecoder : public QObject
 
     /**
      * Scans a provided \a image for barcodes and if present sets the decoded string value.
+     * Only the region of interest of the image is scanned when set.
      */
     void decodeImage( const QImage &image );
 
     QVideoSink *videoSink() const;
     void setVideoSink( QVideoSink *sink );
 
+    /**
+     * Returns the region of images and video frames scanned for barcodes, in normalized coordinates of the presented frames.
+     * An empty rectangle, the default, scans whole frames.
+     */
+    QRectF regionOfInterest() const { return mRegionOfInterest; }
+
+    /**
+     * Sets the \a regionOfInterest of images and video frames scanned for barcodes, in normalized coordinates of the presented frames.
+     * An empty rectangle scans whole frames.
+     */
+    void setRegionOfInterest( const QRectF &regionOfInterest );
+
+    //! Returns the number of video frames decoded per second over the last second
+    double decodeRate() const { return mDecodeRate; }
+
+    //! Returns the average time in milliseconds between a video frame arrival and the end of its decoding over the last second
+    double decodeLatency() const { return mDecodeLatency; }
+
+    //! Returns the number of stale video frames dropped while the decoder was busy
+    int droppedFrameCount() const { return mDroppedFrameCount; }
+
   public slots:
     void decodeVideoFrame( const QVideoFrame &frame );
 
   signals:
     void decodedStringChanged();
     void videoSinkChanged();
+    void regionOfInterestChanged();
+    void statisticsChanged();
+
+  private slots:
+    void onFrameDecoded( const QString &text, double latency );
 
   private:
-    QImage mImage;
+    void setDecodedString( const QString &decodedString );
+
     QString mDecodedString;
-    QThread *mDecodingThread = nullptr;
     QPointer<QVideoSink> mVideoSink;
+    QRectF mRegionOfInterest;
+
+    QThread mWorkerThread;
+    BarcodeDecoderWorker *mWorker = nullptr;
+
+    double mDecodeRate = 0.0;
+    double mDecodeLatency = 0.0;
+    int mDroppedFrameCount = 0;
+    int mStatisticsFrameCount = 0;
+    double mStatisticsLatencySum = 0.0;
+    QElapsedTimer mStatisticsTimer;
 };
 
 #endif // BARCODEDECODER_H
@@ -0,0 +1,284 @@
+/***************************************************************************
+  deferredlayerloader.cpp - DeferredLayerLoader
+
+ ---------------------
+ begin                : 18.10.2026
+ copyright            : (C) 2026 by OPENGIS.ch
+ email                : info@opengis.ch
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "deferredlayerloader.h"
+#include "projectinfo.h"
+#include "qgsquickmapsettings.h"
+
+#include <QDomDocument>
+#include <QSettings>
+#include <qgslayertree.h>
+#include <qgsmaplayer.h>
+#include <qgsproject.h>
+#include <qgsprojectelevationproperties.h>
+#include <qgsreadwritecontext.h>
+#include <qgsrelationmanager.h>
+#include <qgsterrainprovider.h>
+#include <qgsvectorlayer.h>
+#include <qgsvectorlayerjoininfo.h>
+
+//! Dynamic property flagging layers whose data provider creation is deferred
+static const char *DEFERRED_LAYER_PROPERTY = "_qfield_deferred_layer";
+
+//! The delay after the last map scale change before deferred layers entering their scale range are loaded
+static const int LOAD_VISIBLE_LAYERS_DELAY_MS = 250;
+
+DeferredLayerLoader::DeferredLayerLoader( QObject *parent )
+  : QObject( parent )
+{
+  mLoadVisibleLayersTimer.setSingleShot( true );
+  mLoadVisibleLayersTimer.setInterval( LOAD_VISIBLE_LAYERS_DELAY_MS );
+  connect( &mLoadVisibleLayersTimer, &QTimer::timeout, this, &DeferredLayerLoader::loadVisibleLayers );
+}
+
+DeferredLayerLoader *DeferredLayerLoader::instance()
+{
+  static DeferredLayerLoader *sInstance = new DeferredLayerLoader();
+  return sInstance;
+}
+
+bool DeferredLayerLoader::isEnabled()
+{
+  return QSettings().value( QStringLiteral( "deferLayerLoading" ), false ).toBool();
+}
+
+bool DeferredLayerLoader::isDeferred( const QgsMapLayer *layer )
+{
+  return layer && layer->property( DEFERRED_LAYER_PROPERTY ).toBool();
+}
+
+void DeferredLayerLoader::setup( QgsProject *project, QgsQuickMapSettings *mapSettings )
+{
+  reset();
+
+  mProject = project;
+  mMapSettings = mapSettings;
+
+  // All layers are deferred first, allowing layers loaded below to load their own dependencies
+  const QMap<QString, QgsMapLayer *> layers = mProject->mapLayers();
+  for ( QgsMapLayer *layer : layers )
+  {
+    if ( layer->isValid() )
+      continue;
+
+    layer->setProperty( DEFERRED_LAYER_PROPERTY, true );
+    mDeferredLayerIds << layer->id();
+    mNodeLayers.insert( layer->id(), mProject->layerTreeRoot()->findLayer( layer->id() ) );
+  }
+
+  const QSet<QString> requiredIds = requiredLayerIds();
+  for ( QgsMapLayer *layer : layers )
+  {
+    if ( !isDeferred( layer ) )
+      continue;
+
+    // Layers without a tree node or a spatial extent are typically lookup tables used by forms,
+    // visible layers with a scale range are loaded once the map extent is known
+    QgsLayerTreeLayer *nodeLayer = mNodeLayers.value( layer->id() );
+    if ( !nodeLayer || !layer->isSpatial() || requiredIds.contains( layer->id() ) || ( nodeLayer->isVisible() && !layer->hasScaleBasedVisibility() ) )
+    {
+      loadLayer( layer );
+    }
+  }
+
+  // Relations were resolved against unloaded layers while reading the project
+  mProject->relationManager()->updateRelationsStatus();
+
+  if ( mDeferredLayerIds.isEmpty() )
+    return;
+
+  connect( mProject->layerTreeRoot(), &QgsLayerTreeNode::visibilityChanged, this, &DeferredLayerLoader::loadVisibleLayers );
+  // Panning the map emits extent changes on every frame, only scale changes matter to scale ranges
+  connect( mMapSettings, &QgsQuickMapSettings::extentChanged, this, &DeferredLayerLoader::onMapSettingsChanged );
+  connect( mMapSettings, &QgsQuickMapSettings::outputSizeChanged, this, &DeferredLayerLoader::onMapSettingsChanged );
+  connect( mProject, &QgsProject::cleared, this, &DeferredLayerLoader::reset );
+
+  // The map may already have its extent when a project is reloaded
+  onMapSettingsChanged();
+}
+
+bool DeferredLayerLoader::load( QgsMapLayer *layer )
+{
+  if ( !layer )
+    return false;
+
+  if ( !isDeferred( layer ) )
+    return layer->isValid();
+
+  loadLayer( layer );
+
+  if ( mDeferredLayerIds.isEmpty() )
+    reset();
+
+  return layer->isValid();
+}
+
+void DeferredLayerLoader::loadLayer( QgsMapLayer *layer )
+{
+  layer->setProperty( DEFERRED_LAYER_PROPERTY, QVariant() );
+  mDeferredLayerIds.remove( layer->id() );
+  mNodeLayers.remove( layer->id() );
+
+  QgsDataProvider::ProviderOptions options;
+  options.transformContext = mProject ? mProject->transformContext() : QgsCoordinateTransformContext();
+  layer->setDataSource( layer->source(), layer->name(), layer->providerType(), options );
+
+  if ( layer->isValid() && layer->type() != Qgis::LayerType::Vector && !layer->originalXmlProperties().isEmpty() )
+  {
+    // Vector layers keep the style read from the project, other layer types need their provider to read it
+    QDomDocument document;
+    document.setContent( layer->originalXmlProperties() );
+    QgsReadWriteContext context;
+    if ( mProject )
+    {
+      context.setPathResolver( mProject->pathResolver() );
+      context.setProjectTranslator( mProject );
+    }
+    QString errorMessage;
+    layer->readSymbology( document.firstChild(), errorMessage, context );
+  }
+
+  if ( QgsVectorLayer *vlayer = qobject_cast<QgsVectorLayer *>( layer ) )
+  {
+    // Remembered fields could not be restored with the project settings, the fields were unknown then
+    if ( mProject )
+      ProjectInfo::restoreLayerRememberedFields( mProject->fileName(), vlayer );
+
+    // Fields are only known once the provider exists, load the layers the layer forms and joins rely on
+    const QSet<QString> dependencyIds = layerDependencyIds( vlayer );
+    for ( const QString &dependencyId : dependencyIds )
+    {
+      QgsMapLayer *dependency = mProject ? mProject->mapLayer( dependencyId ) : nullptr;
+      if ( isDeferred( dependency ) )
+        loadLayer( dependency );
+    }
+  }
+
+  layer->triggerRepaint();
+  emit layerLoaded( layer );
+
+  if ( !layer->isValid() )
+    emit layerLoadFailed( layer );
+}
+
+void DeferredLayerLoader::onMapSettingsChanged()
+{
+  if ( !mMapSettings || mMapSettings->outputSize().isEmpty() || mMapSettings->extent().isEmpty() )
+    return;
+
+  const double scale = mMapSettings->mapSettings().scale();
+  if ( qgsDoubleNear( scale, mCheckedScale ) )
+    return;
+
+  mCheckedScale = scale;
+  mLoadVisibleLayersTimer.start();
+}
+
+void DeferredLayerLoader::loadVisibleLayers()
+{
+  if ( !mProject )
+    return;
+
+  const QSet<QString> deferredLayerIds = mDeferredLayerIds;
+  for ( const QString &layerId : deferredLayerIds )
+  {
+    QgsMapLayer *layer = mProject->mapLayer( layerId );
+    if ( !layer )
+    {
+      mDeferredLayerIds.remove( layerId );
+      continue;
+    }
+
+    if ( isVisible( layer ) )
+      load( layer );
+  }
+}
+
+bool DeferredLayerLoader::isVisible( QgsMapLayer *layer )
+{
+  // Nodes get replaced when moved around the layer tree
+  QPointer<QgsLayerTreeLayer> &nodeLayer = mNodeLayers[layer->id()];
+  if ( !nodeLayer )
+    nodeLayer = mProject->layerTreeRoot()->findLayer( layer->id() );
+
+  if ( !nodeLayer || !nodeLayer->isVisible() )
+    return false;
+
+  if ( !layer->hasScaleBasedVisibility() )
+    return true;
+
+  // Until the map has a size and an extent, its scale is meaningless
+  if ( !mMapSettings || mMapSettings->outputSize().isEmpty() || mMapSettings->extent().isEmpty() )
+    return false;
+
+  return layer->isInScaleRange( mMapSettings->mapSettings().scale() );
+}
+
+QSet<QString> DeferredLayerLoader::requiredLayerIds() const
+{
+  QSet<QString> layerIds;
+
+  const QMap<QString, QgsRelation> relations = mProject->relationManager()->relations();
+  for ( const QgsRelation &relation : relations )
+  {
+    layerIds << relation.referencingLayerId() << relation.referencedLayerId();
+  }
+
+  if ( QgsRasterDemTerrainProvider *terrainProvider = dynamic_cast<QgsRasterDemTerrainProvider *>( mProject->elevationProperties()->terrainProvider() ) )
+  {
+    if ( terrainProvider->layer() )
+      layerIds << terrainProvider->layer()->id();
+  }
+
+  return layerIds;
+}
+
+QSet<QString> DeferredLayerLoader::layerDependencyIds( QgsVectorLayer *layer )
+{
+  QSet<QString> layerIds;
+
+  const QList<QgsVectorLayerJoinInfo> joins = layer->vectorJoins();
+  for ( const QgsVectorLayerJoinInfo &join : joins )
+  {
+    layerIds << join.joinLayerId();
+  }
+
+  const QgsFields fields = layer->fields();
+  for ( int i = 0; i < fields.count(); i++ )
+  {
+    const QgsEditorWidgetSetup setup = layer->editorWidgetSetup( i );
+    if ( setup.type() == QStringLiteral( "ValueRelation" ) )
+      layerIds << setup.config().value( QStringLiteral( "Layer" ) ).toString();
+  }
+
+  return layerIds;
+}
+
+void DeferredLayerLoader::reset()
+{
+  if ( mProject )
+  {
+    disconnect( mProject, nullptr, this, nullptr );
+    disconnect( mProject->layerTreeRoot(), nullptr, this, nullptr );
+  }
+  if ( mMapSettings )
+    disconnect( mMapSettings, nullptr, this, nullptr );
+
+  mLoadVisibleLayersTimer.stop();
+  mCheckedScale = 0.0;
+  mDeferredLayerIds.clear();
+  mNodeLayers.clear();
+}
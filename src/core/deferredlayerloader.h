@@ -0,0 +1,115 @@
+/***************************************************************************
+  deferredlayerloader.h - DeferredLayerLoader
+
+ ---------------------
+ begin                : 18.10.2026
+ copyright            : (C) 2026 by OPENGIS.ch
+ email                : info@opengis.ch
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef DEFERREDLAYERLOADER_H
+#define DEFERREDLAYERLOADER_H
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QTimer>
+
+class QgsLayerTreeLayer;
+class QgsMapLayer;
+class QgsProject;
+class QgsQuickMapSettings;
+class QgsVectorLayer;
+
+/**
+ * Defers the creation of layer data providers until layers are needed.
+ *
+ * When deferred loading is enabled, projects are read without resolving their layers.
+ * Layers which are visible, in scale range, or used by other layers through relations,
+ * joins, value relations or the terrain are loaded right away; the other layers keep
+ * their project definition and only create their data provider once they become
+ * visible or are explicitly loaded through load(), e.g. when identified, searched
+ * or edited.
+ * \ingroup core
+ */
+class DeferredLayerLoader : public QObject
+{
+    Q_OBJECT
+
+  public:
+    //! Returns the application-wide loader instance
+    static DeferredLayerLoader *instance();
+
+    //! Returns TRUE when the deferred loading of layers is enabled in the settings
+    static bool isEnabled();
+
+    //! Returns TRUE when the data provider of \a layer has not been created yet
+    static bool isDeferred( const QgsMapLayer *layer );
+
+    /**
+     * Takes over the layers of \a project, which must have been read without resolving its layers.
+     * Needed layers are loaded immediately, the others are deferred and loaded as they become
+     * visible in \a mapSettings.
+     */
+    void setup( QgsProject *project, QgsQuickMapSettings *mapSettings );
+
+    /**
+     * Loads the deferred \a layer. Returns TRUE if the layer is valid, whether it was just loaded or not.
+     */
+    Q_INVOKABLE bool load( QgsMapLayer *layer );
+
+    //! Returns the number of layers currently deferred
+    int deferredLayerCount() const { return static_cast<int>( mDeferredLayerIds.size() ); }
+
+  signals:
+    //! Emitted when the deferred \a layer has been loaded
+    void layerLoaded( QgsMapLayer *layer );
+
+    //! Emitted when the deferred \a layer could not be loaded
+    void layerLoadFailed( QgsMapLayer *layer );
+
+  private slots:
+    //! Loads the deferred layers which became visible and are in scale range
+    void loadVisibleLayers();
+
+    //! Schedules loading the deferred layers entering their scale range, map extent changes keeping the scale are ignored
+    void onMapSettingsChanged();
+
+    void reset();
+
+  private:
+    explicit DeferredLayerLoader( QObject *parent = nullptr );
+
+    //! Creates the data provider of the deferred \a layer and loads the deferred layers it depends on
+    void loadLayer( QgsMapLayer *layer );
+
+    //! Returns the ids of the layers relations and the terrain depend on
+    QSet<QString> requiredLayerIds() const;
+
+    //! Returns the ids of the layers joined to \a layer or used by its value relation widgets
+    static QSet<QString> layerDependencyIds( QgsVectorLayer *layer );
+
+    //! Returns TRUE if \a layer is visible in the layer tree and within the current map scale range
+    bool isVisible( QgsMapLayer *layer );
+
+    QPointer<QgsProject> mProject;
+    QPointer<QgsQuickMapSettings> mMapSettings;
+    QSet<QString> mDeferredLayerIds;
+
+    //! The layer tree nodes of the deferred layers, sparing tree lookups on every check
+    QHash<QString, QPointer<QgsLayerTreeLayer>> mNodeLayers;
+
+    //! The map scale at which the deferred layers were last checked, 0 when unknown
+    double mCheckedScale = 0.0;
+    QTimer mLoadVisibleLayersTimer;
+};
+
+#endif // DEFERREDLAYERLOADER_H
@@ -17,12 +17,36 @@
 #include "expressioncontextutils.h"
 
 #include <QDateTime>
+#include <QTimer>
 #include <qgsexpressioncontextutils.h>
 #include <qgslayertree.h>
 #include <qgsmessagelog.h>
 #include <qgsvectorlayerutils.h>
 #include <qgswkbtypes.h>
 
+/**
+ * Prepared expressions fold static variables into constants, the variables of scopes
+ * refreshed after preparation are therefore demoted to non-static ones.
+ */
+static QgsExpressionContextScope *demoteStaticVariables( QgsExpressionContextScope *scope )
+{
+  const QStringList names = scope->variableNames();
+  for ( const QString &name : names )
+  {
+    scope->setVariable( name, scope->variable( name ), false );
+  }
+  return scope;
+}
+
+static void appendVariables( QgsExpressionContextScope *destination, const QgsExpressionContextScope *source )
+{
+  const QStringList names = source->variableNames();
+  for ( const QString &name : names )
+  {
+    destination->setVariable( name, source->variable( name ), false );
+  }
+}
+
 DigitizingLogger::DigitizingLogger()
 {
 }
@@ -33,6 +57,7 @@ void DigitizingLogger::setType( const QString &type )
     return;
 
   mType = type;
+  invalidateCompiledState();
 
   emit typeChanged();
 }
@@ -75,6 +100,9 @@ void DigitizingLogger::setProject( QgsProject *project )
   if ( mProject )
   {
     disconnect( mProject, &QgsProject::readProject, this, &DigitizingLogger::findLogsLayer );
+    disconnect( mProject, qOverload<QgsMapLayer *>( &QgsProject::layerWillBeRemoved ), this, &DigitizingLogger::onLayerWillBeRemoved );
+    disconnect( mProject, &QgsProject::crsChanged, this, &DigitizingLogger::invalidateCompiledState );
+    disconnect( mProject, &QgsProject::transformContextChanged, this, &DigitizingLogger::invalidateCompiledState );
   }
 
   mProject = project;
@@ -82,6 +110,9 @@ void DigitizingLogger::setProject( QgsProject *project )
   if ( mProject )
   {
     connect( mProject, &QgsProject::readProject, this, &DigitizingLogger::findLogsLayer );
+    connect( mProject, qOverload<QgsMapLayer *>( &QgsProject::layerWillBeRemoved ), this, &DigitizingLogger::onLayerWillBeRemoved );
+    connect( mProject, &QgsProject::crsChanged, this, &DigitizingLogger::invalidateCompiledState );
+    connect( mProject, &QgsProject::transformContextChanged, this, &DigitizingLogger::invalidateCompiledState );
   }
 
   clearCoordinates();
@@ -95,14 +126,36 @@ void DigitizingLogger::setMapSettings( QgsQuickMapSettings *mapSettings )
   if ( mMapSettings == mapSettings )
     return;
 
+  if ( mMapSettings )
+  {
+    disconnect( mMapSettings, &QgsQuickMapSettings::extentChanged, this, &DigitizingLogger::invalidateMapSettingsScope );
+    disconnect( mMapSettings, &QgsQuickMapSettings::destinationCrsChanged, this, &DigitizingLogger::invalidateMapSettingsScope );
+    disconnect( mMapSettings, &QgsQuickMapSettings::rotationChanged, this, &DigitizingLogger::invalidateMapSettingsScope );
+    disconnect( mMapSettings, &QgsQuickMapSettings::outputSizeChanged, this, &DigitizingLogger::invalidateMapSettingsScope );
+    disconnect( mMapSettings, &QgsQuickMapSettings::outputDpiChanged, this, &DigitizingLogger::invalidateMapSettingsScope );
+    disconnect( mMapSettings, &QgsQuickMapSettings::layersChanged, this, &DigitizingLogger::invalidateMapSettingsScope );
+  }
+
   mMapSettings = mapSettings;
 
+  if ( mMapSettings )
+  {
+    connect( mMapSettings, &QgsQuickMapSettings::extentChanged, this, &DigitizingLogger::invalidateMapSettingsScope );
+    connect( mMapSettings, &QgsQuickMapSettings::destinationCrsChanged, this, &DigitizingLogger::invalidateMapSettingsScope );
+    connect( mMapSettings, &QgsQuickMapSettings::rotationChanged, this, &DigitizingLogger::invalidateMapSettingsScope );
+    connect( mMapSettings, &QgsQuickMapSettings::outputSizeChanged, this, &DigitizingLogger::invalidateMapSettingsScope );
+    connect( mMapSettings, &QgsQuickMapSettings::outputDpiChanged, this, &DigitizingLogger::invalidateMapSettingsScope );
+    connect( mMapSettings, &QgsQuickMapSettings::layersChanged, this, &DigitizingLogger::invalidateMapSettingsScope );
+  }
+  invalidateCompiledState();
+
   emit mapSettingsChanged();
 }
 
 void DigitizingLogger::setCloudUserInformation( const CloudUserInformation &cloudUserInformation )
 {
   mCloudUserInformation = cloudUserInformation;
+  invalidateCompiledState();
 
   emit cloudUserInformationChanged();
 }
@@ -113,13 +166,14 @@ void DigitizingLogger::setDigitizingLayer( QgsVectorLayer *layer )
     return;
 
   mDigitizingLayer = layer;
+  invalidateCompiledState();
 
   emit digitizingLayerChanged();
 }
 
 void DigitizingLogger::findLogsLayer()
 {
-  mLogsLayer = nullptr;
+  QgsVectorLayer *logsLayer = nullptr;
   if ( mProject )
   {
     const QString logsLayerId = mProject->readEntry( QStringLiteral( "qfieldsync" ), QStringLiteral( "digitizingLogsLayer" ) );
@@ -131,56 +185,84 @@ void DigitizingLogger::findLogsLayer()
         QgsVectorLayer *layer = qobject_cast<QgsVectorLayer *>( item->layer() );
         if ( layer && layer->geometryType() == Qgis::GeometryType::Point && layer->dataProvider() && layer->dataProvider()->capabilities() & Qgis::VectorProviderCapability::AddFeatures )
         {
-          mLogsLayer = layer;
+          logsLayer = layer;
         }
       }
     }
   }
-}
-
-void DigitizingLogger::addCoordinate( const QgsPoint &point )
-{
-  if ( !mLogsLayer || mType.isEmpty() )
-    return;
 
-  QgsFeature feature = QgsFeature( mLogsLayer->fields() );
-  QgsGeometry geom( point.clone() );
-  if ( mProject->crs() != mLogsLayer->crs() )
+  if ( mLogsLayer != logsLayer )
   {
-    QgsCoordinateTransform ct( mProject->crs(), mLogsLayer->crs(), mProject->transformContext() );
-    try
+    if ( mLogsLayer )
     {
-      geom.transform( ct );
+      disconnect( mLogsLayer, &QgsMapLayer::crsChanged, this, &DigitizingLogger::invalidateCompiledState );
+      disconnect( mLogsLayer, &QgsVectorLayer::updatedFields, this, &DigitizingLogger::invalidateCompiledState );
     }
-    catch ( QgsCsException & )
+
+    // Queued features belong to the previous logs layer
+    drainWriteQueue();
+    if ( !mWriteQueue.isEmpty() )
     {
-      QgsDebugMsgLevel( "Could not transform current coordinate", 2 );
-      return;
+      QgsMessageLog::logMessage( tr( "%n queued digitizing log(s) could not be written and were discarded", "", static_cast<int>( mWriteQueue.size() ) ), QStringLiteral( "QField" ) );
+      mWriteQueue.clear();
+    }
+
+    mLogsLayer = logsLayer;
+
+    if ( mLogsLayer )
+    {
+      connect( mLogsLayer, &QgsMapLayer::crsChanged, this, &DigitizingLogger::invalidateCompiledState );
+      connect( mLogsLayer, &QgsVectorLayer::updatedFields, this, &DigitizingLogger::invalidateCompiledState );
     }
   }
-  feature.setGeometry( geom.coerceToType( mLogsLayer->wkbType() ).at( 0 ) );
 
-  QgsExpressionContext expressionContext = mLogsLayer->createExpressionContext();
+  invalidateCompiledState();
+}
 
-  if ( mMapSettings )
-    expressionContext << QgsExpressionContextUtils::mapSettingsScope( mMapSettings->mapSettings() );
+void DigitizingLogger::invalidateCompiledState()
+{
+  mCompiled = false;
+  mTransform = QgsCoordinateTransform();
+  mExpressionContext = QgsExpressionContext();
+  mDefaultValueExpressions.clear();
+}
 
-  if ( mPositionInformation.isValid() )
-    expressionContext << ExpressionContextUtils::positionScope( mPositionInformation, mPositionLocked );
+void DigitizingLogger::invalidateMapSettingsScope()
+{
+  mMapSettingsScopeDirty = true;
+}
 
-  if ( mTopSnappingResult.isValid() )
-    expressionContext << ExpressionContextUtils::mapToolCaptureScope( mTopSnappingResult );
+bool DigitizingLogger::compile()
+{
+  if ( mCompiled )
+    return true;
+
+  if ( !mLogsLayer )
+    return false;
+
+  if ( mProject && mProject->crs() != mLogsLayer->crs() )
+  {
+    mTransform = QgsCoordinateTransform( mProject->crs(), mLogsLayer->crs(), mProject->transformContext() );
+  }
 
-  expressionContext << ExpressionContextUtils::cloudUserScope( mCloudUserInformation );
+  // The expression context is made of scopes which remain unchanged until the configuration changes,
+  // followed by the map settings scope (refreshed on map settings changes) and the per-point scope
+  mExpressionContext = mLogsLayer->createExpressionContext();
+  mExpressionContext << ExpressionContextUtils::cloudUserScope( mCloudUserInformation );
 
   QgsExpressionContextScope *scope = new QgsExpressionContextScope( QObject::tr( "Digitizing Logger" ) );
   scope->addVariable( QgsExpressionContextScope::StaticVariable( QStringLiteral( "digitizing_type" ), mType, true, true ) );
-  scope->addVariable( QgsExpressionContextScope::StaticVariable( QStringLiteral( "digitizing_datetime" ), QDateTime::currentDateTime(), true, true ) );
   scope->addVariable( QgsExpressionContextScope::StaticVariable( QStringLiteral( "digitizing_layer_name" ), mDigitizingLayer ? mDigitizingLayer->name() : QString(), true, true ) );
   scope->addVariable( QgsExpressionContextScope::StaticVariable( QStringLiteral( "digitizing_layer_id" ), mDigitizingLayer ? mDigitizingLayer->id() : QString(), true, true ) );
-  expressionContext << scope;
+  mExpressionContext << scope;
+
+  if ( mMapSettings )
+  {
+    mExpressionContext << demoteStaticVariables( QgsExpressionContextUtils::mapSettingsScope( mMapSettings->mapSettings() ) );
+    mMapSettingsScopeDirty = false;
+  }
 
-  expressionContext.setFeature( feature );
+  mExpressionContext << new QgsExpressionContextScope( QObject::tr( "Digitizing Logger Point" ) );
 
   const QgsFields fields = mLogsLayer->fields();
   for ( int i = 0; i < fields.count(); ++i )
@@ -188,21 +270,80 @@ void DigitizingLogger::addCoordinate( const QgsPoint &point )
     if ( fields.at( i ).defaultValueDefinition().isValid() )
     {
       QgsExpression exp( fields.at( i ).defaultValueDefinition().expression() );
-      exp.prepare( &expressionContext );
+      exp.prepare( &mExpressionContext );
       if ( exp.hasParserError() )
         QgsMessageLog::logMessage( tr( "Default value expression for the digitizing logger's %2 field has a parser error: %3" ).arg( mLogsLayer->name(), fields.at( i ).name(), exp.parserErrorString() ), QStringLiteral( "QField" ) );
 
-      QVariant value = exp.evaluate( &expressionContext );
-      if ( exp.hasEvalError() )
-        QgsMessageLog::logMessage( tr( "Default value expression for the digitizing logger's %2 field has an evaluation error: %3" ).arg( mLogsLayer->name(), fields.at( i ).name(), exp.evalErrorString() ), QStringLiteral( "QField" ) );
+      mDefaultValueExpressions << qMakePair( i, exp );
+    }
+  }
+
+  mCompiled = true;
+  return true;
+}
+
+void DigitizingLogger::addCoordinate( const QgsPoint &point )
+{
+  if ( !mLogsLayer || mType.isEmpty() )
+    return;
 
-      feature.setAttribute( i, value );
+  if ( !compile() )
+    return;
+
+  QgsFeature feature = QgsFeature( mLogsLayer->fields() );
+  QgsGeometry geom( point.clone() );
+  if ( mTransform.isValid() )
+  {
+    try
+    {
+      geom.transform( mTransform );
     }
-    else
+    catch ( QgsCsException & )
     {
-      feature.setAttribute( i, QVariant() );
+      QgsDebugMsgLevel( "Could not transform current coordinate", 2 );
+      return;
     }
   }
+  feature.setGeometry( geom.coerceToType( mLogsLayer->wkbType() ).at( 0 ) );
+
+  // Replace the per-point scope, as well as the map settings scope when outdated
+  delete mExpressionContext.popScope();
+  if ( mMapSettings && mMapSettingsScopeDirty )
+  {
+    delete mExpressionContext.popScope();
+    mExpressionContext << demoteStaticVariables( QgsExpressionContextUtils::mapSettingsScope( mMapSettings->mapSettings() ) );
+    mMapSettingsScopeDirty = false;
+  }
+
+  QgsExpressionContextScope *pointScope = new QgsExpressionContextScope( QObject::tr( "Digitizing Logger Point" ) );
+  if ( mPositionInformation.isValid() )
+  {
+    std::unique_ptr<QgsExpressionContextScope> positionScope( ExpressionContextUtils::positionScope( mPositionInformation, mPositionLocked ) );
+    appendVariables( pointScope, positionScope.get() );
+  }
+
+  if ( mTopSnappingResult.isValid() )
+  {
+    std::unique_ptr<QgsExpressionContextScope> snappingScope( ExpressionContextUtils::mapToolCaptureScope( mTopSnappingResult ) );
+    appendVariables( pointScope, snappingScope.get() );
+  }
+
+  pointScope->setVariable( QStringLiteral( "digitizing_datetime" ), QDateTime::currentDateTime(), false );
+  mExpressionContext << pointScope;
+
+  mExpressionContext.setFeature( feature );
+
+  QgsAttributes attributes( mLogsLayer->fields().count() );
+  for ( QPair<int, QgsExpression> &defaultValueExpression : mDefaultValueExpressions )
+  {
+    QgsExpression &exp = defaultValueExpression.second;
+    const QVariant value = exp.evaluate( &mExpressionContext );
+    if ( exp.hasEvalError() )
+      QgsMessageLog::logMessage( tr( "Default value expression for the digitizing logger's %2 field has an evaluation error: %3" ).arg( mLogsLayer->name(), mLogsLayer->fields().at( defaultValueExpression.first ).name(), exp.evalErrorString() ), QStringLiteral( "QField" ) );
+
+    attributes[defaultValueExpression.first] = value;
+  }
+  feature.setAttributes( attributes );
 
   mPointFeatures << feature;
 }
@@ -218,30 +359,72 @@ void DigitizingLogger::writeCoordinates()
   if ( !mLogsLayer )
     return;
 
-  if ( mLogsLayer->startEditing() )
-  {
-    for ( const auto &pointFeature : std::as_const( mPointFeatures ) )
-    {
-      QgsFeature createdFeature = QgsVectorLayerUtils::createFeature( mLogsLayer, pointFeature.geometry(), pointFeature.attributes().toMap() );
-      if ( !mLogsLayer->addFeature( createdFeature ) )
-      {
-        QgsMessageLog::logMessage( tr( "Digitizing logs layer feature addition failed" ), QStringLiteral( "QField" ) );
-      }
-    }
+  mWriteQueue << mPointFeatures;
+  clearCoordinates();
 
-    if ( !mLogsLayer->commitChanges( true ) )
-    {
-      QgsMessageLog::logMessage( tr( "Digitizing logs layer change commits failed" ), QStringLiteral( "QField" ) );
-    }
-    else
-    {
-      clearCoordinates();
-    }
+  flushWriteQueue();
+}
+
+void DigitizingLogger::flushWriteQueue()
+{
+  if ( writeQueuedBatch() && !mWriteQueue.isEmpty() )
+  {
+    QTimer::singleShot( 0, this, &DigitizingLogger::flushWriteQueue );
   }
-  else
+}
+
+bool DigitizingLogger::writeQueuedBatch()
+{
+  if ( !mLogsLayer || mWriteQueue.isEmpty() )
+    return false;
+
+  if ( !mLogsLayer->startEditing() )
   {
     QgsMessageLog::logMessage( tr( "Digitizing logs layer editing failed" ), QStringLiteral( "QField" ) );
+    return false;
+  }
+
+  const qsizetype batchSize = std::min<qsizetype>( mWriteQueue.size(), WRITE_BATCH_SIZE );
+  QgsVectorLayerUtils::QgsFeaturesDataList featuresData;
+  featuresData.reserve( batchSize );
+  for ( qsizetype i = 0; i < batchSize; ++i )
+  {
+    featuresData << QgsVectorLayerUtils::QgsFeatureData( mWriteQueue.at( i ).geometry(), mWriteQueue.at( i ).attributes().toMap() );
   }
+
+  // Keep the batch queued on failure, it will be retried on the next write
+  QgsFeatureList createdFeatures = QgsVectorLayerUtils::createFeatures( mLogsLayer, featuresData );
+  if ( !mLogsLayer->addFeatures( createdFeatures ) )
+  {
+    QgsMessageLog::logMessage( tr( "Digitizing logs layer feature addition failed" ), QStringLiteral( "QField" ) );
+    mLogsLayer->rollBack();
+    return false;
+  }
+
+  if ( !mLogsLayer->commitChanges( true ) )
+  {
+    QgsMessageLog::logMessage( tr( "Digitizing logs layer change commits failed" ), QStringLiteral( "QField" ) );
+    mLogsLayer->rollBack();
+    return false;
+  }
+
+  mWriteQueue.remove( 0, batchSize );
+  return true;
+}
+
+void DigitizingLogger::drainWriteQueue()
+{
+  while ( !mWriteQueue.isEmpty() )
+  {
+    if ( !writeQueuedBatch() )
+      break;
+  }
+}
+
+void DigitizingLogger::onLayerWillBeRemoved( QgsMapLayer *layer )
+{
+  if ( mLogsLayer && layer == mLogsLayer )
+    drainWriteQueue();
 }
 
 void DigitizingLogger::clearCoordinates()
@@ -22,6 +22,10 @@
 #include "snappingresult.h"
 
 #include <QObject>
+#include <QPointer>
+#include <qgscoordinatetransform.h>
+#include <qgsexpression.h>
+#include <qgsexpressioncontext.h>
 #include <qgspoint.h>
 #include <qgsproject.h>
 #include <qgsvectorlayer.h>
@@ -131,6 +135,9 @@ class DigitizingLogger : public QObject
 
     /**
      * Writes the points buffer to the digitizing logs layer.
+     * \note the buffered points are queued and committed in batches, the first batch
+     * being written immediately while remaining batches are written on subsequent event
+     * loop iterations to keep the interface responsive.
      */
     Q_INVOKABLE void writeCoordinates();
 
@@ -155,11 +162,35 @@ class DigitizingLogger : public QObject
     //! Finds and link to the logs layer in present in the project
     void findLogsLayer();
 
+    //! Discards the compiled default value expressions, transform and expression context
+    void invalidateCompiledState();
+
+    //! Flags the map settings expression context scope as needing a refresh
+    void invalidateMapSettingsScope();
+
+    /**
+     * Prepares the default value expressions, coordinate transform and expression context
+     * used to create digitizing log features. Returns FALSE if no logs layer is available.
+     */
+    bool compile();
+
+    //! Commits the next batch of queued features into the digitizing logs layer, scheduling the following batch
+    void flushWriteQueue();
+
+    //! Commits the next batch of queued features into the digitizing logs layer, returns FALSE and keeps the batch queued on failure
+    bool writeQueuedBatch();
+
+    //! Commits all queued features into the digitizing logs layer before it goes away
+    void drainWriteQueue();
+
+    //! Drains the write queue when the digitizing logs \a layer is about to be removed from the project
+    void onLayerWillBeRemoved( QgsMapLayer *layer );
+
     QString mType;
 
     QgsProject *mProject = nullptr;
     QgsQuickMapSettings *mMapSettings = nullptr;
-    QgsVectorLayer *mLogsLayer = nullptr;
+    QPointer<QgsVectorLayer> mLogsLayer;
     QgsVectorLayer *mDigitizingLayer = nullptr;
 
     GnssPositionInformation mPositionInformation;
@@ -168,6 +199,15 @@ class DigitizingLogger : public QObject
     CloudUserInformation mCloudUserInformation;
 
     QList<QgsFeature> mPointFeatures;
+    QList<QgsFeature> mWriteQueue;
+
+    bool mCompiled = false;
+    QgsCoordinateTransform mTransform;
+    QgsExpressionContext mExpressionContext;
+    bool mMapSettingsScopeDirty = true;
+    QList<QPair<int, QgsExpression>> mDefaultValueExpressions;
+
+    static constexpr int WRITE_BATCH_SIZE = 250;
 };
 
 #endif // DIGITIZINGLOGGER_H
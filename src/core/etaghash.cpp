@@ -0,0 +1,106 @@
+/***************************************************************************
+  etaghash.cpp - EtagHash
+
+ ---------------------
+ begin                : 18.10.2026
+ copyright            : (C) 2026 by OPENGIS.ch
+ email                : info@opengis.ch
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "etaghash.h"
+
+#include <QIODevice>
+
+#include <algorithm>
+#include <limits>
+
+EtagHash::EtagHash( qint64 partSize )
+  : mPartSize( partSize )
+  , mPartHash( QCryptographicHash::Md5 )
+{
+}
+
+void EtagHash::addData( const QByteArray &data )
+{
+  qint64 offset = 0;
+  while ( offset < data.size() )
+  {
+    const qint64 length = std::min( mPartSize - mPartBytes, static_cast<qint64>( data.size() ) - offset );
+    mPartHash.addData( QByteArrayView( data.constData() + offset, length ) );
+    mPartBytes += length;
+    offset += length;
+
+    if ( mPartBytes == mPartSize )
+    {
+      mPartChecksums += mPartHash.result();
+      mPartHash.reset();
+      mPartBytes = 0;
+    }
+  }
+  mSize += data.size();
+}
+
+bool EtagHash::addData( QIODevice *device, qint64 maximumSize )
+{
+  // Read in chunks to keep the memory usage low with large files
+  constexpr qint64 chunkSize = 1024 * 1024;
+  qint64 remaining = maximumSize < 0 ? std::numeric_limits<qint64>::max() : maximumSize;
+  while ( remaining > 0 )
+  {
+    const QByteArray data = device->read( std::min( chunkSize, remaining ) );
+    if ( data.isEmpty() )
+      return maximumSize < 0 && device->atEnd();
+
+    addData( data );
+    remaining -= data.size();
+  }
+  return true;
+}
+
+QString EtagHash::result() const
+{
+  if ( mSize <= mPartSize )
+  {
+    // Single part content, the part checksum got already moved to the list when the part got full
+    return QString( ( mPartChecksums.isEmpty() ? mPartHash.result() : mPartChecksums ).toHex() );
+  }
+
+  QByteArray partChecksums = mPartChecksums;
+  qint64 partCount = mSize / mPartSize;
+  if ( mPartBytes > 0 )
+  {
+    partChecksums += mPartHash.result();
+    partCount++;
+  }
+
+  return QStringLiteral( "%1-%2" ).arg( QString( QCryptographicHash::hash( partChecksums, QCryptographicHash::Md5 ).toHex() ) ).arg( partCount );
+}
+
+bool EtagHash::isComparable( const QString &etag, qint64 size, qint64 partSize )
+{
+  const qsizetype separatorIndex = etag.lastIndexOf( '-' );
+  if ( size <= partSize )
+    return separatorIndex < 0;
+
+  if ( separatorIndex < 0 )
+    return false;
+
+  bool ok = false;
+  const qint64 partCount = etag.mid( separatorIndex + 1 ).toLongLong( &ok );
+  return ok && partCount == ( size + partSize - 1 ) / partSize;
+}
+
+void EtagHash::reset()
+{
+  mPartHash.reset();
+  mPartChecksums.clear();
+  mPartBytes = 0;
+  mSize = 0;
+}
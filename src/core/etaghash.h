@@ -0,0 +1,77 @@
+/***************************************************************************
+  etaghash.h - EtagHash
+
+ ---------------------
+ begin                : 18.10.2026
+ copyright            : (C) 2026 by OPENGIS.ch
+ email                : info@opengis.ch
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef ETAGHASH_H
+#define ETAGHASH_H
+
+#include "qfield_core_export.h"
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QString>
+
+class QIODevice;
+
+/**
+ * Computes the Object Storage (S3) ETag of content fed in successive chunks.
+ *
+ * Content up to the part size gets the MD5 checksum of the content as ETag, larger content
+ * gets the MD5 checksum of the MD5 checksums of its parts, followed by the number of parts.
+ * This allows for checking the integrity of a file while it is being downloaded.
+ * \ingroup core
+ */
+class QFIELD_CORE_EXPORT EtagHash
+{
+  public:
+    //! Creates an ETag hash dividing the content into parts of \a partSize bytes
+    explicit EtagHash( qint64 partSize = DEFAULT_PART_SIZE );
+
+    //! Adds \a data to the hashed content
+    void addData( const QByteArray &data );
+
+    /**
+     * Adds up to \a maximumSize bytes read from \a device to the hashed content, all remaining
+     * bytes when \a maximumSize is negative. Returns FALSE if reading from the device failed.
+     */
+    bool addData( QIODevice *device, qint64 maximumSize = -1 );
+
+    //! Returns the ETag of the content added so far
+    QString result() const;
+
+    //! Returns the number of bytes added so far
+    qint64 size() const { return mSize; }
+
+    //! Clears the hashed content
+    void reset();
+
+    /**
+     * Returns TRUE when \a etag can be compared with the ETag computed over content of \a size bytes
+     * divided into parts of \a partSize bytes. Multipart uploads using another part size give an
+     * ETag with another number of parts, which never matches the computed one.
+     */
+    static bool isComparable( const QString &etag, qint64 size, qint64 partSize = DEFAULT_PART_SIZE );
+
+    static constexpr qint64 DEFAULT_PART_SIZE = 8 * 1024 * 1024;
+
+  private:
+    qint64 mPartSize = DEFAULT_PART_SIZE;
+    qint64 mSize = 0;
+    qint64 mPartBytes = 0;
+    QCryptographicHash mPartHash;
+    QByteArray mPartChecksums;
+};
+
+#endif // ETAGHASH_H
@@ -0,0 +1,102 @@
+/***************************************************************************
+  featureexpressionvaluesgatherer.cpp - FeatureExpressionValuesGatherer
+
+ ---------------------
+ begin                : 29.1.2021
+ copyright            : (C) 2021 by Mathieu Pellerin
+ email                : nirvn dot asia at gmail dot com
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "featureexpressionvaluesgatherer.h"
+
+#include <QQueue>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+FeatureExpressionValuesGatherer::FeatureExpressionValuesGatherer( QgsVectorLayer *layer, const QString &displayExpression, const QgsFeatureRequest &request, const QStringList &identifierFields )
+  : mSource( new QgsVectorLayerFeatureSource( layer ) )
+  , mDisplayExpression( displayExpression.isEmpty() ? layer->displayExpression() : displayExpression )
+  , mExpressionContext( layer->createExpressionContext() )
+  , mRequest( request )
+  , mIdentifierFields( identifierFields )
+{
+}
+
+void FeatureExpressionValuesGatherer::run()
+{
+  QList<int> attributeIndexes;
+  for ( const QString &fieldName : std::as_const( mIdentifierFields ) )
+    attributeIndexes << mSource->fields().indexOf( fieldName );
+
+  // Keep a bounded number of batches in flight so reading does not outpace the evaluation
+  QThreadPool *pool = QThreadPool::globalInstance();
+  const int maxPendingBatches = std::max( 2, pool->maxThreadCount() * 2 );
+  QQueue<QFuture<QVector<Entry>>> pendingBatches;
+
+  auto emitFinishedBatches = [this, &pendingBatches]( int maxPending ) {
+    while ( !pendingBatches.isEmpty() && ( pendingBatches.size() > maxPending || pendingBatches.head().isFinished() ) )
+    {
+      const QVector<Entry> entries = pendingBatches.dequeue().result();
+      if ( !mWasCanceled && !entries.isEmpty() )
+        emit entriesGathered( entries );
+    }
+  };
+
+  QgsFeatureIterator iterator = mSource->getFeatures( mRequest );
+  QgsFeature feature;
+  QVector<QgsFeature> batch;
+  batch.reserve( BATCH_SIZE );
+  while ( iterator.nextFeature( feature ) )
+  {
+    if ( mWasCanceled )
+      break;
+
+    batch << feature;
+    if ( batch.size() >= BATCH_SIZE )
+    {
+      pendingBatches.enqueue( QtConcurrent::run( pool, [this, batch, attributeIndexes] { return gatherBatch( batch, attributeIndexes ); } ) );
+      batch.clear();
+      emitFinishedBatches( maxPendingBatches );
+    }
+  }
+
+  if ( !batch.isEmpty() && !mWasCanceled )
+  {
+    pendingBatches.enqueue( QtConcurrent::run( pool, [this, batch, attributeIndexes] { return gatherBatch( batch, attributeIndexes ); } ) );
+  }
+
+  // Batches still running reference this gatherer, always wait for them
+  emitFinishedBatches( 0 );
+}
+
+QVector<FeatureExpressionValuesGatherer::Entry> FeatureExpressionValuesGatherer::gatherBatch( const QVector<QgsFeature> &features, const QList<int> &attributeIndexes ) const
+{
+  // Expressions are not safe to evaluate concurrently, each batch works on its own copy
+  QgsExpressionContext context( mExpressionContext );
+  QgsExpression expression( mDisplayExpression );
+  expression.prepare( &context );
+
+  QVector<Entry> entries;
+  entries.reserve( features.size() );
+  for ( const QgsFeature &feature : features )
+  {
+    if ( mWasCanceled )
+      break;
+
+    context.setFeature( feature );
+    QVariantList attributes;
+    for ( const int idx : attributeIndexes )
+      attributes << feature.attribute( idx );
+
+    entries.append( Entry( attributes, expression.evaluate( &context ).toString(), feature.id(), mKeepGeometry ? feature.geometry() : QgsGeometry() ) );
+  }
+
+  return entries;
+}
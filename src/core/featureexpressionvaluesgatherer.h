@@ -18,17 +18,23 @@
 #ifndef FEATUREEXPRESSIONVALUESGATHERER_H
 #define FEATUREEXPRESSIONVALUESGATHERER_H
 
-#include <QMutex>
 #include <QThread>
-#include <qgsapplication.h>
+#include <QVector>
 #include <qgsfeature.h>
-#include <qgslogger.h>
 #include <qgsvectorlayer.h>
 #include <qgsvectorlayerfeatureiterator.h>
 
+#include <atomic>
+
 /**
  * Gathers features with substring matching on an expression.
- * \note This is a is an exact copy of QGIS' QgsFeatureExpressionValuesGatherer
+ *
+ * Features are read on the gatherer thread and handed over in batches of consecutive
+ * features to the global thread pool, where the display expression is evaluated. The
+ * gathered entries are streamed to the caller through entriesGathered() in the order of
+ * the request, allowing for results to be displayed before the whole layer is scanned.
+ *
+ * \note This is derived from QGIS' QgsFeatureExpressionValuesGatherer
  * \ingroup core
  */
 class FeatureExpressionValuesGatherer : public QThread
@@ -46,93 +52,40 @@ class FeatureExpressionValuesGatherer : public QThread
     explicit FeatureExpressionValuesGatherer( QgsVectorLayer *layer,
                                               const QString &displayExpression = QString(),
                                               const QgsFeatureRequest &request = QgsFeatureRequest(),
-                                              const QStringList &identifierFields = QStringList() )
-      : mSource( new QgsVectorLayerFeatureSource( layer ) )
-      , mDisplayExpression( displayExpression.isEmpty() ? layer->displayExpression() : displayExpression )
-      , mExpressionContext( layer->createExpressionContext() )
-      , mRequest( request )
-      , mIdentifierFields( identifierFields )
-    {
-    }
+                                              const QStringList &identifierFields = QStringList() );
 
     struct Entry
     {
         Entry() = default;
 
-        Entry( const QVariantList &_identifierFields, const QString &_value, const QgsFeature &_feature )
+        Entry( const QVariantList &_identifierFields, const QString &_value, QgsFeatureId _featureId, const QgsGeometry &_geometry = QgsGeometry() )
           : identifierFields( _identifierFields )
-          , featureId( _feature.isValid() ? _feature.id() : FID_NULL )
-          , value( _value )
-          , feature( _feature )
-        {}
-
-        Entry( const QgsFeatureId &_featureId, const QString &_value, const QgsVectorLayer *layer )
-          : featureId( _featureId )
+          , featureId( _featureId )
           , value( _value )
-          , feature( QgsFeature( layer ? layer->fields() : QgsFields() ) )
+          , geometry( _geometry )
         {}
 
         QVariantList identifierFields;
-        QgsFeatureId featureId;
+        QgsFeatureId featureId = FID_NULL;
         QString value;
-        QgsFeature feature;
 
-        bool operator()( const Entry &lhs, const Entry &rhs ) const;
+        //! The feature geometry, only kept when requested through setKeepGeometry()
+        QgsGeometry geometry;
     };
 
-    static Entry nullEntry( QgsVectorLayer *layer )
-    {
-      return Entry( QVariantList(), QgsApplication::nullRepresentation(), QgsFeature( layer->fields() ) );
-    }
-
-    void run() override
-    {
-      mWasCanceled = false;
-
-      QgsFeatureIterator iterator = mSource->getFeatures( mRequest );
-
-      mDisplayExpression.prepare( &mExpressionContext );
-
-      QgsFeature feature;
-      QList<int> attributeIndexes;
-      for ( const QString &fieldName : std::as_const( mIdentifierFields ) )
-        attributeIndexes << mSource->fields().indexOf( fieldName );
-
-      while ( iterator.nextFeature( feature ) )
-      {
-        mExpressionContext.setFeature( feature );
-        QVariantList attributes;
-        for ( const int idx : attributeIndexes )
-          attributes << feature.attribute( idx );
-
-        const QString expressionValue = mDisplayExpression.evaluate( &mExpressionContext ).toString();
-
-        mEntries.append( Entry( attributes, expressionValue, feature ) );
-
-        QMutexLocker locker( &mCancelMutex );
-        if ( mWasCanceled )
-          return;
-      }
-    }
+    void run() override;
 
     //! Informs the gatherer to immediately stop collecting values
-    void stop()
-    {
-      QMutexLocker locker( &mCancelMutex );
-      mWasCanceled = true;
-    }
+    void stop() { mWasCanceled = true; }
 
     //! Returns TRUE if collection was canceled before completion
-    bool wasCanceled() const
-    {
-      QMutexLocker locker( &mCancelMutex );
-      return mWasCanceled;
-    }
+    bool wasCanceled() const { return mWasCanceled; }
 
-    QVector<Entry> entries() const
-    {
-      return mEntries;
-    }
+    //! Returns TRUE if the feature geometries are kept in the gathered entries
+    bool keepGeometry() const { return mKeepGeometry; }
+
+    //! Sets whether the feature geometries are kept in the gathered entries, defaults to FALSE
+    void setKeepGeometry( bool keepGeometry ) { mKeepGeometry = keepGeometry; }
 
     QgsFeatureRequest request() const
     {
@@ -155,16 +108,26 @@ class FeatureExpressionValuesGatherer : public QThread
       mData = data;
     }
 
-  protected:
-    QVector<Entry> mEntries;
+  signals:
+
+    /**
+     * Emitted from the gatherer thread when a batch of \a entries has been gathered.
+     * Batches are emitted in the order of the request, the finished() signal follows the last batch.
+     */
+    void entriesGathered( const QVector<FeatureExpressionValuesGatherer::Entry> &entries );
 
   private:
+    //! Evaluates the display expression and identifier fields of a batch of \a features
+    QVector<Entry> gatherBatch( const QVector<QgsFeature> &features, const QList<int> &attributeIndexes ) const;
+
+    static constexpr int BATCH_SIZE = 1000;
+
     std::unique_ptr<QgsVectorLayerFeatureSource> mSource;
-    QgsExpression mDisplayExpression;
+    QString mDisplayExpression;
     QgsExpressionContext mExpressionContext;
     QgsFeatureRequest mRequest;
-    bool mWasCanceled = false;
-    mutable QMutex mCancelMutex;
+    std::atomic<bool> mWasCanceled = false;
+    bool mKeepGeometry = false;
     QStringList mIdentifierFields;
     QVariant mData;
 };
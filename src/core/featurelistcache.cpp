@@ -0,0 +1,159 @@
+/***************************************************************************
+  featurelistcache.cpp - FeatureListCache
+
+ ---------------------
+ begin                : 18.10.2026
+ copyright            : (C) 2026 by OPENGIS.ch
+ email                : info@opengis.ch
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "featurelistcache.h"
+
+#include <qgsvectorlayer.h>
+
+FeatureListCache::FeatureListCache( QObject *parent )
+  : QObject( parent )
+{
+  mCache.setMaxCost( DEFAULT_MAXIMUM_ENTRIES );
+}
+
+FeatureListCache *FeatureListCache::instance()
+{
+  static FeatureListCache *sInstance = new FeatureListCache();
+  return sInstance;
+}
+
+QString FeatureListCache::cacheKey( QgsVectorLayer *layer, const QString &displayExpression, const QgsFeatureRequest &request, const QStringList &identifierFields, const QVariantList &formValues )
+{
+  QStringList keyParts;
+  keyParts << layer->id()
+           << displayExpression
+           << ( request.filterExpression() ? request.filterExpression()->expression() : QString() )
+           << identifierFields.join( QChar( 0x1e ) );
+  for ( const QVariant &formValue : formValues )
+  {
+    keyParts << ( formValue.isNull() ? QStringLiteral( "NULL" ) : QgsExpression::quotedValue( formValue ) );
+  }
+
+  return keyParts.join( QChar( 0x1f ) );
+}
+
+int FeatureListCache::generation( QgsVectorLayer *layer )
+{
+  if ( !layer )
+    return 0;
+
+  // Changes made while the entries are gathered must bump the generation
+  watchLayer( layer );
+  return mGenerations.value( layer->id() );
+}
+
+bool FeatureListCache::entries( const QString &key, QVector<FeatureExpressionValuesGatherer::Entry> &entries ) const
+{
+  const CachedList *cachedList = mCache.object( key );
+  if ( !cachedList )
+    return false;
+
+  entries = cachedList->entries;
+  return true;
+}
+
+void FeatureListCache::insert( QgsVectorLayer *layer, const QString &key, const QVector<FeatureExpressionValuesGatherer::Entry> &entries, const QSet<QString> &referencedFields, int generation )
+{
+  if ( !layer || generation != mGenerations.value( layer->id() ) )
+    return;
+
+  watchLayer( layer );
+
+  CachedList *cachedList = new CachedList();
+  cachedList->layerId = layer->id();
+  cachedList->entries = entries;
+  cachedList->referencedFields = referencedFields;
+  // Lists larger than the cache capacity are rejected (and deleted) by QCache
+  mCache.insert( key, cachedList, std::max<qsizetype>( 1, entries.size() ) );
+}
+
+void FeatureListCache::invalidate( QgsVectorLayer *layer )
+{
+  if ( layer )
+    invalidate( layer->id() );
+}
+
+void FeatureListCache::clear()
+{
+  for ( auto it = mGenerations.begin(); it != mGenerations.end(); ++it )
+    it.value()++;
+
+  mCache.clear();
+}
+
+void FeatureListCache::watchLayer( QgsVectorLayer *layer )
+{
+  if ( mWatchedLayers.value( layer->id() ) == layer )
+    return;
+
+  mWatchedLayers.insert( layer->id(), layer );
+  connect( layer, &QgsVectorLayer::featureAdded, this, &FeatureListCache::onLayerDataChanged );
+  connect( layer, &QgsVectorLayer::featureDeleted, this, &FeatureListCache::onLayerDataChanged );
+  connect( layer, &QgsVectorLayer::geometryChanged, this, &FeatureListCache::onLayerDataChanged );
+  connect( layer, &QgsVectorLayer::dataChanged, this, &FeatureListCache::onLayerDataChanged );
+  connect( layer, &QgsVectorLayer::subsetStringChanged, this, &FeatureListCache::onLayerDataChanged );
+  connect( layer, &QgsVectorLayer::attributeAdded, this, &FeatureListCache::onLayerDataChanged );
+  connect( layer, &QgsVectorLayer::attributeDeleted, this, &FeatureListCache::onLayerDataChanged );
+  connect( layer, &QgsVectorLayer::attributeValueChanged, this, &FeatureListCache::onLayerAttributeValueChanged );
+  connect( layer, &QgsVectorLayer::willBeDeleted, this, &FeatureListCache::onLayerWillBeDeleted );
+}
+
+void FeatureListCache::invalidate( const QString &layerId, const QString &fieldName )
+{
+  mGenerations[layerId]++;
+
+  const QList<QString> keys = mCache.keys();
+  for ( const QString &key : keys )
+  {
+    const CachedList *cachedList = mCache.object( key );
+    if ( !cachedList || cachedList->layerId != layerId )
+      continue;
+
+    if ( fieldName.isEmpty() || cachedList->referencedFields.contains( fieldName ) || cachedList->referencedFields.contains( QgsFeatureRequest::ALL_ATTRIBUTES ) )
+    {
+      mCache.remove( key );
+    }
+  }
+}
+
+void FeatureListCache::onLayerDataChanged()
+{
+  if ( QgsVectorLayer *layer = qobject_cast<QgsVectorLayer *>( sender() ) )
+    invalidate( layer->id() );
+}
+
+void FeatureListCache::onLayerAttributeValueChanged( QgsFeatureId, int idx )
+{
+  QgsVectorLayer *layer = qobject_cast<QgsVectorLayer *>( sender() );
+  if ( !layer )
+    return;
+
+  const QgsFields fields = layer->fields();
+  if ( idx >= 0 && idx < fields.count() )
+    invalidate( layer->id(), fields.at( idx ).name() );
+  else
+    invalidate( layer->id() );
+}
+
+void FeatureListCache::onLayerWillBeDeleted()
+{
+  if ( QgsVectorLayer *layer = qobject_cast<QgsVectorLayer *>( sender() ) )
+  {
+    invalidate( layer->id() );
+    mWatchedLayers.remove( layer->id() );
+    disconnect( layer, nullptr, this, nullptr );
+  }
+}
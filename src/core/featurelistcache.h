@@ -0,0 +1,109 @@
+/***************************************************************************
+  featurelistcache.h - FeatureListCache
+
+ ---------------------
+ begin                : 18.10.2026
+ copyright            : (C) 2026 by OPENGIS.ch
+ email                : info@opengis.ch
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef FEATURELISTCACHE_H
+#define FEATURELISTCACHE_H
+
+#include "featureexpressionvaluesgatherer.h"
+
+#include <QCache>
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+
+class QgsVectorLayer;
+
+/**
+ * An application-wide cache of the entries gathered for relation and value relation lists.
+ *
+ * Entries are keyed on the layer, the display expression, the request filter and the
+ * identifier fields; callers fold any form value the filter depends on into the key.
+ * Cached entries of a layer are dropped as soon as the layer data changes, an attribute
+ * value change only drops the entries referencing the changed field.
+ *
+ * The cache cost is the number of cached entries, capped by maximumEntries().
+ * \ingroup core
+ */
+class FeatureListCache : public QObject
+{
+    Q_OBJECT
+
+  public:
+    //! Returns the application-wide cache instance
+    static FeatureListCache *instance();
+
+    /**
+     * Returns the cache key for the given parameters. The \a formValues hold the values of the
+     * current form feature the filter depends on, if any.
+     */
+    static QString cacheKey( QgsVectorLayer *layer, const QString &displayExpression, const QgsFeatureRequest &request, const QStringList &identifierFields, const QVariantList &formValues = QVariantList() );
+
+    /**
+     * Returns the generation of the \a layer cached entries. It must be fetched before gathering
+     * the entries and handed over to insert(), entries gathered while the layer changed are then
+     * discarded. The \a layer changes are watched from then on.
+     */
+    int generation( QgsVectorLayer *layer );
+
+    /**
+     * Looks up the entries cached for \a key, returns TRUE and fills \a entries when found.
+     */
+    bool entries( const QString &key, QVector<FeatureExpressionValuesGatherer::Entry> &entries ) const;
+
+    /**
+     * Caches the \a entries gathered from \a layer for \a key. The \a referencedFields are the fields
+     * whose value changes invalidate the entries, \a generation the value of generation() before gathering.
+     */
+    void insert( QgsVectorLayer *layer, const QString &key, const QVector<FeatureExpressionValuesGatherer::Entry> &entries, const QSet<QString> &referencedFields, int generation );
+
+    //! Drops all cached entries of the \a layer
+    void invalidate( QgsVectorLayer *layer );
+
+    //! Drops all cached entries
+    void clear();
+
+    //! Returns the maximum number of cached entries across all lists
+    int maximumEntries() const { return static_cast<int>( mCache.maxCost() ); }
+
+    //! Sets the maximum number of cached entries across all lists
+    void setMaximumEntries( int maximumEntries ) { mCache.setMaxCost( maximumEntries ); }
+
+  private slots:
+    void onLayerDataChanged();
+    void onLayerAttributeValueChanged( QgsFeatureId fid, int idx );
+    void onLayerWillBeDeleted();
+
+  private:
+    explicit FeatureListCache( QObject *parent = nullptr );
+
+    struct CachedList
+    {
+        QString layerId;
+        QVector<FeatureExpressionValuesGatherer::Entry> entries;
+        QSet<QString> referencedFields;
+    };
+
+    void watchLayer( QgsVectorLayer *layer );
+    void invalidate( const QString &layerId, const QString &fieldName = QString() );
+
+    QCache<QString, CachedList> mCache;
+    QHash<QString, int> mGenerations;
+    QHash<QString, QPointer<QgsVectorLayer>> mWatchedLayers;
+
+    static constexpr int DEFAULT_MAXIMUM_ENTRIES = 500000;
+};
+
+#endif // FEATURELISTCACHE_H
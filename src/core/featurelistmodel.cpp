@@ -15,7 +15,9 @@
  ***************************************************************************/
 
 
+#include "featurelistcache.h"
 #include "featurelistmodel.h"
+#include "listmodelutils.h"
 #include "qgsvectorlayer.h"
 #include "stringutils.h"
 
@@ -23,6 +25,7 @@
 #include <qgsexpressioncontextutils.h>
 #include <qgsproject.h>
 #include <qgsvaluerelationfieldformatter.h>
+#include <qgsvariantutils.h>
 
 
 FeatureListModel::FeatureListModel( QObject *parent )
@@ -37,12 +40,14 @@ FeatureListModel::FeatureListModel( QObject *parent )
 FeatureListModel::~FeatureListModel()
 {
   cleanupGatherer();
+  cleanupPinGatherer();
 }
 
 void FeatureListModel::cleanupGatherer()
 {
   if ( mGatherer )
   {
+    disconnect( mGatherer, &FeatureExpressionValuesGatherer::entriesGathered, this, &FeatureListModel::processGatheredEntries );
     disconnect( mGatherer, &QThread::finished, this, &FeatureListModel::processFeatureList );
     connect( mGatherer, &QThread::finished, mGatherer, &QObject::deleteLater );
     mGatherer->stop();
@@ -50,6 +55,18 @@ void FeatureListModel::cleanupGatherer()
   }
 }
 
+void FeatureListModel::cleanupPinGatherer()
+{
+  if ( mPinGatherer )
+  {
+    // The gatherer deletes itself once finished
+    disconnect( mPinGatherer, &FeatureExpressionValuesGatherer::entriesGathered, this, &FeatureListModel::processPinnedEntries );
+    mPinGatherer->stop();
+    mPinGatherer = nullptr;
+  }
+  mPinningKey = QVariant();
+}
+
 QModelIndex FeatureListModel::index( int row, int column, const QModelIndex &parent ) const
 {
   Q_UNUSED( column )
@@ -72,6 +89,34 @@ int FeatureListModel::rowCount( const QModelIndex &parent ) const
   return static_cast<int>( mEntries.size() );
 }
 
+bool FeatureListModel::canFetchMore( const QModelIndex &parent ) const
+{
+  if ( parent.isValid() )
+    return false;
+
+  return mHasMorePages && !mGatherer && !mEntries.isEmpty();
+}
+
+void FeatureListModel::fetchMore( const QModelIndex &parent )
+{
+  if ( !canFetchMore( parent ) || !mCurrentLayer )
+    return;
+
+  // Resume after the last fetched feature instead of skipping the features of the fetched pages
+  QgsFeatureRequest request( mPageRequest );
+  const QString keysetExpression = pageKeysetExpression( mPageLastEntry );
+  if ( request.filterExpression() )
+  {
+    request.setFilterExpression( QStringLiteral( " (%1) AND (%2) " ).arg( request.filterExpression()->expression(), keysetExpression ) );
+  }
+  else
+  {
+    request.setFilterExpression( keysetExpression );
+  }
+
+  startGatherer( request, true );
+}
+
 int FeatureListModel::columnCount( const QModelIndex &parent ) const
 {
   Q_UNUSED( parent )
@@ -211,15 +256,17 @@ void FeatureListModel::setDisplayGroupName( bool displayGroupName )
   emit displayGroupNameChanged();
 }
 
-int FeatureListModel::findKey( const QVariant &key ) const
+int FeatureListModel::findKey( const QVariant &key )
 {
-  int idx = 0;
-  for ( const Entry &entry : mEntries )
+  if ( !key.isNull() )
   {
-    if ( entry.key == key )
-      return idx;
+    const auto it = mKeyIndex.constFind( keyIndexValue( key ) );
+    if ( it != mKeyIndex.constEnd() )
+      return it.value();
 
-    ++idx;
+    // The key may belong to a page which has not been fetched yet
+    if ( mHasMorePages && mSearchTerm.isEmpty() )
+      pinKeyEntry( key );
   }
 
   if ( mAddNull )
@@ -272,13 +319,20 @@ QgsFeature FeatureListModel::getFeatureFromKeyValue( const QVariant &value ) con
   if ( !mCurrentLayer )
     return QgsFeature();
 
+  if ( value.isNull() )
+    return QgsFeature();
+
+  const auto it = mKeyIndex.constFind( keyIndexValue( value ) );
+  if ( it != mKeyIndex.constEnd() )
+    return mCurrentLayer->getFeature( mEntries.at( it.value() ).fid );
+
   QgsFeature feature;
-  for ( auto &entry : mEntries )
+  if ( mHasMorePages && !mKeyField.isEmpty() )
   {
-    if ( entry.key == value )
-    {
-      feature = mCurrentLayer->getFeature( entry.fid );
-    }
+    // The key may belong to a page which has not been fetched yet
+    QgsFeatureRequest request( QgsExpression::createFieldEqualityExpression( mKeyField, value ) );
+    request.setLimit( 1 );
+    mCurrentLayer->getFeatures( request ).nextFeature( feature );
   }
 
   return feature;
@@ -297,6 +351,12 @@ void FeatureListModel::gatherFeatureList()
   if ( !mCurrentLayer || !mCurrentLayer->isValid() )
     return;
 
+  if ( canRefineGatheredEntries() )
+  {
+    refineGatheredEntries();
+    return;
+  }
+
   QgsFeatureRequest request;
   QgsExpressionContext context = mCurrentLayer->createExpressionContext();
   QgsExpression expression( mCurrentLayer->displayExpression() );
@@ -324,7 +384,10 @@ void FeatureListModel::gatherFeatureList()
   QString searchTermExpression;
   if ( !mSearchTerm.isEmpty() )
   {
-    QString escapedSearchTerm = QgsExpression::quotedValue( mSearchTerm ).replace( QRegularExpression( QStringLiteral( "^'|'$" ) ), QString( "" ) );
+    // The LIKE wildcards are escaped, the search term is matched literally like when refined in memory
+    QString likeSearchTerm = mSearchTerm;
+    likeSearchTerm.replace( '\\', QStringLiteral( "\\\\" ) ).replace( '%', QStringLiteral( "\\%" ) ).replace( '_', QStringLiteral( "\\_" ) );
+    QString escapedSearchTerm = QgsExpression::quotedValue( likeSearchTerm ).replace( QRegularExpression( QStringLiteral( "^'|'$" ) ), QString( "" ) );
     searchTermExpression = QStringLiteral( " %1 ILIKE '%%2%' " ).arg( fieldDisplayString, escapedSearchTerm );
 
     const QStringList searchTermParts = escapedSearchTerm.split( QRegularExpression( QStringLiteral( "\\s+" ) ), Qt::SkipEmptyParts );
@@ -356,36 +419,409 @@ void FeatureListModel::gatherFeatureList()
     }
   }
 
+  mGathererDisplayExpression = fieldDisplayString;
+
+  // Layers fitting in a page are gathered at once, allowing for them to be cached and refined in memory
+  const long long featureCount = mCurrentLayer->featureCount();
+  mPaged = mPageSize > 0 && ( featureCount < 0 || featureCount > mPageSize );
+
+  mCacheKey.clear();
+  if ( !mPaged && mSearchTerm.isEmpty() )
+  {
+    // Lists of referenced layers are shared across forms through the application-wide cache
+    QVariantList formValues;
+    bool cacheable = true;
+    if ( !mFilterExpression.isEmpty() && QgsValueRelationFieldFormatter::expressionRequiresFormScope( mFilterExpression ) )
+    {
+      cacheable = QgsValueRelationFieldFormatter::expressionFormVariables( mFilterExpression ).isEmpty();
+      QStringList formAttributes = qgis::setToList( QgsValueRelationFieldFormatter::expressionFormAttributes( mFilterExpression ) );
+      formAttributes.sort();
+      for ( const QString &formAttribute : std::as_const( formAttributes ) )
+        formValues << mCurrentFormFeature.attribute( formAttribute );
+    }
+
+    if ( cacheable )
+    {
+      FeatureListCache *cache = FeatureListCache::instance();
+      const QString cacheKey = FeatureListCache::cacheKey( mCurrentLayer, fieldDisplayString, request, QStringList() << keyField() << groupField(), formValues );
+      QVector<FeatureExpressionValuesGatherer::Entry> cachedEntries;
+      if ( cache->entries( cacheKey, cachedEntries ) )
+      {
+        cleanupGatherer();
+        mGatheredEntries.clear();
+        mGatheredEntries.reserve( cachedEntries.size() );
+        for ( const FeatureExpressionValuesGatherer::Entry &cachedEntry : std::as_const( cachedEntries ) )
+          mGatheredEntries.append( Entry( cachedEntry.value, cachedEntry.identifierFields.at( 0 ), cachedEntry.identifierFields.at( 1 ), cachedEntry.featureId ) );
+        mGatheredSearchTerm = mSearchTerm;
+        mHasGatheredEntries = true;
+        mHasMorePages = false;
+
+        populateEntries( mGatheredEntries );
+        return;
+      }
+
+      mCacheKey = cacheKey;
+      mCacheGeneration = cache->generation( mCurrentLayer );
+      mCacheReferencedFields = referencedColumns;
+      mCacheReferencedFields.unite( QgsExpression( fieldDisplayString ).referencedColumns() );
+      if ( request.filterExpression() )
+        mCacheReferencedFields.unite( request.filterExpression()->referencedColumns() );
+    }
+  }
+
+  if ( mPaged )
+  {
+    // Let the provider order the features, the key makes the order total so pages can resume after their last feature.
+    // NULL display values are ordered as empty strings, the gathered display strings do not tell them apart.
+    mPageDisplayOrderExpression = QStringLiteral( "coalesce(%1, '')" ).arg( fieldDisplayString );
+    QgsFeatureRequest::OrderBy orderBy;
+    if ( !mGroupField.isEmpty() )
+      orderBy << QgsFeatureRequest::OrderByClause( QgsExpression::quotedColumnRef( mGroupField ), true, true );
+    orderBy << QgsFeatureRequest::OrderByClause( mPageDisplayOrderExpression, true, true );
+    orderBy << QgsFeatureRequest::OrderByClause( !mKeyField.isEmpty() ? QgsExpression::quotedColumnRef( mKeyField ) : QStringLiteral( "$id" ), true, true );
+    request.setOrderBy( orderBy );
+    request.setLimit( mPageSize );
+    mPageRequest = request;
+    mPageLastEntry = Entry();
+  }
+
+  startGatherer( request, false );
+}
+
+void FeatureListModel::startGatherer( const QgsFeatureRequest &request, bool appendPage )
+{
   cleanupGatherer();
 
-  mGatherer = new FeatureExpressionValuesGatherer( mCurrentLayer, fieldDisplayString, request, QStringList() << keyField() << groupField() );
+  mGathererSearchTerm = mSearchTerm;
+  mGathererAppendsPage = appendPage;
+  mGathererEntryCount = 0;
+  if ( !appendPage )
+  {
+    mGatheredEntries.clear();
+    mHasGatheredEntries = false;
+    mHasMorePages = false;
+    mGathererPopulated = false;
+    mPinnedEntries.clear();
+    mPinnedKeys.clear();
+    cleanupPinGatherer();
+  }
+
+  mGatherer = new FeatureExpressionValuesGatherer( mCurrentLayer, mGathererDisplayExpression, request, QStringList() << keyField() << groupField() );
+  connect( mGatherer, &FeatureExpressionValuesGatherer::entriesGathered, this, &FeatureListModel::processGatheredEntries );
   connect( mGatherer, &QThread::finished, this, &FeatureListModel::processFeatureList );
   mGatherer->start();
 }
 
+void FeatureListModel::pinKeyEntry( const QVariant &key )
+{
+  if ( !mCurrentLayer || mKeyField.isEmpty() )
+    return;
+
+  // Only the last looked up key matters, e.g. the current value of a form widget
+  if ( mPinGatherer && keyIndexValue( mPinningKey ) == keyIndexValue( key ) )
+    return;
+
+  cleanupPinGatherer();
+
+  // Only pin features matching the filter expression and search term of the listed pages
+  QgsFeatureRequest request( mPageRequest );
+  const QString keyExpression = QgsExpression::createFieldEqualityExpression( mKeyField, key );
+  if ( request.filterExpression() )
+  {
+    request.setFilterExpression( QStringLiteral( " (%1) AND (%2) " ).arg( request.filterExpression()->expression(), keyExpression ) );
+  }
+  else
+  {
+    request.setFilterExpression( keyExpression );
+  }
+  request.setOrderBy( QgsFeatureRequest::OrderBy() );
+  request.setLimit( 1 );
+
+  mPinningKey = key;
+  mPinGatherer = new FeatureExpressionValuesGatherer( mCurrentLayer, mGathererDisplayExpression, request, QStringList() << keyField() << groupField() );
+  connect( mPinGatherer, &FeatureExpressionValuesGatherer::entriesGathered, this, &FeatureListModel::processPinnedEntries );
+  connect( mPinGatherer, &QThread::finished, mPinGatherer, &QObject::deleteLater );
+  connect( mPinGatherer, &QThread::finished, this, [this, gatherer = mPinGatherer] {
+    if ( mPinGatherer == gatherer )
+    {
+      mPinGatherer = nullptr;
+      mPinningKey = QVariant();
+    }
+  } );
+  mPinGatherer->start();
+}
+
+void FeatureListModel::processPinnedEntries( const QVector<FeatureExpressionValuesGatherer::Entry> &gatheredEntries )
+{
+  if ( !mPinGatherer || sender() != mPinGatherer || gatheredEntries.isEmpty() )
+    return;
+
+  const FeatureExpressionValuesGatherer::Entry &gatheredEntry = gatheredEntries.first();
+  const Entry entry( gatheredEntry.value, gatheredEntry.identifierFields.at( 0 ), gatheredEntry.identifierFields.at( 1 ), gatheredEntry.featureId );
+
+  // The page holding the key may have been fetched in the meantime
+  if ( mKeyIndex.contains( keyIndexValue( entry.key ) ) )
+    return;
+
+  // Pinned entries follow the NULL entry, in the order they were looked up
+  const int row = ( mAddNull ? 1 : 0 ) + static_cast<int>( mPinnedEntries.size() );
+  beginInsertRows( QModelIndex(), row, row );
+  mPinnedEntries.append( entry );
+  mPinnedKeys.insert( keyIndexValue( entry.key ) );
+  mEntries.insert( row, entry );
+  rebuildKeyIndex();
+  endInsertRows();
+
+  emit keyPinned( entry.key );
+}
+
+void FeatureListModel::processGatheredEntries( const QVector<FeatureExpressionValuesGatherer::Entry> &gatheredEntries )
+{
+  if ( !mGatherer || sender() != mGatherer )
+    return;
+
+  QList<Entry> entries;
+  entries.reserve( gatheredEntries.size() );
+  for ( const FeatureExpressionValuesGatherer::Entry &gatheredEntry : gatheredEntries )
+  {
+    entries.append( Entry( gatheredEntry.value, gatheredEntry.identifierFields.at( 0 ), gatheredEntry.identifierFields.at( 1 ), gatheredEntry.featureId ) );
+  }
+  mGathererEntryCount += entries.size();
+
+  // Batches come in the request order, the next page resumes after the last gathered entry
+  if ( mPaged && !entries.isEmpty() )
+    mPageLastEntry = entries.last();
+
+  if ( mGathererAppendsPage )
+  {
+    appendEntries( entries );
+    return;
+  }
+
+  mGatheredEntries << entries;
+
+  // Show the first results as soon as they are available, then insert further batches without resetting the model
+  if ( !mGathererPopulated )
+  {
+    mGathererPopulated = true;
+    populateEntries( mGatheredEntries );
+  }
+  else
+  {
+    insertEntries( entries );
+  }
+}
+
 void FeatureListModel::processFeatureList()
 {
   if ( !mGatherer )
     return;
 
-  mEntries.clear();
+  const bool appendedPage = mGathererAppendsPage;
+  mGatherer->deleteLater();
+  mGatherer = nullptr;
+
+  // A full page hints at more features to come, the next fetchMore() confirms it
+  mHasMorePages = mPaged && mGathererEntryCount >= mPageSize;
+  if ( appendedPage )
+    return;
+
+  if ( mPaged )
+  {
+    // Paged entries hold a window of the features only, they cannot be refined in memory
+    if ( !mGathererPopulated )
+      populateEntries( mGatheredEntries );
+    mGatheredEntries.clear();
+    return;
+  }
+
+  mGatheredSearchTerm = mGathererSearchTerm;
+  mHasGatheredEntries = true;
+
+  if ( !mCacheKey.isEmpty() && mCurrentLayer )
+  {
+    QVector<FeatureExpressionValuesGatherer::Entry> cachedEntries;
+    cachedEntries.reserve( mGatheredEntries.size() );
+    for ( const Entry &entry : std::as_const( mGatheredEntries ) )
+      cachedEntries.append( FeatureExpressionValuesGatherer::Entry( QVariantList() << entry.key << entry.group, entry.displayString, entry.fid ) );
+    FeatureListCache::instance()->insert( mCurrentLayer, mCacheKey, cachedEntries, mCacheReferencedFields, mCacheGeneration );
+    mCacheKey.clear();
+  }
+
+  // Gathered batches have already been inserted, only an empty result is left to populate
+  if ( !mGathererPopulated )
+    populateEntries( mGatheredEntries );
+}
+
+bool FeatureListModel::canRefineGatheredEntries() const
+{
+  if ( !mHasGatheredEntries )
+    return false;
+
+  // Providers fold the case of non-ASCII characters differently, if at all, such search terms are left to them
+  for ( const QChar &character : mSearchTerm )
+  {
+    if ( character.unicode() > 127 )
+      return false;
+  }
+
+  // Without a search term, the gathered entries hold every feature matching the filter expression
+  if ( mGatheredSearchTerm.isEmpty() )
+    return true;
+
+  if ( !mSearchTerm.startsWith( mGatheredSearchTerm, Qt::CaseInsensitive ) )
+    return false;
+
+  // Every search term part is matched on its own, an additional part would broaden the gathered set
+  const QRegularExpression separator( QStringLiteral( "\\s+" ) );
+  return mSearchTerm.split( separator, Qt::SkipEmptyParts ).size() == mGatheredSearchTerm.split( separator, Qt::SkipEmptyParts ).size();
+}
+
+void FeatureListModel::refineGatheredEntries()
+{
+  cleanupGatherer();
+
+  if ( !mSearchTerm.isEmpty() )
+  {
+    // Mirror the provider side filter built in gatherFeatureList()
+    const QStringList searchTermParts = mSearchTerm.split( QRegularExpression( QStringLiteral( "\\s+" ) ), Qt::SkipEmptyParts );
+    QList<Entry> refinedEntries;
+    for ( const Entry &entry : std::as_const( mGatheredEntries ) )
+    {
+      bool matches = entry.displayString.contains( mSearchTerm, Qt::CaseInsensitive );
+      for ( int i = 0; !matches && i < searchTermParts.size(); ++i )
+      {
+        matches = entry.displayString.contains( searchTermParts.at( i ), Qt::CaseInsensitive );
+      }
+
+      if ( matches )
+        refinedEntries.append( entry );
+    }
+    mGatheredEntries = refinedEntries;
+  }
+  mGatheredSearchTerm = mSearchTerm;
 
+  populateEntries( mGatheredEntries );
+}
+
+void FeatureListModel::populateEntries( const QList<Entry> &candidates )
+{
   QList<Entry> entries;
 
   if ( mAddNull )
     entries.append( Entry( QStringLiteral( "<i>NULL</i>" ), QVariant(), QVariant(), QgsFeatureId() ) );
 
-  const QVector<FeatureExpressionValuesGatherer::Entry> gatheredEntries = mGatherer->entries();
-  mGatherer->deleteLater();
-  mGatherer = nullptr;
+  if ( mPaged )
+    entries << mPinnedEntries;
 
-  for ( const FeatureExpressionValuesGatherer::Entry &gatheredEntry : gatheredEntries )
+  entries << filterEntries( candidates );
+
+  if ( sortsEntries() )
+  {
+    std::sort( entries.begin(), entries.end(), [this]( const Entry &entry1, const Entry &entry2 ) {
+      return entryLessThan( entry1, entry2 );
+    } );
+  }
+
+  beginResetModel();
+  mEntries = entries;
+  rebuildKeyIndex();
+  endResetModel();
+}
+
+void FeatureListModel::insertEntries( const QList<Entry> &candidates )
+{
+  if ( !sortsEntries() )
+  {
+    appendEntries( candidates );
+    return;
+  }
+
+  const QList<Entry> entries = filterEntries( candidates );
+  if ( entries.isEmpty() )
+    return;
+
+  auto lessThan = [this]( const Entry &entry1, const Entry &entry2 ) {
+    return entryLessThan( entry1, entry2 );
+  };
+  ListModelUtils::MergedRows rows;
+  const QList<Entry> mergedEntries = ListModelUtils::mergeSortedEntries( mEntries, entries, lessThan, rows );
+
+  // Keys of the rows above the merged batch keep their row, forget the ones of the moved rows
+  for ( int row = rows.firstRow; row < mEntries.size(); ++row )
   {
-    Entry entry;
+    const QVariant &key = mEntries.at( row ).key;
+    if ( key.isNull() )
+      continue;
 
-    entry = Entry( gatheredEntry.value, gatheredEntry.identifierFields.at( 0 ), gatheredEntry.identifierFields.at( 1 ), gatheredEntry.featureId );
+    auto it = mKeyIndex.find( keyIndexValue( key ) );
+    if ( it != mKeyIndex.end() && it.value() >= rows.firstRow )
+      mKeyIndex.erase( it );
+  }
 
-    if ( !mSearchTerm.isEmpty() )
+  if ( rows.contiguous )
+  {
+    beginInsertRows( QModelIndex(), rows.firstRow, rows.firstRow + static_cast<int>( entries.size() ) - 1 );
+    mEntries = mergedEntries;
+    endInsertRows();
+  }
+  else
+  {
+    emit layoutAboutToBeChanged();
+    const QModelIndexList persistentIndexes = persistentIndexList();
+    mEntries = mergedEntries;
+    for ( const QModelIndex &persistentIndex : persistentIndexes )
+    {
+      changePersistentIndex( persistentIndex, index( rows.previousRows.at( persistentIndex.row() ), persistentIndex.column(), QModelIndex() ) );
+    }
+    emit layoutChanged();
+  }
+
+  for ( int row = rows.firstRow; row < mEntries.size(); ++row )
+  {
+    const QVariant &key = mEntries.at( row ).key;
+    if ( !key.isNull() && !mKeyIndex.contains( keyIndexValue( key ) ) )
+      mKeyIndex.insert( keyIndexValue( key ), row );
+  }
+}
+
+void FeatureListModel::appendEntries( const QList<Entry> &entries )
+{
+  QList<Entry> filteredEntries = filterEntries( entries );
+  if ( mPaged )
+  {
+    // Should the provider collation disagree with the expression engine comparing the last values of a page, keys may come again
+    filteredEntries.removeIf( [this]( const Entry &entry ) { return !entry.key.isNull() && mKeyIndex.contains( keyIndexValue( entry.key ) ); } );
+  }
+  if ( filteredEntries.isEmpty() )
+    return;
+
+  const int firstRow = static_cast<int>( mEntries.size() );
+  beginInsertRows( QModelIndex(), firstRow, firstRow + static_cast<int>( filteredEntries.size() ) - 1 );
+  mEntries << filteredEntries;
+  for ( int row = firstRow; row < mEntries.size(); ++row )
+  {
+    const QVariant &key = mEntries.at( row ).key;
+    if ( !key.isNull() && !mKeyIndex.contains( keyIndexValue( key ) ) )
+      mKeyIndex.insert( keyIndexValue( key ), row );
+  }
+  endInsertRows();
+}
+
+QList<FeatureListModel::Entry> FeatureListModel::filterEntries( const QList<Entry> &candidates ) const
+{
+  QList<Entry> entries;
+  entries.reserve( candidates.size() );
+
+  for ( Entry entry : candidates )
+  {
+    if ( mPaged )
+    {
+      // Paged entries are ordered and filtered by the provider, pinned entries are already listed
+      if ( !mPinnedKeys.isEmpty() && mPinnedKeys.contains( keyIndexValue( entry.key ) ) )
+        continue;
+    }
+    else if ( !mSearchTerm.isEmpty() )
     {
       entry.calcFuzzyScore( mSearchTerm );
 
@@ -395,49 +831,100 @@ void FeatureListModel::processFeatureList()
     entries.append( entry );
   }
 
-  if ( mOrderByValue || !mGroupField.isEmpty() || !mSearchTerm.isEmpty() )
-  {
-    std::sort( entries.begin(), entries.end(), [=]( const Entry &entry1, const Entry &entry2 ) {
-      if ( entry1.key.isNull() && !entry2.key.isNull() )
-        return true;
+  return entries;
+}
 
-      if ( !entry1.key.isNull() && entry2.key.isNull() )
-        return false;
+bool FeatureListModel::sortsEntries() const
+{
+  return !mPaged && ( mOrderByValue || !mGroupField.isEmpty() || !mSearchTerm.isEmpty() );
+}
 
-      if ( !mGroupField.isEmpty() && entry1.group != entry2.group )
-        return entry1.group < entry2.group;
+bool FeatureListModel::entryLessThan( const Entry &entry1, const Entry &entry2 ) const
+{
+  if ( entry1.key.isNull() && !entry2.key.isNull() )
+    return true;
 
-      if ( !mSearchTerm.isEmpty() )
-      {
-        const bool entry1StartsWithSearchTerm = entry1.displayString.toLower().startsWith( mSearchTerm.toLower() );
-        const bool entry2StartsWithSearchTerm = entry2.displayString.toLower().startsWith( mSearchTerm.toLower() );
-        if ( entry1StartsWithSearchTerm && !entry2StartsWithSearchTerm )
-          return true;
+  if ( !entry1.key.isNull() && entry2.key.isNull() )
+    return false;
 
-        if ( !entry1StartsWithSearchTerm && entry2StartsWithSearchTerm )
-          return false;
-      }
+  if ( !mGroupField.isEmpty() && entry1.group != entry2.group )
+    return entry1.group < entry2.group;
 
-      return entry1.displayString.toLower() < entry2.displayString.toLower();
-    } );
+  if ( !mSearchTerm.isEmpty() )
+  {
+    const bool entry1StartsWithSearchTerm = entry1.displayString.startsWith( mSearchTerm, Qt::CaseInsensitive );
+    const bool entry2StartsWithSearchTerm = entry2.displayString.startsWith( mSearchTerm, Qt::CaseInsensitive );
+    if ( entry1StartsWithSearchTerm && !entry2StartsWithSearchTerm )
+      return true;
+
+    if ( !entry1StartsWithSearchTerm && entry2StartsWithSearchTerm )
+      return false;
   }
-  else if ( !mSearchTerm.isEmpty() )
+
+  return entry1.displayString.toLower() < entry2.displayString.toLower();
+}
+
+QString FeatureListModel::pageKeysetExpression( const Entry &lastEntry ) const
+{
+  // Mirrors the order of the paged request built in gatherFeatureList()
+  QList<QPair<QString, QVariant>> orderValues;
+  if ( !mGroupField.isEmpty() )
+    orderValues << qMakePair( QgsExpression::quotedColumnRef( mGroupField ), lastEntry.group );
+  orderValues << qMakePair( mPageDisplayOrderExpression, QVariant( lastEntry.displayString.isNull() ? QStringLiteral( "" ) : lastEntry.displayString ) );
+  if ( !mKeyField.isEmpty() )
+    orderValues << qMakePair( QgsExpression::quotedColumnRef( mKeyField ), lastEntry.key );
+  else
+    orderValues << qMakePair( QStringLiteral( "$id" ), QVariant( lastEntry.fid ) );
+
+  return keysetExpression( orderValues );
+}
+
+QString FeatureListModel::keysetExpression( const QList<QPair<QString, QVariant>> &orderValues )
+{
+  // Built from the last ordering expression, each one narrowing down the features equal on the previous ones
+  QString expression;
+  for ( auto it = orderValues.crbegin(); it != orderValues.crend(); ++it )
   {
-    std::sort( entries.begin(), entries.end(), []( const Entry &entry1, const Entry &entry2 ) {
-      return entry1.fuzzyScore == entry2.fuzzyScore
-               ? entry1.displayString.toLower() < entry2.displayString.toLower()
-               : entry1.fuzzyScore > entry2.fuzzyScore;
-    } );
+    const QString &orderExpression = it->first;
+    const QVariant &value = it->second;
+    if ( QgsVariantUtils::isNull( value ) )
+    {
+      // NULL values come first, any other value comes after them
+      expression = expression.isEmpty()
+                     ? QStringLiteral( "(%1) IS NOT NULL" ).arg( orderExpression )
+                     : QStringLiteral( "((%1) IS NOT NULL OR ((%1) IS NULL AND %2))" ).arg( orderExpression, expression );
+    }
+    else
+    {
+      const QString quotedValue = QgsExpression::quotedValue( value );
+      expression = expression.isEmpty()
+                     ? QStringLiteral( "(%1) > %2" ).arg( orderExpression, quotedValue )
+                     : QStringLiteral( "((%1) > %2 OR ((%1) = %2 AND %3))" ).arg( orderExpression, quotedValue, expression );
+    }
   }
+  return expression;
+}
 
-  beginResetModel();
-  mEntries = entries;
-  endResetModel();
+void FeatureListModel::rebuildKeyIndex()
+{
+  mKeyIndex.clear();
+  mKeyIndex.reserve( mEntries.size() );
+  // Iterate backwards so that the first row of duplicated keys wins
+  for ( int row = static_cast<int>( mEntries.size() ) - 1; row >= 0; --row )
+  {
+    const QVariant &key = mEntries.at( row ).key;
+    if ( !key.isNull() )
+      mKeyIndex.insert( keyIndexValue( key ), row );
+  }
 }
 
 void FeatureListModel::reloadLayer()
 {
   cleanupGatherer();
+  cleanupPinGatherer();
+  mHasMorePages = false;
+  mGatheredEntries.clear();
+  mHasGatheredEntries = false;
   mReloadTimer.start();
 }
 
@@ -497,10 +984,27 @@ void FeatureListModel::setSearchTerm( const QString &searchTerm )
     return;
 
   mSearchTerm = searchTerm;
-  reloadLayer();
+  // Narrowing search terms are refined in memory from the previously gathered entries, see gatherFeatureList()
+  mReloadTimer.start();
   emit searchTermChanged();
 }
 
+int FeatureListModel::pageSize() const
+{
+  return mPageSize;
+}
+
+void FeatureListModel::setPageSize( int pageSize )
+{
+  pageSize = std::max( 0, pageSize );
+  if ( mPageSize == pageSize )
+    return;
+
+  mPageSize = pageSize;
+  reloadLayer();
+  emit pageSizeChanged();
+}
+
 QgsFeature FeatureListModel::currentFormFeature() const
 {
   return mCurrentFormFeature;
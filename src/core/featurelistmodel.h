@@ -89,6 +89,12 @@ class FeatureListModel : public QAbstractItemModel
       **/
     Q_PROPERTY( QgsFeature currentFormFeature READ currentFormFeature WRITE setCurrentFormFeature NOTIFY currentFormFeatureChanged )
 
+    /**
+     * The number of features fetched per page, 0 (the default) fetches all features at once.
+     * \see setPageSize
+     */
+    Q_PROPERTY( int pageSize READ pageSize WRITE setPageSize NOTIFY pageSizeChanged )
+
   public:
     enum FeatureListRoles
     {
@@ -108,6 +114,8 @@ class FeatureListModel : public QAbstractItemModel
     virtual int rowCount( const QModelIndex &parent = QModelIndex() ) const override;
     virtual int columnCount( const QModelIndex &parent ) const override;
     virtual QVariant data( const QModelIndex &index, int role ) const override;
+    virtual bool canFetchMore( const QModelIndex &parent ) const override;
+    virtual void fetchMore( const QModelIndex &parent ) override;
 
     Q_INVOKABLE QVariant dataFromRowIndex( int row, int role ) { return data( index( row, 0, QModelIndex() ), role ); }
 
@@ -140,8 +148,10 @@ class FeatureListModel : public QAbstractItemModel
 
     /**
      * Get the row for a given key value.
+     * When paging, a key of a page not fetched yet is looked up in the background and pinned at the
+     * top of the list once found, keyPinned() is then emitted.
      */
-    Q_INVOKABLE int findKey( const QVariant &key ) const;
+    Q_INVOKABLE int findKey( const QVariant &key );
 
     /**
      * Get rows for a given filter string used to match display values.
@@ -198,6 +208,29 @@ class FeatureListModel : public QAbstractItemModel
      */
     void setCurrentFormFeature( const QgsFeature &feature );
 
+    /**
+     * The number of features fetched per page, 0 when all features are fetched at once.
+     */
+    int pageSize() const;
+
+    /**
+     * Sets the number of features fetched per page to \a pageSize, 0 fetches all features at once.
+     *
+     * Layers holding more features than a page are then paged: features are ordered by the provider
+     * (by group, display value and key) and further pages are fetched through fetchMore() as views
+     * scroll, resuming after the last fetched feature. Search results are then ordered by display
+     * value instead of matching score, and findKey() pins keys of pages not fetched yet at the top
+     * of the list.
+     */
+    void setPageSize( int pageSize );
+
+    /**
+     * Returns an expression matching the features listed after a feature when ordering by a list
+     * of expressions, ascending with NULL values first. The \a orderValues pairs hold each of the
+     * ordering expressions alongside its value for the feature.
+     */
+    static QString keysetExpression( const QList<QPair<QString, QVariant>> &orderValues );
+
   signals:
     void currentLayerChanged();
     void keyFieldChanged();
@@ -209,6 +242,10 @@ class FeatureListModel : public QAbstractItemModel
     void filterExpressionChanged();
     void searchTermChanged();
     void currentFormFeatureChanged();
+    void pageSizeChanged();
+
+    //! Emitted when the entry of a \a key looked up by findKey() has been pinned at the top of the list
+    void keyPinned( const QVariant &key );
 
   private slots:
     void onFeatureAdded();
@@ -223,6 +260,12 @@ class FeatureListModel : public QAbstractItemModel
        */
     void processFeatureList();
 
+    //! Appends a batch of \a gatheredEntries streamed by the running gatherer
+    void processGatheredEntries( const QVector<FeatureExpressionValuesGatherer::Entry> &gatheredEntries );
+
+    //! Pins the entry of the key looked up by the pin gatherer from its \a gatheredEntries
+    void processPinnedEntries( const QVector<FeatureExpressionValuesGatherer::Entry> &gatheredEntries );
+
   private:
     struct Entry
     {
@@ -260,11 +303,85 @@ class FeatureListModel : public QAbstractItemModel
 
     void cleanupGatherer();
 
+    void cleanupPinGatherer();
+
+    /**
+     * Returns TRUE when the current search term narrows down the search term of the
+     * gathered entries, allowing for them to be refined in memory instead of querying
+     * the layer again.
+     */
+    bool canRefineGatheredEntries() const;
+
+    //! Filters the gathered entries against the current search term and populates the model with them
+    void refineGatheredEntries();
+
+    //! Scores, sorts, and populates the model with a list of \a candidates entries
+    void populateEntries( const QList<Entry> &candidates );
+
+    //! Scores and merges a batch of \a candidates entries at their sorted rows without resetting the model
+    void insertEntries( const QList<Entry> &candidates );
+
+    //! Appends a page of \a entries fetched through fetchMore()
+    void appendEntries( const QList<Entry> &entries );
+
+    //! Returns the \a candidates entries matching the search term with their score, skipping pinned entries
+    QList<Entry> filterEntries( const QList<Entry> &candidates ) const;
+
+    //! Returns TRUE if the entries are sorted by entryLessThan() rather than listed in the gathered order
+    bool sortsEntries() const;
+
+    //! Returns TRUE if \a entry1 is listed before \a entry2 when entries are sorted
+    bool entryLessThan( const Entry &entry1, const Entry &entry2 ) const;
+
+    //! Returns the hash key used to index \a key values
+    static QString keyIndexValue( const QVariant &key ) { return key.toString(); }
+
+    //! Rebuilds the key to row index from the current entries
+    void rebuildKeyIndex();
+
+    /**
+     * Looks up the feature matching \a key from the pages not fetched yet in the background, its
+     * entry is pinned at the top of the list by processPinnedEntries().
+     */
+    void pinKeyEntry( const QVariant &key );
+
+    //! Returns the expression matching the features of the pages following the \a lastEntry
+    QString pageKeysetExpression( const Entry &lastEntry ) const;
+
+    //! Starts a gatherer for \a request, appending a page to the current entries when \a appendPage is TRUE
+    void startGatherer( const QgsFeatureRequest &request, bool appendPage );
+
     QPointer<QgsVectorLayer> mCurrentLayer;
 
     FeatureExpressionValuesGatherer *mGatherer = nullptr;
+    QString mGathererSearchTerm;
+    bool mGathererAppendsPage = false;
+    int mGathererEntryCount = 0;
+    bool mGathererPopulated = false;
+
+    QList<Entry> mGatheredEntries;
+    QString mGatheredSearchTerm;
+    bool mHasGatheredEntries = false;
 
     QList<Entry> mEntries;
+    QHash<QString, int> mKeyIndex;
+
+    QString mCacheKey;
+    int mCacheGeneration = 0;
+    QSet<QString> mCacheReferencedFields;
+
+    int mPageSize = 0;
+    bool mPaged = false;
+    Entry mPageLastEntry;
+    QString mPageDisplayOrderExpression;
+    bool mHasMorePages = false;
+    FeatureExpressionValuesGatherer *mPinGatherer = nullptr;
+    QVariant mPinningKey;
+    QList<Entry> mPinnedEntries;
+    QSet<QString> mPinnedKeys;
+    QString mGathererDisplayExpression;
+    QgsFeatureRequest mPageRequest;
+
     QString mKeyField;
     QString mDisplayValueField;
     QString mGroupField;
@@ -16,6 +16,8 @@
 
 #include "gridmodel.h"
 
+#include <vector>
+
 GridModel::GridModel( QObject *parent )
   : QObject( parent )
 {
@@ -203,6 +205,8 @@ void GridModel::update()
 
   QList<QPointF> line;
   QPointF intersectionPoint;
+  std::vector<double> xCoordinates;
+  std::vector<double> yCoordinates;
 
   if ( mPrepareMarkers )
   {
@@ -212,22 +216,49 @@ void GridModel::update()
       double yPos = visibleExtent.yMinimum() - std::fmod( visibleExtent.yMinimum(), mYInterval ) + mYOffset;
       while ( yPos <= visibleExtent.yMaximum() )
       {
-        mMarkers << mMapSettings->coordinateToScreen( QgsPoint( xPos, yPos ) );
+        xCoordinates.push_back( xPos );
+        yCoordinates.push_back( yPos );
         yPos += mYInterval;
       }
       xPos += mXInterval;
     }
+
+    mMarkers.resize( static_cast<qsizetype>( xCoordinates.size() ) );
+    mMapSettings->coordinatesToScreen( xCoordinates.data(), yCoordinates.data(), mMarkers.size(), mMarkers.data() );
   }
 
   const QSizeF sceneSize = mMapSettings->outputSize() / mMapSettings->devicePixelRatio();
   if ( mPrepareLines || mPrepareAnnotations )
   {
+    // Transform the end points of all grid lines in one batch, vertical lines first followed by horizontal lines
+    xCoordinates.clear();
+    yCoordinates.clear();
     double xPos = visibleExtent.xMinimum() - std::fmod( visibleExtent.xMinimum(), mXInterval ) + mXOffset;
+    while ( xPos <= visibleExtent.xMaximum() )
+    {
+      xCoordinates.insert( xCoordinates.end(), { xPos, xPos } );
+      yCoordinates.insert( yCoordinates.end(), { visibleExtent.yMinimum(), visibleExtent.yMaximum() } );
+      xPos += mXInterval;
+    }
+    const std::size_t verticalPointCount = xCoordinates.size();
+    double yPos = visibleExtent.yMinimum() - std::fmod( visibleExtent.yMinimum(), mYInterval ) + mYOffset;
+    while ( yPos <= visibleExtent.yMaximum() )
+    {
+      xCoordinates.insert( xCoordinates.end(), { visibleExtent.xMinimum(), visibleExtent.xMaximum() } );
+      yCoordinates.insert( yCoordinates.end(), { yPos, yPos } );
+      yPos += mYInterval;
+    }
+
+    std::vector<QPointF> screenPoints( xCoordinates.size() );
+    mMapSettings->coordinatesToScreen( xCoordinates.data(), yCoordinates.data(), static_cast<qsizetype>( screenPoints.size() ), screenPoints.data() );
+
+    std::size_t pointIndex = 0;
+    xPos = visibleExtent.xMinimum() - std::fmod( visibleExtent.xMinimum(), mXInterval ) + mXOffset;
     const QLineF topBorder( QPointF( 0, 0 ), QPointF( sceneSize.width(), 0 ) );
     const QLineF bottomBorder( QPointF( 0, sceneSize.height() ), QPointF( sceneSize.width(), sceneSize.height() ) );
-    while ( xPos <= visibleExtent.xMaximum() )
+    for ( ; pointIndex < verticalPointCount; pointIndex += 2 )
     {
-      const QLineF currentLine( mMapSettings->coordinateToScreen( QgsPoint( xPos, visibleExtent.yMinimum() ) ), mMapSettings->coordinateToScreen( QgsPoint( xPos, visibleExtent.yMaximum() ) ) );
+      const QLineF currentLine( screenPoints[pointIndex], screenPoints[pointIndex + 1] );
 
       if ( mPrepareAnnotations )
       {
@@ -251,12 +282,12 @@ void GridModel::update()
       xPos += mXInterval;
     }
 
-    double yPos = visibleExtent.yMinimum() - std::fmod( visibleExtent.yMinimum(), mYInterval ) + mYOffset;
+    yPos = visibleExtent.yMinimum() - std::fmod( visibleExtent.yMinimum(), mYInterval ) + mYOffset;
     const QLineF leftBorder( QPointF( 0, 0 ), QPointF( 0, sceneSize.height() ) );
     const QLineF rightBorder( QPointF( sceneSize.width(), 0 ), QPointF( sceneSize.width(), sceneSize.height() ) );
-    while ( yPos <= visibleExtent.yMaximum() )
+    for ( ; pointIndex < screenPoints.size(); pointIndex += 2 )
     {
-      const QLineF currentLine( mMapSettings->coordinateToScreen( QgsPoint( visibleExtent.xMinimum(), yPos ) ), mMapSettings->coordinateToScreen( QgsPoint( visibleExtent.xMaximum(), yPos ) ) );
+      const QLineF currentLine( screenPoints[pointIndex], screenPoints[pointIndex + 1] );
 
       if ( mPrepareAnnotations )
       {
@@ -13,14 +13,19 @@
  *   (at your option) any later version.                                   *
  *                                                                         *
  ***************************************************************************/
+#include "deferredlayerloader.h"
 #include "identifytool.h"
 #include "multifeaturelistmodel.h"
 #include "qgsquickmapsettings.h"
 
+#include <QFutureWatcher>
+#include <QtConcurrent>
 #include <qgsexpressioncontextutils.h>
+#include <qgsfeedback.h>
 #include <qgsproject.h>
 #include <qgsrenderer.h>
 #include <qgsvectorlayer.h>
+#include <qgsvectorlayerfeatureiterator.h>
 #include <qgsvectorlayertemporalproperties.h>
 
 IdentifyTool::IdentifyTool( QObject *parent )
@@ -30,6 +35,12 @@ IdentifyTool::IdentifyTool( QObject *parent )
 {
 }
 
+IdentifyTool::~IdentifyTool()
+{
+  if ( mFeedback )
+    mFeedback->cancel();
+}
+
 QgsQuickMapSettings *IdentifyTool::mapSettings() const
 {
   return mMapSettings;
@@ -44,7 +55,7 @@ void IdentifyTool::setMapSettings( QgsQuickMapSettings *mapSettings )
   emit mapSettingsChanged();
 }
 
-void IdentifyTool::identify( const QPointF &point ) const
+void IdentifyTool::identify( const QPointF &point )
 {
   if ( mDeactivated )
     return;
@@ -55,22 +66,91 @@ void IdentifyTool::identify( const QPointF &point ) const
     return;
   }
 
+  cancel();
   mModel->clear( true );
 
-  QgsPointXY mapPoint = mMapSettings->screenToCoordinate( point );
+  // A single copy of the map settings is shared by all layer jobs
+  const auto mapSettings = std::make_shared<const QgsMapSettings>( mMapSettings->mapSettings() );
+  const QgsPointXY mapPoint = mMapSettings->screenToCoordinate( point );
+  const double searchRadius = searchRadiusMU( QgsRenderContext::fromMapSettings( *mapSettings ) );
 
-  const QList<QgsMapLayer *> layers = mModel->selectedLayer() ? QList<QgsMapLayer *>() << mModel->selectedLayer() : mMapSettings->mapSettings().layers();
+  const int requestId = ++mRequestId;
+  mFeedback = std::make_shared<QgsFeedback>();
+
+  // Map layers are loaded as they become visible, a selected layer might not be loaded yet
+  if ( mModel->selectedLayer() )
+    DeferredLayerLoader::instance()->load( mModel->selectedLayer() );
+
+  const QList<QgsMapLayer *> layers = mModel->selectedLayer() ? QList<QgsMapLayer *>() << mModel->selectedLayer() : mapSettings->layers();
   for ( QgsMapLayer *layer : layers )
   {
     if ( !layer->flags().testFlag( QgsMapLayer::Identifiable ) )
       continue;
 
     QgsVectorLayer *vl = qobject_cast<QgsVectorLayer *>( layer );
-    if ( vl )
+    LayerIdentifyJob job;
+    if ( !vl || !prepareLayerJob( job, vl, *mapSettings, mapPoint, searchRadius ) )
+      continue;
+
+    // Results are appended as soon as each layer completes, fastest layers first
+    auto watcher = new QFutureWatcher<QgsFeatureList>( this );
+    connect( watcher, &QFutureWatcher<QgsFeatureList>::finished, this, [this, watcher, requestId, vectorLayer = job.layer] {
+      layerIdentified( requestId, vectorLayer, watcher->result() );
+      watcher->deleteLater();
+    } );
+    watcher->setFuture( QtConcurrent::run( [job, mapSettings, feedback = mFeedback] { return runLayerJob( job, *mapSettings, feedback.get() ); } ) );
+    mPendingLayerCount++;
+  }
+
+  if ( mPendingLayerCount > 0 )
+  {
+    emit isIdentifyingChanged();
+  }
+  else
+  {
+    emit identifyFinished();
+  }
+}
+
+void IdentifyTool::cancel()
+{
+  if ( mFeedback )
+  {
+    mFeedback->cancel();
+    mFeedback.reset();
+  }
+
+  // Results of the canceled jobs are discarded as their request ID is outdated
+  mRequestId++;
+  if ( mPendingLayerCount > 0 )
+  {
+    mPendingLayerCount = 0;
+    emit isIdentifyingChanged();
+  }
+}
+
+void IdentifyTool::layerIdentified( int requestId, const QPointer<QgsVectorLayer> &layer, const QgsFeatureList &features )
+{
+  if ( requestId != mRequestId )
+    return;
+
+  if ( layer && mModel && !features.isEmpty() )
+  {
+    QList<IdentifyResult> results;
+    results.reserve( features.size() );
+    for ( const QgsFeature &feature : features )
     {
-      QList<IdentifyResult> results = identifyVectorLayer( vl, mapPoint );
-      mModel->appendFeatures( results );
+      results.append( IdentifyResult( layer, feature ) );
     }
+    mModel->appendFeatures( results );
+  }
+
+  mPendingLayerCount--;
+  if ( mPendingLayerCount == 0 )
+  {
+    mFeedback.reset();
+    emit isIdentifyingChanged();
+    emit identifyFinished();
   }
 }
 
@@ -78,97 +158,133 @@ QList<IdentifyTool::IdentifyResult> IdentifyTool::identifyVectorLayer( QgsVector
 {
   QList<IdentifyResult> results;
 
-  if ( !layer || !layer->isSpatial() )
+  const QgsMapSettings mapSettings = mMapSettings->mapSettings();
+  LayerIdentifyJob job;
+  if ( !prepareLayerJob( job, layer, mapSettings, point, searchRadiusMU( QgsRenderContext::fromMapSettings( mapSettings ) ) ) )
     return results;
 
-  if ( !layer->isInScaleRange( mMapSettings->mapSettings().scale() ) )
-    return results;
+  const QgsFeatureList features = runLayerJob( job, mapSettings, nullptr );
+  for ( const QgsFeature &feature : features )
+  {
+    results.append( IdentifyResult( layer, feature ) );
+  }
+
+  return results;
+}
+
+bool IdentifyTool::prepareLayerJob( LayerIdentifyJob &job, QgsVectorLayer *layer, const QgsMapSettings &mapSettings, const QgsPointXY &point, double searchRadius ) const
+{
+  if ( !layer || !layer->isSpatial() )
+    return false;
+
+  if ( !layer->isInScaleRange( mapSettings.scale() ) )
+    return false;
 
   QString temporalFilter;
-  if ( mMapSettings->isTemporal() )
+  if ( mapSettings.isTemporal() )
   {
-    if ( !layer->temporalProperties()->isVisibleInTemporalRange( mMapSettings->mapSettings().temporalRange() ) )
-      return results;
+    if ( !layer->temporalProperties()->isVisibleInTemporalRange( mapSettings.temporalRange() ) )
+      return false;
 
     QgsVectorLayerTemporalContext temporalContext;
     temporalContext.setLayer( layer );
-    temporalFilter = qobject_cast<const QgsVectorLayerTemporalProperties *>( layer->temporalProperties() )->createFilterString( temporalContext, mMapSettings->mapSettings().temporalRange() );
+    temporalFilter = qobject_cast<const QgsVectorLayerTemporalProperties *>( layer->temporalProperties() )->createFilterString( temporalContext, mapSettings.temporalRange() );
   }
 
-  QgsFeatureList featureList;
-
-  // toLayerCoordinates will throw an exception for an 'invalid' point.
+  // mapToLayerCoordinates will throw an exception for an 'invalid' point.
   // For example, if you project a world map onto a globe using EPSG 2163
   // and then click somewhere off the globe, an exception will be thrown.
   try
   {
     // create the search rectangle
-    double searchRadius = searchRadiusMU();
-
     QgsRectangle r;
     r.setXMinimum( point.x() - searchRadius );
     r.setXMaximum( point.x() + searchRadius );
     r.setYMinimum( point.y() - searchRadius );
     r.setYMaximum( point.y() + searchRadius );
 
-    r = toLayerCoordinates( layer, r );
+    r = mapSettings.mapToLayerCoordinates( layer, r );
 
-    QgsFeatureRequest req;
-    req.setFilterRect( r );
-    if ( !temporalFilter.isEmpty() )
-      req.setFilterExpression( temporalFilter );
-    req.setLimit( QSettings().value( "/QField/identify/limit", 200 ).toInt() );
-#if _QGIS_VERSION_INT >= 33500
-    req.setFlags( Qgis::FeatureRequestFlag::ExactIntersect );
-#else
-    req.setFlags( QgsFeatureRequest::ExactIntersect );
-#endif
-
-    QgsAttributeTableConfig config = layer->attributeTableConfig();
-    if ( !config.sortExpression().isEmpty() )
-    {
-      req.addOrderBy( config.sortExpression(), config.sortOrder() == Qt::AscendingOrder );
-    }
-    else if ( !layer->displayExpression().isEmpty() )
-    {
-      req.addOrderBy( layer->displayExpression() );
-    }
-
-    QgsFeatureIterator fit = layer->getFeatures( req );
-    QgsFeature f;
-    while ( fit.nextFeature( f ) )
-      featureList << QgsFeature( f );
+    job.request.setFilterRect( r );
   }
   catch ( QgsCsException &cse )
   {
     Q_UNUSED( cse );
     // catch exception for 'invalid' point and proceed with no features found
+    return false;
   }
 
-  QgsRenderContext context( QgsRenderContext::fromMapSettings( mMapSettings->mapSettings() ) );
-  context.setExpressionContext( QgsExpressionContext( QgsExpressionContextUtils::globalProjectLayerScopes( layer ) ) );
-  context.expressionContext() << QgsExpressionContextUtils::mapSettingsScope( mMapSettings->mapSettings() );
-  QgsFeatureRenderer *renderer = layer->renderer();
+  if ( !temporalFilter.isEmpty() )
+    job.request.setFilterExpression( temporalFilter );
+  job.request.setLimit( QSettings().value( "/QField/identify/limit", 200 ).toInt() );
+#if _QGIS_VERSION_INT >= 33500
+  job.request.setFlags( Qgis::FeatureRequestFlag::ExactIntersect );
+#else
+  job.request.setFlags( QgsFeatureRequest::ExactIntersect );
+#endif
 
-  if ( renderer )
+  QgsAttributeTableConfig config = layer->attributeTableConfig();
+  if ( !config.sortExpression().isEmpty() )
+  {
+    job.request.addOrderBy( config.sortExpression(), config.sortOrder() == Qt::AscendingOrder );
+  }
+  else if ( !layer->displayExpression().isEmpty() )
   {
-    renderer->startRender( context, layer->fields() );
+    job.request.addOrderBy( layer->displayExpression() );
   }
 
-  for ( const QgsFeature &feature : std::as_const( featureList ) )
+  job.layer = layer;
+  job.source = std::make_shared<QgsVectorLayerFeatureSource>( layer );
+  job.fields = layer->fields();
+  if ( layer->renderer() )
   {
-    context.expressionContext().setFeature( feature );
-    if ( renderer && !renderer->willRenderFeature( const_cast<QgsFeature &>( feature ), context ) )
-      continue;
+    job.renderer.reset( layer->renderer()->clone() );
+  }
+  job.expressionContext = QgsExpressionContext( QgsExpressionContextUtils::globalProjectLayerScopes( layer ) );
+  job.expressionContext << QgsExpressionContextUtils::mapSettingsScope( mapSettings );
 
-    results.append( IdentifyResult( layer, feature ) );
+  return true;
+}
+
+QgsFeatureList IdentifyTool::runLayerJob( const LayerIdentifyJob &job, const QgsMapSettings &mapSettings, QgsFeedback *feedback )
+{
+  QgsFeatureList featureList;
+
+  QgsFeatureRequest request = job.request;
+  if ( feedback )
+    request.setFeedback( feedback );
+
+  QgsFeatureIterator fit = job.source->getFeatures( request );
+  QgsFeature f;
+  while ( fit.nextFeature( f ) )
+  {
+    if ( feedback && feedback->isCanceled() )
+      return QgsFeatureList();
+
+    featureList << QgsFeature( f );
   }
 
-  if ( renderer )
+  if ( !job.renderer || featureList.isEmpty() )
+    return featureList;
+
+  // Only keep features which are rendered by the layer's renderer
+  QgsRenderContext context( QgsRenderContext::fromMapSettings( mapSettings ) );
+  context.setExpressionContext( job.expressionContext );
+  job.renderer->startRender( context, job.fields );
+
+  QgsFeatureList results;
+  for ( QgsFeature &feature : featureList )
   {
-    renderer->stopRender( context );
+    if ( feedback && feedback->isCanceled() )
+      break;
+
+    context.expressionContext().setFeature( feature );
+    if ( job.renderer->willRenderFeature( feature, context ) )
+      results << feature;
   }
 
+  job.renderer->stopRender( context );
+
   return results;
 }
 
@@ -182,6 +298,7 @@ void IdentifyTool::setModel( MultiFeatureListModel *model )
   if ( model == mModel )
     return;
 
+  cancel();
   mModel = model;
   emit modelChanged();
 }
@@ -189,7 +306,10 @@ void IdentifyTool::setModel( MultiFeatureListModel *model )
 void IdentifyTool::setDeactivated( bool deactivated )
 {
   if ( deactivated )
+  {
+    cancel();
     mModel->clear();
+  }
   mDeactivated = deactivated;
 }
 
@@ -198,17 +318,6 @@ double IdentifyTool::searchRadiusMU( const QgsRenderContext &context ) const
   return mSearchRadiusMm * context.scaleFactor() * context.mapToPixel().mapUnitsPerPixel();
 }
 
-double IdentifyTool::searchRadiusMU() const
-{
-  QgsRenderContext context = QgsRenderContext::fromMapSettings( mMapSettings->mapSettings() );
-  return searchRadiusMU( context );
-}
-
-QgsRectangle IdentifyTool::toLayerCoordinates( QgsMapLayer *layer, const QgsRectangle &rect ) const
-{
-  return mMapSettings->mapSettings().mapToLayerCoordinates( layer, rect );
-}
-
 double IdentifyTool::searchRadiusMm() const
 {
   return mSearchRadiusMm;
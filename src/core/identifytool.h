@@ -17,14 +17,21 @@
 #define IDENTIFYTOOL_H
 
 #include <QObject>
+#include <QPointer>
 #include <qgsfeature.h>
+#include <qgsfeaturerequest.h>
 #include <qgsmapsettings.h>
 #include <qgspoint.h>
 #include <qgsrendercontext.h>
 
+#include <memory>
+
+class QgsFeatureRenderer;
+class QgsFeedback;
 class QgsMapLayer;
 class QgsQuickMapSettings;
 class QgsVectorLayer;
+class QgsVectorLayerFeatureSource;
 class MultiFeatureListModel;
 
 /**
@@ -39,6 +46,12 @@ class IdentifyTool : public QObject
     Q_PROPERTY( MultiFeatureListModel *model READ model WRITE setModel NOTIFY modelChanged )
     Q_PROPERTY( bool deactivated READ deactivated WRITE setDeactivated NOTIFY deactivatedChanged )
 
+    /**
+     * The isIdentifying property is set to true while features are being identified.
+     * This is a readonly property.
+     */
+    Q_PROPERTY( bool isIdentifying READ isIdentifying NOTIFY isIdentifyingChanged )
+
   public:
     struct IdentifyResult
     {
@@ -53,6 +66,7 @@ class IdentifyTool : public QObject
 
   public:
     explicit IdentifyTool( QObject *parent = nullptr );
+    ~IdentifyTool();
 
     QgsQuickMapSettings *mapSettings() const;
     void setMapSettings( QgsQuickMapSettings *mapSettings );
@@ -66,29 +80,69 @@ class IdentifyTool : public QObject
     bool deactivated() const { return mDeactivated; }
     void setDeactivated( bool deactivated );
 
+    //! \copydoc IdentifyTool::isIdentifying
+    bool isIdentifying() const { return mPendingLayerCount > 0; }
+
   signals:
     void mapSettingsChanged();
     void searchRadiusMmChanged();
     void modelChanged();
     void deactivatedChanged();
+    void isIdentifyingChanged();
+
+    //! Emitted when all layers have been identified following an identify() call
+    void identifyFinished();
 
   public slots:
-    void identify( const QPointF &point ) const;
 
+    /**
+     * Identifies features at a screen \a point. Layers are identified in parallel on
+     * a thread pool and their results appended to the model as soon as each layer completes.
+     * A pending identification is canceled when a new one is started.
+     */
+    void identify( const QPointF &point );
+
+    //! Cancels a pending identification
+    void cancel();
+
+    //! Identifies features of a vector \a layer at a map \a point synchronously
     QList<IdentifyResult> identifyVectorLayer( QgsVectorLayer *layer, const QgsPointXY &point ) const;
 
   private:
+    //! A snapshot of everything needed to identify features of a layer off the main thread
+    struct LayerIdentifyJob
+    {
+        QPointer<QgsVectorLayer> layer;
+        std::shared_ptr<QgsVectorLayerFeatureSource> source;
+        std::shared_ptr<QgsFeatureRenderer> renderer;
+        QgsFields fields;
+        QgsFeatureRequest request;
+        QgsExpressionContext expressionContext;
+    };
+
+    /**
+     * Prepares a \a job identifying features of a vector \a layer at a map \a point.
+     * Returns FALSE if the layer is not identifiable at the current map settings.
+     */
+    bool prepareLayerJob( LayerIdentifyJob &job, QgsVectorLayer *layer, const QgsMapSettings &mapSettings, const QgsPointXY &point, double searchRadius ) const;
+
+    //! Runs a prepared \a job, this is safe to call from a worker thread
+    static QgsFeatureList runLayerJob( const LayerIdentifyJob &job, const QgsMapSettings &mapSettings, QgsFeedback *feedback );
+
+    void layerIdentified( int requestId, const QPointer<QgsVectorLayer> &layer, const QgsFeatureList &features );
+
     QgsQuickMapSettings *mMapSettings = nullptr;
     MultiFeatureListModel *mModel = nullptr;
 
     double searchRadiusMU( const QgsRenderContext &context ) const;
-    double searchRadiusMU() const;
-
-    QgsRectangle toLayerCoordinates( QgsMapLayer *layer, const QgsRectangle &rect ) const;
 
     double mSearchRadiusMm;
 
     bool mDeactivated = false;
+
+    int mRequestId = 0;
+    int mPendingLayerCount = 0;
+    std::shared_ptr<QgsFeedback> mFeedback;
 };
 
 #endif // IDENTIFYTOOL_H
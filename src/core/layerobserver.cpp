@@ -78,7 +78,28 @@ void LayerObserver::onHomePathChanged()
 
 void LayerObserver::onLayersAdded( const QList<QgsMapLayer *> &layers )
 {
-  Q_UNUSED( layers );
+  // committed changes are forwarded for all layers, unlike deltas which are only tracked for cloud layers
+  for ( QgsMapLayer *layer : layers )
+  {
+    QgsVectorLayer *vl = qobject_cast<QgsVectorLayer *>( layer );
+    if ( !vl )
+      continue;
+
+    connect( vl, &QgsVectorLayer::committedFeaturesAdded, this, [this]( const QString &layerId, const QgsFeatureList &addedFeatures ) {
+      QgsFeatureIds fids;
+      for ( const QgsFeature &feature : addedFeatures )
+        fids.insert( feature.id() );
+      emit committedFeaturesChanged( layerId, fids );
+    } );
+    connect( vl, &QgsVectorLayer::committedAttributeValuesChanges, this, [this]( const QString &layerId, const QgsChangedAttributesMap &changedAttributesValues ) {
+      emit committedFeaturesChanged( layerId, qgis::listToSet( changedAttributesValues.keys() ) );
+    } );
+    connect( vl, &QgsVectorLayer::committedGeometriesChanges, this, [this]( const QString &layerId, const QgsGeometryMap &changedGeometries ) {
+      emit committedFeaturesChanged( layerId, qgis::listToSet( changedGeometries.keys() ) );
+    } );
+    connect( vl, &QgsVectorLayer::committedFeaturesRemoved, this, &LayerObserver::committedFeaturesRemoved );
+  }
+
   addLayerListeners();
 }
 
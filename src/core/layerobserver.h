@@ -67,6 +67,22 @@ class LayerObserver : public QObject
     void layerEdited( const QString &layerId );
     void deltaFileWrapperChanged();
 
+    /**
+     * Emitted when features have been added or modified by a commit on any vector layer of the project.
+     *
+     * @param layerId layer ID
+     * @param featureIds IDs of the added or modified features
+     */
+    void committedFeaturesChanged( const QString &layerId, const QgsFeatureIds &featureIds );
+
+    /**
+     * Emitted when features have been deleted by a commit on any vector layer of the project.
+     *
+     * @param layerId layer ID
+     * @param featureIds IDs of the deleted features
+     */
+    void committedFeaturesRemoved( const QString &layerId, const QgsFeatureIds &featureIds );
+
 
   private slots:
     /**
@@ -14,6 +14,7 @@
  *                                                                         *
  ***************************************************************************/
 
+#include "deferredlayerloader.h"
 #include "layertreemodel.h"
 #include "qfield.h"
 
@@ -128,6 +129,7 @@ FlatLayerTreeModelBase::FlatLayerTreeModelBase( QgsLayerTree *layerTree, QgsProj
   connect( mLayerTreeModel, &QAbstractItemModel::dataChanged, this, &FlatLayerTreeModelBase::updateMap );
   connect( mLayerTreeModel, &QAbstractItemModel::rowsRemoved, this, &FlatLayerTreeModelBase::removeFromMap );
   connect( mLayerTreeModel, &QAbstractItemModel::rowsInserted, this, &FlatLayerTreeModelBase::insertInMap );
+  connect( DeferredLayerLoader::instance(), &DeferredLayerLoader::layerLoaded, this, &FlatLayerTreeModelBase::deferredLayerLoaded );
 }
 
 bool FlatLayerTreeModelBase::isFrozen() const
@@ -819,7 +821,19 @@ QVariant FlatLayerTreeModelBase::data( const QModelIndex &index, int role ) cons
         return false;
       }
 
-      return layer->isValid();
+      // Layers which have not been loaded yet are not reported as invalid
+      return layer->isValid() || DeferredLayerLoader::isDeferred( layer );
+    }
+
+    case FlatLayerTreeModel::IsLoaded:
+    {
+      QgsLayerTreeNode *node = mLayerTreeModel->index2node( sourceIndex );
+      if ( QgsLayerTree::isLayer( node ) )
+      {
+        return !DeferredLayerLoader::isDeferred( QgsLayerTree::toLayer( node )->layer() );
+      }
+
+      return true;
     }
 
     case FlatLayerTreeModel::FeatureCount:
@@ -1152,6 +1166,11 @@ void FlatLayerTreeModelBase::featureCountChanged()
   emit dataChanged( createIndex( 0, 0 ), createIndex( rowCount() - 1, 0 ), QVector<int>() << FlatLayerTreeModel::Name << FlatLayerTreeModel::FeatureCount );
 }
 
+void FlatLayerTreeModelBase::deferredLayerLoaded()
+{
+  emit dataChanged( createIndex( 0, 0 ), createIndex( rowCount() - 1, 0 ), QVector<int>() << FlatLayerTreeModel::IsLoaded << FlatLayerTreeModel::IsValid << FlatLayerTreeModel::FeatureCount );
+}
+
 QHash<int, QByteArray> FlatLayerTreeModelBase::roleNames() const
 {
   QHash<int, QByteArray> roleNames = QAbstractProxyModel::roleNames();
@@ -1179,6 +1198,7 @@ QHash<int, QByteArray> FlatLayerTreeModelBase::roleNames() const
   roleNames[FlatLayerTreeModel::FilterExpression] = "FilterExpression";
   roleNames[FlatLayerTreeModel::Credits] = "Credits";
   roleNames[FlatLayerTreeModel::SnappingEnabled] = "SnappingEnabled";
+  roleNames[FlatLayerTreeModel::IsLoaded] = "IsLoaded";
   return roleNames;
 }
 
@@ -93,6 +93,7 @@ class FlatLayerTreeModelBase : public QAbstractProxyModel
 
   private:
     void featureCountChanged();
+    void deferredLayerLoaded();
     void updateTemporalState();
     void adjustTemporalStateFromAddedLayers( const QList<QgsMapLayer *> &layers );
 
@@ -150,6 +151,7 @@ class FlatLayerTreeModel : public QSortFilterProxyModel
       FilterExpression,
       Credits,
       SnappingEnabled,
+      IsLoaded,
     };
     Q_ENUM( Roles )
 
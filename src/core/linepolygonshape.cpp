@@ -19,6 +19,7 @@
 #include <qgscoordinatetransform.h>
 #include <qgscurve.h>
 #include <qgsgeometry.h>
+#include <qgslinestring.h>
 #include <qgspolygon.h>
 #include <qgsproject.h>
 
@@ -35,9 +36,28 @@ void LinePolygonShape::createPolylines()
 {
   const QgsRectangle visibleExtent = mMapSettings->visibleExtent();
   const double scaleFactor = 1.0 / mMapSettings->mapUnitsPerPoint();
+  // Unrotated transform into item coordinates relative to the top left corner, the item itself handles the rotation
+  const QTransform transform( scaleFactor, 0, 0, -scaleFactor, -visibleExtent.xMinimum() * scaleFactor, visibleExtent.yMaximum() * scaleFactor );
 
   mPolylines.clear();
 
+  auto addPolyline = [this, &transform]( const QgsCurve *curve ) {
+    if ( !curve )
+      return;
+
+    std::unique_ptr<QgsLineString> segmentized;
+    const QgsLineString *line = qgsgeometry_cast<const QgsLineString *>( curve );
+    if ( !line )
+    {
+      segmentized.reset( curve->curveToLine() );
+      line = segmentized.get();
+    }
+
+    QPolygonF polyline( line->numPoints() );
+    QgsQuickMapSettings::transformCoordinates( transform, line->xData(), line->yData(), polyline.size(), polyline.data() );
+    mPolylines << polyline;
+  };
+
   QgsGeometry geometry( mGeometry ? mGeometry->qgsGeometry() : QgsGeometry() );
   Qgis::GeometryType geomType = Qgis::GeometryType::Null;
   if ( mGeometry && !geometry.isEmpty() && geometry.type() != Qgis::GeometryType::Point )
@@ -50,32 +70,25 @@ void LinePolygonShape::createPolylines()
     {
       case Qgis::GeometryType::Line:
       {
-        const QgsMultiPolylineXY lines = geometry.isMultipart() ? geometry.asMultiPolyline() : QgsMultiPolylineXY() << geometry.asPolyline();
-        for ( const QgsPolylineXY &line : lines )
+        for ( auto it = geometry.const_parts_begin(); it != geometry.const_parts_end(); ++it )
         {
-          QPolygonF polyline;
-          for ( const QgsPointXY &point : line )
-          {
-            polyline << QPointF( ( point.x() - visibleExtent.xMinimum() ) * scaleFactor, ( point.y() - visibleExtent.yMaximum() ) * -scaleFactor );
-          }
-          mPolylines << polyline;
+          addPolyline( qgsgeometry_cast<const QgsCurve *>( *it ) );
         }
         break;
       }
 
       case Qgis::GeometryType::Polygon:
       {
-        const QgsMultiPolygonXY polygons = geometry.isMultipart() ? geometry.asMultiPolygon() : QgsMultiPolygonXY() << geometry.asPolygon();
-        for ( const QgsPolygonXY &polygon : polygons )
+        for ( auto it = geometry.const_parts_begin(); it != geometry.const_parts_end(); ++it )
         {
-          for ( const QgsPolylineXY line : polygon )
+          const QgsCurvePolygon *polygon = qgsgeometry_cast<const QgsCurvePolygon *>( *it );
+          if ( !polygon )
+            continue;
+
+          addPolyline( polygon->exteriorRing() );
+          for ( int i = 0; i < polygon->numInteriorRings(); ++i )
           {
-            QPolygonF polyline;
-            for ( const QgsPointXY &point : line )
-            {
-              polyline << QPointF( ( point.x() - visibleExtent.xMinimum() ) * scaleFactor, ( point.y() - visibleExtent.yMaximum() ) * -scaleFactor );
-            }
-            mPolylines << polyline;
+            addPolyline( polygon->interiorRing( i ) );
           }
         }
         break;
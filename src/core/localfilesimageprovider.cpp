@@ -16,56 +16,282 @@
 
 #include "localfilesimageprovider.h"
 
-#include <QIcon>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QPainter>
+#include <QRunnable>
+#include <QStandardPaths>
+#include <QSvgRenderer>
+#include <QThread>
+#include <exiv2/exiv2.hpp>
 #include <qgsgdalutils.h>
 
+#include <atomic>
+#include <cstdlib>
 #include <gdal.h>
 
-LocalFilesImageProvider::LocalFilesImageProvider()
-  : QQuickImageProvider( Pixmap )
+//! The thumbnail size used when QML does not request a specific size
+static const QSize DEFAULT_THUMBNAIL_SIZE( 256, 256 );
+
+//! Returns the image, embedded in the EXIF metadata of the \a path JPEG, when it can serve as thumbnail of \a size
+static QImage exifThumbnail( const QString &path, const QSize &size )
 {
+  QImage thumbnail;
+  int orientation = 1;
+  try
+  {
+    auto image = Exiv2::ImageFactory::open( path.toStdString() );
+    image->readMetadata();
+    const Exiv2::ExifData &exifData = image->exifData();
+    const Exiv2::DataBuf data = Exiv2::ExifThumbC( exifData ).copy();
+#if EXIV2_TEST_VERSION( 0, 28, 0 )
+    thumbnail.loadFromData( QByteArray( reinterpret_cast<const char *>( data.c_data() ), static_cast<qsizetype>( data.size() ) ) );
+#else
+    thumbnail.loadFromData( QByteArray( reinterpret_cast<const char *>( data.pData_ ), static_cast<qsizetype>( data.size_ ) ) );
+#endif
+    if ( thumbnail.isNull() || image->pixelWidth() == 0 || image->pixelHeight() == 0 )
+      return QImage();
+
+    // Embedded thumbnails of a different aspect ratio are letterboxed, they would show black bars
+    const double imageRatio = static_cast<double>( image->pixelWidth() ) / image->pixelHeight();
+    const double thumbnailRatio = static_cast<double>( thumbnail.width() ) / thumbnail.height();
+    if ( std::abs( imageRatio - thumbnailRatio ) > 0.02 )
+      return QImage();
+
+    const auto orientationIt = exifData.findKey( Exiv2::ExifKey( "Exif.Image.Orientation" ) );
+    if ( orientationIt != exifData.end() )
+      orientation = std::atoi( orientationIt->toString().c_str() );
+  }
+  catch ( const std::exception & )
+  {
+    return QImage();
+  }
+
+  switch ( orientation )
+  {
+    case 2:
+      thumbnail = thumbnail.mirrored( true, false );
+      break;
+    case 3:
+      thumbnail = thumbnail.transformed( QTransform().rotate( 180 ) );
+      break;
+    case 4:
+      thumbnail = thumbnail.mirrored( false, true );
+      break;
+    case 5:
+      thumbnail = thumbnail.mirrored( true, false ).transformed( QTransform().rotate( 270 ) );
+      break;
+    case 6:
+      thumbnail = thumbnail.transformed( QTransform().rotate( 90 ) );
+      break;
+    case 7:
+      thumbnail = thumbnail.mirrored( true, false ).transformed( QTransform().rotate( 90 ) );
+      break;
+    case 8:
+      thumbnail = thumbnail.transformed( QTransform().rotate( 270 ) );
+      break;
+    default:
+      break;
+  }
+
+  const QSize outputSize = thumbnail.size().scaled( size, Qt::KeepAspectRatio );
+  if ( thumbnail.width() < outputSize.width() )
+    return QImage();
+
+  return thumbnail.scaled( outputSize, Qt::KeepAspectRatio, Qt::SmoothTransformation );
 }
 
-QImage LocalFilesImageProvider::requestImage( const QString &id, QSize *size, const QSize &requestedSize )
+//! Returns a thumbnail of the \a path image fitting within \a size, decoded by Qt at a reduced scale when the format allows for it
+static QImage imageThumbnail( const QString &path, const QSize &size )
 {
-  static const QIcon defaultIcon( QStringLiteral( ":/themes/qfield/nodpi/ic_file_green_48dp.svg" ) );
+  QImageReader reader( path );
+  reader.setAutoTransform( true );
+  QSize box = size;
+  if ( reader.transformation() & QImageIOHandler::TransformationRotate90 )
+    box.transpose();
 
-  // the id is passed on as an encoded URL string which needs decoding
-  QString path = QUrl::fromPercentEncoding( id.toUtf8() );
+  const QSize imageSize = reader.size();
+  if ( imageSize.isValid() && ( imageSize.width() > box.width() || imageSize.height() > box.height() ) )
+    reader.setScaledSize( imageSize.scaled( box, Qt::KeepAspectRatio ) );
+
+  return reader.read();
+}
+
+//! Returns a thumbnail of the \a path raster dataset fitting within \a size, read from its best fitting overview level
+static QImage rasterThumbnail( QString path, const QSize &size )
+{
   if ( path.toLower().endsWith( QStringLiteral( ".zip" ) ) )
     path = QStringLiteral( "/vsizip/%1" ).arg( path );
 
   const gdal::dataset_unique_ptr dataset( GDALOpen( path.toLocal8Bit().data(), GA_ReadOnly ) );
   if ( !dataset )
-    return defaultIcon.pixmap( QSize( requestedSize ) ).toImage();
+    return QImage();
 
   const int cols = GDALGetRasterXSize( dataset.get() );
   const int rows = GDALGetRasterYSize( dataset.get() );
   int bands = std::min( 4, GDALGetRasterCount( dataset.get() ) );
+  if ( cols <= 0 || rows <= 0 || bands == 0 )
+    return QImage();
+
   if ( bands == 2 )
   {
     // For 2-band raster, go for a 1-band grayscale representation
     bands = 1;
   }
 
-  const QSize outputSize( requestedSize.width(), rows * requestedSize.width() / cols );
+  QSize outputSize = QSize( cols, rows ).scaled( size, Qt::KeepAspectRatio ).boundedTo( QSize( cols, rows ) );
+  outputSize = outputSize.expandedTo( QSize( 1, 1 ) );
   QImage image( outputSize, bands == 4 ? QImage::Format_RGBA8888 : bands == 3 ? QImage::Format_RGB888
                                                                               : QImage::Format_Grayscale8 );
   if ( image.isNull() )
-    return defaultIcon.pixmap( QSize( requestedSize ) ).toImage();
+    return QImage();
 
   GByte *firstPixel = reinterpret_cast<GByte *>( image.bits() );
   for ( int i = 0; i < bands; i++ )
   {
-    CPLErr err = GDALRasterIOEx( GDALGetRasterBand( dataset.get(), i + 1 ),
-                                 GF_Read, 0, 0, cols, rows,
+    // Read from the smallest overview still larger than the output, sparing full resolution reads
+    GDALRasterBandH fullBand = GDALGetRasterBand( dataset.get(), i + 1 );
+    GDALRasterBandH band = fullBand;
+    const int overviewCount = GDALGetOverviewCount( fullBand );
+    for ( int j = 0; j < overviewCount; j++ )
+    {
+      GDALRasterBandH overview = GDALGetOverview( fullBand, j );
+      if ( overview && GDALGetRasterBandXSize( overview ) >= outputSize.width() && GDALGetRasterBandYSize( overview ) >= outputSize.height()
+           && GDALGetRasterBandXSize( overview ) < GDALGetRasterBandXSize( band ) )
+      {
+        band = overview;
+      }
+    }
+
+    CPLErr err = GDALRasterIOEx( band,
+                                 GF_Read, 0, 0, GDALGetRasterBandXSize( band ), GDALGetRasterBandYSize( band ),
                                  firstPixel + ( i ),
                                  outputSize.width(), outputSize.height(),
                                  GDT_Byte, bands, image.bytesPerLine(), nullptr );
     if ( err != CE_None )
     {
-      return defaultIcon.pixmap( QSize( requestedSize ) ).toImage();
+      return QImage();
     }
   }
   return image;
 }
+
+//! Renders the default file icon at \a size
+static QImage defaultThumbnail( const QSize &size )
+{
+  QSvgRenderer renderer( QStringLiteral( ":/themes/qfield/nodpi/ic_file_green_48dp.svg" ) );
+  QImage image( renderer.defaultSize().scaled( size, Qt::KeepAspectRatio ), QImage::Format_ARGB32_Premultiplied );
+  image.fill( Qt::transparent );
+  QPainter painter( &image );
+  renderer.render( &painter );
+  return image;
+}
+
+/**
+ * An image response rendering a thumbnail on a thread pool.
+ */
+class LocalFilesImageResponse : public QQuickImageResponse, public QRunnable
+{
+  public:
+    LocalFilesImageResponse( const QString &path, const QSize &requestedSize, ThumbnailCache *cache )
+      : mPath( path )
+      , mRequestedSize( requestedSize )
+      , mCache( cache )
+    {
+      setAutoDelete( false );
+    }
+
+    QQuickTextureFactory *textureFactory() const override
+    {
+      return QQuickTextureFactory::textureFactoryForImage( mImage );
+    }
+
+    void cancel() override
+    {
+      mCanceled = true;
+    }
+
+    void run() override
+    {
+      // Canceled responses still have to signal they are finished for the engine to clean them up
+      if ( !mCanceled )
+      {
+        bool found = false;
+        mImage = mCache->thumbnail( mPath, mRequestedSize, &found );
+        if ( !found )
+        {
+          // Failed renders are cached too, files without a thumbnail are not opened again on every scroll
+          mImage = LocalFilesImageProvider::renderThumbnail( mPath, mRequestedSize );
+          mCache->insert( mPath, mRequestedSize, mImage );
+        }
+
+        if ( mImage.isNull() )
+          mImage = defaultThumbnail( mRequestedSize );
+      }
+
+      emit finished();
+    }
+
+  private:
+    QString mPath;
+    QSize mRequestedSize;
+    ThumbnailCache *mCache = nullptr;
+    QImage mImage;
+    std::atomic<bool> mCanceled = false;
+};
+
+LocalFilesImageProvider::LocalFilesImageProvider()
+  : mCache( QStandardPaths::writableLocation( QStandardPaths::CacheLocation ) + QStringLiteral( "/thumbnails" ) )
+{
+  // Decoding large images is memory hungry, keep a few cores free for the UI and map rendering
+  mThreadPool.setMaxThreadCount( std::max( 2, QThread::idealThreadCount() / 2 ) );
+
+  // The XMP toolkit must be initialized from the main thread before being used from worker threads
+  Exiv2::XmpParser::initialize();
+}
+
+LocalFilesImageProvider::~LocalFilesImageProvider()
+{
+  // Running responses use the cache, let them finish before it goes away
+  mThreadPool.clear();
+  mThreadPool.waitForDone();
+}
+
+QQuickImageResponse *LocalFilesImageProvider::requestImageResponse( const QString &id, const QSize &requestedSize )
+{
+  // the id is passed on as an encoded URL string which needs decoding
+  const QString path = QUrl::fromPercentEncoding( id.toUtf8() );
+
+  QSize size = requestedSize;
+  if ( size.width() <= 0 && size.height() <= 0 )
+    size = DEFAULT_THUMBNAIL_SIZE;
+  else if ( size.width() <= 0 )
+    size.setWidth( size.height() );
+  else if ( size.height() <= 0 )
+    size.setHeight( size.width() );
+
+  LocalFilesImageResponse *response = new LocalFilesImageResponse( path, size, &mCache );
+  mThreadPool.start( response );
+  return response;
+}
+
+QImage LocalFilesImageProvider::renderThumbnail( const QString &path, const QSize &size )
+{
+  const QString suffix = QFileInfo( path ).suffix().toLower();
+  if ( suffix == QLatin1String( "jpg" ) || suffix == QLatin1String( "jpeg" ) )
+  {
+    QImage image = exifThumbnail( path, size );
+    if ( image.isNull() )
+      image = imageThumbnail( path, size );
+    if ( !image.isNull() )
+      return image;
+  }
+  else if ( suffix == QLatin1String( "png" ) || suffix == QLatin1String( "webp" ) )
+  {
+    const QImage image = imageThumbnail( path, size );
+    if ( !image.isNull() )
+      return image;
+  }
+
+  return rasterThumbnail( path, size );
+}
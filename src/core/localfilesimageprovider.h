@@ -16,18 +16,36 @@
 #ifndef LOCALFILESIMAGEPROVIDER_H
 #define LOCALFILESIMAGEPROVIDER_H
 
-#include <QQuickImageProvider>
+#include "thumbnailcache.h"
+
+#include <QQuickAsyncImageProvider>
+#include <QThreadPool>
 
 /**
+ * An asynchronous image provider rendering thumbnails of local images and raster datasets.
+ *
+ * Thumbnails are rendered on a dedicated thread pool and stored in an on-disk thumbnail
+ * cache, scrolling back to a previously visited folder does not render its thumbnails again.
  * \ingroup core
  */
-class LocalFilesImageProvider : public QQuickImageProvider
+class LocalFilesImageProvider : public QQuickAsyncImageProvider
 {
   public:
     explicit LocalFilesImageProvider();
+    ~LocalFilesImageProvider() override;
+
+    QQuickImageResponse *requestImageResponse( const QString &id, const QSize &requestedSize ) override;
+
+    /**
+     * Renders a thumbnail of the file at \a path fitting within \a size. JPEG images use their embedded
+     * EXIF thumbnail when large enough, raster datasets are read from their best fitting overview level.
+     * Returns a null image if the file can not be rendered.
+     */
+    static QImage renderThumbnail( const QString &path, const QSize &size );
 
-    QQmlImageProviderBase::ImageType imageType() const override { return QQmlImageProviderBase::Image; }
-    QImage requestImage( const QString &id, QSize *size, const QSize &requestedSize ) override;
+  private:
+    QThreadPool mThreadPool;
+    ThumbnailCache mCache;
 };
 
 #endif // LOCALFILESIMAGEPROVIDER_H
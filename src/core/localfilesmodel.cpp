@@ -22,10 +22,18 @@
 #include <QDir>
 #include <QFile>
 #include <QImageReader>
+#include <QSet>
+#include <QtConcurrent>
 
 LocalFilesModel::LocalFilesModel( QObject *parent )
   : QAbstractListModel( parent )
 {
+  // Changes on disk often come in bursts, e.g. while copying a set of files
+  mRefreshTimer.setSingleShot( true );
+  mRefreshTimer.setInterval( 500 );
+  connect( &mRefreshTimer, &QTimer::timeout, this, &LocalFilesModel::refreshModel );
+  connect( &mFileSystemWatcher, &QFileSystemWatcher::directoryChanged, &mRefreshTimer, qOverload<>( &QTimer::start ) );
+
   QSettings settings;
   const bool favoritesInitialized = settings.value( QStringLiteral( "qfieldFavoritesInitialized" ), false ).toBool();
   if ( !favoritesInitialized )
@@ -48,6 +56,14 @@ LocalFilesModel::LocalFilesModel( QObject *parent )
   resetToRoot();
 }
 
+LocalFilesModel::~LocalFilesModel()
+{
+  if ( mScanWatcher )
+  {
+    mScanWatcher->cancel();
+  }
+}
+
 QHash<int, QByteArray> LocalFilesModel::roleNames() const
 {
   QHash<int, QByteArray> roles = QAbstractListModel::roleNames();
@@ -204,6 +220,14 @@ void LocalFilesModel::moveUp()
 
 void LocalFilesModel::reloadModel()
 {
+  cancelScan();
+  mRefreshTimer.stop();
+  mRefreshPending = false;
+  if ( !mFileSystemWatcher.directories().isEmpty() )
+  {
+    mFileSystemWatcher.removePaths( mFileSystemWatcher.directories() );
+  }
+
   beginResetModel();
   mItems.clear();
 
@@ -242,55 +266,300 @@ void LocalFilesModel::reloadModel()
       mItems << Item( ItemMetaType::Favorite, ItemType::SimpleFolder, getCurrentTitleFromPath( item ), QString(), item );
     }
   }
-  else
+
+  endResetModel();
+
+  if ( path != QLatin1String( "root" ) && QFileInfo( path ).isDir() )
+  {
+    mFileSystemWatcher.addPath( path );
+    startScan( false );
+  }
+}
+
+void LocalFilesModel::refreshModel()
+{
+  if ( currentPath() == QLatin1String( "root" ) )
   {
-    QDir dir( path );
-    if ( dir.exists() )
+    return;
+  }
+
+  if ( mScanWatcher )
+  {
+    // Refresh once the running listing is done, it may have missed the change
+    mRefreshPending = true;
+    return;
+  }
+
+  startScan( true );
+}
+
+void LocalFilesModel::scanDirectory( QPromise<QList<Item>> &promise, const QString &path )
+{
+  QDir dir( path );
+  if ( !dir.exists() )
+  {
+    return;
+  }
+
+  const QStringList entries = dir.entryList( QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot, QDir::DirsFirst | QDir::IgnoreCase );
+  // A set keeps the project preview images lookup cheap in folders holding thousands of photos
+  const QSet<QString> entryNames( entries.constBegin(), entries.constEnd() );
+
+  QList<Item> batch;
+  for ( const QString &entry : entries )
+  {
+    if ( promise.isCanceled() )
+    {
+      return;
+    }
+
+    QFileInfo fi( path + QDir::separator() + entry );
+    if ( fi.isDir() )
     {
-      const QStringList items = dir.entryList( QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot, QDir::DirsFirst | QDir::IgnoreCase );
-      QList<Item> folders;
-      QList<Item> files;
-      QList<Item> projects;
-      QList<Item> datasets;
-      for ( const QString &item : items )
+      batch << Item( ItemMetaType::Folder, ItemType::SimpleFolder, fi.fileName(), QString(), fi.absoluteFilePath() );
+    }
+    else
+    {
+      const QString suffix = fi.suffix().toLower();
+      if ( ( suffix == QStringLiteral( "png" ) || suffix == QStringLiteral( "jpg" ) ) && entryNames.contains( fi.completeBaseName() ) )
+      {
+        // Skip project preview images
+        continue;
+      }
+
+      if ( SUPPORTED_PROJECT_EXTENSIONS.contains( suffix ) )
+      {
+        batch << Item( ItemMetaType::Project, ItemType::ProjectFile, fi.completeBaseName(), suffix, fi.absoluteFilePath(), fi.size() );
+      }
+      else if ( SUPPORTED_VECTOR_EXTENSIONS.contains( suffix ) && suffix != QStringLiteral( "pdf" ) )
+      {
+        batch << Item( ItemMetaType::Dataset, ItemType::VectorDataset, fi.completeBaseName(), suffix, fi.absoluteFilePath(), fi.size() );
+      }
+      else if ( SUPPORTED_RASTER_EXTENSIONS.contains( suffix ) )
       {
-        QFileInfo fi( path + QDir::separator() + item );
-        if ( fi.isDir() )
-        {
-          folders << Item( ItemMetaType::Folder, ItemType::SimpleFolder, fi.fileName(), QString(), fi.absoluteFilePath() );
-        }
-        else
-        {
-          const QString suffix = fi.suffix().toLower();
-          if ( ( suffix == QStringLiteral( "png" ) || suffix == QStringLiteral( "jpg" ) ) && items.contains( fi.completeBaseName() ) )
-          {
-            // Skip project preview images
-            continue;
-          }
-
-          if ( SUPPORTED_PROJECT_EXTENSIONS.contains( suffix ) )
-          {
-            projects << Item( ItemMetaType::Project, ItemType::ProjectFile, fi.completeBaseName(), suffix, fi.absoluteFilePath(), fi.size() );
-          }
-          else if ( SUPPORTED_VECTOR_EXTENSIONS.contains( suffix ) && suffix != QStringLiteral( "pdf" ) )
-          {
-            datasets << Item( ItemMetaType::Dataset, ItemType::VectorDataset, fi.completeBaseName(), suffix, fi.absoluteFilePath(), fi.size() );
-          }
-          else if ( SUPPORTED_RASTER_EXTENSIONS.contains( suffix ) )
-          {
-            datasets << Item( ItemMetaType::Dataset, ItemType::RasterDataset, fi.completeBaseName(), suffix, fi.absoluteFilePath(), fi.size() );
-          }
-          else if ( suffix == QStringLiteral( "log" ) || suffix == QStringLiteral( "txt" ) )
-          {
-            files << Item( ItemMetaType::File, ItemType::OtherFile, fi.completeBaseName(), suffix, fi.absoluteFilePath(), fi.size() );
-          }
-        }
+        batch << Item( ItemMetaType::Dataset, ItemType::RasterDataset, fi.completeBaseName(), suffix, fi.absoluteFilePath(), fi.size() );
       }
-      mItems << folders << projects << datasets << files;
+      else if ( suffix == QStringLiteral( "log" ) || suffix == QStringLiteral( "txt" ) )
+      {
+        batch << Item( ItemMetaType::File, ItemType::OtherFile, fi.completeBaseName(), suffix, fi.absoluteFilePath(), fi.size() );
+      }
+    }
+
+    if ( batch.size() >= SCAN_BATCH_SIZE )
+    {
+      std::sort( batch.begin(), batch.end(), itemLessThan );
+      promise.addResult( batch );
+      batch.clear();
     }
   }
 
-  endResetModel();
+  if ( !batch.isEmpty() )
+  {
+    std::sort( batch.begin(), batch.end(), itemLessThan );
+    promise.addResult( batch );
+  }
+}
+
+void LocalFilesModel::startScan( bool incremental )
+{
+  cancelScan();
+
+  QFutureWatcher<QList<Item>> *watcher = new QFutureWatcher<QList<Item>>( this );
+  mScanWatcher = watcher;
+  if ( !incremental )
+  {
+    connect( watcher, &QFutureWatcher<QList<Item>>::resultsReadyAt, this, [this, watcher]( int beginIndex, int endIndex ) {
+      for ( int i = beginIndex; i < endIndex; i++ )
+      {
+        insertItems( watcher->resultAt( i ) );
+      }
+    } );
+  }
+  connect( watcher, &QFutureWatcher<QList<Item>>::finished, this, [this, watcher, incremental] {
+    watcher->deleteLater();
+    mScanWatcher = nullptr;
+
+    if ( incremental )
+    {
+      QList<Item> items;
+      const QList<QList<Item>> batches = watcher->future().results();
+      for ( const QList<Item> &batch : batches )
+      {
+        items << batch;
+      }
+      std::sort( items.begin(), items.end(), itemLessThan );
+      updateItems( items );
+    }
+    else
+    {
+      mIsLoading = false;
+      emit isLoadingChanged();
+    }
+
+    if ( mRefreshPending )
+    {
+      mRefreshPending = false;
+      startScan( true );
+    }
+  } );
+  watcher->setFuture( QtConcurrent::run( &LocalFilesModel::scanDirectory, currentPath() ) );
+
+  if ( !incremental )
+  {
+    mIsLoading = true;
+    emit isLoadingChanged();
+  }
+}
+
+void LocalFilesModel::cancelScan()
+{
+  if ( !mScanWatcher )
+  {
+    return;
+  }
+
+  disconnect( mScanWatcher, nullptr, this, nullptr );
+  mScanWatcher->cancel();
+  mScanWatcher->deleteLater();
+  mScanWatcher = nullptr;
+
+  if ( mIsLoading )
+  {
+    mIsLoading = false;
+    emit isLoadingChanged();
+  }
+}
+
+void LocalFilesModel::insertItems( const QList<Item> &items )
+{
+  qsizetype i = 0;
+  while ( i < items.size() )
+  {
+    const qsizetype row = std::upper_bound( mItems.constBegin(), mItems.constEnd(), items[i], itemLessThan ) - mItems.constBegin();
+
+    // The following items landing at the same row are inserted at once
+    qsizetype count = 1;
+    while ( i + count < items.size() && ( row == mItems.size() || itemLessThan( items[i + count], mItems[row] ) ) )
+    {
+      count++;
+    }
+
+    beginInsertRows( QModelIndex(), static_cast<int>( row ), static_cast<int>( row + count - 1 ) );
+    for ( qsizetype j = 0; j < count; j++ )
+    {
+      mItems.insert( row + j, items[i + j] );
+    }
+    endInsertRows();
+
+    i += count;
+  }
+}
+
+void LocalFilesModel::updateItems( const QList<Item> &items )
+{
+  auto itemKey = []( const Item &item ) {
+    return QStringLiteral( "%1|%2" ).arg( item.type ).arg( item.path );
+  };
+
+  QSet<QString> keys;
+  for ( const Item &item : items )
+  {
+    keys << itemKey( item );
+  }
+
+  // Remove the items gone from disk, range by range
+  qsizetype row = mItems.size() - 1;
+  while ( row >= 0 )
+  {
+    if ( keys.contains( itemKey( mItems[row] ) ) )
+    {
+      row--;
+      continue;
+    }
+
+    qsizetype first = row;
+    while ( first > 0 && !keys.contains( itemKey( mItems[first - 1] ) ) )
+    {
+      first--;
+    }
+
+    beginRemoveRows( QModelIndex(), static_cast<int>( first ), static_cast<int>( row ) );
+    mItems.remove( first, row - first + 1 );
+    endRemoveRows();
+    row = first - 1;
+  }
+
+  // The remaining items keep the order of the new items, insert the new ones and update the modified ones
+  row = 0;
+  qsizetype i = 0;
+  while ( i < items.size() )
+  {
+    if ( row < mItems.size() && itemKey( mItems[row] ) == itemKey( items[i] ) )
+    {
+      if ( mItems[row].size != items[i].size || mItems[row].title != items[i].title )
+      {
+        mItems[row] = items[i];
+        emit dataChanged( index( static_cast<int>( row ) ), index( static_cast<int>( row ) ) );
+      }
+      row++;
+      i++;
+      continue;
+    }
+
+    qsizetype count = 1;
+    while ( i + count < items.size() && ( row == mItems.size() || itemKey( mItems[row] ) != itemKey( items[i + count] ) ) )
+    {
+      count++;
+    }
+
+    beginInsertRows( QModelIndex(), static_cast<int>( row ), static_cast<int>( row + count - 1 ) );
+    for ( qsizetype j = 0; j < count; j++ )
+    {
+      mItems.insert( row + j, items[i + j] );
+    }
+    endInsertRows();
+
+    row += count;
+    i += count;
+  }
+}
+
+bool LocalFilesModel::itemLessThan( const Item &item1, const Item &item2 )
+{
+  // Folders first, followed by projects, datasets, and other files
+  auto metaTypeRank = []( ItemMetaType metaType ) {
+    switch ( metaType )
+    {
+      case ItemMetaType::Folder:
+        return 0;
+      case ItemMetaType::Project:
+        return 1;
+      case ItemMetaType::Dataset:
+        return 2;
+      case ItemMetaType::File:
+        return 3;
+      case ItemMetaType::Favorite:
+        return 4;
+    }
+    return 5;
+  };
+
+  const int rank1 = metaTypeRank( item1.metaType );
+  const int rank2 = metaTypeRank( item2.metaType );
+  if ( rank1 != rank2 )
+  {
+    return rank1 < rank2;
+  }
+
+  const QStringView name1 = QStringView( item1.path ).mid( item1.path.lastIndexOf( QLatin1Char( '/' ) ) + 1 );
+  const QStringView name2 = QStringView( item2.path ).mid( item2.path.lastIndexOf( QLatin1Char( '/' ) ) + 1 );
+  const int comparison = name1.compare( name2, Qt::CaseInsensitive );
+  if ( comparison != 0 )
+  {
+    return comparison < 0;
+  }
+
+  return item1.path < item2.path;
 }
 
 int LocalFilesModel::rowCount( const QModelIndex &parent ) const
@@ -17,6 +17,10 @@
 #define LOCALFILESMODEL_H
 
 #include <QAbstractListModel>
+#include <QFileSystemWatcher>
+#include <QFutureWatcher>
+#include <QPromise>
+#include <QTimer>
 
 #define SUPPORTED_DATASET_THUMBNAIL QStringList( { QStringLiteral( "zip" ), QStringLiteral( "tif" ), QStringLiteral( "tiff" ), QStringLiteral( "pdf" ), QStringLiteral( "jpg" ), QStringLiteral( "jpeg" ), QStringLiteral( "png" ), QStringLiteral( "jp2" ), QStringLiteral( "webp" ) } )
 
@@ -31,6 +35,7 @@ class LocalFilesModel : public QAbstractListModel
     Q_PROPERTY( QString currentPath READ currentPath WRITE setCurrentPath NOTIFY currentPathChanged )
     Q_PROPERTY( int currentDepth READ currentDepth NOTIFY currentPathChanged )
     Q_PROPERTY( bool isDeletedAllowedInCurrentPath READ isDeletedAllowedInCurrentPath NOTIFY currentPathChanged )
+    Q_PROPERTY( bool isLoading READ isLoading NOTIFY isLoadingChanged )
 
   public:
     enum ItemMetaType
@@ -91,6 +96,7 @@ class LocalFilesModel : public QAbstractListModel
 
 
     explicit LocalFilesModel( QObject *parent = nullptr );
+    ~LocalFilesModel() override;
 
     QHash<int, QByteArray> roleNames() const override;
 
@@ -133,18 +139,58 @@ class LocalFilesModel : public QAbstractListModel
     //! Walks the navigation history back up on step
     Q_INVOKABLE void moveUp();
 
+    //! Returns TRUE while the content of the current path is being listed
+    bool isLoading() const { return mIsLoading; }
+
   signals:
 
     void currentPathChanged();
+    void isLoadingChanged();
 
   private:
     void reloadModel();
     const QString getCurrentTitleFromPath( const QString &path ) const;
 
+    /**
+     * Lists the content of the \a path directory, reporting the items in sorted batches to the \a promise.
+     * \note This is run on a worker thread
+     */
+    static void scanDirectory( QPromise<QList<Item>> &promise, const QString &path );
+
+    /**
+     * Starts listing the content of the current path. Items are inserted batch by batch as they are listed,
+     * or when \a incremental is TRUE, the existing items are updated once the listing is done.
+     */
+    void startScan( bool incremental );
+
+    //! Cancels the running listing, if any
+    void cancelScan();
+
+    //! Inserts the sorted \a items at their position
+    void insertItems( const QList<Item> &items );
+
+    //! Updates the model to match the sorted \a items, only removing and inserting the changed rows
+    void updateItems( const QList<Item> &items );
+
+    //! Refreshes the items of the current path after its content changed on disk
+    void refreshModel();
+
+    //! Returns TRUE if \a item1 is listed before \a item2
+    static bool itemLessThan( const Item &item1, const Item &item2 );
+
     QStringList mHistory;
     QList<Item> mItems;
 
     QStringList mFavorites;
+
+    QFileSystemWatcher mFileSystemWatcher;
+    QTimer mRefreshTimer;
+    QFutureWatcher<QList<Item>> *mScanWatcher = nullptr;
+    bool mRefreshPending = false;
+    bool mIsLoading = false;
+
+    //! Number of listed items reported per batch
+    static constexpr int SCAN_BATCH_SIZE = 250;
 };
 
 #endif // LOCALFILESMODEL_H
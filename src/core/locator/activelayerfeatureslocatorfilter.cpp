@@ -16,6 +16,7 @@
 
 #include "activelayerfeatureslocatorfilter.h"
 #include "featurelistextentcontroller.h"
+#include "featuressearchindex.h"
 #include "locatormodelsuperbridge.h"
 #include "qgsquickmapsettings.h"
 
@@ -79,8 +80,15 @@ QStringList ActiveLayerFeaturesLocatorFilter::prepare( const QString &string, co
   bool allowNumeric = false;
   double numericalValue = searchString.toDouble( &allowNumeric );
 
-  // search in display expression if no field restriction
-  if ( !isRestricting )
+  // search in display expression if no field restriction, through the full-text index when available
+  FeaturesSearchIndex *searchIndex = mLocatorBridge->searchIndex();
+  mSearchIndexPath.clear();
+  if ( !isRestricting && searchIndex && searchIndex->isLayerIndexed( layer->id() ) )
+  {
+    mSearchIndexPath = searchIndex->databasePath();
+    mDisplayTitleIterator = QgsFeatureIterator();
+  }
+  else if ( !isRestricting )
   {
     QgsFeatureRequest req;
     req.setSubsetOfAttributes( qgis::setToList( mDispExpression.referencedAttributeIndexes( layer->fields() ) ) );
@@ -219,7 +227,40 @@ void ActiveLayerFeaturesLocatorFilter::fetchResults( const QString &string, cons
   }
 
   // search in display title
-  if ( mDisplayTitleIterator.isValid() )
+  auto emitDisplayTitleResult = [this, &searchString, &featuresFound]( QgsFeatureId fid, const QString &displayString ) {
+    QgsLocatorResult result;
+    result.displayString = displayString;
+    result.group = mLayerName;
+
+#if _QGIS_VERSION_INT >= 33300
+    result.setUserData( QVariantList() << fid << mLayerId );
+#else
+    result.userData = QVariantList() << fid << mLayerId;
+#endif
+    result.score = static_cast<double>( searchString.length() ) / result.displayString.size();
+    result.actions << QgsLocatorResult::ResultAction( OpenForm, tr( "Open form" ), QStringLiteral( "qrc:/themes/qfield/nodpi/ic_baseline-list_white_24dp.svg" ) );
+    if ( mLayerIsSpatial )
+    {
+      result.actions << QgsLocatorResult::ResultAction( Navigation, tr( "Set feature as destination" ), QStringLiteral( "qrc:/themes/qfield/nodpi/ic_navigation_flag_purple_24dp.svg" ) );
+    }
+
+    emit resultFetched( result );
+
+    featuresFound << fid;
+  };
+
+  if ( !mSearchIndexPath.isEmpty() )
+  {
+    const QList<FeaturesSearchIndex::Result> indexResults = FeaturesSearchIndex::search( mSearchIndexPath, searchString, QStringList() << mLayerId, mMaxTotalResults, mMaxTotalResults, feedback );
+    for ( const FeaturesSearchIndex::Result &indexResult : indexResults )
+    {
+      if ( feedback->isCanceled() )
+        return;
+
+      emitDisplayTitleResult( indexResult.featureId, indexResult.displayString );
+    }
+  }
+  else if ( mDisplayTitleIterator.isValid() )
   {
     while ( mDisplayTitleIterator.nextFeature( f ) )
     {
@@ -228,25 +269,7 @@ void ActiveLayerFeaturesLocatorFilter::fetchResults( const QString &string, cons
 
       mContext.setFeature( f );
 
-      QgsLocatorResult result;
-      result.displayString = mDispExpression.evaluate( &mContext ).toString();
-      result.group = mLayerName;
-
-#if _QGIS_VERSION_INT >= 33300
-      result.setUserData( QVariantList() << f.id() << mLayerId );
-#else
-      result.userData = QVariantList() << f.id() << mLayerId;
-#endif
-      result.score = static_cast<double>( searchString.length() ) / result.displayString.size();
-      result.actions << QgsLocatorResult::ResultAction( OpenForm, tr( "Open form" ), QStringLiteral( "qrc:/themes/qfield/nodpi/ic_baseline-list_white_24dp.svg" ) );
-      if ( mLayerIsSpatial )
-      {
-        result.actions << QgsLocatorResult::ResultAction( Navigation, tr( "Set feature as destination" ), QStringLiteral( "qrc:/themes/qfield/nodpi/ic_navigation_flag_purple_24dp.svg" ) );
-      }
-
-      emit resultFetched( result );
-
-      featuresFound << f.id();
+      emitDisplayTitleResult( f.id(), mDispExpression.evaluate( &mContext ).toString() );
       if ( featuresFound.count() >= mMaxTotalResults )
         break;
     }
@@ -70,6 +70,7 @@ class ActiveLayerFeaturesLocatorFilter : public QgsLocatorFilter
     QgsExpression mDispExpression;
     QgsExpressionContext mContext;
     QgsFeatureIterator mDisplayTitleIterator;
+    QString mSearchIndexPath;
     QgsFeatureIterator mFieldIterator;
     QString mLayerId;
     QString mLayerName;
@@ -14,8 +14,10 @@
  *                                                                         *
  ***************************************************************************/
 
+#include "deferredlayerloader.h"
 #include "featurelistextentcontroller.h"
 #include "featureslocatorfilter.h"
+#include "featuressearchindex.h"
 #include "locatormodelsuperbridge.h"
 #include "qgsquickmapsettings.h"
 
@@ -49,12 +51,35 @@ QStringList FeaturesLocatorFilter::prepare( const QString &string, const QgsLoca
     return QStringList();
 
   mPreparedLayers.clear();
+  mIndexedLayers.clear();
+  FeaturesSearchIndex *searchIndex = mLocatorBridge->searchIndex();
+  mSearchIndexPath = searchIndex ? searchIndex->databasePath() : QString();
+
   const QMap<QString, QgsMapLayer *> layers = QgsProject::instance()->mapLayers();
   for ( auto it = layers.constBegin(); it != layers.constEnd(); ++it )
   {
     QgsVectorLayer *layer = qobject_cast<QgsVectorLayer *>( it.value() );
-    if ( !layer || !layer->isValid() || !layer->dataProvider() || !layer->flags().testFlag( QgsMapLayer::Searchable ) )
+    if ( !layer || !layer->flags().testFlag( QgsMapLayer::Searchable ) )
+      continue;
+
+    // Searching loads the searchable layers which have not been loaded yet
+    if ( DeferredLayerLoader::isDeferred( layer ) )
+      DeferredLayerLoader::instance()->load( layer );
+
+    if ( !layer->isValid() || !layer->dataProvider() )
+      continue;
+
+    // Indexed layers are searched through the full-text index instead of scanning their provider
+    if ( searchIndex && searchIndex->isLayerIndexed( layer->id() ) )
+    {
+      std::shared_ptr<PreparedLayer> indexedLayer( new PreparedLayer() );
+      indexedLayer->layerId = layer->id();
+      indexedLayer->layerName = layer->name();
+      indexedLayer->layerIcon = QgsMapLayerModel::iconForLayer( layer );
+      indexedLayer->layerGeometryType = layer->geometryType();
+      mIndexedLayers.append( indexedLayer );
       continue;
+    }
 
     QgsExpression expression( layer->displayExpression() );
     QgsExpressionContext expressionContext;
@@ -97,6 +122,29 @@ void FeaturesLocatorFilter::fetchResults( const QString &string, const QgsLocato
   int foundInTotal = 0;
   QgsFeature f;
 
+  if ( !mIndexedLayers.isEmpty() )
+  {
+    QStringList layerIds;
+    QHash<QString, std::shared_ptr<PreparedLayer>> indexedLayers;
+    for ( const std::shared_ptr<PreparedLayer> &indexedLayer : std::as_const( mIndexedLayers ) )
+    {
+      layerIds << indexedLayer->layerId;
+      indexedLayers.insert( indexedLayer->layerId, indexedLayer );
+    }
+
+    const QList<FeaturesSearchIndex::Result> indexResults = FeaturesSearchIndex::search( mSearchIndexPath, string, layerIds, mMaxResultsPerLayer, mMaxTotalResults, feedback );
+    for ( const FeaturesSearchIndex::Result &indexResult : indexResults )
+    {
+      if ( feedback->isCanceled() )
+        return;
+
+      emit resultFetched( createResult( *indexedLayers.value( indexResult.layerId ), indexResult.featureId, indexResult.displayString, string ) );
+      foundInTotal++;
+    }
+    if ( foundInTotal >= mMaxTotalResults )
+      return;
+  }
+
   // we cannot used const loop since iterator::nextFeature is not const
   for ( auto preparedLayer : std::as_const( mPreparedLayers ) )
   {
@@ -107,27 +155,9 @@ void FeaturesLocatorFilter::fetchResults( const QString &string, const QgsLocato
       if ( feedback->isCanceled() )
         return;
 
-      QgsLocatorResult result;
-      result.group = preparedLayer->layerName;
-
       preparedLayer->context.setFeature( f );
 
-      result.displayString = preparedLayer->expression.evaluate( &( preparedLayer->context ) ).toString();
-
-#if _QGIS_VERSION_INT >= 33300
-      result.setUserData( QVariantList() << f.id() << preparedLayer->layerId );
-#else
-      result.userData = QVariantList() << f.id() << preparedLayer->layerId;
-#endif
-      result.icon = preparedLayer->layerIcon;
-      result.score = static_cast<double>( string.length() ) / result.displayString.size();
-      result.actions << QgsLocatorResult::ResultAction( OpenForm, tr( "Open form" ), QStringLiteral( "qrc:/themes/qfield/nodpi/ic_baseline-list_white_24dp.svg" ) );
-      if ( preparedLayer->layerGeometryType != Qgis::GeometryType::Null && preparedLayer->layerGeometryType != Qgis::GeometryType::Unknown )
-      {
-        result.actions << QgsLocatorResult::ResultAction( Navigation, tr( "Set feature as destination" ), QStringLiteral( "qrc:/themes/qfield/nodpi/ic_navigation_flag_purple_24dp.svg" ) );
-      }
-
-      emit resultFetched( result );
+      emit resultFetched( createResult( *preparedLayer, f.id(), preparedLayer->expression.evaluate( &( preparedLayer->context ) ).toString(), string ) );
 
       foundInCurrentLayer++;
       foundInTotal++;
@@ -139,6 +169,28 @@ void FeaturesLocatorFilter::fetchResults( const QString &string, const QgsLocato
   }
 }
 
+QgsLocatorResult FeaturesLocatorFilter::createResult( const PreparedLayer &preparedLayer, QgsFeatureId fid, const QString &displayString, const QString &string ) const
+{
+  QgsLocatorResult result;
+  result.group = preparedLayer.layerName;
+  result.displayString = displayString;
+
+#if _QGIS_VERSION_INT >= 33300
+  result.setUserData( QVariantList() << fid << preparedLayer.layerId );
+#else
+  result.userData = QVariantList() << fid << preparedLayer.layerId;
+#endif
+  result.icon = preparedLayer.layerIcon;
+  result.score = static_cast<double>( string.length() ) / result.displayString.size();
+  result.actions << QgsLocatorResult::ResultAction( OpenForm, tr( "Open form" ), QStringLiteral( "qrc:/themes/qfield/nodpi/ic_baseline-list_white_24dp.svg" ) );
+  if ( preparedLayer.layerGeometryType != Qgis::GeometryType::Null && preparedLayer.layerGeometryType != Qgis::GeometryType::Unknown )
+  {
+    result.actions << QgsLocatorResult::ResultAction( Navigation, tr( "Set feature as destination" ), QStringLiteral( "qrc:/themes/qfield/nodpi/ic_navigation_flag_purple_24dp.svg" ) );
+  }
+
+  return result;
+}
+
 void FeaturesLocatorFilter::triggerResult( const QgsLocatorResult &result )
 {
   triggerResultFromAction( result, Normal );
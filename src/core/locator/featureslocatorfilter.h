@@ -70,9 +70,13 @@ class FeaturesLocatorFilter : public QgsLocatorFilter
     void triggerResultFromAction( const QgsLocatorResult &result, const int actionId ) override;
 
   private:
+    QgsLocatorResult createResult( const PreparedLayer &preparedLayer, QgsFeatureId fid, const QString &displayString, const QString &string ) const;
+
     int mMaxResultsPerLayer = 12;
     int mMaxTotalResults = 16;
     QList<std::shared_ptr<PreparedLayer>> mPreparedLayers;
+    QList<std::shared_ptr<PreparedLayer>> mIndexedLayers;
+    QString mSearchIndexPath;
     LocatorModelSuperBridge *mLocatorBridge = nullptr;
 };
 
@@ -0,0 +1,564 @@
+/***************************************************************************
+  featuressearchindex.cpp
+
+ ---------------------
+ begin                : 18.10.2026
+ copyright            : (C) 2026 by OPENGIS.ch
+ email                : info@opengis.ch
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "featuressearchindex.h"
+#include "layerobserver.h"
+#include "platformutilities.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <qgsexpressioncontextutils.h>
+#include <qgsfeedback.h>
+#include <qgsmessagelog.h>
+#include <qgsproject.h>
+#include <qgsproviderregistry.h>
+#include <qgssqliteutils.h>
+#include <qgsvectordataprovider.h>
+#include <qgsvectorlayer.h>
+#include <qgsvectorlayerfeatureiterator.h>
+
+#include <algorithm>
+#include <sqlite3.h>
+
+struct FeaturesSearchIndexJob
+{
+    int generation = 0;
+    QString layerId;
+    QString signature;
+    std::unique_ptr<QgsVectorLayerFeatureSource> source;
+    QgsExpression expression;
+    QgsExpressionContext context;
+    QgsFeatureRequest request;
+
+    //! When TRUE, all features of the layer are indexed from scratch
+    bool rebuild = false;
+
+    //! Features to re-index, ignored when rebuilding
+    QgsFeatureIds changedFeatureIds;
+
+    //! Features to remove from the index, ignored when rebuilding
+    QgsFeatureIds removedFeatureIds;
+};
+
+class FeaturesSearchIndexWorker : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit FeaturesSearchIndexWorker( std::shared_ptr<std::atomic<int>> generation );
+
+    /**
+     * Opens the index database at \a databasePath, creating its tables if needed.
+     */
+    void open( const QString &databasePath );
+
+    /**
+     * Closes the index database.
+     */
+    void close();
+
+    /**
+     * Updates the index according to a \a job, jobs from a previous generation are skipped.
+     */
+    void processJob( const std::shared_ptr<FeaturesSearchIndexJob> &job );
+
+  signals:
+    void layerIndexed( int generation, const QString &layerId );
+
+  private:
+    //! Returns TRUE when the \a job is outdated, i.e. the project has been closed in the meantime
+    bool isCanceled( const FeaturesSearchIndexJob &job ) const { return job.generation != *mGeneration; }
+
+    //! Removes the index entry of the feature matching \a fid from the layer matching \a layerId
+    void removeEntry( const QByteArray &layerId, QgsFeatureId fid );
+
+    //! Iterates over the features of a \a job and adds them to the index, returns FALSE when canceled
+    bool insertEntries( FeaturesSearchIndexJob &job, const QByteArray &layerId );
+
+    std::shared_ptr<std::atomic<int>> mGeneration;
+    sqlite3_database_unique_ptr mDatabase;
+    bool mIsValid = false;
+};
+
+FeaturesSearchIndexWorker::FeaturesSearchIndexWorker( std::shared_ptr<std::atomic<int>> generation )
+  : mGeneration( generation )
+{
+}
+
+void FeaturesSearchIndexWorker::open( const QString &databasePath )
+{
+  close();
+
+  QDir().mkpath( QFileInfo( databasePath ).absolutePath() );
+
+  int status = mDatabase.open_v2( databasePath, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr );
+  if ( status != SQLITE_OK )
+  {
+    QgsMessageLog::logMessage( QObject::tr( "There was an error opening the search index database <b>%1</b>: %2" ).arg( databasePath, mDatabase.errorMessage() ) );
+    return;
+  }
+
+  QString error;
+  mDatabase.exec( QStringLiteral( "PRAGMA journal_mode=WAL; PRAGMA synchronous=NORMAL;" ), error );
+  mDatabase.exec( QStringLiteral( "CREATE TABLE IF NOT EXISTS layers (layer_id TEXT PRIMARY KEY, signature TEXT)" ), error );
+  mDatabase.exec( QStringLiteral( "CREATE TABLE IF NOT EXISTS entries (id INTEGER PRIMARY KEY, layer_id TEXT NOT NULL, fid INTEGER NOT NULL, UNIQUE (layer_id, fid))" ), error );
+  if ( !error.isEmpty() )
+  {
+    QgsMessageLog::logMessage( QObject::tr( "Could not create the search index tables: %1" ).arg( error ) );
+    return;
+  }
+
+  // The trigram tokenizer provides for substring matches akin to the ILIKE filters it replaces,
+  // fall back to word prefix matching when the SQLite library predates it
+  mDatabase.exec( QStringLiteral( "CREATE VIRTUAL TABLE IF NOT EXISTS features USING fts5(display, tokenize='trigram')" ), error );
+  if ( !error.isEmpty() )
+  {
+    error.clear();
+    mDatabase.exec( QStringLiteral( "CREATE VIRTUAL TABLE IF NOT EXISTS features USING fts5(display, tokenize='unicode61 remove_diacritics 2')" ), error );
+  }
+  if ( !error.isEmpty() )
+  {
+    QgsMessageLog::logMessage( QObject::tr( "Could not create the search index full-text table: %1" ).arg( error ) );
+    return;
+  }
+
+  mIsValid = true;
+}
+
+void FeaturesSearchIndexWorker::close()
+{
+  mIsValid = false;
+  mDatabase.reset();
+}
+
+void FeaturesSearchIndexWorker::processJob( const std::shared_ptr<FeaturesSearchIndexJob> &job )
+{
+  if ( !mIsValid || isCanceled( *job ) )
+    return;
+
+  const QByteArray layerId = job->layerId.toUtf8();
+  const QByteArray signature = job->signature.toUtf8();
+
+  int status = SQLITE_OK;
+  QString error;
+  if ( job->rebuild )
+  {
+    sqlite3_statement_unique_ptr select = mDatabase.prepare( QStringLiteral( "SELECT signature FROM layers WHERE layer_id = ?" ), status );
+    sqlite3_bind_text( select.get(), 1, layerId.constData(), static_cast<int>( layerId.size() ), SQLITE_TRANSIENT );
+    if ( select.step() == SQLITE_ROW && select.columnAsText( 0 ) == job->signature )
+    {
+      emit layerIndexed( job->generation, job->layerId );
+      return;
+    }
+    select.reset();
+
+    mDatabase.exec( QStringLiteral( "BEGIN" ), error );
+    for ( const QString &sql : { QStringLiteral( "DELETE FROM layers WHERE layer_id = ?" ),
+                                 QStringLiteral( "DELETE FROM features WHERE rowid IN (SELECT id FROM entries WHERE layer_id = ?)" ),
+                                 QStringLiteral( "DELETE FROM entries WHERE layer_id = ?" ) } )
+    {
+      sqlite3_statement_unique_ptr remove = mDatabase.prepare( sql, status );
+      sqlite3_bind_text( remove.get(), 1, layerId.constData(), static_cast<int>( layerId.size() ), SQLITE_TRANSIENT );
+      remove.step();
+    }
+
+    if ( !insertEntries( *job, layerId ) )
+    {
+      mDatabase.exec( QStringLiteral( "ROLLBACK" ), error );
+      return;
+    }
+
+    sqlite3_statement_unique_ptr insert = mDatabase.prepare( QStringLiteral( "INSERT INTO layers (layer_id, signature) VALUES (?, ?)" ), status );
+    sqlite3_bind_text( insert.get(), 1, layerId.constData(), static_cast<int>( layerId.size() ), SQLITE_TRANSIENT );
+    sqlite3_bind_text( insert.get(), 2, signature.constData(), static_cast<int>( signature.size() ), SQLITE_TRANSIENT );
+    insert.step();
+    mDatabase.exec( QStringLiteral( "COMMIT" ), error );
+
+    emit layerIndexed( job->generation, job->layerId );
+  }
+  else
+  {
+    mDatabase.exec( QStringLiteral( "BEGIN" ), error );
+    for ( const QgsFeatureId fid : std::as_const( job->removedFeatureIds ) )
+    {
+      removeEntry( layerId, fid );
+    }
+    if ( !job->changedFeatureIds.isEmpty() )
+    {
+      for ( const QgsFeatureId fid : std::as_const( job->changedFeatureIds ) )
+      {
+        removeEntry( layerId, fid );
+      }
+      if ( !insertEntries( *job, layerId ) )
+      {
+        mDatabase.exec( QStringLiteral( "ROLLBACK" ), error );
+        return;
+      }
+    }
+
+    // Keep the signature in sync so the index is reused when the project is opened again
+    sqlite3_statement_unique_ptr update = mDatabase.prepare( QStringLiteral( "UPDATE layers SET signature = ? WHERE layer_id = ?" ), status );
+    sqlite3_bind_text( update.get(), 1, signature.constData(), static_cast<int>( signature.size() ), SQLITE_TRANSIENT );
+    sqlite3_bind_text( update.get(), 2, layerId.constData(), static_cast<int>( layerId.size() ), SQLITE_TRANSIENT );
+    update.step();
+    mDatabase.exec( QStringLiteral( "COMMIT" ), error );
+  }
+}
+
+void FeaturesSearchIndexWorker::removeEntry( const QByteArray &layerId, QgsFeatureId fid )
+{
+  int status = SQLITE_OK;
+  sqlite3_statement_unique_ptr select = mDatabase.prepare( QStringLiteral( "SELECT id FROM entries WHERE layer_id = ? AND fid = ?" ), status );
+  sqlite3_bind_text( select.get(), 1, layerId.constData(), static_cast<int>( layerId.size() ), SQLITE_TRANSIENT );
+  sqlite3_bind_int64( select.get(), 2, fid );
+  if ( select.step() != SQLITE_ROW )
+    return;
+
+  const qint64 id = select.columnAsInt64( 0 );
+  for ( const QString &sql : { QStringLiteral( "DELETE FROM features WHERE rowid = ?" ), QStringLiteral( "DELETE FROM entries WHERE id = ?" ) } )
+  {
+    sqlite3_statement_unique_ptr remove = mDatabase.prepare( sql, status );
+    sqlite3_bind_int64( remove.get(), 1, id );
+    remove.step();
+  }
+}
+
+bool FeaturesSearchIndexWorker::insertEntries( FeaturesSearchIndexJob &job, const QByteArray &layerId )
+{
+  int status = SQLITE_OK;
+  sqlite3_statement_unique_ptr insertEntry = mDatabase.prepare( QStringLiteral( "INSERT INTO entries (layer_id, fid) VALUES (?, ?)" ), status );
+  sqlite3_statement_unique_ptr insertFeature = mDatabase.prepare( QStringLiteral( "INSERT INTO features (rowid, display) VALUES (?, ?)" ), status );
+
+  QgsFeature feature;
+  QgsFeatureIterator it = job.source->getFeatures( job.request );
+  while ( it.nextFeature( feature ) )
+  {
+    if ( isCanceled( job ) )
+      return false;
+
+    job.context.setFeature( feature );
+    const QByteArray displayString = job.expression.evaluate( &job.context ).toString().toUtf8();
+    if ( displayString.isEmpty() )
+      continue;
+
+    sqlite3_reset( insertEntry.get() );
+    sqlite3_bind_text( insertEntry.get(), 1, layerId.constData(), static_cast<int>( layerId.size() ), SQLITE_TRANSIENT );
+    sqlite3_bind_int64( insertEntry.get(), 2, feature.id() );
+    if ( insertEntry.step() != SQLITE_DONE )
+      continue;
+
+    sqlite3_reset( insertFeature.get() );
+    sqlite3_bind_int64( insertFeature.get(), 1, sqlite3_last_insert_rowid( mDatabase.get() ) );
+    sqlite3_bind_text( insertFeature.get(), 2, displayString.constData(), static_cast<int>( displayString.size() ), SQLITE_TRANSIENT );
+    insertFeature.step();
+  }
+
+  return true;
+}
+
+
+FeaturesSearchIndex::FeaturesSearchIndex( QgsProject *project, LayerObserver *layerObserver, QObject *parent )
+  : QObject( parent )
+  , mProject( project )
+  , mGeneration( std::make_shared<std::atomic<int>>( 0 ) )
+{
+  mFlushTimer.setSingleShot( true );
+  mFlushTimer.setInterval( 0 );
+  connect( &mFlushTimer, &QTimer::timeout, this, &FeaturesSearchIndex::flushPendingChanges );
+
+  mWorker = new FeaturesSearchIndexWorker( mGeneration );
+  mWorker->moveToThread( &mWorkerThread );
+  connect( &mWorkerThread, &QThread::finished, mWorker, &QObject::deleteLater );
+  connect( mWorker, &FeaturesSearchIndexWorker::layerIndexed, this, &FeaturesSearchIndex::onLayerIndexed );
+  mWorkerThread.start( QThread::LowPriority );
+
+  connect( mProject, &QgsProject::cleared, this, &FeaturesSearchIndex::onProjectCleared );
+  connect( mProject, &QgsProject::readProject, this, &FeaturesSearchIndex::onReadProject );
+  connect( mProject, &QgsProject::layersAdded, this, &FeaturesSearchIndex::onLayersAdded );
+  connect( mProject, &QgsProject::layersRemoved, this, &FeaturesSearchIndex::onLayersRemoved );
+  connect( layerObserver, &LayerObserver::committedFeaturesChanged, this, &FeaturesSearchIndex::onCommittedFeaturesChanged );
+  connect( layerObserver, &LayerObserver::committedFeaturesRemoved, this, &FeaturesSearchIndex::onCommittedFeaturesRemoved );
+}
+
+FeaturesSearchIndex::~FeaturesSearchIndex()
+{
+  ( *mGeneration )++;
+  mWorkerThread.quit();
+  mWorkerThread.wait();
+}
+
+void FeaturesSearchIndex::onProjectCleared()
+{
+  // Outdated jobs still queued or running on the worker thread will be skipped
+  ( *mGeneration )++;
+  mDatabasePath.clear();
+  mIndexedLayerIds.clear();
+  mPendingChanges.clear();
+
+  QMetaObject::invokeMethod( mWorker, [worker = mWorker] { worker->close(); } );
+}
+
+void FeaturesSearchIndex::onReadProject()
+{
+  if ( mProject->absoluteFilePath().isEmpty() )
+    return;
+
+  const QByteArray projectHash = QCryptographicHash::hash( mProject->absoluteFilePath().toUtf8(), QCryptographicHash::Sha1 ).toHex();
+  mDatabasePath = QStringLiteral( "%1/%2.sqlite" ).arg( PlatformUtilities::instance()->systemLocalDataLocation( QStringLiteral( "search_indexes" ) ), QString::fromLatin1( projectHash ) );
+  QMetaObject::invokeMethod( mWorker, [worker = mWorker, databasePath = mDatabasePath] { worker->open( databasePath ); } );
+
+  const QList<QgsMapLayer *> layers = mProject->mapLayers().values();
+  for ( QgsMapLayer *layer : layers )
+  {
+    QgsVectorLayer *vlayer = qobject_cast<QgsVectorLayer *>( layer );
+    if ( isIndexable( vlayer ) )
+      indexLayer( vlayer );
+  }
+}
+
+void FeaturesSearchIndex::onLayersAdded( const QList<QgsMapLayer *> &layers )
+{
+  // Layers loaded alongside a project are handled once it has been read
+  if ( mDatabasePath.isEmpty() )
+    return;
+
+  for ( QgsMapLayer *layer : layers )
+  {
+    QgsVectorLayer *vlayer = qobject_cast<QgsVectorLayer *>( layer );
+    if ( isIndexable( vlayer ) )
+      indexLayer( vlayer );
+  }
+}
+
+void FeaturesSearchIndex::onLayersRemoved( const QStringList &layerIds )
+{
+  for ( const QString &layerId : layerIds )
+  {
+    mIndexedLayerIds.remove( layerId );
+    mPendingChanges.remove( layerId );
+  }
+}
+
+void FeaturesSearchIndex::onCommittedFeaturesChanged( const QString &layerId, const QgsFeatureIds &featureIds )
+{
+  if ( mDatabasePath.isEmpty() || featureIds.isEmpty() )
+    return;
+
+  // Attribute and geometry changes of a single commit are coalesced into one update
+  mPendingChanges[layerId].unite( featureIds );
+  mFlushTimer.start();
+}
+
+void FeaturesSearchIndex::onCommittedFeaturesRemoved( const QString &layerId, const QgsFeatureIds &featureIds )
+{
+  if ( mDatabasePath.isEmpty() || featureIds.isEmpty() )
+    return;
+
+  QgsVectorLayer *layer = qobject_cast<QgsVectorLayer *>( mProject->mapLayer( layerId ) );
+  if ( !isIndexable( layer ) )
+    return;
+
+  std::shared_ptr<FeaturesSearchIndexJob> job = createJob( layer );
+  job->removedFeatureIds = featureIds;
+  QMetaObject::invokeMethod( mWorker, [worker = mWorker, job] { worker->processJob( job ); } );
+}
+
+void FeaturesSearchIndex::flushPendingChanges()
+{
+  for ( auto it = mPendingChanges.constBegin(); it != mPendingChanges.constEnd(); ++it )
+  {
+    QgsVectorLayer *layer = qobject_cast<QgsVectorLayer *>( mProject->mapLayer( it.key() ) );
+    if ( !isIndexable( layer ) )
+      continue;
+
+    std::shared_ptr<FeaturesSearchIndexJob> job = createJob( layer, it.value() );
+    QMetaObject::invokeMethod( mWorker, [worker = mWorker, job] { worker->processJob( job ); } );
+  }
+  mPendingChanges.clear();
+}
+
+void FeaturesSearchIndex::onLayerIndexed( int generation, const QString &layerId )
+{
+  if ( generation != *mGeneration )
+    return;
+
+  mIndexedLayerIds.insert( layerId );
+  emit layerIndexed( layerId );
+}
+
+void FeaturesSearchIndex::indexLayer( QgsVectorLayer *layer )
+{
+  std::shared_ptr<FeaturesSearchIndexJob> job = createJob( layer );
+  job->rebuild = true;
+  QMetaObject::invokeMethod( mWorker, [worker = mWorker, job] { worker->processJob( job ); } );
+}
+
+bool FeaturesSearchIndex::isIndexable( QgsVectorLayer *layer )
+{
+  if ( !layer || !layer->isValid() || !layer->dataProvider() || !layer->flags().testFlag( QgsMapLayer::Searchable ) )
+    return false;
+
+  return !layerFilePath( layer ).isEmpty();
+}
+
+QString FeaturesSearchIndex::layerFilePath( QgsVectorLayer *layer )
+{
+  // Only providers reading local files can have their changes detected from the file metadata
+  static const QStringList sFileProviders { QStringLiteral( "ogr" ), QStringLiteral( "spatialite" ), QStringLiteral( "delimitedtext" ) };
+  if ( !sFileProviders.contains( layer->providerType() ) )
+    return QString();
+
+  const QVariantMap uriParts = QgsProviderRegistry::instance()->decodeUri( layer->providerType(), layer->source() );
+  const QFileInfo fileInfo( uriParts.value( QStringLiteral( "path" ) ).toString() );
+  return fileInfo.isFile() ? fileInfo.absoluteFilePath() : QString();
+}
+
+QString FeaturesSearchIndex::layerSignature( QgsVectorLayer *layer )
+{
+  QStringList parts;
+  parts << layer->source() << layer->displayExpression() << QString::number( layer->dataProvider()->featureCount() );
+
+  const QString filePath = layerFilePath( layer );
+  if ( !filePath.isEmpty() )
+  {
+    // Edits of SQLite based datasets in WAL mode only reach the main file once checkpointed
+    for ( const QString &path : { filePath, QStringLiteral( "%1-wal" ).arg( filePath ) } )
+    {
+      const QFileInfo fileInfo( path );
+      if ( fileInfo.exists() )
+      {
+        parts << QString::number( fileInfo.size() ) << QString::number( fileInfo.lastModified().toMSecsSinceEpoch() );
+      }
+    }
+  }
+
+  return QString::fromLatin1( QCryptographicHash::hash( parts.join( QChar( '\n' ) ).toUtf8(), QCryptographicHash::Sha1 ).toHex() );
+}
+
+std::shared_ptr<FeaturesSearchIndexJob> FeaturesSearchIndex::createJob( QgsVectorLayer *layer, const QgsFeatureIds &featureIds ) const
+{
+  std::shared_ptr<FeaturesSearchIndexJob> job = std::make_shared<FeaturesSearchIndexJob>();
+  job->generation = *mGeneration;
+  job->layerId = layer->id();
+  job->signature = layerSignature( layer );
+  job->changedFeatureIds = featureIds;
+  job->source = std::make_unique<QgsVectorLayerFeatureSource>( layer );
+  job->expression = QgsExpression( layer->displayExpression() );
+  job->context.appendScopes( QgsExpressionContextUtils::globalProjectLayerScopes( layer ) );
+  job->expression.prepare( &job->context );
+
+  job->request.setSubsetOfAttributes( qgis::setToList( job->expression.referencedAttributeIndexes( layer->fields() ) ) );
+  if ( !job->expression.needsGeometry() )
+  {
+#if _QGIS_VERSION_INT >= 33500
+    job->request.setFlags( Qgis::FeatureRequestFlag::NoGeometry );
+#else
+    job->request.setFlags( QgsFeatureRequest::NoGeometry );
+#endif
+  }
+  if ( !featureIds.isEmpty() )
+  {
+    job->request.setFilterFids( featureIds );
+  }
+
+  return job;
+}
+
+QList<FeaturesSearchIndex::Result> FeaturesSearchIndex::search( const QString &databasePath, const QString &string, const QStringList &layerIds, int maxResultsPerLayer, int maxTotalResults, QgsFeedback *feedback )
+{
+  QList<Result> results;
+  if ( databasePath.isEmpty() || layerIds.isEmpty() )
+    return results;
+
+  sqlite3_database_unique_ptr database;
+  if ( database.open_v2( databasePath, SQLITE_OPEN_READONLY, nullptr ) != SQLITE_OK )
+    return results;
+
+  int status = SQLITE_OK;
+  bool isTrigram = false;
+  sqlite3_statement_unique_ptr tokenizer = database.prepare( QStringLiteral( "SELECT sql FROM sqlite_master WHERE name = 'features'" ), status );
+  if ( status == SQLITE_OK && tokenizer.step() == SQLITE_ROW )
+  {
+    isTrigram = tokenizer.columnAsText( 0 ).contains( QStringLiteral( "trigram" ) );
+  }
+  tokenizer.reset();
+
+  // Every search term must be matched, trigram queries need at least three characters and shorter terms are matched through LIKE
+  QStringList matchTerms;
+  QList<QByteArray> likePatterns;
+  const QStringList terms = string.split( QRegularExpression( QStringLiteral( "\\s+" ) ), Qt::SkipEmptyParts );
+  for ( QString term : terms )
+  {
+    if ( !isTrigram || term.size() >= 3 )
+    {
+      matchTerms << QStringLiteral( "\"%1\"%2" ).arg( term.replace( '"', QStringLiteral( "\"\"" ) ), isTrigram ? QString() : QStringLiteral( "*" ) );
+    }
+    else
+    {
+      term.replace( '\\', QStringLiteral( "\\\\" ) ).replace( '%', QStringLiteral( "\\%" ) ).replace( '_', QStringLiteral( "\\_" ) );
+      likePatterns << QStringLiteral( "%%1%" ).arg( term ).toUtf8();
+    }
+  }
+  if ( matchTerms.isEmpty() && likePatterns.isEmpty() )
+    return results;
+
+  QString sql = QStringLiteral( "SELECT entries.fid, features.display FROM features JOIN entries ON entries.id = features.rowid WHERE entries.layer_id = ?" );
+  if ( !matchTerms.isEmpty() )
+    sql += QStringLiteral( " AND features MATCH ?" );
+  for ( int i = 0; i < likePatterns.size(); ++i )
+    sql += QStringLiteral( " AND features.display LIKE ? ESCAPE '\\'" );
+  sql += matchTerms.isEmpty() ? QStringLiteral( " ORDER BY length(features.display)" ) : QStringLiteral( " ORDER BY rank" );
+  sql += QStringLiteral( " LIMIT ?" );
+
+  sqlite3_statement_unique_ptr select = database.prepare( sql, status );
+  if ( status != SQLITE_OK )
+    return results;
+
+  const QByteArray match = matchTerms.join( QStringLiteral( " AND " ) ).toUtf8();
+  for ( const QString &layerId : layerIds )
+  {
+    if ( feedback && feedback->isCanceled() )
+      break;
+
+    const QByteArray layerIdData = layerId.toUtf8();
+    int index = 1;
+    sqlite3_reset( select.get() );
+    sqlite3_bind_text( select.get(), index++, layerIdData.constData(), static_cast<int>( layerIdData.size() ), SQLITE_TRANSIENT );
+    if ( !matchTerms.isEmpty() )
+      sqlite3_bind_text( select.get(), index++, match.constData(), static_cast<int>( match.size() ), SQLITE_TRANSIENT );
+    for ( const QByteArray &likePattern : std::as_const( likePatterns ) )
+      sqlite3_bind_text( select.get(), index++, likePattern.constData(), static_cast<int>( likePattern.size() ), SQLITE_TRANSIENT );
+    sqlite3_bind_int( select.get(), index++, std::min( maxResultsPerLayer, maxTotalResults - static_cast<int>( results.size() ) ) );
+
+    while ( select.step() == SQLITE_ROW )
+    {
+      Result result;
+      result.layerId = layerId;
+      result.featureId = select.columnAsInt64( 0 );
+      result.displayString = select.columnAsText( 1 );
+      results << result;
+    }
+
+    if ( results.size() >= maxTotalResults )
+      break;
+  }
+
+  return results;
+}
+
+#include "featuressearchindex.moc"
@@ -0,0 +1,129 @@
+/***************************************************************************
+  featuressearchindex.h
+
+ ---------------------
+ begin                : 18.10.2026
+ copyright            : (C) 2026 by OPENGIS.ch
+ email                : info@opengis.ch
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef FEATURESSEARCHINDEX_H
+#define FEATURESSEARCHINDEX_H
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QThread>
+#include <QTimer>
+#include <qgsfeatureid.h>
+
+#include <atomic>
+#include <memory>
+
+class FeaturesSearchIndexWorker;
+class LayerObserver;
+class QgsFeedback;
+class QgsMapLayer;
+class QgsProject;
+class QgsVectorLayer;
+struct FeaturesSearchIndexJob;
+
+/**
+ * \brief A persistent full-text index of the display expression of searchable local layers.
+ *
+ * The index is stored in a per-project SQLite database using an FTS5 table. It is built
+ * in the background when a project is opened, layers whose source, display expression
+ * and file did not change since the last session are reused as is. Committed edits reported by the
+ * LayerObserver keep the index up to date incrementally.
+ *
+ * Searches are run through search(), which opens its own read-only connection and is
+ * therefore safe to call from the locator filters' worker threads.
+ *
+ * \ingroup core
+ */
+class FeaturesSearchIndex : public QObject
+{
+    Q_OBJECT
+
+  public:
+    //! A feature matching a search
+    struct Result
+    {
+        QString layerId;
+        QgsFeatureId featureId = FID_NULL;
+        QString displayString;
+    };
+
+    FeaturesSearchIndex( QgsProject *project, LayerObserver *layerObserver, QObject *parent = nullptr );
+    ~FeaturesSearchIndex();
+
+    //! Returns the path of the index database of the current project, empty when no project is opened
+    QString databasePath() const { return mDatabasePath; }
+
+    //! Returns TRUE when the layer matching \a layerId has been fully indexed and can be searched
+    bool isLayerIndexed( const QString &layerId ) const { return mIndexedLayerIds.contains( layerId ); }
+
+    /**
+     * Searches the index database at \a databasePath for features of the \a layerIds layers whose
+     * display string matches \a string. Results are ranked by relevance, capped to \a maxResultsPerLayer
+     * per layer and \a maxTotalResults overall.
+     */
+    static QList<Result> search( const QString &databasePath, const QString &string, const QStringList &layerIds, int maxResultsPerLayer, int maxTotalResults, QgsFeedback *feedback = nullptr );
+
+    /**
+     * Returns TRUE when the \a layer is searchable through the locator and backed by a local file.
+     * Remote layers are not indexed, as their changes cannot be detected without fetching all their
+     * features, they are searched through their provider instead.
+     */
+    static bool isIndexable( QgsVectorLayer *layer );
+
+    /**
+     * Returns a signature of the \a layer content and display expression, used to decide
+     * whether a persisted index is still current.
+     */
+    static QString layerSignature( QgsVectorLayer *layer );
+
+  signals:
+    //! Emitted when the layer matching \a layerId has been indexed and can be searched
+    void layerIndexed( const QString &layerId );
+
+  private slots:
+    void onProjectCleared();
+    void onReadProject();
+    void onLayersAdded( const QList<QgsMapLayer *> &layers );
+    void onLayersRemoved( const QStringList &layerIds );
+    void onCommittedFeaturesChanged( const QString &layerId, const QgsFeatureIds &featureIds );
+    void onCommittedFeaturesRemoved( const QString &layerId, const QgsFeatureIds &featureIds );
+    void onLayerIndexed( int generation, const QString &layerId );
+    void flushPendingChanges();
+
+  private:
+    //! Returns the path of the local file backing the \a layer, empty for layers not backed by a file
+    static QString layerFilePath( QgsVectorLayer *layer );
+
+    //! Prepares a job for the worker thread, restricted to \a featureIds when not empty
+    std::shared_ptr<FeaturesSearchIndexJob> createJob( QgsVectorLayer *layer, const QgsFeatureIds &featureIds = QgsFeatureIds() ) const;
+
+    void indexLayer( QgsVectorLayer *layer );
+
+    QgsProject *mProject = nullptr;
+
+    QString mDatabasePath;
+    QSet<QString> mIndexedLayerIds;
+
+    QHash<QString, QgsFeatureIds> mPendingChanges;
+    QTimer mFlushTimer;
+
+    QThread mWorkerThread;
+    FeaturesSearchIndexWorker *mWorker = nullptr;
+    std::shared_ptr<std::atomic<int>> mGeneration;
+};
+
+#endif // FEATURESSEARCHINDEX_H
@@ -20,6 +20,7 @@
 #include "expressioncalculatorlocatorfilter.h"
 #include "featurelistextentcontroller.h"
 #include "featureslocatorfilter.h"
+#include "featuressearchindex.h"
 #include "finlandlocatorfilter.h"
 #include "gnsspositioninformation.h"
 #include "gotolocatorfilter.h"
@@ -169,6 +170,20 @@ void LocatorModelSuperBridge::setKeepScale( bool keepScale )
   emit keepScaleChanged();
 }
 
+FeaturesSearchIndex *LocatorModelSuperBridge::searchIndex() const
+{
+  return mSearchIndex;
+}
+
+void LocatorModelSuperBridge::setSearchIndex( FeaturesSearchIndex *searchIndex )
+{
+  if ( searchIndex == mSearchIndex )
+    return;
+
+  mSearchIndex = searchIndex;
+  emit searchIndexChanged();
+}
+
 void LocatorModelSuperBridge::requestSearch( const QString &text )
 {
   emit searchRequested( text );
@@ -26,6 +26,7 @@
 
 class QgsQuickMapSettings;
 class FeatureListExtentController;
+class FeaturesSearchIndex;
 class PeliasGeocoder;
 class GnssPositionInformation;
 class QFieldLocatorFilter;
@@ -74,6 +75,8 @@ class LocatorModelSuperBridge : public QgsLocatorModelBridge
     Q_PROPERTY( Navigation *navigation READ navigation WRITE setNavigation NOTIFY navigationChanged )
     //! The keep scale flag. When turned on, locator actions should not result in changed scale
     Q_PROPERTY( bool keepScale READ keepScale WRITE setKeepScale NOTIFY keepScaleChanged )
+    //! The full-text index of the current project's features used by the features locator filters
+    Q_PROPERTY( FeaturesSearchIndex *searchIndex READ searchIndex WRITE setSearchIndex NOTIFY searchIndexChanged )
 
   public:
     explicit LocatorModelSuperBridge( QObject *parent = nullptr );
@@ -114,6 +117,11 @@ class LocatorModelSuperBridge : public QgsLocatorModelBridge
     //! \copydoc LocatorModelSuperBridge::keepScale
     void setKeepScale( bool keepScale );
 
+    //! \copydoc LocatorModelSuperBridge::searchIndex
+    FeaturesSearchIndex *searchIndex() const;
+    //! \copydoc LocatorModelSuperBridge::searchIndex
+    void setSearchIndex( FeaturesSearchIndex *searchIndex );
+
     /**
      * Requests a \a text query against the search bar.
      */
@@ -163,6 +171,7 @@ class LocatorModelSuperBridge : public QgsLocatorModelBridge
     void activeLayerChanged();
     void messageEmitted( const QString &text );
     void keepScaleChanged();
+    void searchIndexChanged();
     void searchRequested( const QString &text );
     void searchTextChangeRequested( const QString &text );
     void locatorFiltersChanged();
@@ -176,6 +185,7 @@ class LocatorModelSuperBridge : public QgsLocatorModelBridge
     FeatureListExtentController *mFeatureListController = nullptr;
     QPointer<QgsMapLayer> mActiveLayer;
     bool mKeepScale = false;
+    FeaturesSearchIndex *mSearchIndex = nullptr;
 
     PeliasGeocoder *mFinlandGeocoder = nullptr;
     BookmarkModel *mBookmarks = nullptr;
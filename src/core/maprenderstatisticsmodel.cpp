@@ -0,0 +1,297 @@
+/***************************************************************************
+ maprenderstatisticsmodel.cpp
+ ---------------------
+ begin                : 18.10.2026
+ copyright            : (C) 2026 by OPENGIS.ch
+ email                : info at opengis dot ch
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "maprenderstatisticsmodel.h"
+#include "platformutilities.h"
+
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <qgsmessagelog.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+MapRenderStatisticsModel::MapRenderStatisticsModel( QObject *parent )
+  : QAbstractListModel( parent )
+{
+}
+
+QHash<int, QByteArray> MapRenderStatisticsModel::roleNames() const
+{
+  QHash<int, QByteArray> roles = QAbstractListModel::roleNames();
+  roles[LayerIdRole] = "LayerId";
+  roles[LayerNameRole] = "LayerName";
+  roles[LastRenderTimeRole] = "LastRenderTime";
+  roles[AverageRenderTimeRole] = "AverageRenderTime";
+  roles[MaximumRenderTimeRole] = "MaximumRenderTime";
+  roles[FeatureCountRole] = "FeatureCount";
+  roles[CacheHitRatioRole] = "CacheHitRatio";
+  roles[SampleCountRole] = "SampleCount";
+  return roles;
+}
+
+int MapRenderStatisticsModel::rowCount( const QModelIndex &parent ) const
+{
+  if ( parent.isValid() )
+    return 0;
+
+  return static_cast<int>( mLayers.size() );
+}
+
+QVariant MapRenderStatisticsModel::data( const QModelIndex &index, int role ) const
+{
+  if ( !index.isValid() || index.row() >= mLayers.size() )
+    return QVariant();
+
+  const LayerStatistics &layer = mLayers.at( index.row() );
+  switch ( role )
+  {
+    case LayerIdRole:
+      return layer.layerId;
+    case Qt::DisplayRole:
+    case LayerNameRole:
+      return layer.layerName;
+    case LastRenderTimeRole:
+      return layer.renderTimes.isEmpty() ? 0 : layer.renderTimes.last();
+    case AverageRenderTimeRole:
+      return layer.averageRenderTime();
+    case MaximumRenderTimeRole:
+      return layer.maximumRenderTime();
+    case FeatureCountRole:
+      return layer.featureCount;
+    case CacheHitRatioRole:
+      return layer.cacheHitRatio();
+    case SampleCountRole:
+      return static_cast<int>( layer.renderTimes.size() );
+  }
+
+  return QVariant();
+}
+
+void MapRenderStatisticsModel::setMapCanvas( QgsQuickMapCanvasMap *mapCanvas )
+{
+  if ( mMapCanvas == mapCanvas )
+    return;
+
+  if ( mMapCanvas )
+  {
+    disconnect( mMapCanvas, &QgsQuickMapCanvasMap::renderStatisticsCollected, this, &MapRenderStatisticsModel::onRenderStatisticsCollected );
+    mMapCanvas->setCollectRenderStatistics( false );
+  }
+
+  mMapCanvas = mapCanvas;
+
+  if ( mMapCanvas )
+  {
+    connect( mMapCanvas, &QgsQuickMapCanvasMap::renderStatisticsCollected, this, &MapRenderStatisticsModel::onRenderStatisticsCollected );
+  }
+
+  updateCollecting();
+  clear();
+
+  emit mapCanvasChanged();
+}
+
+void MapRenderStatisticsModel::setEnabled( bool enabled )
+{
+  if ( mEnabled == enabled )
+    return;
+
+  mEnabled = enabled;
+  updateCollecting();
+
+  emit enabledChanged();
+}
+
+void MapRenderStatisticsModel::setTraceEnabled( bool traceEnabled )
+{
+  if ( mTraceEnabled == traceEnabled )
+    return;
+
+  mTraceEnabled = traceEnabled;
+  updateCollecting();
+
+  emit traceEnabledChanged();
+}
+
+void MapRenderStatisticsModel::updateCollecting()
+{
+  if ( mMapCanvas )
+  {
+    mMapCanvas->setCollectRenderStatistics( mEnabled || mTraceEnabled );
+  }
+}
+
+void MapRenderStatisticsModel::clear()
+{
+  beginResetModel();
+  mLayers.clear();
+  mLastStatistics = QgsQuickMapCanvasMap::RenderStatistics();
+  mRenderCount = 0;
+  endResetModel();
+
+  emit statisticsChanged();
+}
+
+void MapRenderStatisticsModel::onRenderStatisticsCollected( const QgsQuickMapCanvasMap::RenderStatistics &statistics )
+{
+  if ( mTraceEnabled )
+  {
+    writeTrace( statistics );
+  }
+
+  if ( !mEnabled )
+    return;
+
+  beginResetModel();
+  for ( const QgsQuickMapCanvasMap::LayerRenderStatistics &layerStatistics : statistics.layers )
+  {
+    auto it = std::find_if( mLayers.begin(), mLayers.end(), [&layerStatistics]( const LayerStatistics &layer ) { return layer.layerId == layerStatistics.layerId; } );
+    if ( it == mLayers.end() )
+    {
+      LayerStatistics layer;
+      layer.layerId = layerStatistics.layerId;
+      it = mLayers.insert( mLayers.end(), layer );
+    }
+
+    it->layerName = layerStatistics.layerName;
+    it->renderTimes << layerStatistics.renderTime;
+    it->cacheHits << layerStatistics.cacheHit;
+    if ( it->renderTimes.size() > ROLLING_WINDOW_SIZE )
+    {
+      it->renderTimes.removeFirst();
+      it->cacheHits.removeFirst();
+    }
+    if ( layerStatistics.featureCount >= 0 )
+    {
+      it->featureCount = layerStatistics.featureCount;
+    }
+  }
+
+  std::stable_sort( mLayers.begin(), mLayers.end(), []( const LayerStatistics &a, const LayerStatistics &b ) { return a.averageRenderTime() > b.averageRenderTime(); } );
+  mLastStatistics = statistics;
+  mRenderCount++;
+  endResetModel();
+
+  emit statisticsChanged();
+
+  if ( statistics.renderTime >= SLOW_RENDER_THRESHOLD )
+  {
+    QList<QgsQuickMapCanvasMap::LayerRenderStatistics> layers = statistics.layers;
+    std::sort( layers.begin(), layers.end(), []( const QgsQuickMapCanvasMap::LayerRenderStatistics &a, const QgsQuickMapCanvasMap::LayerRenderStatistics &b ) { return a.renderTime > b.renderTime; } );
+    QStringList slowestLayers;
+    for ( int i = 0; i < std::min<int>( 3, layers.size() ); i++ )
+    {
+      slowestLayers << tr( "%1 (%2 ms)" ).arg( layers.at( i ).layerName ).arg( layers.at( i ).renderTime );
+    }
+    QgsMessageLog::logMessage( tr( "Slow map rendering: %1 ms, slowest layers: %2" ).arg( statistics.renderTime ).arg( slowestLayers.join( QStringLiteral( ", " ) ) ), QStringLiteral( "QField" ) );
+  }
+}
+
+void MapRenderStatisticsModel::logStatistics() const
+{
+  QStringList lines;
+  lines << tr( "Map rendering statistics over %n render(s): last render %1 ms (preparation %2 ms, labeling %3 ms)", "", mRenderCount ).arg( mLastStatistics.renderTime ).arg( mLastStatistics.preparationTime ).arg( mLastStatistics.labelingTime );
+  for ( const LayerStatistics &layer : mLayers )
+  {
+    QString line = tr( "%1: average %2 ms, maximum %3 ms, cache hits %4%" ).arg( layer.layerName ).arg( layer.averageRenderTime() ).arg( layer.maximumRenderTime() ).arg( std::round( layer.cacheHitRatio() * 100 ) );
+    if ( layer.featureCount >= 0 )
+    {
+      line += tr( ", %n feature(s)", "", static_cast<int>( layer.featureCount ) );
+    }
+    lines << line;
+  }
+  QgsMessageLog::logMessage( lines.join( QLatin1Char( '\n' ) ), QStringLiteral( "QField" ) );
+}
+
+void MapRenderStatisticsModel::writeTrace( const QgsQuickMapCanvasMap::RenderStatistics &statistics )
+{
+  if ( !mTraceFile.isOpen() )
+  {
+    const QString traceDirectory = PlatformUtilities::instance()->systemLocalDataLocation( QStringLiteral( "render_traces" ) );
+    QDir().mkpath( traceDirectory );
+    mTraceFile.setFileName( QStringLiteral( "%1/render_trace_%2.json" ).arg( traceDirectory, QDateTime::currentDateTime().toString( QStringLiteral( "yyyyMMdd_hhmmss" ) ) ) );
+    if ( !mTraceFile.open( QIODevice::WriteOnly | QIODevice::Text ) )
+    {
+      QgsMessageLog::logMessage( tr( "Could not open render trace file %1" ).arg( mTraceFile.fileName() ), QStringLiteral( "QField" ) );
+      mTraceEnabled = false;
+      emit traceEnabledChanged();
+      return;
+    }
+    // The trace viewers accept an unterminated array, allowing for events to be appended until the session ends
+    mTraceFile.write( "[\n" );
+    emit traceFilePathChanged();
+  }
+
+  auto writeEvent = [this]( const QString &name, const QString &category, qint64 timestamp, qint64 duration, int thread, const QJsonObject &args ) {
+    QJsonObject event;
+    event.insert( QStringLiteral( "name" ), name );
+    event.insert( QStringLiteral( "cat" ), category );
+    event.insert( QStringLiteral( "ph" ), QStringLiteral( "X" ) );
+    event.insert( QStringLiteral( "ts" ), timestamp );
+    event.insert( QStringLiteral( "dur" ), duration );
+    event.insert( QStringLiteral( "pid" ), 1 );
+    event.insert( QStringLiteral( "tid" ), thread );
+    event.insert( QStringLiteral( "args" ), args );
+    mTraceFile.write( QJsonDocument( event ).toJson( QJsonDocument::Compact ) );
+    mTraceFile.write( ",\n" );
+  };
+
+  // Trace event timestamps and durations are expressed in microseconds
+  const qint64 start = statistics.startTime.toMSecsSinceEpoch() * 1000;
+  writeEvent( statistics.tiled ? QStringLiteral( "Render tiles" ) : QStringLiteral( "Render" ), QStringLiteral( "job" ), start, statistics.renderTime * 1000LL, 0, QJsonObject( { { QStringLiteral( "preparation" ), statistics.preparationTime }, { QStringLiteral( "labeling" ), statistics.labelingTime } } ) );
+  writeEvent( QStringLiteral( "Preparation" ), QStringLiteral( "job" ), start, statistics.preparationTime * 1000LL, 1, QJsonObject() );
+
+  // Layers are rendered in parallel once prepared, each gets its own track
+  const qint64 layersStart = start + statistics.preparationTime * 1000LL;
+  int thread = 2;
+  for ( const QgsQuickMapCanvasMap::LayerRenderStatistics &layer : statistics.layers )
+  {
+    writeEvent( layer.layerName, QStringLiteral( "layer" ), layersStart, layer.renderTime * 1000LL, thread++, QJsonObject( { { QStringLiteral( "layerId" ), layer.layerId }, { QStringLiteral( "features" ), layer.featureCount }, { QStringLiteral( "cacheHit" ), layer.cacheHit } } ) );
+  }
+
+  if ( statistics.labelingTime > 0 )
+  {
+    writeEvent( QStringLiteral( "Labeling" ), QStringLiteral( "job" ), start + ( statistics.renderTime - statistics.labelingTime ) * 1000LL, statistics.labelingTime * 1000LL, 1, QJsonObject() );
+  }
+
+  mTraceFile.flush();
+}
+
+int MapRenderStatisticsModel::LayerStatistics::averageRenderTime() const
+{
+  if ( renderTimes.isEmpty() )
+    return 0;
+
+  return static_cast<int>( std::accumulate( renderTimes.constBegin(), renderTimes.constEnd(), 0LL ) / renderTimes.size() );
+}
+
+int MapRenderStatisticsModel::LayerStatistics::maximumRenderTime() const
+{
+  if ( renderTimes.isEmpty() )
+    return 0;
+
+  return *std::max_element( renderTimes.constBegin(), renderTimes.constEnd() );
+}
+
+double MapRenderStatisticsModel::LayerStatistics::cacheHitRatio() const
+{
+  if ( cacheHits.isEmpty() )
+    return 0.0;
+
+  return static_cast<double>( cacheHits.count( true ) ) / cacheHits.size();
+}
@@ -0,0 +1,150 @@
+/***************************************************************************
+ maprenderstatisticsmodel.h
+ ---------------------
+ begin                : 18.10.2026
+ copyright            : (C) 2026 by OPENGIS.ch
+ email                : info at opengis dot ch
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+#ifndef MAPRENDERSTATISTICSMODEL_H
+#define MAPRENDERSTATISTICSMODEL_H
+
+#include "qgsquickmapcanvasmap.h"
+
+#include <QAbstractListModel>
+#include <QFile>
+#include <QPointer>
+
+/**
+ * \brief A model exposing per-layer rendering statistics of a map canvas.
+ *
+ * The model keeps a rolling window of the most recent render jobs of each layer and
+ * exposes the last, average, and maximum render times alongside the rendered feature
+ * counts and cache hit ratios. Layers are sorted from the most to the least expensive.
+ *
+ * When tracing is enabled, every render job is also appended to a trace file in the
+ * Chrome trace event format, which can be opened with chrome://tracing or Perfetto.
+ * A single trace file is written per session.
+ *
+ * \ingroup core
+ */
+class MapRenderStatisticsModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY( QgsQuickMapCanvasMap *mapCanvas READ mapCanvas WRITE setMapCanvas NOTIFY mapCanvasChanged )
+    Q_PROPERTY( bool enabled READ enabled WRITE setEnabled NOTIFY enabledChanged )
+    Q_PROPERTY( bool traceEnabled READ traceEnabled WRITE setTraceEnabled NOTIFY traceEnabledChanged )
+    Q_PROPERTY( QString traceFilePath READ traceFilePath NOTIFY traceFilePathChanged )
+    Q_PROPERTY( int renderCount READ renderCount NOTIFY statisticsChanged )
+    Q_PROPERTY( int lastPreparationTime READ lastPreparationTime NOTIFY statisticsChanged )
+    Q_PROPERTY( int lastRenderTime READ lastRenderTime NOTIFY statisticsChanged )
+    Q_PROPERTY( int lastLabelingTime READ lastLabelingTime NOTIFY statisticsChanged )
+
+  public:
+    enum Roles
+    {
+      LayerIdRole = Qt::UserRole + 1,
+      LayerNameRole,
+      LastRenderTimeRole,
+      AverageRenderTimeRole,
+      MaximumRenderTimeRole,
+      FeatureCountRole,
+      CacheHitRatioRole,
+      SampleCountRole,
+    };
+    Q_ENUM( Roles )
+
+    explicit MapRenderStatisticsModel( QObject *parent = nullptr );
+
+    QHash<int, QByteArray> roleNames() const override;
+    int rowCount( const QModelIndex &parent = QModelIndex() ) const override;
+    QVariant data( const QModelIndex &index, int role ) const override;
+
+    //! Returns the map canvas from which statistics are collected
+    QgsQuickMapCanvasMap *mapCanvas() const { return mMapCanvas; }
+
+    //! Sets the map canvas from which statistics are collected
+    void setMapCanvas( QgsQuickMapCanvasMap *mapCanvas );
+
+    //! Returns TRUE when statistics are collected
+    bool enabled() const { return mEnabled; }
+
+    //! Sets whether statistics are collected
+    void setEnabled( bool enabled );
+
+    //! Returns TRUE when render jobs are written to a trace file
+    bool traceEnabled() const { return mTraceEnabled; }
+
+    //! Sets whether render jobs are written to a trace file
+    void setTraceEnabled( bool traceEnabled );
+
+    //! Returns the path of the trace file for the current session, empty until a render job has been traced
+    QString traceFilePath() const { return mTraceFile.fileName(); }
+
+    //! Returns the number of render jobs collected since the model was last cleared
+    int renderCount() const { return mRenderCount; }
+
+    //! Returns the time spent preparing the last render job in milliseconds
+    int lastPreparationTime() const { return mLastStatistics.preparationTime; }
+
+    //! Returns the total time spent by the last render job in milliseconds
+    int lastRenderTime() const { return mLastStatistics.renderTime; }
+
+    //! Returns the time spent labeling during the last render job in milliseconds
+    int lastLabelingTime() const { return mLastStatistics.labelingTime; }
+
+    //! Clears the collected statistics
+    Q_INVOKABLE void clear();
+
+    //! Writes a summary of the collected statistics to the message log
+    Q_INVOKABLE void logStatistics() const;
+
+  signals:
+    void mapCanvasChanged();
+    void enabledChanged();
+    void traceEnabledChanged();
+    void traceFilePathChanged();
+    void statisticsChanged();
+
+  private slots:
+    void onRenderStatisticsCollected( const QgsQuickMapCanvasMap::RenderStatistics &statistics );
+
+  private:
+    struct LayerStatistics
+    {
+        QString layerId;
+        QString layerName;
+        QList<int> renderTimes;
+        QList<bool> cacheHits;
+        long long featureCount = -1;
+
+        int averageRenderTime() const;
+        int maximumRenderTime() const;
+        double cacheHitRatio() const;
+    };
+
+    void updateCollecting();
+    void writeTrace( const QgsQuickMapCanvasMap::RenderStatistics &statistics );
+
+    static constexpr int ROLLING_WINDOW_SIZE = 20;
+    static constexpr int SLOW_RENDER_THRESHOLD = 2000; // in milliseconds
+
+    QPointer<QgsQuickMapCanvasMap> mMapCanvas;
+    bool mEnabled = false;
+    bool mTraceEnabled = false;
+
+    QList<LayerStatistics> mLayers;
+    QgsQuickMapCanvasMap::RenderStatistics mLastStatistics;
+    int mRenderCount = 0;
+
+    QFile mTraceFile;
+};
+
+#endif // MAPRENDERSTATISTICSMODEL_H
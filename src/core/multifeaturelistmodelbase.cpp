@@ -76,24 +76,15 @@ void MultiFeatureListModelBase::setFeatures( const QMap<QgsVectorLayer *, QgsFea
 
 void MultiFeatureListModelBase::appendFeatures( const QList<IdentifyTool::IdentifyResult> &results )
 {
-  beginInsertRows( QModelIndex(), static_cast<int>( mFeatures.count() ), static_cast<int>( mFeatures.count() + results.count() ) - 1 );
-
+  QList<QPair<QgsVectorLayer *, QgsFeature>> items;
   for ( const IdentifyTool::IdentifyResult &result : results )
   {
     QgsVectorLayer *layer = qobject_cast<QgsVectorLayer *>( result.layer );
     QPair<QgsVectorLayer *, QgsFeature> item( layer, result.feature );
     if ( !mFeatures.contains( item ) )
     {
-      mFeatures.append( item );
-      connect( layer, &QObject::destroyed, this, &MultiFeatureListModelBase::layerDeleted, Qt::UniqueConnection );
-      connect( layer, &QgsVectorLayer::featureDeleted, this, &MultiFeatureListModelBase::featureDeleted, Qt::UniqueConnection );
-      connect( layer, &QgsVectorLayer::attributeValueChanged, this, &MultiFeatureListModelBase::attributeValueChanged, Qt::UniqueConnection );
-      connect( layer, &QgsVectorLayer::geometryChanged, this, &MultiFeatureListModelBase::geometryChanged, Qt::UniqueConnection );
-
-      if ( !mSelectedFeatures.isEmpty() )
-      {
-        mSelectedFeatures.append( item );
-      }
+      if ( !items.contains( item ) )
+        items.append( item );
     }
     else if ( mSelectedFeatures.size() > 1 && mSelectedFeatures.contains( item ) )
     {
@@ -104,7 +95,27 @@ void MultiFeatureListModelBase::appendFeatures( const QList<IdentifyTool::Identi
       emit dataChanged( index, index, QVector<int>() << MultiFeatureListModel::FeatureSelectedRole );
     }
   }
+
+  if ( items.isEmpty() )
+    return;
+
+  beginInsertRows( QModelIndex(), static_cast<int>( mFeatures.count() ), static_cast<int>( mFeatures.count() + items.count() ) - 1 );
+  for ( const QPair<QgsVectorLayer *, QgsFeature> &item : std::as_const( items ) )
+  {
+    QgsVectorLayer *layer = item.first;
+    mFeatures.append( item );
+    connect( layer, &QObject::destroyed, this, &MultiFeatureListModelBase::layerDeleted, Qt::UniqueConnection );
+    connect( layer, &QgsVectorLayer::featureDeleted, this, &MultiFeatureListModelBase::featureDeleted, Qt::UniqueConnection );
+    connect( layer, &QgsVectorLayer::attributeValueChanged, this, &MultiFeatureListModelBase::attributeValueChanged, Qt::UniqueConnection );
+    connect( layer, &QgsVectorLayer::geometryChanged, this, &MultiFeatureListModelBase::geometryChanged, Qt::UniqueConnection );
+
+    if ( !mSelectedFeatures.isEmpty() )
+    {
+      mSelectedFeatures.append( item );
+    }
+  }
   endInsertRows();
+  emit countChanged();
 
   if ( !mSelectedFeatures.isEmpty() )
   {
@@ -229,9 +229,7 @@ bool OrderedRelationModel::beforeDeleteFeature( QgsVectorLayer *referencingLayer
   return true;
 }
 
-void OrderedRelationModel::sortEntries()
+bool OrderedRelationModel::entryLessThan( const Entry &e1, const Entry &e2 ) const
 {
-  std::sort( mEntries.begin(), mEntries.end(), [=]( const Entry &e1, const Entry &e2 ) {
-    return e1.referencingFeature.attribute( mOrderingField ).toInt() < e2.referencingFeature.attribute( mOrderingField ).toInt();
-  } );
+  return e1.referencingFeature.attribute( mOrderingField ).toInt() < e2.referencingFeature.attribute( mOrderingField ).toInt();
 }
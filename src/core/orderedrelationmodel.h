@@ -66,7 +66,7 @@ class OrderedRelationModel : public ReferencingFeatureListModel
 
   private:
     bool beforeDeleteFeature( QgsVectorLayer *referencingLayer, QgsFeatureId referencingFeatureId ) override;
-    void sortEntries() override;
+    bool entryLessThan( const Entry &e1, const Entry &e2 ) const override;
 
     QString mOrderingField;
     QString mImagePath;
@@ -32,6 +32,7 @@ void Geofencer::cleanupGatherer()
 {
   if ( mGatherer )
   {
+    disconnect( mGatherer, &FeatureExpressionValuesGatherer::entriesGathered, this, &Geofencer::processGatheredAreas );
     disconnect( mGatherer, &QThread::finished, this, &Geofencer::processAreas );
     connect( mGatherer, &QThread::finished, mGatherer, &QObject::deleteLater );
     mGatherer->stop();
@@ -57,19 +58,30 @@ void Geofencer::gatherAreas()
 
   cleanupGatherer();
 
+  mGatheredAreas.clear();
   mGatherer = new FeatureExpressionValuesGatherer( mAreasLayer, mAreasLayer->displayExpression(), request );
+  mGatherer->setKeepGeometry( true );
+  connect( mGatherer, &FeatureExpressionValuesGatherer::entriesGathered, this, &Geofencer::processGatheredAreas );
   connect( mGatherer, &QThread::finished, this, &Geofencer::processAreas );
   mGatherer->start();
 }
 
+void Geofencer::processGatheredAreas( const QVector<FeatureExpressionValuesGatherer::Entry> &entries )
+{
+  if ( !mGatherer || sender() != mGatherer )
+    return;
+
+  mGatheredAreas << entries;
+}
+
 void Geofencer::processAreas()
 {
   if ( !mGatherer )
     return;
 
-  mAreas.clear();
-
-  mAreas = mGatherer->entries();
+  // Areas are only swapped once complete, a partial set would trigger spurious outside alerts
+  mAreas = std::move( mGatheredAreas );
+  mGatheredAreas.clear();
   mGatherer->deleteLater();
   mGatherer = nullptr;
 
@@ -89,7 +101,7 @@ void Geofencer::checkWithin()
     geometryEngine.reset( QgsGeometry::createGeometryEngine( &mPosition ) );
     for ( int i = 0; i < mAreas.size(); i++ )
     {
-      if ( geometryEngine->within( mAreas.at( i ).feature.geometry().get() ) )
+      if ( geometryEngine->within( mAreas.at( i ).geometry.constGet() ) )
       {
         isWithinIndex = i;
         break;
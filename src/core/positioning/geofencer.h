@@ -155,6 +155,7 @@ class Geofencer : public QObject
   private:
     void cleanupGatherer();
     void gatherAreas();
+    void processGatheredAreas( const QVector<FeatureExpressionValuesGatherer::Entry> &entries );
     void processAreas();
 
     void checkWithin();
@@ -167,7 +168,8 @@ class Geofencer : public QObject
     QgsCoordinateReferenceSystem mPositionCrs;
 
     QPointer<QgsVectorLayer> mAreasLayer;
-    QList<FeatureExpressionValuesGatherer::Entry> mAreas;
+    QVector<FeatureExpressionValuesGatherer::Entry> mAreas;
+    QVector<FeatureExpressionValuesGatherer::Entry> mGatheredAreas;
 
     bool mIsAlerting = false;
 
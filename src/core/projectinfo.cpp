@@ -16,6 +16,7 @@
 
 
 #include "expressioncontextutils.h"
+#include "profilerutils.h"
 #include "projectinfo.h"
 
 #include <QDateTime>
@@ -28,6 +29,7 @@
 #include <qgslinesymbol.h>
 #include <qgsmaplayerstyle.h>
 #include <qgsmarkersymbol.h>
+#include <qgsruntimeprofiler.h>
 #include <qgssymbollayerutils.h>
 
 ProjectInfo::ProjectInfo( QObject *parent )
@@ -361,6 +363,18 @@ void ProjectInfo::saveLayerSnappingConfiguration( QgsMapLayer *layer )
   mSettings.endGroup();
 }
 
+//! Sets the \a rememberedFields, a map of field names to whether their value is remembered, on the \a layer form configuration
+static void applyRememberedFields( QgsVectorLayer *layer, const QVariantMap &rememberedFields )
+{
+  QgsEditFormConfig config = layer->editFormConfig();
+  const QStringList fieldNames = rememberedFields.keys();
+  for ( const QString &fieldName : fieldNames )
+  {
+    config.setReuseLastValue( layer->fields().indexFromName( fieldName ), rememberedFields[fieldName].toBool() );
+  }
+  layer->setEditFormConfig( config );
+}
+
 void ProjectInfo::saveLayerRememberedFields( QgsMapLayer *layer )
 {
   if ( mFilePath.isEmpty() )
@@ -459,6 +473,7 @@ void ProjectInfo::saveVariable( const QString &name, const QString &value )
 void ProjectInfo::restoreSettings( QString &projectFilePath, QgsProject *project, QgsQuickMapCanvasMap *mapCanvas, FlatLayerTreeModel *layerTree )
 {
   QSettings settings;
+  QgsScopedRuntimeProfile profile( tr( "Map settings" ), ProfilerUtils::projectOpenGroup() );
 
   const double rotation = settings.value( QStringLiteral( "qgis/projectInfo/%1/rotation" ).arg( projectFilePath ), mapCanvas->mapSettings()->rotation() ).toDouble();
   mapCanvas->mapSettings()->setRotation( rotation );
@@ -473,6 +488,7 @@ void ProjectInfo::restoreSettings( QString &projectFilePath, QgsProject *project
     mapCanvas->mapSettings()->setIsTemporal( isTemporal );
   }
 
+  profile.switchTask( tr( "Layer styles" ) );
   settings.beginGroup( QStringLiteral( "/qgis/projectInfo/%1/layerStyles" ).arg( projectFilePath ) );
   QStringList ids = settings.childGroups();
   if ( !ids.isEmpty() )
@@ -521,6 +537,7 @@ void ProjectInfo::restoreSettings( QString &projectFilePath, QgsProject *project
   settings.endGroup();
 
 
+  profile.switchTask( tr( "Remembered fields" ) );
   settings.beginGroup( QStringLiteral( "/qgis/projectInfo/%1/layerFields" ).arg( projectFilePath ) );
   ids = settings.childGroups();
   if ( !ids.isEmpty() )
@@ -554,18 +571,13 @@ void ProjectInfo::restoreSettings( QString &projectFilePath, QgsProject *project
 
       if ( QgsVectorLayer *vlayer = qobject_cast<QgsVectorLayer *>( layer ) )
       {
-        QgsEditFormConfig config = vlayer->editFormConfig();
-        const QStringList fieldNames = rememberedFields.keys();
-        for ( const QString fieldName : fieldNames )
-        {
-          config.setReuseLastValue( vlayer->fields().indexFromName( fieldName ), rememberedFields[fieldName].toBool() );
-        }
-        vlayer->setEditFormConfig( config );
+        applyRememberedFields( vlayer, rememberedFields );
       }
     }
   }
   settings.endGroup();
 
+  profile.switchTask( tr( "Layer tree state" ) );
   const QString mapTheme = settings.value( QStringLiteral( "/qgis/projectInfo/%1/maptheme" ).arg( projectFilePath ), QString() ).toString();
   const QString layerTreeState = settings.value( QStringLiteral( "/qgis/projectInfo/%1/layertreestate" ).arg( projectFilePath ), QString() ).toString();
   if ( !mapTheme.isEmpty() )
@@ -582,6 +594,7 @@ void ProjectInfo::restoreSettings( QString &projectFilePath, QgsProject *project
     mapCollection.applyTheme( QStringLiteral( "::QFieldLayerTreeState" ), layerTree->layerTreeModel()->rootGroup(), layerTree->layerTreeModel() );
   }
 
+  profile.switchTask( tr( "Snapping" ) );
   settings.beginGroup( QStringLiteral( "/qgis/projectInfo/%1/layerSnapping" ).arg( projectFilePath ) );
   const QStringList values = settings.allKeys();
   if ( !values.isEmpty() )
@@ -637,6 +650,7 @@ void ProjectInfo::restoreSettings( QString &projectFilePath, QgsProject *project
   }
   settings.endGroup();
 
+  profile.switchTask( tr( "Variables" ) );
   settings.beginGroup( QStringLiteral( "/qgis/projectInfo/%1/variables" ).arg( projectFilePath ) );
   const QStringList variableNames = settings.allKeys();
   for ( const QString &name : variableNames )
@@ -645,6 +659,17 @@ void ProjectInfo::restoreSettings( QString &projectFilePath, QgsProject *project
   }
 }
 
+void ProjectInfo::restoreLayerRememberedFields( const QString &projectFilePath, QgsVectorLayer *layer )
+{
+  if ( projectFilePath.isEmpty() || !layer )
+    return;
+
+  QSettings settings;
+  const QVariant rememberedFields = settings.value( QStringLiteral( "/qgis/projectInfo/%1/layerFields/::%2/remembered" ).arg( projectFilePath, layer->id() ) );
+  if ( rememberedFields.isValid() )
+    applyRememberedFields( layer, rememberedFields.toMap() );
+}
+
 QVariantMap ProjectInfo::getTitleDecorationConfiguration()
 {
   QVariantMap configuration;
@@ -186,6 +186,12 @@ class ProjectInfo : public QObject
     //! Restore various project settings
     static void restoreSettings( QString &projectFilePath, QgsProject *project, QgsQuickMapCanvasMap *mapCanvas, FlatLayerTreeModel *layerTree );
 
+    /**
+     * Restores the remembered fields of the vector \a layer saved for the \a projectFilePath project.
+     * This is needed for layers whose fields were unknown when the project settings got restored.
+     */
+    static void restoreLayerRememberedFields( const QString &projectFilePath, QgsVectorLayer *layer );
+
     //! Retrieves configuration of the title decoration
     Q_INVOKABLE QVariantMap getTitleDecorationConfiguration();
 
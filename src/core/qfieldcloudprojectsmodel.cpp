@@ -21,14 +21,17 @@
 #include "qfieldcloudprojectsmodel.h"
 #include "qfieldcloudutils.h"
 
+#include <QCryptographicHash>
 #include <QDir>
 #include <QDirIterator>
+#include <QFileInfo>
+#include <QFutureWatcher>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QNetworkReply>
 #include <QSettings>
-#include <QTemporaryFile>
+#include <QtConcurrent>
 #include <qgis.h>
 #include <qgsapplication.h>
 #include <qgsmessagelog.h>
@@ -40,11 +43,52 @@
 
 #define MAX_REDIRECTS_ALLOWED 10
 #define MAX_PARALLEL_REQUESTS 6
+#define MAX_PARALLEL_DOWNLOADS_LIMIT 16
+#define MAX_DOWNLOAD_RETRIES 3
+#define DOWNLOAD_RETRY_DELAY_MS 1000
+#define DOWNLOAD_ETA_MIN_ELAPSED_MS 2000
 #define CACHE_PROJECT_DATA_SECS 1
 
+//! Returns whether a file download failing with \a error is worth trying again
+static bool isTransientDownloadError( QNetworkReply::NetworkError error )
+{
+  switch ( error )
+  {
+    case QNetworkReply::ConnectionRefusedError:
+    case QNetworkReply::RemoteHostClosedError:
+    case QNetworkReply::HostNotFoundError:
+    case QNetworkReply::TimeoutError:
+    case QNetworkReply::TemporaryNetworkFailureError:
+    case QNetworkReply::NetworkSessionFailedError:
+    case QNetworkReply::UnknownNetworkError:
+    case QNetworkReply::ProxyTimeoutError:
+    case QNetworkReply::InternalServerError:
+    case QNetworkReply::ServiceUnavailableError:
+    case QNetworkReply::UnknownServerError:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+//! Sets the headers requesting the content of a file with \a etag from \a offset on
+static void setDownloadRangeHeaders( QNetworkRequest &request, long long offset, const QString &etag )
+{
+  if ( offset <= 0 )
+    return;
+
+  request.setRawHeader( "Range", QStringLiteral( "bytes=%1-" ).arg( offset ).toLatin1() );
+  // a file changed in the meantime is sent in full instead of a range which does not fit the partial download
+  if ( !etag.isEmpty() )
+    request.setRawHeader( "If-Range", QStringLiteral( "\"%1\"" ).arg( etag ).toLatin1() );
+}
+
 QFieldCloudProjectsModel::QFieldCloudProjectsModel()
   : mProject( QgsProject::instance() )
 {
+  mMaximumParallelDownloads = std::clamp( QSettings().value( QStringLiteral( "QFieldCloud/maximumParallelDownloads" ), MAX_PARALLEL_REQUESTS ).toInt(), 1, MAX_PARALLEL_DOWNLOADS_LIMIT );
+
   loadProjects();
 
   // TODO all of these connects are a bit too much, and I guess not very precise, should be refactored!
@@ -308,6 +352,8 @@ void QFieldCloudProjectsModel::removeLocalProject( const QString &projectId )
     dir.removeRecursively();
   }
 
+  QDir( partialDownloadDir( projectId ) ).removeRecursively();
+
   QSettings().remove( QStringLiteral( "QFieldCloud/projects/%1" ).arg( projectId ) );
 }
 
@@ -779,6 +825,7 @@ void QFieldCloudProjectsModel::projectPackageAndDownload( const QString &project
   project->downloadFilesFailed = 0;
   project->downloadBytesTotal = 0;
   project->downloadBytesReceived = 0;
+  project->downloadBytesResumed = 0;
   project->downloadProgress = 0;
   project->status = ProjectStatus::Downloading;
   project->errorStatus = NoErrorStatus;
@@ -937,10 +984,13 @@ void QFieldCloudProjectsModel::projectPackageAndDownload( const QString &project
       {
         project->downloadFileTransfers[fileNameKey].networkReply->abort();
       }
-      project->downloadFileTransfers[fileNameKey].networkReply->deleteLater();
+
+      if ( project->downloadFileTransfers[fileNameKey].networkReply )
+        project->downloadFileTransfers[fileNameKey].networkReply->deleteLater();
     }
 
-    mActiveProjectFilesToDownload.clear();
+    project->downloadFilesQueued.clear();
+    project->downloadFilesActive.clear();
 
     const bool hasError = !errorString.isNull();
 
@@ -1034,7 +1084,7 @@ void QFieldCloudProjectsModel::projectDownload( const QString &projectId )
     for ( const QJsonValue &fileValue : files )
     {
       const QJsonObject fileObject = fileValue.toObject();
-      const int fileSize = fileObject.value( QStringLiteral( "size" ) ).toInt();
+      const long long fileSize = fileObject.value( QStringLiteral( "size" ) ).toInteger();
       const QString fileName = fileObject.value( QStringLiteral( "name" ) ).toString();
       const QString projectFileName = QStringLiteral( "%1/%2/%3/%4" ).arg( QFieldCloudUtils::localCloudDirectory(), mUsername, projectId, fileName );
       // NOTE the cloud API is giving the false impression that the file keys `md5sum` is having a MD5 or another checksum.
@@ -1055,11 +1105,37 @@ void QFieldCloudProjectsModel::projectDownload( const QString &projectId )
       if ( cloudEtag == localEtag )
         continue;
 
-      project->downloadFileTransfers.insert( fileName, FileTransfer( fileName, fileSize ) );
-      project->downloadBytesTotal += std::max( fileSize, 0 );
+      FileTransfer transfer( fileName, fileSize, cloudEtag );
+      // the partial download is specific to the file content, a new version never resumes from an older one
+      const QByteArray partialKey = QCryptographicHash::hash( QStringLiteral( "%1|%2" ).arg( fileName, cloudEtag ).toUtf8(), QCryptographicHash::Sha1 ).toHex();
+      transfer.tmpFile = QStringLiteral( "%1/%2.part" ).arg( partialDownloadDir( projectId ), QString( partialKey ) );
+
+      project->downloadFileTransfers.insert( fileName, transfer );
+      project->downloadBytesTotal += std::max( fileSize, 0LL );
     }
 
-    emit dataChanged( projectIndex, projectIndex, QVector<int>() << DownloadSizeRole );
+    // partial downloads of files which got updated or removed from the package can not be resumed anymore
+    QStringList partialFileNames;
+    for ( const FileTransfer &transfer : std::as_const( project->downloadFileTransfers ) )
+      partialFileNames << QFileInfo( transfer.tmpFile ).fileName();
+
+    const QFileInfoList partialFiles = QDir( partialDownloadDir( projectId ) ).entryInfoList( QDir::Files );
+    for ( const QFileInfo &partialFile : partialFiles )
+    {
+      if ( !partialFileNames.contains( partialFile.fileName() ) )
+        QFile::remove( partialFile.absoluteFilePath() );
+    }
+
+    QMap<QString, long long> fileSizes;
+    for ( const FileTransfer &transfer : std::as_const( project->downloadFileTransfers ) )
+      fileSizes.insert( transfer.fileName, transfer.bytesTotal );
+
+    project->downloadFilesQueued = downloadOrder( fileSizes );
+    project->downloadFilesActive.clear();
+    project->downloadEta = -1;
+    project->downloadTimer.start();
+
+    emit dataChanged( projectIndex, projectIndex, QVector<int>() << DownloadSizeRole << DownloadEtaRole );
 
     const QJsonObject layers = payload.value( QStringLiteral( "layers" ) ).toObject();
     bool hasLayerExportErrror = false;
@@ -1120,46 +1196,20 @@ void QFieldCloudProjectsModel::updateActiveProjectFilesToDownload( const QString
   if ( !project )
     return;
 
-  const QStringList fileNames = project->downloadFileTransfers.keys();
-
-  if ( fileNames.isEmpty() )
+  // transfers completed without a reply, such as verified partial downloads, release their slot too
+  QSet<QString> finishedFileNames;
+  for ( const QString &fileName : std::as_const( project->downloadFilesActive ) )
   {
-    mActiveProjectFilesToDownload.clear();
-    return;
+    const FileTransfer &transfer = project->downloadFileTransfers[fileName];
+    if ( transfer.isFinished || ( transfer.networkReply && transfer.networkReply->isFinished() ) )
+      finishedFileNames << fileName;
   }
 
-  for ( const QString &fileName : fileNames )
-  {
-    if ( project->downloadFileTransfers[fileName].networkReply )
-    {
-      if ( project->downloadFileTransfers[fileName].networkReply->isFinished() )
-      {
-        if ( mActiveProjectFilesToDownload.removeOne( fileName ) )
-        {
-          // QgsLogger::debug( QStringLiteral( "Project %1, file `%2`: removed from the list of active download files" ).arg( projectId, fileName ) );
-        }
-        continue;
-      }
-      else
-      {
-        // the request is still active
-        continue;
-      }
-    }
-
-    if ( mActiveProjectFilesToDownload.size() >= MAX_PARALLEL_REQUESTS )
-    {
-      return;
-    }
-
-    // QgsLogger::debug( QStringLiteral( "Project %1, file `%2`: appended to the active download files list" ).arg( projectId, fileName ) );
-
-    mActiveProjectFilesToDownload.append( fileName );
-  }
+  updateActiveDownloads( project->downloadFilesActive, project->downloadFilesQueued, finishedFileNames, mMaximumParallelDownloads );
 
-  if ( mActiveProjectFilesToDownload.count() > 0 )
+  if ( project->downloadFilesActive.count() > 0 )
   {
-    QgsLogger::debug( QStringLiteral( "Project %1: active download files list contains %2 files, namely: %3" ).arg( projectId ).arg( mActiveProjectFilesToDownload.count() ).arg( mActiveProjectFilesToDownload.join( ", " ) ) );
+    QgsLogger::debug( QStringLiteral( "Project %1: active download files list contains %2 files, namely: %3" ).arg( projectId ).arg( project->downloadFilesActive.count() ).arg( project->downloadFilesActive.join( ", " ) ) );
   }
   else
   {
@@ -1181,7 +1231,7 @@ void QFieldCloudProjectsModel::projectDownloadFiles( const QString &projectId )
   CloudProject *project = findProject( projectId );
 
   // Don't call download project files, if there are no project files
-  if ( mActiveProjectFilesToDownload.isEmpty() )
+  if ( project->downloadFileTransfers.isEmpty() )
   {
     project->status = ProjectStatus::Idle;
     project->downloadProgress = 1;
@@ -1191,35 +1241,204 @@ void QFieldCloudProjectsModel::projectDownloadFiles( const QString &projectId )
     return;
   }
 
-  QgsLogger::debug( QStringLiteral( "Project %1: active download files list before actual download: %2" ).arg( projectId, mActiveProjectFilesToDownload.join( ", " ) ) );
+  QgsLogger::debug( QStringLiteral( "Project %1: active download files list before actual download: %2" ).arg( projectId, project->downloadFilesActive.join( ", " ) ) );
 
-  for ( const QString &fileName : std::as_const( mActiveProjectFilesToDownload ) )
+  const QStringList activeFileNames = project->downloadFilesActive;
+  for ( const QString &fileName : activeFileNames )
   {
-    if ( project->downloadFileTransfers[fileName].networkReply )
+    if ( project->downloadFileTransfers[fileName].networkReply || project->downloadFileTransfers[fileName].isPreparing || project->downloadFileTransfers[fileName].isFinished )
     {
-      // Download is already in progress
+      // Download is already in progress or done
       continue;
     }
 
-    NetworkReply *reply = downloadFile( projectId, fileName );
-    QTemporaryFile *file = new QTemporaryFile( reply );
+    startFileDownload( projectId, fileName );
+  }
+}
 
-    file->setAutoRemove( false );
+QFieldCloudProjectsModel::PartialDownloadAction QFieldCloudProjectsModel::partialDownloadAction( long long partialSize, long long bytesTotal, const QString &etag )
+{
+  if ( partialSize <= 0 )
+    return PartialDownloadAction::Download;
 
-    if ( !file->open() )
-    {
-      project->downloadFilesFailed++;
-      emit projectDownloadFinished( projectId, tr( "Failed to open temporary file for `%1`, reason:\n%2" )
-                                                 .arg( fileName )
-                                                 .arg( file->errorString() ) );
-      return;
-    }
+  if ( partialSize > bytesTotal || !EtagHash::isComparable( etag, bytesTotal ) )
+    return PartialDownloadAction::Discard;
 
-    project->downloadFileTransfers[fileName].tmpFile = file->fileName();
-    project->downloadFileTransfers[fileName].networkReply = reply;
+  return partialSize == bytesTotal ? PartialDownloadAction::Verify : PartialDownloadAction::Resume;
+}
 
-    downloadFileConnections( projectId, fileName );
+int QFieldCloudProjectsModel::downloadPriority( const QString &fileName )
+{
+  const QString suffix = QFileInfo( fileName ).suffix().toLower();
+  // the project file and its datasets make the project usable, rasters and attachments can follow
+  if ( suffix == QLatin1String( "qgs" ) || suffix == QLatin1String( "qgz" ) )
+    return 0;
+
+  if ( suffix == QLatin1String( "gpkg" ) || suffix == QLatin1String( "sqlite" ) || suffix == QLatin1String( "db" ) )
+    return 1;
+
+  static const QStringList sLargeFileSuffixes { QStringLiteral( "tif" ), QStringLiteral( "tiff" ), QStringLiteral( "jp2" ), QStringLiteral( "ecw" ), QStringLiteral( "mbtiles" ), QStringLiteral( "pmtiles" ), QStringLiteral( "jpg" ), QStringLiteral( "jpeg" ), QStringLiteral( "png" ), QStringLiteral( "webp" ), QStringLiteral( "mp4" ), QStringLiteral( "mp3" ), QStringLiteral( "pdf" ), QStringLiteral( "zip" ) };
+  if ( sLargeFileSuffixes.contains( suffix ) || fileName.contains( '/' ) )
+    return 3;
+
+  return 2;
+}
+
+QStringList QFieldCloudProjectsModel::downloadOrder( const QMap<QString, long long> &fileSizes )
+{
+  // project files and datasets first, then the smallest files first within the same priority
+  QStringList fileNames = fileSizes.keys();
+  std::stable_sort( fileNames.begin(), fileNames.end(), [&fileSizes]( const QString &a, const QString &b ) {
+    const int priorityA = downloadPriority( a );
+    const int priorityB = downloadPriority( b );
+    if ( priorityA != priorityB )
+      return priorityA < priorityB;
+
+    return fileSizes.value( a ) < fileSizes.value( b );
+  } );
+
+  return fileNames;
+}
+
+int QFieldCloudProjectsModel::downloadRetryDelay( int retriesCount )
+{
+  if ( retriesCount >= MAX_DOWNLOAD_RETRIES )
+    return -1;
+
+  return DOWNLOAD_RETRY_DELAY_MS * ( 1 << retriesCount );
+}
+
+void QFieldCloudProjectsModel::updateActiveDownloads( QStringList &activeFileNames, QStringList &queuedFileNames, const QSet<QString> &finishedFileNames, int maximumActive )
+{
+  activeFileNames.erase( std::remove_if( activeFileNames.begin(), activeFileNames.end(), [&finishedFileNames]( const QString &fileName ) {
+                           return finishedFileNames.contains( fileName );
+                         } ),
+                         activeFileNames.end() );
+
+  // fill the free slots with the queued transfers, in their download order
+  while ( activeFileNames.size() < maximumActive && !queuedFileNames.isEmpty() )
+  {
+    activeFileNames.append( queuedFileNames.takeFirst() );
+  }
+}
+
+void QFieldCloudProjectsModel::startFileDownload( const QString &projectId, const QString &fileName )
+{
+  CloudProject *project = findProject( projectId );
+  FileTransfer &transfer = project->downloadFileTransfers[fileName];
+
+  if ( !QDir().mkpath( QFileInfo( transfer.tmpFile ).absolutePath() ) )
+  {
+    project->downloadFilesFailed++;
+    emit projectDownloadFinished( projectId, tr( "Failed to create the temporary directory for `%1`" ).arg( fileName ) );
+    return;
+  }
+
+  // a partial download left by a previous attempt, or a previous run of the app, is resumed
+  long long offset = QFileInfo( transfer.tmpFile ).size();
+  PartialDownloadAction action = partialDownloadAction( offset, transfer.bytesTotal, transfer.etag );
+  if ( action == PartialDownloadAction::Discard )
+  {
+    QFile::remove( transfer.tmpFile );
+    offset = 0;
+    action = PartialDownloadAction::Download;
+  }
+
+  if ( offset > 0 && ( !transfer.etagHash || transfer.etagHash->size() != offset ) )
+  {
+    // the integrity check needs the content downloaded so far, read it off the UI thread before resuming
+    transfer.isPreparing = true;
+
+    QFutureWatcher<std::shared_ptr<EtagHash>> *watcher = new QFutureWatcher<std::shared_ptr<EtagHash>>( this );
+    connect( watcher, &QFutureWatcher<std::shared_ptr<EtagHash>>::finished, this, [=]() {
+      watcher->deleteLater();
+
+      CloudProject *project = findProject( projectId );
+      if ( !project || !project->downloadFileTransfers.contains( fileName ) )
+        return;
+
+      FileTransfer &transfer = project->downloadFileTransfers[fileName];
+      transfer.isPreparing = false;
+
+      // the project download got cancelled or failed in the meantime
+      if ( project->status != ProjectStatus::Downloading || project->packagingStatus == PackagingAbortStatus || !project->downloadFilesActive.contains( fileName ) )
+        return;
+
+      transfer.etagHash = watcher->result();
+      if ( transfer.etagHash->size() != offset )
+      {
+        // the partial download could not be read, start over
+        QFile::remove( transfer.tmpFile );
+        transfer.etagHash->reset();
+      }
+
+      startFileDownload( projectId, fileName );
+    } );
+
+    watcher->setFuture( QtConcurrent::run( [partialFileName = transfer.tmpFile, offset]() {
+      std::shared_ptr<EtagHash> etagHash = std::make_shared<EtagHash>();
+      QFile partialFile( partialFileName );
+      if ( !partialFile.open( QIODevice::ReadOnly ) || !etagHash->addData( &partialFile, offset ) )
+        etagHash->reset();
+
+      return etagHash;
+    } ) );
+
+    return;
+  }
+
+  if ( action == PartialDownloadAction::Verify && transfer.etagHash->result() != transfer.etag )
+  {
+    QgsLogger::debug( QStringLiteral( "Project %1, file `%2`: downloaded content ETag `%3` does not match `%4`" ).arg( projectId, fileName, transfer.etagHash->result(), transfer.etag ) );
+    QFile::remove( transfer.tmpFile );
+    offset = 0;
+    action = PartialDownloadAction::Download;
   }
+
+  if ( offset == 0 )
+    transfer.etagHash = std::make_shared<EtagHash>();
+
+  // the bytes already downloaded count as received, the resumed ones are left out of the throughput
+  if ( offset > transfer.bytesTransferred )
+    project->downloadBytesResumed += offset - transfer.bytesTransferred;
+  project->downloadBytesReceived += offset - transfer.bytesTransferred;
+  transfer.bytesTransferred = offset;
+  transfer.resumeOffset = offset;
+  transfer.isRestartRequested = false;
+
+  if ( action == PartialDownloadAction::Verify )
+  {
+    // a previous attempt got the whole content, only moving it to the project got interrupted
+    QgsLogger::debug( QStringLiteral( "Project %1, file `%2`: already downloaded" ).arg( projectId, fileName ) );
+    updateDownloadProgress( project );
+
+    // completed once the other active files got started, as completing may finish the whole project download
+    transfer.isPreparing = true;
+    QTimer::singleShot( 0, this, [=]() {
+      CloudProject *project = findProject( projectId );
+      if ( !project || !project->downloadFileTransfers.contains( fileName ) )
+        return;
+
+      project->downloadFileTransfers[fileName].isPreparing = false;
+
+      // the project download got cancelled or failed in the meantime
+      if ( project->status != ProjectStatus::Downloading || project->packagingStatus == PackagingAbortStatus || !project->downloadFilesActive.contains( fileName ) )
+        return;
+
+      project->downloadFilesFinished++;
+      finishFileDownload( projectId, fileName );
+    } );
+
+    return;
+  }
+
+  if ( offset > 0 )
+    QgsLogger::debug( QStringLiteral( "Project %1, file `%2`: resuming download from byte %3" ).arg( projectId, fileName ).arg( offset ) );
+
+  transfer.networkReply = downloadFile( projectId, fileName, offset, transfer.etag );
+  updateDownloadProgress( project );
+
+  downloadFileConnections( projectId, fileName );
 }
 
 bool QFieldCloudProjectsModel::projectMoveDownloadedFilesToPermanentStorage( const QString &projectId )
@@ -1255,7 +1474,11 @@ bool QFieldCloudProjectsModel::projectMoveDownloadedFilesToPermanentStorage( con
       QgsMessageLog::logMessage( QStringLiteral( "Failed to remove file before overwriting stored at `%1`, reason:\n%2" ).arg( fileName ).arg( file.errorString() ) );
     }
 
-    if ( !hasError && !file.copy( destinationFileName ) )
+    // the temporary file is on the same volume, moving it avoids copying large files
+    if ( !hasError && file.rename( destinationFileName ) )
+      continue;
+
+    if ( !hasError )
     {
       hasError = true;
       QgsMessageLog::logMessage( QStringLiteral( "Failed to write downloaded file stored at `%1`, reason:\n%2" ).arg( fileName ).arg( file.errorString() ) );
@@ -1264,10 +1487,12 @@ bool QFieldCloudProjectsModel::projectMoveDownloadedFilesToPermanentStorage( con
         QgsMessageLog::logMessage( QStringLiteral( "Failed to remove partly overwritten file stored at `%1`" ).arg( fileName ) );
     }
 
-    if ( !file.remove() )
-      QgsMessageLog::logMessage( QStringLiteral( "Failed to remove temporary file `%1`" ).arg( fileName ) );
+    // the files not moved are kept, downloading the project again only needs to verify them
   }
 
+  if ( !hasError )
+    QDir( partialDownloadDir( projectId ) ).removeRecursively();
+
   return !hasError;
 }
 
@@ -1727,11 +1952,12 @@ void QFieldCloudProjectsModel::projectListReceived()
   }
 }
 
-NetworkReply *QFieldCloudProjectsModel::downloadFile( const QString &projectId, const QString &fileName )
+NetworkReply *QFieldCloudProjectsModel::downloadFile( const QString &projectId, const QString &fileName, long long offset, const QString &etag )
 {
   QNetworkRequest request;
   request.setAttribute( QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::RedirectPolicy::UserVerifiedRedirectPolicy );
   mCloudConnection->setAuthenticationToken( request );
+  setDownloadRangeHeaders( request, offset, etag );
 
   return mCloudConnection->get( request, QStringLiteral( "/api/v1/packages/%1/latest/files/%2/" ).arg( projectId, fileName ) );
 }
@@ -1765,8 +1991,6 @@ void QFieldCloudProjectsModel::downloadFileConnections( const QString &projectId
     return;
   }
 
-  const QStringList fileNames = project->downloadFileTransfers.keys();
-
   QgsLogger::debug( QStringLiteral( "Project %1, file `%2`: requested." ).arg( projectId, fileName ) );
 
   connect( reply, &NetworkReply::redirected, reply, [=]( const QUrl &url ) {
@@ -1798,6 +2022,7 @@ void QFieldCloudProjectsModel::downloadFileConnections( const QString &projectId
     QgsLogger::debug( QStringLiteral( "Package %1, file `%2`: redirected to `%3`" ).arg( projectId, fileName, url.toString() ) );
 
     QNetworkRequest request;
+    setDownloadRangeHeaders( request, project->downloadFileTransfers[fileName].resumeOffset, project->downloadFileTransfers[fileName].etag );
     project->downloadFileTransfers[fileName].networkReply = mCloudConnection->get( request, url );
     project->downloadFileTransfers[fileName].networkReply->setParent( reply );
 
@@ -1808,13 +2033,46 @@ void QFieldCloudProjectsModel::downloadFileConnections( const QString &projectId
   } );
 
   connect( reply, &NetworkReply::downloadProgress, reply, [=]( int bytesReceived, int bytesTotal ) {
+    Q_UNUSED( bytesReceived )
+    Q_UNUSED( bytesTotal )
+
     QNetworkReply *rawReply = reply->currentRawReply();
     if ( !rawReply )
     {
       return;
     }
 
-    const QString temporaryFileName = project->downloadFileTransfers[fileName].tmpFile;
+    if ( !findProject( projectId ) )
+    {
+      QgsLogger::debug( QStringLiteral( "Project %1, file `%2`: updating download progress, but the project is deleted." ).arg( projectId, fileName ) );
+      return;
+    }
+
+    FileTransfer &transfer = project->downloadFileTransfers[fileName];
+    const int statusCode = rawReply->attribute( QNetworkRequest::HttpStatusCodeAttribute ).toInt();
+
+    // the body of a redirect is not part of the file
+    if ( statusCode >= 300 && statusCode < 400 )
+      return;
+
+    if ( transfer.resumeOffset > 0 && statusCode == 200 )
+    {
+      // the range got ignored, the whole file is sent instead
+      QgsLogger::debug( QStringLiteral( "Project %1, file `%2`: download could not be resumed, starting over" ).arg( projectId, fileName ) );
+      discardPartialDownload( project, fileName );
+    }
+    else if ( statusCode == 206 && !rawReply->rawHeader( "Content-Range" ).startsWith( QStringLiteral( "bytes %1-" ).arg( transfer.resumeOffset ).toLatin1() ) )
+    {
+      // the received range does not continue the partial download
+      QgsLogger::debug( QStringLiteral( "Project %1, file `%2`: unexpected content range `%3`" ).arg( projectId, fileName, QString( rawReply->rawHeader( "Content-Range" ) ) ) );
+      discardPartialDownload( project, fileName );
+      transfer.isRestartRequested = true;
+      rawReply->abort();
+      return;
+    }
+
+    const QString temporaryFileName = transfer.tmpFile;
+    const QByteArray data = rawReply->readAll();
     QFile file( temporaryFileName );
     QString errorMessageDetail;
     QString errorMessage;
@@ -1822,7 +2080,7 @@ void QFieldCloudProjectsModel::downloadFileConnections( const QString &projectId
 
     if ( file.open( QIODevice::WriteOnly | QIODevice::Append ) )
     {
-      file.write( rawReply->readAll() );
+      file.write( data );
 
       if ( file.error() != QFile::NoError )
       {
@@ -1846,19 +2104,11 @@ void QFieldCloudProjectsModel::downloadFileConnections( const QString &projectId
       return;
     }
 
-    if ( !findProject( projectId ) )
-    {
-      QgsLogger::debug( QStringLiteral( "Project %1, file `%2`: updating download progress, but the project is deleted." ).arg( projectId, fileName ) );
-      return;
-    }
-
-    Q_UNUSED( bytesTotal )
-
-    project->downloadBytesReceived -= project->downloadFileTransfers[fileName].bytesTransferred;
-    project->downloadBytesReceived += bytesReceived;
-    project->downloadFileTransfers[fileName].bytesTransferred = bytesReceived;
-    project->downloadProgress = std::clamp( ( static_cast<double>( project->downloadBytesReceived ) / std::max( project->downloadBytesTotal, 1 ) ), 0., 1. );
-    emit dataChanged( projectIndex, projectIndex, QVector<int>() << DownloadProgressRole );
+    // the integrity check runs as the content streams in, sparing another read of large files once downloaded
+    transfer.etagHash->addData( data );
+    transfer.bytesTransferred += data.size();
+    project->downloadBytesReceived += data.size();
+    updateDownloadProgress( project );
   } );
 
   connect( reply, &NetworkReply::finished, reply, [=]() {
@@ -1871,7 +2121,6 @@ void QFieldCloudProjectsModel::downloadFileConnections( const QString &projectId
       return;
     }
 
-    QVector<int> rolesChanged;
     QNetworkReply *rawReply = reply->currentRawReply();
 
     Q_ASSERT( reply->isFinished() );
@@ -1881,6 +2130,35 @@ void QFieldCloudProjectsModel::downloadFileConnections( const QString &projectId
     if ( project->downloadFileTransfers[fileName].networkReply != reply )
       return;
 
+    FileTransfer &transfer = project->downloadFileTransfers[fileName];
+    bool isRestartNeeded = transfer.isRestartRequested;
+
+    if ( rawReply->error() == QNetworkReply::NoError && transfer.etagHash && transfer.etagHash->result() != transfer.etag )
+    {
+      if ( EtagHash::isComparable( transfer.etag, transfer.bytesTotal ) )
+      {
+        QgsLogger::debug( QStringLiteral( "Project %1, file `%2`: downloaded content ETag `%3` does not match `%4`" ).arg( projectId, fileName, transfer.etagHash->result(), transfer.etag ) );
+        discardPartialDownload( project, fileName );
+        isRestartNeeded = true;
+      }
+      else
+      {
+        // uploaded with another part size, such files are never resumed and are accepted as downloaded
+        QgsLogger::debug( QStringLiteral( "Project %1, file `%2`: ETag `%3` can not be verified" ).arg( projectId, fileName, transfer.etag ) );
+      }
+    }
+
+    const bool hasProgressed = !isRestartNeeded && transfer.bytesTransferred > transfer.resumeOffset;
+
+    // transient network errors are retried after a delay instead of failing the whole project download
+    if ( ( isRestartNeeded || isTransientDownloadError( rawReply->error() ) ) && retryFailedDownload( project, fileName, hasProgressed ) )
+    {
+      reply->deleteLater();
+      updateActiveProjectFilesToDownload( projectId );
+      projectDownloadFiles( projectId );
+      return;
+    }
+
     project->downloadFilesFinished++;
 
     bool hasError = false;
@@ -1893,13 +2171,11 @@ void QFieldCloudProjectsModel::downloadFileConnections( const QString &projectId
       errorMessageDetail = QFieldCloudConnection::errorString( rawReply );
       errorMessage = tr( "Network error. Failed to download file `%1`." ).arg( fileName );
     }
-
-    if ( !hasError )
+    else if ( isRestartNeeded )
     {
-      project->downloadBytesReceived -= project->downloadFileTransfers[fileName].bytesTransferred;
-      project->downloadBytesReceived += project->downloadFileTransfers[fileName].bytesTotal;
-      project->downloadProgress = std::clamp( ( static_cast<double>( project->downloadBytesReceived ) / std::max( project->downloadBytesTotal, 1 ) ), 0., 1. );
-      emit dataChanged( projectIndex, projectIndex, QVector<int>() << DownloadProgressRole );
+      hasError = true;
+      errorMessageDetail = tr( "The downloaded content does not match the file on QFieldCloud." );
+      errorMessage = tr( "Integrity error. Failed to download file `%1`." ).arg( fileName );
     }
 
     // check if the code above failed with error
@@ -1910,72 +2186,86 @@ void QFieldCloudProjectsModel::downloadFileConnections( const QString &projectId
       return;
     }
 
-    QgsLogger::debug( QStringLiteral( "Package %1, file `%2`: downloaded" ).arg( projectId, fileName ) );
+    finishFileDownload( projectId, fileName );
+  } );
+}
 
-    updateActiveProjectFilesToDownload( projectId );
+void QFieldCloudProjectsModel::finishFileDownload( const QString &projectId, const QString &fileName )
+{
+  CloudProject *project = findProject( projectId );
+  const QModelIndex projectIndex = findProjectIndex( projectId );
+  const QStringList fileNames = project->downloadFileTransfers.keys();
+  QVector<int> rolesChanged;
 
-    if ( project->downloadFilesFinished == fileNames.count() )
-    {
-      QgsLogger::debug( QStringLiteral( "Project %1: All files downloaded." ).arg( projectId ) );
+  project->downloadBytesReceived -= project->downloadFileTransfers[fileName].bytesTransferred;
+  project->downloadBytesReceived += project->downloadFileTransfers[fileName].bytesTotal;
+  project->downloadFileTransfers[fileName].bytesTransferred = project->downloadFileTransfers[fileName].bytesTotal;
+  project->downloadFileTransfers[fileName].isFinished = true;
+  project->downloadFilesActive.removeOne( fileName );
+  updateDownloadProgress( project );
 
-      Q_ASSERT( mActiveProjectFilesToDownload.size() == 0 );
+  QgsLogger::debug( QStringLiteral( "Package %1, file `%2`: downloaded" ).arg( projectId, fileName ) );
 
-      if ( !hasError )
-      {
-        const bool currentProjectReloadNeeded = project->id == mCurrentProjectId;
-        QStringList gpkgFileNames;
-        if ( currentProjectReloadNeeded )
-        {
-          // we need to close the project to safely flush the gpkg files and avoid file lock on Windows
-          const QStringList unprefixedGpkgFileNames = filterGpkgFileNames( fileNames );
-          gpkgFileNames = projectFileNames( mProject->homePath(), unprefixedGpkgFileNames );
-          mProject->clear();
+  updateActiveProjectFilesToDownload( projectId );
 
-          for ( const QString &fileName : gpkgFileNames )
-            mGpkgFlusher->stop( fileName );
-        }
+  if ( project->downloadFilesFinished == fileNames.count() )
+  {
+    QgsLogger::debug( QStringLiteral( "Project %1: All files downloaded." ).arg( projectId ) );
 
-        // move the files from their temporary location to their permanent one
-        if ( !projectMoveDownloadedFilesToPermanentStorage( projectId ) )
-        {
-          emit projectDownloadFinished( projectId, tr( "Failed to copy some of the downloaded files on your device. Check your device storage." ) );
-          return;
-        }
+    Q_ASSERT( project->downloadFilesActive.size() == 0 );
 
-        if ( currentProjectReloadNeeded )
-        {
-          deleteGpkgShmAndWal( gpkgFileNames );
-          AppInterface::instance()->reloadProject();
-        }
+    const bool currentProjectReloadNeeded = project->id == mCurrentProjectId;
+    QStringList gpkgFileNames;
+    if ( currentProjectReloadNeeded )
+    {
+      // we need to close the project to safely flush the gpkg files and avoid file lock on Windows
+      const QStringList unprefixedGpkgFileNames = filterGpkgFileNames( fileNames );
+      gpkgFileNames = projectFileNames( mProject->homePath(), unprefixedGpkgFileNames );
+      mProject->clear();
 
-        project->errorStatus = NoErrorStatus;
-        project->checkout = ProjectCheckout::LocalAndRemoteCheckout;
-        project->localPath = QFieldCloudUtils::localProjectFilePath( mUsername, projectId );
-        project->lastLocalExportedAt = QDateTime::currentDateTimeUtc().toString( Qt::ISODate );
-        project->lastLocalExportId = QUuid::createUuid().toString( QUuid::WithoutBraces );
-        project->lastLocalDataLastUpdatedAt = project->dataLastUpdatedAt;
-        project->isOutdated = false;
-        project->projectFileIsOutdated = false;
-
-        QFieldCloudUtils::setProjectSetting( projectId, QStringLiteral( "lastExportedAt" ), project->lastExportedAt );
-        QFieldCloudUtils::setProjectSetting( projectId, QStringLiteral( "lastExportId" ), project->lastExportId );
-        QFieldCloudUtils::setProjectSetting( projectId, QStringLiteral( "lastLocalExportedAt" ), project->lastLocalExportedAt );
-        QFieldCloudUtils::setProjectSetting( projectId, QStringLiteral( "lastLocalExportId" ), project->lastLocalExportId );
-        QFieldCloudUtils::setProjectSetting( projectId, QStringLiteral( "lastLocalDataLastUpdatedAt" ), project->lastLocalDataLastUpdatedAt );
-        QFieldCloudUtils::setProjectSetting( projectId, QStringLiteral( "lastProjectFileMd5" ), QString() );
-        QFieldCloudUtils::setProjectSetting( projectId, QStringLiteral( "projectFileOudated" ), false );
-
-        rolesChanged << StatusRole << ProjectOutdatedRole << ProjectFileOutdatedRole << LocalPathRole << CheckoutRole << LastLocalExportedAtRole;
-
-        emit dataChanged( projectIndex, projectIndex, rolesChanged );
-        emit projectDownloadFinished( projectId );
-      }
+      for ( const QString &gpkgFileName : gpkgFileNames )
+        mGpkgFlusher->stop( gpkgFileName );
     }
-    else
+
+    // move the files from their temporary location to their permanent one
+    if ( !projectMoveDownloadedFilesToPermanentStorage( projectId ) )
     {
-      projectDownloadFiles( projectId );
+      emit projectDownloadFinished( projectId, tr( "Failed to copy some of the downloaded files on your device. Check your device storage." ) );
+      return;
     }
-  } );
+
+    if ( currentProjectReloadNeeded )
+    {
+      deleteGpkgShmAndWal( gpkgFileNames );
+      AppInterface::instance()->reloadProject();
+    }
+
+    project->errorStatus = NoErrorStatus;
+    project->checkout = ProjectCheckout::LocalAndRemoteCheckout;
+    project->localPath = QFieldCloudUtils::localProjectFilePath( mUsername, projectId );
+    project->lastLocalExportedAt = QDateTime::currentDateTimeUtc().toString( Qt::ISODate );
+    project->lastLocalExportId = QUuid::createUuid().toString( QUuid::WithoutBraces );
+    project->lastLocalDataLastUpdatedAt = project->dataLastUpdatedAt;
+    project->isOutdated = false;
+    project->projectFileIsOutdated = false;
+
+    QFieldCloudUtils::setProjectSetting( projectId, QStringLiteral( "lastExportedAt" ), project->lastExportedAt );
+    QFieldCloudUtils::setProjectSetting( projectId, QStringLiteral( "lastExportId" ), project->lastExportId );
+    QFieldCloudUtils::setProjectSetting( projectId, QStringLiteral( "lastLocalExportedAt" ), project->lastLocalExportedAt );
+    QFieldCloudUtils::setProjectSetting( projectId, QStringLiteral( "lastLocalExportId" ), project->lastLocalExportId );
+    QFieldCloudUtils::setProjectSetting( projectId, QStringLiteral( "lastLocalDataLastUpdatedAt" ), project->lastLocalDataLastUpdatedAt );
+    QFieldCloudUtils::setProjectSetting( projectId, QStringLiteral( "lastProjectFileMd5" ), QString() );
+    QFieldCloudUtils::setProjectSetting( projectId, QStringLiteral( "projectFileOudated" ), false );
+
+    rolesChanged << StatusRole << ProjectOutdatedRole << ProjectFileOutdatedRole << LocalPathRole << CheckoutRole << LastLocalExportedAtRole;
+
+    emit dataChanged( projectIndex, projectIndex, rolesChanged );
+    emit projectDownloadFinished( projectId );
+  }
+  else
+  {
+    projectDownloadFiles( projectId );
+  }
 }
 
 QHash<int, QByteArray> QFieldCloudProjectsModel::roleNames() const
@@ -1995,6 +2285,8 @@ QHash<int, QByteArray> QFieldCloudProjectsModel::roleNames() const
   roles[ErrorStringRole] = "ErrorString";
   roles[DownloadSizeRole] = "DownloadSize";
   roles[DownloadProgressRole] = "DownloadProgress";
+  roles[DownloadBytesReceivedRole] = "DownloadBytesReceived";
+  roles[DownloadEtaRole] = "DownloadEta";
   roles[PackagingStatusRole] = "PackagingStatus";
   roles[PackagedLayerErrorsRole] = "PackagedLayerErrors";
   roles[UploadDeltaProgressRole] = "UploadDeltaProgress";
@@ -2084,6 +2376,92 @@ void QFieldCloudProjectsModel::insertProjects( const QList<CloudProject *> &proj
   endInsertRows();
 }
 
+void QFieldCloudProjectsModel::updateDownloadProgress( CloudProject *project )
+{
+  project->downloadProgress = std::clamp( ( static_cast<double>( project->downloadBytesReceived ) / std::max( project->downloadBytesTotal, 1LL ) ), 0., 1. );
+
+  // the remaining time is estimated from the average throughput, early estimates are mostly noise
+  const qint64 elapsed = project->downloadTimer.isValid() ? project->downloadTimer.elapsed() : 0;
+  const long long bytesDownloaded = project->downloadBytesReceived - project->downloadBytesResumed;
+  if ( elapsed >= DOWNLOAD_ETA_MIN_ELAPSED_MS && bytesDownloaded > 0 )
+  {
+    const double bytesPerSecond = static_cast<double>( bytesDownloaded ) * 1000 / elapsed;
+    const long long bytesRemaining = std::max( project->downloadBytesTotal - project->downloadBytesReceived, 0LL );
+    project->downloadEta = static_cast<int>( std::ceil( bytesRemaining / bytesPerSecond ) );
+  }
+  else
+  {
+    project->downloadEta = -1;
+  }
+
+  const QModelIndex projectIndex = findProjectIndex( project->id );
+  emit dataChanged( projectIndex, projectIndex, QVector<int>() << DownloadProgressRole << DownloadBytesReceivedRole << DownloadEtaRole );
+}
+
+bool QFieldCloudProjectsModel::retryFailedDownload( CloudProject *project, const QString &fileName, bool hasProgressed )
+{
+  FileTransfer &transfer = project->downloadFileTransfers[fileName];
+
+  // downloads moving forward get retried for as long as it takes, large files on a flaky connection would never complete otherwise
+  if ( hasProgressed )
+    transfer.retriesCount = 0;
+
+  const int delay = downloadRetryDelay( transfer.retriesCount );
+  if ( delay < 0 )
+    return false;
+
+  transfer.retriesCount++;
+
+  // the partial download is kept, the next attempt resumes from where this one stopped
+  transfer.networkReply = nullptr;
+  transfer.redirectsCount = 0;
+  transfer.lastRedirectUrl.clear();
+  project->downloadFilesActive.removeOne( fileName );
+  updateDownloadProgress( project );
+
+  QgsLogger::debug( QStringLiteral( "Project %1, file `%2`: download failed, retrying in %3 ms" ).arg( project->id, fileName ).arg( delay ) );
+
+  const QString projectId = project->id;
+  QTimer::singleShot( delay, this, [=]() {
+    CloudProject *project = findProject( projectId );
+
+    // the project download got cancelled, failed or restarted in the meantime
+    if ( !project
+         || project->status != ProjectStatus::Downloading
+         || project->packagingStatus == PackagingAbortStatus
+         || !project->downloadFileTransfers.contains( fileName )
+         || project->downloadFileTransfers[fileName].networkReply
+         || project->downloadFilesQueued.contains( fileName )
+         || project->downloadFilesActive.contains( fileName ) )
+      return;
+
+    // the file was started before the queued ones, it keeps its place ahead of them
+    project->downloadFilesQueued.prepend( fileName );
+    updateActiveProjectFilesToDownload( projectId );
+    projectDownloadFiles( projectId );
+  } );
+
+  return true;
+}
+
+void QFieldCloudProjectsModel::discardPartialDownload( CloudProject *project, const QString &fileName )
+{
+  FileTransfer &transfer = project->downloadFileTransfers[fileName];
+
+  QFile::remove( transfer.tmpFile );
+  project->downloadBytesReceived -= transfer.bytesTransferred;
+  project->downloadBytesResumed = std::min( project->downloadBytesResumed, project->downloadBytesReceived );
+  transfer.bytesTransferred = 0;
+  transfer.resumeOffset = 0;
+  transfer.etagHash = std::make_shared<EtagHash>();
+}
+
+QString QFieldCloudProjectsModel::partialDownloadDir( const QString &projectId ) const
+{
+  // not named after a user, the local projects scan skips it
+  return QStringLiteral( "%1/.partial/%2/%3" ).arg( QFieldCloudUtils::localCloudDirectory(), mUsername, projectId );
+}
+
 void QFieldCloudProjectsModel::logFailedDownload( CloudProject *project, const QString &fileName, const QString &errorMessage, const QString &errorMessageDetail )
 {
   project->downloadFilesFailed++;
@@ -2276,6 +2654,10 @@ QVariant QFieldCloudProjectsModel::data( const QModelIndex &index, int role ) co
       return mProjects.at( index.row() )->downloadBytesTotal;
     case DownloadProgressRole:
       return mProjects.at( index.row() )->downloadProgress;
+    case DownloadBytesReceivedRole:
+      return mProjects.at( index.row() )->downloadBytesReceived;
+    case DownloadEtaRole:
+      return mProjects.at( index.row() )->downloadEta;
     case UploadDeltaProgressRole:
       return mProjects.at( index.row() )->uploadDeltaProgress;
     case UploadDeltaStatusRole:
@@ -2370,6 +2752,18 @@ void QFieldCloudProjectsModel::setGpkgFlusher( QgsGpkgFlusher *flusher )
   emit gpkgFlusherChanged();
 }
 
+void QFieldCloudProjectsModel::setMaximumParallelDownloads( int maximumParallelDownloads )
+{
+  maximumParallelDownloads = std::clamp( maximumParallelDownloads, 1, MAX_PARALLEL_DOWNLOADS_LIMIT );
+  if ( mMaximumParallelDownloads == maximumParallelDownloads )
+    return;
+
+  mMaximumParallelDownloads = maximumParallelDownloads;
+  QSettings().setValue( QStringLiteral( "QFieldCloud/maximumParallelDownloads" ), mMaximumParallelDownloads );
+
+  emit maximumParallelDownloadsChanged();
+}
+
 bool QFieldCloudProjectsModel::deleteGpkgShmAndWal( const QStringList &gpkgFileNames )
 {
   bool isSuccess = true;
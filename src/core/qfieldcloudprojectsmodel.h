@@ -17,14 +17,19 @@
 #define QFIELDCLOUDPROJECTSMODEL_H
 
 #include "deltalistmodel.h"
+#include "etaghash.h"
 #include "qgsgpkgflusher.h"
 
 #include <QAbstractListModel>
+#include <QElapsedTimer>
 #include <QJsonArray>
 #include <QNetworkReply>
+#include <QSet>
 #include <QSortFilterProxyModel>
 #include <QTimer>
 
+#include <memory>
+
 
 class QNetworkRequest;
 class QFieldCloudConnection;
@@ -73,6 +78,8 @@ class QFieldCloudProjectsModel : public QAbstractListModel
       ForceAutoPushRole,
       AutoPushEnabledRole,
       AutoPushIntervalMinsRole,
+      DownloadBytesReceivedRole,
+      DownloadEtaRole,
     };
 
     Q_ENUM( ColumnRole )
@@ -185,8 +192,45 @@ class QFieldCloudProjectsModel : public QAbstractListModel
 
     Q_ENUM( ProjectRefreshReason )
 
+    //! The way the partial download of a file is used before requesting its content
+    enum class PartialDownloadAction
+    {
+      Download, //!< There is no partial download, the whole file is requested
+      Resume,   //!< The remaining content is requested
+      Verify,   //!< The whole content is already downloaded, it only needs to be verified
+      Discard,  //!< The partial download is removed and the whole file requested
+    };
+
     QFieldCloudProjectsModel();
 
+    /**
+     * Returns how a partial download of \a partialSize bytes is used to download a file of \a bytesTotal
+     * bytes with \a etag. Files whose \a etag can not be checked are never resumed, as a resumed download
+     * could not be verified.
+     */
+    static PartialDownloadAction partialDownloadAction( long long partialSize, long long bytesTotal, const QString &etag );
+
+    //! Returns the download priority of \a fileName, files with lower values are downloaded first
+    static int downloadPriority( const QString &fileName );
+
+    /**
+     * Returns the file names of \a fileSizes in their download order: by priority, then the smallest files
+     * first within the same priority.
+     */
+    static QStringList downloadOrder( const QMap<QString, long long> &fileSizes );
+
+    /**
+     * Returns the delay in milliseconds before retrying a failed download already retried \a retriesCount
+     * times, or -1 if it is not retried anymore.
+     */
+    static int downloadRetryDelay( int retriesCount );
+
+    /**
+     * Releases the \a finishedFileNames slots of the \a activeFileNames, then fills the free slots with the
+     * \a queuedFileNames in their order until \a maximumActive files are active.
+     */
+    static void updateActiveDownloads( QStringList &activeFileNames, QStringList &queuedFileNames, const QSet<QString> &finishedFileNames, int maximumActive );
+
     //! Stores the current cloud connection.
     Q_PROPERTY( QFieldCloudConnection *cloudConnection READ cloudConnection WRITE setCloudConnection NOTIFY cloudConnectionChanged )
 
@@ -235,6 +279,15 @@ class QFieldCloudProjectsModel : public QAbstractListModel
     //! Returns a set containing the currently busy project ids.
     QSet<QString> busyProjectIds() const;
 
+    //! Stores the maximum number of files downloaded in parallel for a project.
+    Q_PROPERTY( int maximumParallelDownloads READ maximumParallelDownloads WRITE setMaximumParallelDownloads NOTIFY maximumParallelDownloadsChanged )
+
+    //! Returns the maximum number of files downloaded in parallel for a project.
+    int maximumParallelDownloads() const { return mMaximumParallelDownloads; }
+
+    //! Sets the maximum number of files downloaded in parallel for a project, the value is saved in the settings.
+    void setMaximumParallelDownloads( int maximumParallelDownloads );
+
     //! Returns the cloud project data for given \a projectId.
     Q_INVOKABLE QVariantMap getProjectData( const QString &projectId ) const;
 
@@ -300,6 +353,7 @@ class QFieldCloudProjectsModel : public QAbstractListModel
     void busyProjectIdsChanged();
     void canSyncCurrentProjectChanged();
     void gpkgFlusherChanged();
+    void maximumParallelDownloadsChanged();
     void warning( const QString &message );
     void projectDownloaded( const QString &projectId, const QString &projectName, const bool hasError, const QString &errorString = QString() );
     void projectStatusChanged( const QString &projectId, const ProjectStatus &projectStatus );
@@ -330,22 +384,29 @@ class QFieldCloudProjectsModel : public QAbstractListModel
         FileTransfer(
           const QString &fileName,
           const long long bytesTotal,
+          const QString &etag = QString(),
           NetworkReply *networkReply = nullptr,
           const QStringList &layerIds = QStringList() )
-          : fileName( fileName ), bytesTotal( bytesTotal ), networkReply( networkReply ), layerIds( layerIds ) {};
+          : fileName( fileName ), etag( etag ), bytesTotal( bytesTotal ), networkReply( networkReply ), layerIds( layerIds ) {};
 
         FileTransfer() = default;
 
         QString fileName;
-        QString tmpFile;
+        QString etag;
+        QString tmpFile; // partial download, kept across failures to resume the download
         long long bytesTotal;
         long long bytesTransferred = 0;
-        bool isFinished = false;
+        bool isFinished = false; // downloaded or verified, its slot is released and it is never started again
         NetworkReply *networkReply;
         QNetworkReply::NetworkError error = QNetworkReply::NoError;
         QStringList layerIds;
         int redirectsCount = 0;
         QUrl lastRedirectUrl;
+        int retriesCount = 0;
+        long long resumeOffset = 0;
+        bool isPreparing = false;
+        bool isRestartRequested = false;
+        std::shared_ptr<EtagHash> etagHash; // of the tmpFile content, checked against the etag once downloaded
     };
 
     //! Tracks the job status (status, error etc) for a particular project. For now 1 project can have only 1 job of a type.
@@ -428,11 +489,16 @@ class QFieldCloudProjectsModel : public QAbstractListModel
         QString packagingStatusString;
         QStringList packagedLayerErrors;
         QMap<QString, FileTransfer> downloadFileTransfers;
+        QStringList downloadFilesQueued;  // waiting for a free slot, in download order
+        QStringList downloadFilesActive;  // being downloaded
         int downloadFilesFinished = 0;
         int downloadFilesFailed = 0;
-        int downloadBytesTotal = 0;
-        int downloadBytesReceived = 0;
+        long long downloadBytesTotal = 0;
+        long long downloadBytesReceived = 0;
+        long long downloadBytesResumed = 0; // received before the download got (re)started
         double downloadProgress = 0.0; // range from 0.0 to 1.0
+        QElapsedTimer downloadTimer;
+        int downloadEta = -1; // remaining seconds, -1 if unknown
 
         double uploadDeltaProgress = 0.0; // range from 0.0 to 1.0
         int deltasCount = 0;
@@ -463,7 +529,7 @@ class QFieldCloudProjectsModel : public QAbstractListModel
     QgsProject *mProject = nullptr;
     QgsGpkgFlusher *mGpkgFlusher = nullptr;
     QString mUsername;
-    QStringList mActiveProjectFilesToDownload;
+    int mMaximumParallelDownloads = 0;
     const int mProjectsPerFetch = 250;
 
     QModelIndex findProjectIndex( const QString &projectId ) const;
@@ -480,9 +546,15 @@ class QFieldCloudProjectsModel : public QAbstractListModel
     void projectSetSetting( const QString &projectId, const QString &setting, const QVariant &value );
     QVariant projectSetting( const QString &projectId, const QString &setting, const QVariant &defaultValue = QVariant() );
 
-    NetworkReply *downloadFile( const QString &projectId, const QString &fileName );
+    NetworkReply *downloadFile( const QString &projectId, const QString &fileName, long long offset = 0, const QString &etag = QString() );
     void projectDownloadFiles( const QString &projectId );
     void updateActiveProjectFilesToDownload( const QString &projectId );
+    void updateDownloadProgress( CloudProject *project );
+    bool retryFailedDownload( CloudProject *project, const QString &fileName, bool hasProgressed );
+    void discardPartialDownload( CloudProject *project, const QString &fileName );
+    QString partialDownloadDir( const QString &projectId ) const;
+    void startFileDownload( const QString &projectId, const QString &fileName );
+    void finishFileDownload( const QString &projectId, const QString &fileName );
 
     bool canSyncProject( const QString &projectId ) const;
 
@@ -44,6 +44,7 @@
 #include "barcodedecoder.h"
 #include "changelogcontents.h"
 #include "coordinatereferencesystemutils.h"
+#include "deferredlayerloader.h"
 #include "deltafilewrapper.h"
 #include "deltalistmodel.h"
 #include "digitizinglogger.h"
@@ -58,6 +59,7 @@
 #include "featurelistmodel.h"
 #include "featurelistmodelselection.h"
 #include "featuremodel.h"
+#include "featuressearchindex.h"
 #include "featureutils.h"
 #include "fileutils.h"
 #include "focusstack.h"
@@ -78,6 +80,7 @@
 #include "localfilesimageprovider.h"
 #include "localfilesmodel.h"
 #include "locatormodelsuperbridge.h"
+#include "maprenderstatisticsmodel.h"
 #include "maptoscreen.h"
 #include "messagelogmodel.h"
 #include "modelhelper.h"
@@ -96,6 +99,7 @@
 #include "processingalgorithm.h"
 #include "processingalgorithmparametersmodel.h"
 #include "processingalgorithmsmodel.h"
+#include "profilerutils.h"
 #include "projectinfo.h"
 #include "projectsimageprovider.h"
 #include "projectsource.h"
@@ -135,12 +139,16 @@
 #include <QDateTime>
 #include <QFileInfo>
 #include <QFontDatabase>
+#include <QFutureWatcher>
 #include <QPalette>
 #include <QPermissions>
 #include <QQmlFileSelector>
 #include <QResource>
 #include <QScreen>
+#include <QStandardPaths>
 #include <QStyleHints>
+#include <QThread>
+#include <QtConcurrent>
 #include <QtQml/QQmlApplicationEngine>
 #include <QtQml/QQmlContext>
 #include <QtQml/QQmlEngine>
@@ -149,6 +157,7 @@
 #include <qgscoordinatereferencesystem.h>
 #include <qgsexpressionfunction.h>
 #include <qgsfeature.h>
+#include <qgsfeedback.h>
 #include <qgsfield.h>
 #include <qgsfieldconstraints.h>
 #include <qgsfontmanager.h>
@@ -182,6 +191,7 @@
 #include <qgsrasterlayer.h>
 #include <qgsrasterresamplefilter.h>
 #include <qgsrelationmanager.h>
+#include <qgsruntimeprofiler.h>
 #include <qgssinglesymbolrenderer.h>
 #include <qgssnappingutils.h>
 #include <qgstemporalutils.h>
@@ -218,6 +228,8 @@ QgisMobileapp::QgisMobileapp( QgsApplication *app, QObject *parent )
 
   AppInterface::setInstance( mIface );
 
+  QgsScopedRuntimeProfile startupProfile( tr( "Register fonts" ), ProfilerUtils::startupGroup() );
+
   //set the authHandler to qfield-handler
   std::unique_ptr<QgsNetworkAuthenticationHandler> handler;
   mAuthRequestHandler = new QFieldAppAuthRequestHandler();
@@ -264,10 +276,12 @@ QgisMobileapp::QgisMobileapp( QgsApplication *app, QObject *parent )
 
   QgsApplication::fontManager()->enableFontDownloadsForSession();
 
+  startupProfile.switchTask( tr( "Create models" ) );
   mProject = QgsProject::instance();
   mTrackingModel = new TrackingModel();
   mGpkgFlusher = std::make_unique<QgsGpkgFlusher>( mProject );
   mLayerObserver = std::make_unique<LayerObserver>( mProject );
+  mFeaturesSearchIndex = std::make_unique<FeaturesSearchIndex>( mProject, mLayerObserver.get() );
   mFeatureHistory = std::make_unique<FeatureHistory>( mProject, mTrackingModel );
   mClipboardManager = std::make_unique<ClipboardManager>( this );
   mFlatLayerTree = new FlatLayerTreeModel( mProject->layerTreeRoot(), mProject, this );
@@ -280,6 +294,7 @@ QgisMobileapp::QgisMobileapp( QgsApplication *app, QObject *parent )
 
   mPluginManager = new PluginManager( this );
 
+  startupProfile.switchTask( tr( "Register QML types" ) );
   // cppcheck-suppress leakReturnValNotUsed
   initDeclarative( this );
 
@@ -299,6 +314,7 @@ QgisMobileapp::QgisMobileapp( QgsApplication *app, QObject *parent )
     }
 #endif
 
+    startupProfile.switchTask( tr( "Import authentication configurations" ) );
     QgsApplication::instance()->authManager()->setPasswordHelperEnabled( false );
     QgsApplication::instance()->authManager()->setMasterPassword( QString( "qfield" ) );
     // import authentication method configurations
@@ -318,8 +334,11 @@ QgisMobileapp::QgisMobileapp( QgsApplication *app, QObject *parent )
 
   PlatformUtilities::instance()->setScreenLockPermission( false );
 
+  startupProfile.switchTask( tr( "Load user interface" ) );
   load( QUrl( "qrc:/qml/qgismobileapp.qml" ) );
 
+  startupProfile.switchTask( tr( "Set up map canvas" ) );
+
   mMapCanvas = rootObjects().first()->findChild<QgsQuickMapCanvasMap *>();
   Q_ASSERT_X( mMapCanvas, "QML Init", "QgsQuickMapCanvasMap not found. It is likely that we failed to load the QML files. Check debug output for related messages." );
   mMapCanvas->mapSettings()->setProject( mProject );
@@ -332,6 +351,8 @@ QgisMobileapp::QgisMobileapp( QgsApplication *app, QObject *parent )
 
   connect( this, &QgisMobileapp::loadProjectTriggered, mIface, &AppInterface::loadProjectTriggered );
   connect( this, &QgisMobileapp::loadProjectEnded, mIface, &AppInterface::loadProjectEnded );
+  connect( this, &QgisMobileapp::loadProjectProgress, mIface, &AppInterface::loadProjectProgress );
+  connect( this, &QgisMobileapp::loadProjectCanceled, mIface, &AppInterface::loadProjectCanceled );
   connect( this, &QgisMobileapp::setMapExtent, mIface, &AppInterface::setMapExtent );
 
   QTimer::singleShot( 1, this, &QgisMobileapp::onAfterFirstRendering );
@@ -471,6 +492,7 @@ void QgisMobileapp::initDeclarative( QQmlEngine *engine )
   qmlRegisterType<PrintLayoutListModel>( "org.qfield", 1, 0, "PrintLayoutListModel" );
   qmlRegisterType<VertexModel>( "org.qfield", 1, 0, "VertexModel" );
   qmlRegisterType<MapToScreen>( "org.qfield", 1, 0, "MapToScreen" );
+  qmlRegisterType<MapRenderStatisticsModel>( "org.qfield", 1, 0, "MapRenderStatisticsModel" );
   qmlRegisterType<LocatorModelSuperBridge>( "org.qfield", 1, 0, "LocatorModelSuperBridge" );
   qmlRegisterType<LocatorActionsModel>( "org.qfield", 1, 0, "LocatorActionsModel" );
   qmlRegisterType<LocatorFiltersModel>( "org.qfield", 1, 0, "LocatorFiltersModel" );
@@ -554,6 +576,7 @@ void QgisMobileapp::initDeclarative( QQmlEngine *engine )
   qmlRegisterUncreatableType<TrackingModel>( "org.qfield", 1, 0, "TrackingModel", "The TrackingModel is available as context property `trackingModel`." );
   qmlRegisterUncreatableType<QgsGpkgFlusher>( "org.qfield", 1, 0, "QgsGpkgFlusher", "The gpkgFlusher is available as context property `gpkgFlusher`" );
   qmlRegisterUncreatableType<LayerObserver>( "org.qfield", 1, 0, "LayerObserver", "" );
+  qmlRegisterUncreatableType<FeaturesSearchIndex>( "org.qfield", 1, 0, "FeaturesSearchIndex", "" );
   qmlRegisterUncreatableType<DeltaFileWrapper>( "org.qfield", 1, 0, "DeltaFileWrapper", "" );
   qmlRegisterUncreatableType<BookmarkModel>( "org.qfield", 1, 0, "BookmarkModel", "The BookmarkModel is available as context property `bookmarkModel`" );
   qmlRegisterUncreatableType<MessageLogModel>( "org.qfield", 1, 0, "MessageLogModel", "The MessageLogModel is available as context property `messageLogModel`." );
@@ -595,6 +618,8 @@ void QgisMobileapp::registerGlobalVariables()
   rootContext()->setContextProperty( "bookmarkModel", mBookmarkModel );
   rootContext()->setContextProperty( "gpkgFlusher", mGpkgFlusher.get() );
   rootContext()->setContextProperty( "layerObserver", mLayerObserver.get() );
+  rootContext()->setContextProperty( "featuresSearchIndex", mFeaturesSearchIndex.get() );
+  rootContext()->setContextProperty( "deferredLayerLoader", DeferredLayerLoader::instance() );
   rootContext()->setContextProperty( "featureHistory", mFeatureHistory.get() );
   rootContext()->setContextProperty( "clipboardManager", mClipboardManager.get() );
   rootContext()->setContextProperty( "messageLogModel", mMessageLogModel );
@@ -680,7 +705,9 @@ void QgisMobileapp::onAfterFirstRendering()
   // disconnect( this, &QgisMobileapp::afterRendering, this, &QgisMobileapp::onAfterFirstRendering );
   if ( mFirstRenderingFlag )
   {
+    QgsScopedRuntimeProfile profile( tr( "Restore app plugins" ), ProfilerUtils::startupGroup() );
     mPluginManager->restoreAppPlugins();
+    profile.switchTask( tr( "Trigger project load" ) );
     if ( PlatformUtilities::instance()->hasQgsProject() )
     {
       PlatformUtilities::instance()->loadQgsProject();
@@ -714,6 +741,13 @@ void QgisMobileapp::onMapCanvasRefreshed()
   disconnect( mMapCanvas, &QgsQuickMapCanvasMap::mapCanvasRefreshed, this, &QgisMobileapp::onMapCanvasRefreshed );
   if ( !mProjectFilePath.isEmpty() )
   {
+    if ( mProjectLoadTimer.isValid() )
+    {
+      QgsApplication::profiler()->record( tr( "Time to first map render" ), mProjectLoadTimer.elapsed() / 1000.0, ProfilerUtils::projectRenderGroup() );
+      mProjectLoadTimer.invalidate();
+      logProjectLoadProfile();
+    }
+
     if ( !QFileInfo::exists( QStringLiteral( "%1.png" ).arg( mProjectFilePath ) ) )
     {
       saveProjectPreviewImage();
@@ -741,6 +775,12 @@ bool QgisMobileapp::loadProjectFile( const QString &path, const QString &name )
     }
     mAuthRequestHandler->clearStoredRealms();
 
+    if ( mProjectLoading )
+    {
+      // Stop the ongoing load, the triggered project is read once it has stopped
+      mProjectLoadFeedback->cancel();
+    }
+
     mProjectFilePath = path;
     mProjectFileName = !name.isEmpty() ? name : fi.completeBaseName();
 
@@ -761,6 +801,14 @@ void QgisMobileapp::reloadProjectFile()
 
 void QgisMobileapp::readProjectFile()
 {
+  if ( mProjectLoading )
+  {
+    // The ongoing load is superseded, the project is read again once it has stopped
+    mProjectReadPending = true;
+    mProjectLoadFeedback->cancel();
+    return;
+  }
+
   QFileInfo fi( mProjectFilePath );
   if ( !fi.exists() )
     QgsMessageLog::logMessage( tr( "Can't read project, file \"%1\" does not exist" ).arg( mProjectFilePath ), QStringLiteral( "QField" ), Qgis::Warning );
@@ -769,39 +817,24 @@ void QgisMobileapp::readProjectFile()
 
   const QString suffix = fi.suffix().toLower();
 
+  mProjectLoading = true;
+  QgsApplication::profiler()->clear( ProfilerUtils::projectOpenGroup() );
+  QgsApplication::profiler()->clear( ProfilerUtils::projectRenderGroup() );
+  mProjectLoadTimer.start();
+  mProjectLoadFeedback = std::make_shared<QgsFeedback>();
+  connect( mProjectLoadFeedback.get(), &QgsFeedback::progressChanged, this, [this]( double progress ) {
+    emit loadProjectProgress( progress / 100.0 * PROJECT_LOAD_GATHER_PROGRESS, tr( "Scanning datasets" ) );
+  } );
+
   mProject->clear();
   mProject->layerTreeRegistryBridge()->setLayerInsertionMethod( Qgis::LayerTreeInsertionMethod::OptimalInInsertionGroup );
 
   mTrackingModel->reset();
 
-  // load project file fonts if present
-  const QStringList fontDirNames = QStringList() << QStringLiteral( ".fonts" ) << QStringLiteral( "fonts" );
-  for ( const QString &fontDirName : fontDirNames )
-  {
-    const QDir fontDir = QDir::cleanPath( QFileInfo( mProjectFilePath ).absoluteDir().path() + QDir::separator() + fontDirName );
-    const QStringList fontExts = QStringList() << "*.ttf"
-                                               << "*.TTF"
-                                               << "*.otf"
-                                               << "*.OTF";
-    const QStringList fontFiles = fontDir.entryList( fontExts, QDir::Files );
-    for ( const QString &fontFile : fontFiles )
-    {
-      const int id = QFontDatabase::addApplicationFont( QDir::cleanPath( fontDir.path() + QDir::separator() + fontFile ) );
-      qInfo() << QStringLiteral( "Project font registered: %1" ).arg( QDir::cleanPath( fontDir.path() + QDir::separator() + fontFile ) );
-      if ( id == -1 )
-      {
-        QgsMessageLog::logMessage( tr( "Could not load font: %1" ).arg( fontFile ) );
-      }
-    }
-  }
-
-  // Load project file
-  bool projectLoaded = false;
+  QString projectUri;
   if ( SUPPORTED_PROJECT_EXTENSIONS.contains( suffix ) )
   {
-    mProject->read( mProjectFilePath, Qgis::ProjectReadFlag::DontLoadProjectStyles | Qgis::ProjectReadFlag::DontLoad3DViews );
-    mProject->writeEntry( QStringLiteral( "QField" ), QStringLiteral( "isDataset" ), false );
-    projectLoaded = true;
+    projectUri = mProjectFilePath;
   }
   else if ( suffix == QStringLiteral( "gpkg" ) )
   {
@@ -811,58 +844,56 @@ void QgisMobileapp::readProjectFile()
       const QStringList projectNames = storage->listProjects( mProjectFilePath );
       if ( !projectNames.isEmpty() )
       {
-        QgsGeoPackageProjectUri projectUri { true, mProjectFilePath, projectNames.at( 0 ) };
-        mProject->read( QgsGeoPackageProjectStorage::encodeUri( projectUri ), Qgis::ProjectReadFlag::DontLoadProjectStyles | Qgis::ProjectReadFlag::DontLoad3DViews );
-        mProject->writeEntry( QStringLiteral( "QField" ), QStringLiteral( "isDataset" ), false );
-        projectLoaded = true;
+        QgsGeoPackageProjectUri geopackageProjectUri { true, mProjectFilePath, projectNames.at( 0 ) };
+        projectUri = QgsGeoPackageProjectStorage::encodeUri( geopackageProjectUri );
       }
     }
   }
 
-  if ( projectLoaded )
-  {
-    if ( !mProject->error().isEmpty() )
-    {
-      QgsMessageLog::logMessage( mProject->error() );
-    }
-  }
+  // Fonts and datasets are scanned, and dataset layers constructed, off the main thread
+  emit loadProjectProgress( 0.0, tr( "Scanning datasets" ) );
+  QFutureWatcher<ProjectLoadData> *watcher = new QFutureWatcher<ProjectLoadData>( this );
+  connect( watcher, &QFutureWatcher<ProjectLoadData>::finished, this, [this, watcher, projectUri] {
+    watcher->deleteLater();
+    QgsApplication::profiler()->record( tr( "Scan datasets" ), mProjectLoadTimer.elapsed() / 1000.0, ProfilerUtils::projectOpenGroup() );
+    finishReadProjectFile( watcher->result(), projectUri );
+  } );
+  watcher->setFuture( QtConcurrent::run( &QgisMobileapp::gatherProjectData, mProjectFilePath, !projectUri.isEmpty(), mProjectLoadFeedback, QThread::currentThread() ) );
+}
 
-  QString title;
-  if ( mProject->fileName().startsWith( QFieldCloudUtils::localCloudDirectory() ) )
-  {
-    // Overwrite the title to match what is used in QFieldCloud
-    const QString projectId = fi.dir().dirName();
-    title = QSettings().value( QStringLiteral( "QFieldCloud/projects/%1/name" ).arg( projectId ), fi.fileName() ).toString();
-  }
-  else
-  {
-    title = mProject->title().isEmpty() ? mProjectFileName : mProject->title();
-  }
+void QgisMobileapp::cancelProjectLoad()
+{
+  if ( mProjectLoading )
+    mProjectLoadFeedback->cancel();
+}
 
-  QList<QPair<QString, QString>> projects = recentProjects();
-  for ( int idx = 0; idx < projects.count(); idx++ )
+QgisMobileapp::ProjectLoadData QgisMobileapp::gatherProjectData( const QString &projectFilePath, bool hasProject, std::shared_ptr<QgsFeedback> feedback, QThread *targetThread )
+{
+  ProjectLoadData data;
+
+  // list project file fonts if present
+  const QStringList fontDirNames = QStringList() << QStringLiteral( ".fonts" ) << QStringLiteral( "fonts" );
+  for ( const QString &fontDirName : fontDirNames )
   {
-    if ( projects.at( idx ).second == mProjectFilePath )
+    const QDir fontDir = QDir::cleanPath( QFileInfo( projectFilePath ).absoluteDir().path() + QDir::separator() + fontDirName );
+    const QStringList fontExts = QStringList() << "*.ttf"
+                                               << "*.TTF"
+                                               << "*.otf"
+                                               << "*.OTF";
+    const QStringList fontFiles = fontDir.entryList( fontExts, QDir::Files );
+    for ( const QString &fontFile : fontFiles )
     {
-      projects.removeAt( idx );
-      break;
+      data.fontFiles << QDir::cleanPath( fontDir.path() + QDir::separator() + fontFile );
     }
   }
-  QPair<QString, QString> project = qMakePair( title, mProjectFilePath );
-  projects.insert( 0, project );
-  saveRecentProjects( projects );
-
-  QList<QgsMapLayer *> vectorLayers;
-  QList<QgsMapLayer *> rasterLayers;
-  QgsCoordinateReferenceSystem crs;
-  QgsRectangle extent;
 
+  const QString suffix = QFileInfo( projectFilePath ).suffix().toLower();
   QStringList files;
   if ( suffix == QStringLiteral( "zip" ) || suffix == QStringLiteral( "7z" ) || suffix == QStringLiteral( "rar" ) )
   {
     // get list of files inside zip file
     QString tmpPath;
-    char **papszSiblingFiles = VSIReadDirRecursive( QStringLiteral( "/vsi%1/%2" ).arg( suffix, mProjectFilePath ).toLocal8Bit().constData() );
+    char **papszSiblingFiles = VSIReadDirRecursive( QStringLiteral( "/vsi%1/%2" ).arg( suffix, projectFilePath ).toLocal8Bit().constData() );
     if ( papszSiblingFiles )
     {
       for ( int i = 0; papszSiblingFiles[i]; i++ )
@@ -873,28 +904,34 @@ void QgisMobileapp::readProjectFile()
         {
           const QFileInfo tmpFi( tmpPath );
           if ( SUPPORTED_VECTOR_EXTENSIONS.contains( tmpFi.suffix().toLower() ) || SUPPORTED_RASTER_EXTENSIONS.contains( tmpFi.suffix().toLower() ) )
-            files << QStringLiteral( "/vsi%1/%2/%3" ).arg( suffix, mProjectFilePath, tmpPath );
+            files << QStringLiteral( "/vsi%1/%2/%3" ).arg( suffix, projectFilePath, tmpPath );
         }
       }
       CSLDestroy( papszSiblingFiles );
     }
   }
-  else if ( !projectLoaded )
+  else if ( !hasProject )
   {
-    files << mProjectFilePath;
+    files << projectFilePath;
   }
 
-  QgsProviderSublayerDetails::LayerOptions options( QgsProject::instance()->transformContext() );
+  // The project has been cleared, its transform context is the default one
+  const QgsCoordinateTransformContext transformContext;
+  QgsProviderSublayerDetails::LayerOptions options( transformContext );
   options.loadDefaultStyle = true;
 
-  for ( auto filePath : std::as_const( files ) )
+  for ( int fileIndex = 0; fileIndex < files.size(); ++fileIndex )
   {
+    if ( feedback->isCanceled() )
+      break;
+
+    QString filePath = files.at( fileIndex );
     const QString fileSuffix = QFileInfo( filePath ).suffix().toLower();
 
     if ( fileSuffix == QLatin1String( "kmz" ) )
     {
       // GDAL's internal KML driver doesn't support KMZ, work around this limitation
-      filePath = QStringLiteral( "/vsizip/%1/doc.kml" ).arg( mProjectFilePath );
+      filePath = QStringLiteral( "/vsizip/%1/doc.kml" ).arg( projectFilePath );
     }
     else if ( fileSuffix == QLatin1String( "pdf" ) )
     {
@@ -902,29 +939,32 @@ void QgisMobileapp::readProjectFile()
       filePath += QStringLiteral( "|option:DPI=300" );
     }
 
-    const QList<QgsProviderSublayerDetails> sublayers = QgsProviderRegistry::instance()->querySublayers( filePath, Qgis::SublayerQueryFlags() | Qgis::SublayerQueryFlag::ResolveGeometryType );
+    const QList<QgsProviderSublayerDetails> sublayers = QgsProviderRegistry::instance()->querySublayers( filePath, Qgis::SublayerQueryFlags() | Qgis::SublayerQueryFlag::ResolveGeometryType, feedback.get() );
     for ( const QgsProviderSublayerDetails &sublayer : sublayers )
     {
+      if ( feedback->isCanceled() )
+        break;
+
       std::unique_ptr<QgsMapLayer> layer( sublayer.toLayer( options ) );
       if ( !layer || !layer->isValid() )
         continue;
 
       if ( layer->crs().isValid() )
       {
-        if ( !crs.isValid() )
-          crs = layer->crs();
+        if ( !data.crs.isValid() )
+          data.crs = layer->crs();
 
         if ( !layer->extent().isEmpty() )
         {
-          if ( crs != layer->crs() )
+          if ( data.crs != layer->crs() )
           {
-            QgsCoordinateTransform transform( layer->crs(), crs, mProject->transformContext() );
+            QgsCoordinateTransform transform( layer->crs(), data.crs, transformContext );
             try
             {
-              if ( extent.isEmpty() )
-                extent = transform.transformBoundingBox( layer->extent() );
+              if ( data.extent.isEmpty() )
+                data.extent = transform.transformBoundingBox( layer->extent() );
               else
-                extent.combineExtentWith( transform.transformBoundingBox( layer->extent() ) );
+                data.extent.combineExtentWith( transform.transformBoundingBox( layer->extent() ) );
             }
             catch ( const QgsCsException &exp )
             {
@@ -934,10 +974,10 @@ void QgisMobileapp::readProjectFile()
           }
           else
           {
-            if ( extent.isEmpty() )
-              extent = layer->extent();
+            if ( data.extent.isEmpty() )
+              data.extent = layer->extent();
             else
-              extent.combineExtentWith( layer->extent() );
+              data.extent.combineExtentWith( layer->extent() );
           }
         }
       }
@@ -945,10 +985,12 @@ void QgisMobileapp::readProjectFile()
       switch ( sublayer.type() )
       {
         case Qgis::LayerType::Vector:
-          vectorLayers << layer.release();
+          layer->moveToThread( targetThread );
+          data.vectorLayers << layer.release();
           break;
         case Qgis::LayerType::Raster:
-          rasterLayers << layer.release();
+          layer->moveToThread( targetThread );
+          data.rasterLayers << layer.release();
           break;
         case Qgis::LayerType::Mesh:
         case Qgis::LayerType::VectorTile:
@@ -961,8 +1003,128 @@ void QgisMobileapp::readProjectFile()
           break;
       }
     }
+
+    feedback->setProgress( 100.0 * ( fileIndex + 1 ) / files.size() );
+  }
+
+  return data;
+}
+
+void QgisMobileapp::finishReadProjectFile( const ProjectLoadData &data, const QString &projectUri )
+{
+  if ( mProjectLoadFeedback->isCanceled() )
+  {
+    qDeleteAll( data.vectorLayers );
+    qDeleteAll( data.rasterLayers );
+    endProjectLoad();
+    return;
+  }
+
+  QFileInfo fi( mProjectFilePath );
+  const QString suffix = fi.suffix().toLower();
+
+  QgsScopedRuntimeProfile profile( tr( "Register fonts" ), ProfilerUtils::projectOpenGroup() );
+
+  // load project file fonts if present
+  for ( const QString &fontFile : data.fontFiles )
+  {
+    const int id = QFontDatabase::addApplicationFont( fontFile );
+    qInfo() << QStringLiteral( "Project font registered: %1" ).arg( fontFile );
+    if ( id == -1 )
+    {
+      QgsMessageLog::logMessage( tr( "Could not load font: %1" ).arg( QFileInfo( fontFile ).fileName() ) );
+    }
+  }
+
+  // Load project file
+  bool projectLoaded = false;
+  if ( !projectUri.isEmpty() )
+  {
+    emit loadProjectProgress( PROJECT_LOAD_GATHER_PROGRESS, tr( "Reading project" ) );
+    profile.switchTask( tr( "Read project" ) );
+
+    // QgsProject::read() must run on the main thread, keep the progress reporting painted while layers are loaded.
+    // User input is held back until the project is read, project loads triggered meanwhile cancel the feedback
+    // and are deferred through mProjectLoading.
+    QMetaObject::Connection layerLoadedConnection = connect( mProject, &QgsProject::layerLoaded, this, [this]( int i, int n ) {
+      // Once canceled, the remaining layers are read without further events processing and the project is cleared
+      if ( mProjectLoadFeedback->isCanceled() )
+        return;
+
+      emit loadProjectProgress( PROJECT_LOAD_GATHER_PROGRESS + ( PROJECT_LOAD_READ_PROGRESS - PROJECT_LOAD_GATHER_PROGRESS ) * i / std::max( 1, n ), tr( "Loading layers" ) );
+      QCoreApplication::processEvents( QEventLoop::ExcludeUserInputEvents );
+    } );
+    Qgis::ProjectReadFlags readFlags = Qgis::ProjectReadFlag::DontLoadProjectStyles | Qgis::ProjectReadFlag::DontLoad3DViews;
+    const bool deferLayerLoading = DeferredLayerLoader::isEnabled();
+    if ( deferLayerLoading )
+    {
+      // Layers are read without creating their data provider, the loader creates them as layers are needed
+      readFlags |= Qgis::ProjectReadFlag::DontResolveLayers;
+    }
+    mProject->read( projectUri, readFlags );
+    disconnect( layerLoadedConnection );
+
+    // The project is fully read, deliver the user input held back meanwhile so a tap on the cancel button is polled below
+    QCoreApplication::processEvents();
+
+    if ( mProjectLoadFeedback->isCanceled() )
+    {
+      mProject->clear();
+      endProjectLoad();
+      return;
+    }
+
+    if ( deferLayerLoading )
+    {
+      profile.switchTask( tr( "Load visible layers" ) );
+      DeferredLayerLoader::instance()->setup( mProject, mMapCanvas->mapSettings() );
+    }
+
+    mProject->writeEntry( QStringLiteral( "QField" ), QStringLiteral( "isDataset" ), false );
+    projectLoaded = true;
+  }
+
+  emit loadProjectProgress( PROJECT_LOAD_READ_PROGRESS, tr( "Restoring project state" ) );
+  profile.switchTask( tr( "Set up layers" ) );
+
+  if ( projectLoaded )
+  {
+    if ( !mProject->error().isEmpty() )
+    {
+      QgsMessageLog::logMessage( mProject->error() );
+    }
   }
 
+  QString title;
+  if ( mProject->fileName().startsWith( QFieldCloudUtils::localCloudDirectory() ) )
+  {
+    // Overwrite the title to match what is used in QFieldCloud
+    const QString projectId = fi.dir().dirName();
+    title = QSettings().value( QStringLiteral( "QFieldCloud/projects/%1/name" ).arg( projectId ), fi.fileName() ).toString();
+  }
+  else
+  {
+    title = mProject->title().isEmpty() ? mProjectFileName : mProject->title();
+  }
+
+  QList<QPair<QString, QString>> projects = recentProjects();
+  for ( int idx = 0; idx < projects.count(); idx++ )
+  {
+    if ( projects.at( idx ).second == mProjectFilePath )
+    {
+      projects.removeAt( idx );
+      break;
+    }
+  }
+  QPair<QString, QString> project = qMakePair( title, mProjectFilePath );
+  projects.insert( 0, project );
+  saveRecentProjects( projects );
+
+  QList<QgsMapLayer *> vectorLayers = data.vectorLayers;
+  QList<QgsMapLayer *> rasterLayers = data.rasterLayers;
+  QgsCoordinateReferenceSystem crs = data.crs;
+  QgsRectangle extent = data.extent;
+
   if ( vectorLayers.size() > 1 )
   {
     std::sort( vectorLayers.begin(), vectorLayers.end(), []( QgsMapLayer *a, QgsMapLayer *b ) {
@@ -1201,18 +1363,55 @@ void QgisMobileapp::readProjectFile()
     mMapCanvas->mapSettings()->setExtent( extent.buffered( extent.width() * 0.02 ) );
   }
 
+  profile.switchTask( tr( "Restore project settings" ) );
   ProjectInfo::restoreSettings( mProjectFilePath, mProject, mMapCanvas, mFlatLayerTree );
+  profile.switchTask( tr( "Create trackers" ) );
   mTrackingModel->createProjectTrackers( mProject );
 
   emit loadProjectEnded( mProjectFilePath, mProjectFileName );
 
   connect( mMapCanvas, &QgsQuickMapCanvasMap::mapCanvasRefreshed, this, &QgisMobileapp::onMapCanvasRefreshed );
 
+  profile.switchTask( tr( "Load project plugin" ) );
   const QString projectPluginPath = PluginManager::findProjectPlugin( mProjectFilePath );
   if ( !projectPluginPath.isEmpty() )
   {
     mPluginManager->loadPlugin( projectPluginPath, tr( "Project Plugin" ) );
   }
+
+  endProjectLoad();
+}
+
+void QgisMobileapp::logProjectLoadProfile()
+{
+  const QStringList groups = { ProfilerUtils::projectOpenGroup(), ProfilerUtils::projectLoadGroup(), ProfilerUtils::projectRenderGroup() };
+  QgsMessageLog::logMessage( tr( "Project load profile:\n%1" ).arg( ProfilerUtils::report( groups ) ), QStringLiteral( "QField" ), Qgis::Info );
+
+  const QString tracePath = QStringLiteral( "%1/profiling/projectload.json" ).arg( QStandardPaths::writableLocation( QStandardPaths::AppDataLocation ) );
+  if ( !ProfilerUtils::writeTrace( tracePath, groups ) )
+  {
+    QgsMessageLog::logMessage( tr( "Could not write the project load trace to %1" ).arg( tracePath ), QStringLiteral( "QField" ), Qgis::Warning );
+  }
+}
+
+void QgisMobileapp::endProjectLoad()
+{
+  const bool canceled = mProjectLoadFeedback->isCanceled();
+  mProjectLoading = false;
+
+  if ( mProjectReadPending )
+  {
+    mProjectReadPending = false;
+    QTimer::singleShot( 0, this, &QgisMobileapp::readProjectFile );
+  }
+  else if ( canceled )
+  {
+    // Do not reopen a canceled project on next launch
+    QSettings().remove( QStringLiteral( "QField/lastProjectFilePath" ) );
+    emit loadProjectCanceled( mProjectFilePath, mProjectFileName );
+    mProjectFilePath.clear();
+    mProjectFileName.clear();
+  }
 }
 
 QString QgisMobileapp::readProjectEntry( const QString &scope, const QString &key, const QString &def ) const
@@ -19,15 +19,21 @@
 #define QGISMOBILEAPP_H
 
 // Qt includes
+#include <QElapsedTimer>
 #include <QtQml/QQmlApplicationEngine>
 
 // QGIS includes
 #include <qgsapplication.h>
 #include <qgsconfig.h>
+#include <qgscoordinatereferencesystem.h>
 #include <qgsexiftools.h>
+#include <qgsfeedback.h>
 #include <qgsmaplayerproxymodel.h>
+#include <qgsrectangle.h>
 #include <qgsunittypes.h>
 
+#include <memory>
+
 // QField includes
 #include "appcoordinateoperationhandlers.h"
 #include "bookmarkmodel.h"
@@ -54,9 +60,11 @@ class TrackingModel;
 class LocatorFiltersModel;
 class QgsProject;
 class LayerObserver;
+class FeaturesSearchIndex;
 class FeatureHistory;
 class MessageLogModel;
 class QgsPrintLayout;
+class QThread;
 
 #define REGISTER_SINGLETON( uri, _class, name ) qmlRegisterSingletonType<_class>( uri, 1, 0, name, []( QQmlEngine *engine, QJSEngine *scriptEngine ) -> QObject * { Q_UNUSED(engine); Q_UNUSED(scriptEngine); return new _class(); } )
 
@@ -112,10 +120,20 @@ class QFIELD_CORE_EXPORT QgisMobileapp : public QQmlApplicationEngine
     void reloadProjectFile();
 
     /**
-     * Reads and opens the project file set in the loadProjectFile function
+     * Reads and opens the project file set in the loadProjectFile function.
+     *
+     * Fonts and datasets are scanned, and dataset layers constructed, on a worker thread
+     * while QgsProject::read() runs on the main thread. Progress is reported through
+     * loadProjectProgress() and loadProjectEnded() is emitted once the project is opened.
      */
     void readProjectFile();
 
+    /**
+     * Cancels the ongoing project load. The cancelation takes effect at the next loading stage,
+     * the project is then cleared and loadProjectCanceled() emitted.
+     */
+    void cancelProjectLoad();
+
     /**
      * Reads a string from the specified \a scope and \a key from the currently opened project
      *
@@ -204,6 +222,17 @@ class QFIELD_CORE_EXPORT QgisMobileapp : public QQmlApplicationEngine
      */
     void loadProjectEnded( const QString &filename, const QString &name );
 
+    /**
+     * Emitted when an ongoing project load reports its \a progress (between 0.0 and 1.0)
+     * along with the name of its current \a stage
+     */
+    void loadProjectProgress( double progress, const QString &stage );
+
+    /**
+     * Emitted when a project load has been canceled
+     */
+    void loadProjectCanceled( const QString &filename, const QString &name );
+
     /**
      * Emitted when a map canvas extent change is needed
      */
@@ -215,6 +244,31 @@ class QFIELD_CORE_EXPORT QgisMobileapp : public QQmlApplicationEngine
     void onMapCanvasRefreshed();
 
   private:
+    //! Fonts and dataset layers gathered on a worker thread while a project is loading
+    struct ProjectLoadData
+    {
+        QStringList fontFiles;
+        QList<QgsMapLayer *> vectorLayers;
+        QList<QgsMapLayer *> rasterLayers;
+        QgsCoordinateReferenceSystem crs;
+        QgsRectangle extent;
+    };
+
+    /**
+     * Gathers the fonts and dataset layers of the \a projectFilePath, constructed layers are moved
+     * to the \a targetThread. Datasets are not scanned when the file \a hasProject to be read.
+     */
+    static ProjectLoadData gatherProjectData( const QString &projectFilePath, bool hasProject, std::shared_ptr<QgsFeedback> feedback, QThread *targetThread );
+
+    //! Reads the project \a projectUri if any and sets up the gathered \a data on the main thread
+    void finishReadProjectFile( const ProjectLoadData &data, const QString &projectUri );
+
+    //! Wraps up the ongoing project load, reading a project triggered meanwhile
+    void endProjectLoad();
+
+    //! Logs the timings of the last project opening and writes them into a trace file
+    void logProjectLoadProfile();
+
     void registerGlobalVariables();
     void loadProjectQuirks();
     void saveProjectPreviewImage();
@@ -236,8 +290,19 @@ class QFIELD_CORE_EXPORT QgisMobileapp : public QQmlApplicationEngine
     QString mProjectFilePath;
     QString mProjectFileName;
 
+    bool mProjectLoading = false;
+    bool mProjectReadPending = false;
+    std::shared_ptr<QgsFeedback> mProjectLoadFeedback;
+    //! Times the project opening stages, up to the first map render
+    QElapsedTimer mProjectLoadTimer;
+
+    //! Overall progress reached once datasets are gathered, and once the project is read
+    static constexpr double PROJECT_LOAD_GATHER_PROGRESS = 0.2;
+    static constexpr double PROJECT_LOAD_READ_PROGRESS = 0.9;
+
     std::unique_ptr<QgsGpkgFlusher> mGpkgFlusher;
     std::unique_ptr<LayerObserver> mLayerObserver;
+    std::unique_ptr<FeaturesSearchIndex> mFeaturesSearchIndex;
     std::unique_ptr<FeatureHistory> mFeatureHistory;
     std::unique_ptr<ClipboardManager> mClipboardManager;
 
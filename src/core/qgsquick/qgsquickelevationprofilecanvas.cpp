@@ -33,6 +33,10 @@
 #include "qgsquickelevationprofilecanvas.h"
 #include "qgsterrainprovider.h"
 
+#include <algorithm>
+#include <limits>
+
+#include <QCryptographicHash>
 #include <QQuickWindow>
 #include <QSGSimpleRectNode>
 #include <QSGSimpleTextureNode>
@@ -74,9 +78,9 @@ class QgsElevationProfilePlotItem : public Qgs2DPlot
       setSize( mCanvas->boundingRect().size() );
     }
 
-    void setRenderer( QgsProfilePlotRenderer *renderer )
+    void setChunks( const QList<QgsQuickElevationProfileCanvas::ProfileChunk> &chunks )
     {
-      mRenderer = renderer;
+      mChunks = chunks;
     }
 
     void updateRect()
@@ -120,10 +124,10 @@ class QgsElevationProfilePlotItem : public Qgs2DPlot
     {
       mPlotArea = plotArea;
 
-      if ( !mRenderer )
+      if ( mChunks.isEmpty() )
         return;
 
-      const QStringList sourceIds = mRenderer->sourceIds();
+      const QStringList sourceIds = mChunks.constFirst().renderer->sourceIds();
       for ( const QString &source : sourceIds )
       {
         QImage plot;
@@ -143,7 +147,21 @@ class QgsElevationProfilePlotItem : public Qgs2DPlot
           plotPainter.setRenderHint( QPainter::Antialiasing, true );
           QgsRenderContext plotRc = QgsRenderContext::fromQPainter( &plotPainter );
           plotRc.setDevicePixelRatio( devicePixelRatio );
-          mRenderer->render( plotRc, plotArea.width(), plotArea.height(), xMinimum(), xMaximum(), yMinimum(), yMaximum(), source );
+          const double pixelsPerDistance = plotArea.width() / ( xMaximum() - xMinimum() );
+          for ( const QgsQuickElevationProfileCanvas::ProfileChunk &chunk : std::as_const( mChunks ) )
+          {
+            // skip chunks outside of the visible distance range
+            if ( chunk.distanceOffset > xMaximum() || chunk.distanceOffset + chunk.length < xMinimum() )
+              continue;
+
+            // vector features within tolerance of a chunk can be located past its ends, clip them to the chunk
+            // so that features near chunk boundaries are not drawn over the results of neighboring chunks
+            const double chunkLeft = ( chunk.distanceOffset - xMinimum() ) * pixelsPerDistance;
+            plotPainter.save();
+            plotPainter.setClipRect( QRectF( chunkLeft, 0, chunk.length * pixelsPerDistance, plotArea.height() ) );
+            chunk.renderer->render( plotRc, plotArea.width(), plotArea.height(), xMinimum() - chunk.distanceOffset, xMaximum() - chunk.distanceOffset, yMinimum(), yMaximum(), source );
+            plotPainter.restore();
+          }
           plotPainter.end();
 
           mCachedImages.insert( source, plot );
@@ -154,7 +172,7 @@ class QgsElevationProfilePlotItem : public Qgs2DPlot
 
   private:
     QgsQuickElevationProfileCanvas *mCanvas = nullptr;
-    QgsProfilePlotRenderer *mRenderer = nullptr;
+    QList<QgsQuickElevationProfileCanvas::ProfileChunk> mChunks;
 
     QRectF mPlotArea;
     QMap<QString, QImage> mCachedImages;
@@ -184,24 +202,24 @@ QgsQuickElevationProfileCanvas::QgsQuickElevationProfileCanvas( QQuickItem *pare
 
 QgsQuickElevationProfileCanvas::~QgsQuickElevationProfileCanvas()
 {
-  if ( mCurrentJob )
-  {
-    mPlotItem->setRenderer( nullptr );
-    mCurrentJob->deleteLater();
-    mCurrentJob = nullptr;
-  }
+  mPlotItem->setChunks( QList<ProfileChunk>() );
+  mActiveChunks.clear();
+  clearChunkCache();
 }
 
 void QgsQuickElevationProfileCanvas::cancelJobs()
 {
-  if ( mCurrentJob )
+  mPlotItem->setChunks( QList<ProfileChunk>() );
+  for ( const ProfileChunk &chunk : std::as_const( mActiveChunks ) )
   {
-    mPlotItem->setRenderer( nullptr );
-    disconnect( mCurrentJob, &QgsProfilePlotRenderer::generationFinished, this, &QgsQuickElevationProfileCanvas::generationFinished );
-    mCurrentJob->cancelGeneration();
-    mCurrentJob->deleteLater();
-    mCurrentJob = nullptr;
+    if ( chunk.renderer->isActive() )
+    {
+      // partially generated results can't be reused
+      chunk.renderer->cancelGeneration();
+      removeCachedChunk( chunk.key );
+    }
   }
+  mActiveChunks.clear();
 }
 
 void QgsQuickElevationProfileCanvas::setupLayerConnections( QgsMapLayer *layer, bool isDisconnect )
@@ -257,7 +275,12 @@ void QgsQuickElevationProfileCanvas::setupLayerConnections( QgsMapLayer *layer,
 
 bool QgsQuickElevationProfileCanvas::isRendering() const
 {
-  return mCurrentJob && mCurrentJob->isActive();
+  for ( const ProfileChunk &chunk : mActiveChunks )
+  {
+    if ( chunk.renderer->isActive() )
+      return true;
+  }
+  return false;
 }
 
 void QgsQuickElevationProfileCanvas::refresh()
@@ -265,15 +288,92 @@ void QgsQuickElevationProfileCanvas::refresh()
   if ( !mCrs.isValid() || !mProject || mProfileCurve.isEmpty() )
     return;
 
-  if ( mCurrentJob )
+  const QgsCurve *curve = qgsgeometry_cast<const QgsCurve *>( mProfileCurve.constGet() );
+  if ( !curve )
+    return;
+
+  cancelJobs();
+
+  const double plotWidth = mPlotItem->plotArea().width();
+  if ( plotWidth <= 0 || qgsDoubleNear( curve->length(), 0.0 ) )
+    return;
+
+  mGenerationContext = generationContext( curve->length() * 1.02 / plotWidth );
+
+  // The chunk keys identify the CRS, tolerance, and layers alongside the chunk vertices
+  QString keyPrefix = QStringLiteral( "%1|%2" ).arg( mCrs.authid().isEmpty() ? mCrs.toWkt() : mCrs.authid() ).arg( mTolerance );
+  const QList<QgsMapLayer *> profileLayers = layers();
+  for ( QgsMapLayer *layer : profileLayers )
+  {
+    keyPrefix += '|' + layer->id();
+  }
+
+  std::unique_ptr<QgsLineString> line( curve->curveToLine() );
+  QgsPointSequence points;
+  line->points( points );
+
+  bool needsGeneration = false;
+  double distanceOffset = 0;
+  for ( int i = 0; i < points.size() - 1; i += CHUNK_SEGMENT_COUNT )
+  {
+    const QgsPointSequence chunkPoints = points.mid( i, std::min<int>( CHUNK_SEGMENT_COUNT + 1, static_cast<int>( points.size() ) - i ) );
+
+    QCryptographicHash hash( QCryptographicHash::Sha1 );
+    hash.addData( keyPrefix.toUtf8() );
+    for ( const QgsPoint &point : chunkPoints )
+    {
+      const double coordinates[3] = { point.x(), point.y(), point.is3D() ? point.z() : 0.0 };
+      hash.addData( QByteArrayView( reinterpret_cast<const char *>( coordinates ), sizeof( coordinates ) ) );
+    }
+
+    ProfileChunk chunk;
+    chunk.key = QString::fromLatin1( hash.result().toHex() );
+    chunk.distanceOffset = distanceOffset;
+    chunk.length = QgsLineString( chunkPoints ).length();
+    distanceOffset += chunk.length;
+
+    auto it = mChunkCache.find( chunk.key );
+    if ( it == mChunkCache.end() )
+    {
+      CachedProfileChunk cachedChunk;
+      cachedChunk.renderer = createChunkRenderer( chunkPoints );
+      it = mChunkCache.insert( chunk.key, cachedChunk );
+      chunk.renderer = cachedChunk.renderer;
+      it->context = chunkContext( chunk );
+      chunk.renderer->setContext( it->context );
+      chunk.renderer->startGeneration();
+      needsGeneration = true;
+    }
+    chunk.renderer = it->renderer;
+    it->lastUsed = ++mChunkCacheCounter;
+    mActiveChunks << chunk;
+  }
+
+  if ( applyGenerationContext() )
+  {
+    needsGeneration = true;
+  }
+
+  pruneChunkCache();
+
+  mPlotItem->updatePlot();
+  mPlotItem->setChunks( mActiveChunks );
+
+  if ( needsGeneration )
   {
-    mPlotItem->setRenderer( nullptr );
-    disconnect( mCurrentJob, &QgsProfilePlotRenderer::generationFinished, this, &QgsQuickElevationProfileCanvas::generationFinished );
-    mCurrentJob->deleteLater();
-    mCurrentJob = nullptr;
+    emit activeJobCountChanged( 1 );
+    emit isRenderingChanged();
   }
+  else
+  {
+    // all chunks were found in the cache, the profile can be drawn right away
+    generationFinished();
+  }
+}
 
-  QgsProfileRequest request( static_cast<QgsCurve *>( mProfileCurve.get()->clone() ) );
+QgsProfilePlotRenderer *QgsQuickElevationProfileCanvas::createChunkRenderer( const QgsPointSequence &points )
+{
+  QgsProfileRequest request( new QgsLineString( points ) );
   request.setCrs( mCrs );
   request.setTolerance( mTolerance );
   request.setTransformContext( mProject->transformContext() );
@@ -293,26 +393,147 @@ void QgsQuickElevationProfileCanvas::refresh()
       sources.append( source );
   }
 
-  mCurrentJob = new QgsProfilePlotRenderer( sources, request );
-  connect( mCurrentJob, &QgsProfilePlotRenderer::generationFinished, this, &QgsQuickElevationProfileCanvas::generationFinished );
+  QgsProfilePlotRenderer *renderer = new QgsProfilePlotRenderer( sources, request );
+  connect( renderer, &QgsProfilePlotRenderer::generationFinished, this, &QgsQuickElevationProfileCanvas::generationFinished );
+  return renderer;
+}
+
+QgsProfileGenerationContext QgsQuickElevationProfileCanvas::generationContext( double distanceUnitsPerPixel ) const
+{
+  QgsProfileGenerationContext context;
+  context.setDpi( window()->screen()->physicalDotsPerInch() * window()->screen()->devicePixelRatio() );
 
-  QgsProfileGenerationContext generationContext;
-  generationContext.setDpi( window()->screen()->physicalDotsPerInch() * window()->screen()->devicePixelRatio() );
-  generationContext.setMaximumErrorMapUnits( MAX_ERROR_PIXELS * ( mProfileCurve.get()->length() ) / mPlotItem->plotArea().width() );
-  generationContext.setMapUnitsPerDistancePixel( mProfileCurve.get()->length() / mPlotItem->plotArea().width() );
-  mCurrentJob->setContext( generationContext );
+  // we round the actual desired map error down to just one significant figure, to avoid tiny differences
+  // as the plot is panned or the profile curve slightly grows, which would invalidate cached chunks
+  const double targetMaxErrorInMapUnits = MAX_ERROR_PIXELS * distanceUnitsPerPixel;
+  const double factor = std::pow( 10.0, 1 - std::ceil( std::log10( std::fabs( targetMaxErrorInMapUnits ) ) ) );
+  context.setMaximumErrorMapUnits( std::floor( targetMaxErrorInMapUnits * factor ) / factor );
+  context.setMapUnitsPerDistancePixel( std::floor( distanceUnitsPerPixel * factor ) / factor );
 
-  mPlotItem->updatePlot();
-  mCurrentJob->startGeneration();
-  mPlotItem->setRenderer( mCurrentJob );
+  return context;
+}
+
+QgsProfileGenerationContext QgsQuickElevationProfileCanvas::chunkContext( const ProfileChunk &chunk ) const
+{
+  QgsProfileGenerationContext context = mGenerationContext;
+
+  // Clamp the distance range to the chunk, so fully visible chunks keep an identical context
+  const QgsDoubleRange distanceRange = mGenerationContext.distanceRange();
+  const double lower = std::clamp( distanceRange.lower() - chunk.distanceOffset, 0.0, chunk.length );
+  const double upper = std::clamp( distanceRange.upper() - chunk.distanceOffset, 0.0, chunk.length );
+  context.setDistanceRange( QgsDoubleRange( lower, upper ) );
+
+  return context;
+}
+
+bool QgsQuickElevationProfileCanvas::applyGenerationContext()
+{
+  bool invalidated = false;
+  for ( const ProfileChunk &chunk : std::as_const( mActiveChunks ) )
+  {
+    auto it = mChunkCache.find( chunk.key );
+    if ( it == mChunkCache.end() )
+      continue;
 
-  emit activeJobCountChanged( 1 );
-  emit isRenderingChanged();
+    const QgsProfileGenerationContext context = chunkContext( chunk );
+    if ( it->context == context )
+      continue;
+
+    it->context = context;
+    chunk.renderer->setContext( context );
+    if ( !chunk.renderer->isActive() )
+    {
+      chunk.renderer->regenerateInvalidatedResults();
+      invalidated = true;
+    }
+  }
+  return invalidated;
+}
+
+bool QgsQuickElevationProfileCanvas::invalidateResults( QgsAbstractProfileSource *source )
+{
+  // Inactive chunks would otherwise keep outdated results of the source
+  const QStringList keys = mChunkCache.keys();
+  for ( const QString &key : keys )
+  {
+    const bool isActive = std::any_of( mActiveChunks.constBegin(), mActiveChunks.constEnd(), [&key]( const ProfileChunk &chunk ) { return chunk.key == key; } );
+    if ( !isActive )
+      removeCachedChunk( key );
+  }
+
+  bool invalidated = false;
+  for ( const ProfileChunk &chunk : std::as_const( mActiveChunks ) )
+  {
+    if ( chunk.renderer->invalidateResults( source ) )
+      invalidated = true;
+  }
+  return invalidated;
+}
+
+void QgsQuickElevationProfileCanvas::removeCachedChunk( const QString &key )
+{
+  auto it = mChunkCache.find( key );
+  if ( it == mChunkCache.end() )
+    return;
+
+  disconnect( it->renderer, &QgsProfilePlotRenderer::generationFinished, this, &QgsQuickElevationProfileCanvas::generationFinished );
+  if ( it->renderer->isActive() )
+    it->renderer->cancelGeneration();
+  it->renderer->deleteLater();
+  mChunkCache.erase( it );
+}
+
+void QgsQuickElevationProfileCanvas::pruneChunkCache()
+{
+  if ( mChunkCache.size() <= MAX_CACHED_CHUNKS )
+    return;
+
+  QList<QPair<quint64, QString>> inactiveChunks;
+  for ( auto it = mChunkCache.constBegin(); it != mChunkCache.constEnd(); ++it )
+  {
+    const bool isActive = std::any_of( mActiveChunks.constBegin(), mActiveChunks.constEnd(), [&it]( const ProfileChunk &chunk ) { return chunk.key == it.key(); } );
+    if ( !isActive )
+      inactiveChunks << qMakePair( it->lastUsed, it.key() );
+  }
+
+  std::sort( inactiveChunks.begin(), inactiveChunks.end() );
+  for ( const QPair<quint64, QString> &inactiveChunk : std::as_const( inactiveChunks ) )
+  {
+    if ( mChunkCache.size() <= MAX_CACHED_CHUNKS )
+      break;
+    removeCachedChunk( inactiveChunk.second );
+  }
+}
+
+void QgsQuickElevationProfileCanvas::clearChunkCache()
+{
+  const QStringList keys = mChunkCache.keys();
+  for ( const QString &key : keys )
+  {
+    removeCachedChunk( key );
+  }
+}
+
+QgsDoubleRange QgsQuickElevationProfileCanvas::zRange() const
+{
+  double lower = std::numeric_limits<double>::max();
+  double upper = std::numeric_limits<double>::lowest();
+  for ( const ProfileChunk &chunk : mActiveChunks )
+  {
+    const QgsDoubleRange chunkRange = chunk.renderer->zRange();
+    if ( chunkRange.upper() < chunkRange.lower() )
+      continue;
+
+    lower = std::min( lower, chunkRange.lower() );
+    upper = std::max( upper, chunkRange.upper() );
+  }
+  return QgsDoubleRange( lower, upper );
 }
 
 void QgsQuickElevationProfileCanvas::generationFinished()
 {
-  if ( !mCurrentJob )
+  // wait until all active chunks are generated
+  if ( mActiveChunks.isEmpty() || isRendering() )
     return;
 
   emit activeJobCountChanged( 0 );
@@ -347,7 +568,10 @@ void QgsQuickElevationProfileCanvas::generationFinished()
   if ( mForceRegenerationAfterCurrentJobCompletes )
   {
     mForceRegenerationAfterCurrentJobCompletes = false;
-    mCurrentJob->invalidateAllRefinableSources();
+    for ( const ProfileChunk &chunk : std::as_const( mActiveChunks ) )
+    {
+      chunk.renderer->invalidateAllRefinableSources();
+    }
     scheduleDeferredRegeneration();
   }
   else
@@ -359,7 +583,7 @@ void QgsQuickElevationProfileCanvas::generationFinished()
 void QgsQuickElevationProfileCanvas::onLayerProfileGenerationPropertyChanged()
 {
   // TODO -- handle nicely when existing job is in progress
-  if ( !mCurrentJob || mCurrentJob->isActive() )
+  if ( mActiveChunks.isEmpty() || isRendering() )
     return;
 
   QgsMapLayerElevationProperties *properties = qobject_cast<QgsMapLayerElevationProperties *>( sender() );
@@ -370,7 +594,7 @@ void QgsQuickElevationProfileCanvas::onLayerProfileGenerationPropertyChanged()
   {
     if ( QgsAbstractProfileSource *source = dynamic_cast<QgsAbstractProfileSource *>( layer ) )
     {
-      if ( mCurrentJob->invalidateResults( source ) )
+      if ( invalidateResults( source ) )
         scheduleDeferredRegeneration();
     }
   }
@@ -379,7 +603,7 @@ void QgsQuickElevationProfileCanvas::onLayerProfileGenerationPropertyChanged()
 void QgsQuickElevationProfileCanvas::onLayerProfileRendererPropertyChanged()
 {
   // TODO -- handle nicely when existing job is in progress
-  if ( !mCurrentJob || mCurrentJob->isActive() )
+  if ( mActiveChunks.isEmpty() || isRendering() )
     return;
 
   QgsMapLayerElevationProperties *properties = qobject_cast<QgsMapLayerElevationProperties *>( sender() );
@@ -390,7 +614,10 @@ void QgsQuickElevationProfileCanvas::onLayerProfileRendererPropertyChanged()
   {
     if ( QgsAbstractProfileSource *source = dynamic_cast<QgsAbstractProfileSource *>( layer ) )
     {
-      mCurrentJob->replaceSource( source );
+      for ( const CachedProfileChunk &cachedChunk : std::as_const( mChunkCache ) )
+      {
+        cachedChunk.renderer->replaceSource( source );
+      }
     }
     if ( mPlotItem->redrawResults( layer->id() ) )
       scheduleDeferredRedraw();
@@ -399,14 +626,14 @@ void QgsQuickElevationProfileCanvas::onLayerProfileRendererPropertyChanged()
 
 void QgsQuickElevationProfileCanvas::regenerateResultsForLayer()
 {
-  if ( !mCurrentJob )
+  if ( mChunkCache.isEmpty() )
     return;
 
   if ( QgsMapLayer *layer = qobject_cast<QgsMapLayer *>( sender() ) )
   {
     if ( QgsAbstractProfileSource *source = dynamic_cast<QgsAbstractProfileSource *>( layer ) )
     {
-      if ( mCurrentJob->invalidateResults( source ) )
+      if ( invalidateResults( source ) )
         scheduleDeferredRegeneration();
     }
   }
@@ -432,12 +659,15 @@ void QgsQuickElevationProfileCanvas::scheduleDeferredRedraw()
 
 void QgsQuickElevationProfileCanvas::startDeferredRegeneration()
 {
-  if ( mCurrentJob && !mCurrentJob->isActive() )
+  if ( !mActiveChunks.isEmpty() && !isRendering() )
   {
     emit activeJobCountChanged( 1 );
-    mCurrentJob->regenerateInvalidatedResults();
+    for ( const ProfileChunk &chunk : std::as_const( mActiveChunks ) )
+    {
+      chunk.renderer->regenerateInvalidatedResults();
+    }
   }
-  else if ( mCurrentJob )
+  else if ( !mActiveChunks.isEmpty() )
   {
     mForceRegenerationAfterCurrentJobCompletes = true;
   }
@@ -453,31 +683,30 @@ void QgsQuickElevationProfileCanvas::startDeferredRedraw()
 
 void QgsQuickElevationProfileCanvas::refineResults()
 {
-  if ( mCurrentJob )
+  if ( !mActiveChunks.isEmpty() )
   {
-    QgsProfileGenerationContext context;
-    context.setDpi( window()->screen()->physicalDotsPerInch() * window()->screen()->devicePixelRatio() );
     const double plotDistanceRange = mPlotItem->xMaximum() - mPlotItem->xMinimum();
     const double plotElevationRange = mPlotItem->yMaximum() - mPlotItem->yMinimum();
-    const double plotDistanceUnitsPerPixel = plotDistanceRange / mPlotItem->plotArea().width();
+    QgsProfileGenerationContext context = generationContext( plotDistanceRange / mPlotItem->plotArea().width() );
 
-    // we round the actual desired map error down to just one significant figure, to avoid tiny differences
-    // as the plot is panned
-    const double targetMaxErrorInMapUnits = MAX_ERROR_PIXELS * plotDistanceUnitsPerPixel;
-    const double factor = std::pow( 10.0, 1 - std::ceil( std::log10( std::fabs( targetMaxErrorInMapUnits ) ) ) );
-    const double roundedErrorInMapUnits = std::floor( targetMaxErrorInMapUnits * factor ) / factor;
-    context.setMaximumErrorMapUnits( roundedErrorInMapUnits );
-
-    context.setMapUnitsPerDistancePixel( plotDistanceUnitsPerPixel );
-
-    // for similar reasons we round the minimum distance off to multiples of the maximum error in map units
+    // the minimum distance is rounded off to multiples of the maximum error in map units, to avoid tiny differences as the plot is panned
     const double distanceMin = std::floor( ( mPlotItem->xMinimum() - plotDistanceRange * 0.05 ) / context.maximumErrorMapUnits() ) * context.maximumErrorMapUnits();
     context.setDistanceRange( QgsDoubleRange( std::max( 0.0, distanceMin ),
                                               mPlotItem->xMaximum() + plotDistanceRange * 0.05 ) );
 
     context.setElevationRange( QgsDoubleRange( mPlotItem->yMinimum() - plotElevationRange * 0.05,
                                                mPlotItem->yMaximum() + plotElevationRange * 0.05 ) );
-    mCurrentJob->setContext( context );
+    mGenerationContext = context;
+    for ( const ProfileChunk &chunk : std::as_const( mActiveChunks ) )
+    {
+      auto it = mChunkCache.find( chunk.key );
+      const QgsProfileGenerationContext chunkGenerationContext = chunkContext( chunk );
+      if ( it != mChunkCache.end() && !( it->context == chunkGenerationContext ) )
+      {
+        it->context = chunkGenerationContext;
+        chunk.renderer->setContext( chunkGenerationContext );
+      }
+    }
   }
   scheduleDeferredRegeneration();
 }
@@ -488,6 +717,8 @@ void QgsQuickElevationProfileCanvas::setProject( QgsProject *project )
     return;
 
   mProject = project;
+  cancelJobs();
+  clearChunkCache();
 
   emit projectChanged();
 }
@@ -553,6 +784,9 @@ void QgsQuickElevationProfileCanvas::populateLayersFromProject()
                                       } ),
                       filteredList.end() );
 
+  cancelJobs();
+  clearChunkCache();
+
   mLayers = _qgis_listRawToQPointer( filteredList );
   for ( QgsMapLayer *layer : std::as_const( mLayers ) )
   {
@@ -631,10 +865,10 @@ QSGNode *QgsQuickElevationProfileCanvas::updatePaintNode( QSGNode *oldNode, QQui
 
 void QgsQuickElevationProfileCanvas::zoomFull()
 {
-  if ( !mCurrentJob )
+  if ( mActiveChunks.isEmpty() )
     return;
 
-  const QgsDoubleRange zRange = mCurrentJob->zRange();
+  const QgsDoubleRange zRange = this->zRange();
 
   if ( zRange.upper() < zRange.lower() )
   {
@@ -666,10 +900,10 @@ void QgsQuickElevationProfileCanvas::zoomFull()
 
 void QgsQuickElevationProfileCanvas::zoomFullInRatio()
 {
-  if ( !mCurrentJob )
+  if ( mActiveChunks.isEmpty() )
     return;
 
-  const QgsDoubleRange zRange = mCurrentJob->zRange();
+  const QgsDoubleRange zRange = this->zRange();
   double xLength = mProfileCurve.get()->length();
   double yLength = zRange.upper() - zRange.lower();
   if ( yLength < 0.0 )
@@ -827,13 +1061,8 @@ QgsDoubleRange QgsQuickElevationProfileCanvas::visibleElevationRange() const
 void QgsQuickElevationProfileCanvas::clear()
 {
   setProfileCurve( QgsGeometry() );
-  if ( mCurrentJob )
-  {
-    mPlotItem->setRenderer( nullptr );
-    disconnect( mCurrentJob, &QgsProfilePlotRenderer::generationFinished, this, &QgsQuickElevationProfileCanvas::generationFinished );
-    mCurrentJob->deleteLater();
-    mCurrentJob = nullptr;
-  }
+  // generated chunks are kept in the cache, allowing for an extended profile curve to reuse them
+  cancelJobs();
 
   mZoomFullWhenJobFinished = true;
 
@@ -18,6 +18,7 @@
 #ifndef QGSELEVATIONPROFILECANVAS_H
 #define QGSELEVATIONPROFILECANVAS_H
 
+#include "qgsabstractprofilegenerator.h"
 #include "qgscoordinatereferencesystem.h"
 #include "qgsgeometry.h"
 #include "qgsmaplayer.h"
@@ -51,6 +52,22 @@ class QgsQuickElevationProfileCanvas : public QQuickItem
     Q_PROPERTY( bool isRendering READ isRendering NOTIFY isRenderingChanged )
 
   public:
+    /**
+     * A part of the profile curve with its own profile renderer. Chunks are positioned
+     * along the profile curve at a given distance offset.
+     */
+    struct ProfileChunk
+    {
+        //! The cache key identifying the chunk
+        QString key;
+        //! The profile renderer generating the chunk results
+        QgsProfilePlotRenderer *renderer = nullptr;
+        //! The distance of the chunk start from the profile curve start
+        double distanceOffset = 0;
+        //! The length of the chunk
+        double length = 0;
+    };
+
     /**
      * Constructor for QgsElevationProfileCanvas, with the specified \a parent widget.
      */
@@ -65,8 +82,12 @@ class QgsQuickElevationProfileCanvas : public QQuickItem
     bool isRendering() const;
 
     /**
-     * Triggers a complete regeneration of the profile, causing the profile extraction to perform in the
+     * Triggers a regeneration of the profile, causing the profile extraction to perform in the
      * background.
+     *
+     * The profile curve is split into chunks of consecutive segments, the results of which are cached
+     * per layer. Only chunks which changed since they were last generated (e.g. the last chunk of a
+     * profile curve extended by a new vertex) are extracted again.
      */
     Q_INVOKABLE void refresh();
 
@@ -293,9 +314,35 @@ class QgsQuickElevationProfileCanvas : public QQuickItem
     void refineResults();
 
   private:
+    struct CachedProfileChunk
+    {
+        QgsProfilePlotRenderer *renderer = nullptr;
+        QgsProfileGenerationContext context;
+        quint64 lastUsed = 0;
+    };
+
     void setupLayerConnections( QgsMapLayer *layer, bool isDisconnect );
     void updateStyle();
 
+    //! Returns a new profile renderer for a chunk made of a list of \a points
+    QgsProfilePlotRenderer *createChunkRenderer( const QgsPointSequence &points );
+    //! Returns a generation context for a plot showing \a distanceUnitsPerPixel, rounded to keep cached chunk contexts stable
+    QgsProfileGenerationContext generationContext( double distanceUnitsPerPixel ) const;
+    //! Returns the generation context of a \a chunk derived from the whole profile generation context
+    QgsProfileGenerationContext chunkContext( const ProfileChunk &chunk ) const;
+    //! Applies the current generation context to the active chunks, returns TRUE if results were invalidated
+    bool applyGenerationContext();
+    //! Invalidates results of a profile \a source, returns TRUE if active chunks need to be regenerated
+    bool invalidateResults( QgsAbstractProfileSource *source );
+    //! Removes a chunk matching a given \a key from the cache and deletes its renderer
+    void removeCachedChunk( const QString &key );
+    //! Removes the least recently used inactive chunks when the cache is full
+    void pruneChunkCache();
+    //! Removes all chunks from the cache
+    void clearChunkCache();
+    //! Returns the elevation range covered by the active chunks
+    QgsDoubleRange zRange() const;
+
     QgsCoordinateReferenceSystem mCrs;
     QgsProject *mProject = nullptr;
 
@@ -304,7 +351,14 @@ class QgsQuickElevationProfileCanvas : public QQuickItem
     QImage mImage;
 
     QgsElevationProfilePlotItem *mPlotItem = nullptr;
-    QgsProfilePlotRenderer *mCurrentJob = nullptr;
+
+    QList<ProfileChunk> mActiveChunks;
+    QHash<QString, CachedProfileChunk> mChunkCache;
+    quint64 mChunkCacheCounter = 0;
+    QgsProfileGenerationContext mGenerationContext;
+
+    static constexpr int CHUNK_SEGMENT_COUNT = 8;
+    static constexpr int MAX_CACHED_CHUNKS = 256;
 
     QTimer *mDeferredRegenerationTimer = nullptr;
     bool mDeferredRegenerationScheduled = false;
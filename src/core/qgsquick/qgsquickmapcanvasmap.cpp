@@ -15,27 +15,139 @@
 
 #include "qgsquickmapcanvasmap.h"
 #include "qgsquickmapsettings.h"
+#include "qgsquickmaptilecache.h"
 
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QMutex>
+#include <QPainter>
 #include <QQuickWindow>
 #include <QSGSimpleTextureNode>
 #include <QScreen>
+#include <QStandardPaths>
 #include <qgis.h>
 #include <qgsannotationlayer.h>
 #include <qgsexpressioncontextutils.h>
 #include <qgslabelingresults.h>
+#include <qgsmaplayerstyle.h>
 #include <qgsmaplayertemporalproperties.h>
 #include <qgsmaprenderercache.h>
 #include <qgsmaprendererparalleljob.h>
+#include <qgsmaprenderersequentialjob.h>
 #include <qgsmessagelog.h>
 #include <qgspallabeling.h>
 #include <qgsproject.h>
+#include <qgsproviderregistry.h>
+#include <qgsrenderedfeaturehandlerinterface.h>
 #include <qgsvectorlayer.h>
 
+#include <cstring>
+#include <rhi/qrhi.h>
+
+/**
+ * A texture which is kept across map image updates, uploading new content when
+ * the scene graph commits its texture operations.
+ */
+class MapCanvasTexture : public QSGTexture
+{
+  public:
+    ~MapCanvasTexture() override
+    {
+      // Defer the release until the frames in flight no longer use the texture
+      if ( mTexture )
+        mTexture->deleteLater();
+    }
+
+    //! Sets the \a image to be uploaded on the next commit
+    void setImage( const QImage &image )
+    {
+      mImage = image;
+      mSize = image.size();
+    }
+
+    qint64 comparisonKey() const override { return static_cast<qint64>( reinterpret_cast<quintptr>( this ) ); }
+    QRhiTexture *rhiTexture() const override { return mTexture; }
+    QSize textureSize() const override { return mSize; }
+    bool hasAlphaChannel() const override { return true; }
+    bool hasMipmaps() const override { return false; }
+
+    void commitTextureOperations( QRhi *rhi, QRhiResourceUpdateBatch *resourceUpdates ) override
+    {
+      if ( mImage.isNull() )
+        return;
+
+      // Uploading ARGB32 images as BGRA textures avoids a conversion when supported
+      const bool bgra = mImage.format() == QImage::Format_ARGB32_Premultiplied && rhi->isTextureFormatSupported( QRhiTexture::BGRA8 );
+      const QRhiTexture::Format format = bgra ? QRhiTexture::BGRA8 : QRhiTexture::RGBA8;
+      if ( !mTexture || mTexture->pixelSize() != mSize || mTexture->format() != format )
+      {
+        if ( mTexture )
+          mTexture->deleteLater();
+        mTexture = rhi->newTexture( format, mSize );
+        mTexture->create();
+      }
+
+      resourceUpdates->uploadTexture( mTexture, bgra ? mImage : mImage.convertToFormat( QImage::Format_RGBA8888_Premultiplied ) );
+      mImage = QImage();
+    }
+
+  private:
+    QImage mImage;
+    QSize mSize;
+    QRhiTexture *mTexture = nullptr;
+};
+
+//! Returns TRUE if the pixels within a \a rect are identical in images \a image1 and \a image2
+static bool imageRectEquals( const QImage &image1, const QImage &image2, const QRect &rect )
+{
+  const int bytesPerPixel = image1.depth() / 8;
+  const qsizetype length = static_cast<qsizetype>( rect.width() ) * bytesPerPixel;
+  for ( int y = rect.top(); y <= rect.bottom(); y++ )
+  {
+    if ( std::memcmp( image1.constScanLine( y ) + rect.left() * bytesPerPixel, image2.constScanLine( y ) + rect.left() * bytesPerPixel, length ) != 0 )
+      return false;
+  }
+  return true;
+}
+
+/**
+ * A rendered feature handler counting the features rendered per layer. Features
+ * are handled from the render threads, the counts are guarded by a mutex.
+ */
+class RenderedFeatureCounter : public QgsRenderedFeatureHandlerInterface
+{
+  public:
+    void handleRenderedFeature( const QgsFeature &, const QgsGeometry &, const QgsRenderedFeatureHandlerInterface::RenderedFeatureContext &context ) override
+    {
+      const QString layerId = context.renderContext->expressionContext().variable( QStringLiteral( "layer_id" ) ).toString();
+      QMutexLocker locker( &mMutex );
+      mCounts[layerId]++;
+    }
+
+    //! Returns the number of features rendered for the layer matching a \a layerId
+    long long count( const QString &layerId )
+    {
+      QMutexLocker locker( &mMutex );
+      return mCounts.value( layerId, 0 );
+    }
+
+    //! Resets the counts
+    void reset()
+    {
+      QMutexLocker locker( &mMutex );
+      mCounts.clear();
+    }
+
+  private:
+    QMutex mMutex;
+    QHash<QString, long long> mCounts;
+};
 
 QgsQuickMapCanvasMap::QgsQuickMapCanvasMap( QQuickItem *parent )
   : QQuickItem( parent )
   , mMapSettings( std::make_unique<QgsQuickMapSettings>() )
   , mCache( std::make_unique<QgsMapRendererCache>() )
+  , mRenderedFeatureCounter( std::make_unique<RenderedFeatureCounter>() )
 {
   connect( this, &QQuickItem::windowChanged, this, &QgsQuickMapCanvasMap::onWindowChanged );
   connect( &mRefreshTimer, &QTimer::timeout, this, [=] { refreshMap(); } );
@@ -49,6 +161,12 @@ QgsQuickMapCanvasMap::QgsQuickMapCanvasMap( QQuickItem *parent )
   connect( this, &QgsQuickMapCanvasMap::renderStarting, this, &QgsQuickMapCanvasMap::isRenderingChanged );
   connect( this, &QgsQuickMapCanvasMap::mapCanvasRefreshed, this, &QgsQuickMapCanvasMap::isRenderingChanged );
 
+  mTileMemoryCache.setMaxCost( TILE_MEMORY_CACHE_SIZE );
+
+  mPrefetchTimer.setSingleShot( true );
+  mPrefetchTimer.setInterval( 1000 );
+  connect( &mPrefetchTimer, &QTimer::timeout, this, &QgsQuickMapCanvasMap::startPrefetching );
+
   mMapUpdateTimer.setSingleShot( false );
   mMapUpdateTimer.setInterval( 250 );
   mRefreshTimer.setSingleShot( true );
@@ -104,13 +222,11 @@ void QgsQuickMapCanvasMap::pan( QPointF oldPos, QPointF newPos )
   mMapSettings->setExtent( extent );
 }
 
-void QgsQuickMapCanvasMap::refreshMap()
+QgsMapSettings QgsQuickMapCanvasMap::prepareMapSettings() const
 {
-  stopRendering(); // if any...
-
   QgsMapSettings mapSettings = mMapSettings->mapSettings();
   if ( !mapSettings.hasValidSettings() )
-    return;
+    return mapSettings;
 
   if ( !qgsDoubleNear( mQuality, 1.0 ) )
   {
@@ -143,9 +259,47 @@ void QgsQuickMapCanvasMap::refreshMap()
   // with incremental rendering - enables updates of partially rendered layers (good for WMTS, XYZ layers)
   mapSettings.setFlag( Qgis::MapSettingsFlag::RenderPartialOutput, mIncrementalRendering );
 
+  return mapSettings;
+}
+
+void QgsQuickMapCanvasMap::refreshMap()
+{
+  stopRendering(); // if any...
+
+  const QgsMapSettings mapSettings = prepareMapSettings();
+  if ( !mapSettings.hasValidSettings() )
+    return;
+
+  if ( mTiledRendering && mTileCache && qgsDoubleNear( mapSettings.rotation(), 0.0 ) )
+  {
+    refreshTiledMap( mapSettings );
+    return;
+  }
+
+  mJobMapSettings = mapSettings;
+  startRenderJob( overscanMapSettings( mapSettings, mJobOverscan ) );
+
+  if ( !mSilentRefresh )
+  {
+    emit renderStarting();
+  }
+}
+
+void QgsQuickMapCanvasMap::startRenderJob( const QgsMapSettings &mapSettings )
+{
   // create the renderer job
   Q_ASSERT( !mJob );
-  mJob = new QgsMapRendererParallelJob( mapSettings );
+  if ( mCollectRenderStatistics )
+  {
+    QgsMapSettings jobMapSettings = mapSettings;
+    mRenderedFeatureCounter->reset();
+    jobMapSettings.addRenderedFeatureHandler( mRenderedFeatureCounter.get() );
+    mJob = new QgsMapRendererParallelJob( jobMapSettings );
+  }
+  else
+  {
+    mJob = new QgsMapRendererParallelJob( mapSettings );
+  }
 
   if ( mIncrementalRendering )
     mMapUpdateTimer.start();
@@ -154,11 +308,23 @@ void QgsQuickMapCanvasMap::refreshMap()
   connect( mJob, &QgsMapRendererJob::finished, this, &QgsQuickMapCanvasMap::renderJobFinished );
   mJob->setCache( mCache.get() );
 
-  mJob->start();
-
-  if ( !mSilentRefresh )
+  if ( mCollectRenderStatistics )
   {
-    emit renderStarting();
+    // Labeling starts once all layers are rendered, the remaining time until the job finishes is spent labeling
+    mLayersRenderedElapsed = -1;
+    connect( mJob, &QgsMapRendererJob::renderingLayersFinished, this, [this] { mLayersRenderedElapsed = mRenderStatisticsTimer.elapsed(); } );
+
+    mRenderStatistics = RenderStatistics();
+    mRenderStatistics.startTime = QDateTime::currentDateTime();
+    mRenderStatistics.tiled = mRenderingTiles;
+    mRenderStatisticsTimer.start();
+    // The parallel job prepares the layer renderers synchronously before dispatching them to worker threads
+    mJob->start();
+    mRenderStatistics.preparationTime = static_cast<int>( mRenderStatisticsTimer.elapsed() );
+  }
+  else
+  {
+    mJob->start();
   }
 }
 
@@ -167,8 +333,16 @@ void QgsQuickMapCanvasMap::renderJobUpdated()
   if ( !mJob )
     return;
 
-  mImage = mJob->renderedImage();
-  mImageMapSettings = mJob->mapSettings();
+  if ( mRenderingTiles )
+  {
+    drawMissingTiles( mJob->renderedImage() );
+  }
+  else
+  {
+    mImage = mJob->renderedImage();
+    mImageMapSettings = mJobMapSettings;
+    mImageOverscan = mJobOverscan;
+  }
   mDirty = true;
   // Temporarily freeze the canvas, we only need to reset the geometry but not trigger a repaint
   bool freeze = mFreeze;
@@ -190,13 +364,32 @@ void QgsQuickMapCanvasMap::renderJobFinished()
     QgsMessageLog::logMessage( QStringLiteral( "%1 :: %2" ).arg( error.layerID, error.message ), tr( "Rendering" ) );
   }
 
+  if ( mCollectRenderStatistics )
+  {
+    collectJobStatistics( mJob );
+  }
+
   // take labeling results before emitting renderComplete, so labeling map tools
   // connected to signal work with correct results
   delete mLabelingResults;
   mLabelingResults = mJob->takeLabelingResults();
 
-  mImage = mJob->renderedImage();
-  mImageMapSettings = mJob->mapSettings();
+  if ( mRenderingTiles )
+  {
+    const QImage renderedImage = mJob->renderedImage();
+    drawMissingTiles( renderedImage );
+    // Avoid persisting tiles of layers which failed to render
+    if ( errors.isEmpty() )
+      storeTiles( renderedImage, mRenderedTileRange, mMissingTiles, mTiledLayerIds );
+    mMissingTiles.clear();
+    mRenderingTiles = false;
+  }
+  else
+  {
+    mImage = mJob->renderedImage();
+    mImageMapSettings = mJobMapSettings;
+    mImageOverscan = mJobOverscan;
+  }
 
   // now we are in a slot called from mJob - do not delete it immediately
   // so the class is still valid when the execution returns to the class
@@ -205,6 +398,11 @@ void QgsQuickMapCanvasMap::renderJobFinished()
   mDirty = true;
   mMapUpdateTimer.stop();
 
+  completeRefresh();
+}
+
+void QgsQuickMapCanvasMap::completeRefresh()
+{
   // Temporarily freeze the canvas, we only need to reset the geometry but not trigger a repaint
   bool freeze = mFreeze;
   mFreeze = true;
@@ -227,6 +425,10 @@ void QgsQuickMapCanvasMap::renderJobFinished()
     mSilentRefresh = true;
     refresh();
   }
+  else if ( mPrefetching && mTiledRendering && mTileCache )
+  {
+    mPrefetchTimer.start();
+  }
 }
 
 void QgsQuickMapCanvasMap::layerRepaintRequested( bool deferred )
@@ -234,6 +436,13 @@ void QgsQuickMapCanvasMap::layerRepaintRequested( bool deferred )
   if ( mMapSettings->outputSize().isNull() )
     return; // the map image size has not been set yet
 
+  // Layers redrawn on a timer, e.g. animated symbols, change without notifying about it
+  QgsMapLayer *layer = qobject_cast<QgsMapLayer *>( sender() );
+  if ( layer && layer->hasAutoRefreshEnabled() )
+  {
+    invalidateTiles( layer );
+  }
+
   if ( !mFreeze )
   {
     if ( deferred || mForceDeferredLayersRepaint )
@@ -369,6 +578,55 @@ void QgsQuickMapCanvasMap::setQuality( double quality )
   refresh();
 }
 
+bool QgsQuickMapCanvasMap::collectRenderStatistics() const
+{
+  return mCollectRenderStatistics;
+}
+
+void QgsQuickMapCanvasMap::setCollectRenderStatistics( bool collectRenderStatistics )
+{
+  if ( mCollectRenderStatistics == collectRenderStatistics )
+    return;
+
+  mCollectRenderStatistics = collectRenderStatistics;
+  emit collectRenderStatisticsChanged();
+}
+
+void QgsQuickMapCanvasMap::collectJobStatistics( QgsMapRendererJob *job )
+{
+  // Statistics are only gathered for jobs started while collecting was enabled
+  if ( !mRenderStatistics.startTime.isValid() )
+    return;
+
+  const qint64 elapsed = mRenderStatisticsTimer.elapsed();
+  mRenderStatistics.renderTime = static_cast<int>( elapsed );
+  mRenderStatistics.labelingTime = mLayersRenderedElapsed >= 0 ? static_cast<int>( elapsed - mLayersRenderedElapsed ) : 0;
+
+  const QHash<QgsMapLayer *, int> renderingTimes = job->perLayerRenderingTime();
+  const QStringList layersRedrawnFromCache = job->layersRedrawnFromCache();
+  const QList<QgsMapLayer *> layers = job->mapSettings().layers();
+  for ( QgsMapLayer *layer : layers )
+  {
+    if ( !layer )
+      continue;
+
+    LayerRenderStatistics layerStatistics;
+    layerStatistics.layerId = layer->id();
+    layerStatistics.layerName = layer->name();
+    layerStatistics.renderTime = renderingTimes.value( layer, 0 );
+    layerStatistics.cacheHit = layersRedrawnFromCache.contains( layer->id() );
+    if ( layer->type() == Qgis::LayerType::Vector && !layerStatistics.cacheHit )
+    {
+      layerStatistics.featureCount = mRenderedFeatureCounter->count( layer->id() );
+    }
+    mRenderStatistics.layers << layerStatistics;
+  }
+
+  const RenderStatistics statistics = mRenderStatistics;
+  mRenderStatistics = RenderStatistics();
+  emit renderStatisticsCollected( statistics );
+}
+
 double QgsQuickMapCanvasMap::bottomMargin() const
 {
   return mMapSettings->bottomMargin();
@@ -411,6 +669,101 @@ void QgsQuickMapCanvasMap::setForceDeferredLayersRepaint( bool deferred )
   emit forceDeferredLayersRepaintChanged();
 }
 
+bool QgsQuickMapCanvasMap::tiledRendering() const
+{
+  return mTiledRendering;
+}
+
+void QgsQuickMapCanvasMap::setTiledRendering( bool tiledRendering )
+{
+  if ( mTiledRendering == tiledRendering )
+    return;
+
+  mTiledRendering = tiledRendering;
+
+  if ( mTiledRendering )
+  {
+    const QString cachePath = QStandardPaths::writableLocation( QStandardPaths::CacheLocation ) + QStringLiteral( "/map_tiles.db" );
+    mTileCache = std::make_unique<QgsQuickMapTileCache>( cachePath );
+    mTileCache->setMaximumSize( static_cast<qint64>( mTileCacheMaximumSize ) * 1024 * 1024 );
+    connect( mTileCache.get(), &QgsQuickMapTileCache::tilesFetched, this, &QgsQuickMapCanvasMap::onTilesFetched );
+  }
+  else
+  {
+    stopRendering();
+    mTileCache.reset();
+    mTileMemoryCache.clear();
+    mLayerMemoryTileKeys.clear();
+  }
+
+  emit tiledRenderingChanged();
+
+  // And trigger a new rendering job
+  refresh();
+}
+
+int QgsQuickMapCanvasMap::tileCacheMaximumSize() const
+{
+  return mTileCacheMaximumSize;
+}
+
+void QgsQuickMapCanvasMap::setTileCacheMaximumSize( int tileCacheMaximumSize )
+{
+  if ( mTileCacheMaximumSize == tileCacheMaximumSize )
+    return;
+
+  mTileCacheMaximumSize = tileCacheMaximumSize;
+
+  if ( mTileCache )
+    mTileCache->setMaximumSize( static_cast<qint64>( mTileCacheMaximumSize ) * 1024 * 1024 );
+
+  emit tileCacheMaximumSizeChanged();
+}
+
+QImage QgsQuickMapCanvasMap::image() const
+{
+  if ( mImageOverscan.isNull() )
+    return mImage;
+
+  return mImage.copy( QRect( QPoint( mImageOverscan.width(), mImageOverscan.height() ), mImage.size() - 2 * mImageOverscan ) );
+}
+
+double QgsQuickMapCanvasMap::overscan() const
+{
+  return mOverscan;
+}
+
+void QgsQuickMapCanvasMap::setOverscan( double overscan )
+{
+  overscan = std::clamp( overscan, 0.0, 0.5 );
+  if ( qgsDoubleNear( mOverscan, overscan ) )
+    return;
+
+  mOverscan = overscan;
+
+  emit overscanChanged();
+
+  // And trigger a new rendering job
+  refresh();
+}
+
+bool QgsQuickMapCanvasMap::prefetching() const
+{
+  return mPrefetching;
+}
+
+void QgsQuickMapCanvasMap::setPrefetching( bool prefetching )
+{
+  if ( mPrefetching == prefetching )
+    return;
+
+  mPrefetching = prefetching;
+  if ( !mPrefetching )
+    stopPrefetching();
+
+  emit prefetchingChanged();
+}
+
 bool QgsQuickMapCanvasMap::freeze() const
 {
   return mFreeze;
@@ -433,42 +786,81 @@ void QgsQuickMapCanvasMap::setFreeze( bool freeze )
 
 bool QgsQuickMapCanvasMap::isRendering() const
 {
-  return mJob;
+  return mJob || mTileFetchPending;
 }
 
 QSGNode *QgsQuickMapCanvasMap::updatePaintNode( QSGNode *oldNode, QQuickItem::UpdatePaintNodeData * )
 {
-  if ( mDirty )
+  if ( mImage.isNull() )
   {
     delete oldNode;
-    oldNode = nullptr;
-    mDirty = false;
+    mUploadedImage = QImage();
+    return nullptr;
   }
 
-  if ( mImage.isNull() )
+  // The map image is split into a grid of textures, allowing for unchanged parts of the
+  // image to be skipped when uploading an updated image. Each texture overlaps its neighbors
+  // by TEXTURE_TILE_OVERLAP pixels which are not drawn, so that linear filtering at texture
+  // edges samples the neighboring pixels instead of clamping and leaving seams when scaled
+  const int columns = ( mImage.width() + TEXTURE_TILE_SIZE - 1 ) / TEXTURE_TILE_SIZE;
+  const int rows = ( mImage.height() + TEXTURE_TILE_SIZE - 1 ) / TEXTURE_TILE_SIZE;
+
+  QSGNode *rootNode = oldNode;
+  if ( !rootNode || mUploadedImage.size() != mImage.size() )
   {
-    return nullptr;
+    delete rootNode;
+    rootNode = new QSGNode();
+    for ( int i = 0; i < columns * rows; i++ )
+    {
+      QSGSimpleTextureNode *node = new QSGSimpleTextureNode();
+      node->setFiltering( QSGTexture::Linear );
+      node->setTexture( new MapCanvasTexture() );
+      node->setOwnsTexture( true );
+      rootNode->appendChildNode( node );
+    }
+    mUploadedImage = QImage();
+    mDirty = true;
   }
 
-  QSGSimpleTextureNode *node = static_cast<QSGSimpleTextureNode *>( oldNode );
-  if ( !node )
+  if ( mDirty )
   {
-    node = new QSGSimpleTextureNode();
-    node->setFiltering( QSGTexture::Linear );
-    QSGTexture *texture = window()->createTextureFromImage( mImage );
-    node->setTexture( texture );
-    node->setOwnsTexture( true );
+    mDirty = false;
+
+    const bool fullUpload = mUploadedImage.isNull() || mUploadedImage.format() != mImage.format();
+    if ( fullUpload || mUploadedImage.constBits() != mImage.constBits() )
+    {
+      QSGNode *node = rootNode->firstChild();
+      for ( int row = 0; row < rows; row++ )
+      {
+        for ( int column = 0; column < columns; column++ )
+        {
+          const QRect textureRect = QRect( column * TEXTURE_TILE_SIZE, row * TEXTURE_TILE_SIZE, TEXTURE_TILE_SIZE, TEXTURE_TILE_SIZE ).intersected( mImage.rect() );
+          const QRect overlappingRect = textureRect.adjusted( -TEXTURE_TILE_OVERLAP, -TEXTURE_TILE_OVERLAP, TEXTURE_TILE_OVERLAP, TEXTURE_TILE_OVERLAP ).intersected( mImage.rect() );
+          if ( fullUpload || !imageRectEquals( mImage, mUploadedImage, overlappingRect ) )
+          {
+            QSGSimpleTextureNode *textureNode = static_cast<QSGSimpleTextureNode *>( node );
+            static_cast<MapCanvasTexture *>( textureNode->texture() )->setImage( mImage.copy( overlappingRect ) );
+            textureNode->setSourceRect( QRectF( textureRect.topLeft() - overlappingRect.topLeft(), textureRect.size() ) );
+            textureNode->markDirty( QSGNode::DirtyMaterial );
+          }
+          node = node->nextSibling();
+        }
+      }
+      mUploadedImage = mImage;
+    }
   }
 
   QRectF rect( boundingRect() );
-  QSizeF size = mImage.size();
+  // The image may cover an overscan margin around the visible extent
+  const QSize visibleImageSize = mImage.size() - 2 * mImageOverscan;
+  QSizeF size = visibleImageSize;
   if ( !size.isEmpty() )
     size /= mMapSettings->devicePixelRatio();
 
   // Check for resizes that change the w/h ratio
   if ( !rect.isEmpty() && !size.isEmpty() && !qgsDoubleNear( rect.width() / rect.height(), ( size.width() ) / static_cast<double>( size.height() ), 3 ) )
   {
-    if ( qgsDoubleNear( rect.height(), mImage.height() ) )
+    if ( qgsDoubleNear( rect.height(), size.height() ) )
     {
       rect.setHeight( rect.width() / size.width() * size.height() );
     }
@@ -478,9 +870,27 @@ QSGNode *QgsQuickMapCanvasMap::updatePaintNode( QSGNode *oldNode, QQuickItem::Up
     }
   }
 
-  node->setRect( rect );
+  if ( !mImageOverscan.isNull() && !visibleImageSize.isEmpty() )
+  {
+    const double horizontalMargin = mImageOverscan.width() * rect.width() / visibleImageSize.width();
+    const double verticalMargin = mImageOverscan.height() * rect.height() / visibleImageSize.height();
+    rect.adjust( -horizontalMargin, -verticalMargin, horizontalMargin, verticalMargin );
+  }
+
+  const double xScale = rect.width() / mImage.width();
+  const double yScale = rect.height() / mImage.height();
+  QSGNode *node = rootNode->firstChild();
+  for ( int row = 0; row < rows; row++ )
+  {
+    for ( int column = 0; column < columns; column++ )
+    {
+      const QRect textureRect = QRect( column * TEXTURE_TILE_SIZE, row * TEXTURE_TILE_SIZE, TEXTURE_TILE_SIZE, TEXTURE_TILE_SIZE ).intersected( mImage.rect() );
+      static_cast<QSGSimpleTextureNode *>( node )->setRect( QRectF( rect.x() + textureRect.x() * xScale, rect.y() + textureRect.y() * yScale, textureRect.width() * xScale, textureRect.height() * yScale ) );
+      node = node->nextSibling();
+    }
+  }
 
-  return node;
+  return rootNode;
 }
 
 void QgsQuickMapCanvasMap::geometryChange( const QRectF &newGeometry, const QRectF &oldGeometry )
@@ -503,11 +913,23 @@ void QgsQuickMapCanvasMap::onLayersChanged()
     disconnect( conn );
   }
   mLayerConnections.clear();
+  mLayerTileHashes.clear();
 
   const QList<QgsMapLayer *> layers = mMapSettings->layers();
   for ( QgsMapLayer *layer : layers )
   {
     mLayerConnections << connect( layer, &QgsMapLayer::repaintRequested, this, &QgsQuickMapCanvasMap::layerRepaintRequested );
+
+    // Repaints are also requested while the layer is unchanged, only tiles of modified layers are invalidated
+    mLayerConnections << connect( layer, &QgsMapLayer::dataChanged, this, [this, layer] { invalidateTiles( layer ); } );
+    mLayerConnections << connect( layer, &QgsMapLayer::styleChanged, this, [this, layer] { invalidateTiles( layer ); } );
+    mLayerConnections << connect( layer, &QgsMapLayer::rendererChanged, this, [this, layer] { invalidateTiles( layer ); } );
+    if ( QgsVectorLayer *vlayer = qobject_cast<QgsVectorLayer *>( layer ) )
+    {
+      // Edits and selections are drawn on tiles
+      mLayerConnections << connect( vlayer, &QgsVectorLayer::layerModified, this, [this, layer] { invalidateTiles( layer ); } );
+      mLayerConnections << connect( vlayer, &QgsVectorLayer::selectionChanged, this, [this, layer] { invalidateTiles( layer ); } );
+    }
   }
 
   refresh();
@@ -521,6 +943,13 @@ void QgsQuickMapCanvasMap::destroyJob( QgsMapRendererJob *job )
 
 void QgsQuickMapCanvasMap::stopRendering()
 {
+  stopPrefetching();
+
+  // Ignore tiles fetched for an outdated tiled rendering
+  mTileRequestId = ++mLastTileRequestId;
+  mTileFetchPending = false;
+  mRenderingTiles = false;
+
   if ( mJob )
   {
     mMapUpdateTimer.stop();
@@ -567,6 +996,9 @@ void QgsQuickMapCanvasMap::zoomToFullExtent()
 
 void QgsQuickMapCanvasMap::refresh()
 {
+  // Any interaction with the map cancels the idle prefetching
+  stopPrefetching();
+
   if ( mMapSettings->outputSize().isNull() )
     return; // the map image size has not been set yet
 
@@ -604,3 +1036,460 @@ void QgsQuickMapCanvasMap::clearTemporalCache()
     }
   }
 }
+
+QString QgsQuickMapCanvasMap::layerTileHash( QgsMapLayer *layer )
+{
+  auto it = mLayerTileHashes.constFind( layer->id() );
+  if ( it != mLayerTileHashes.constEnd() )
+    return it.value();
+
+  QCryptographicHash hash( QCryptographicHash::Sha1 );
+  hash.addData( layer->id().toUtf8() );
+
+  QgsMapLayerStyle style;
+  style.readFromLayer( layer );
+  hash.addData( style.xmlData().toUtf8() );
+
+  // Include the modification time of file-based datasets so tiles are not reused after
+  // the dataset has been modified outside of the application
+  const QString path = QgsProviderRegistry::instance()->decodeUri( layer->providerType(), layer->source() ).value( QStringLiteral( "path" ) ).toString();
+  if ( !path.isEmpty() )
+  {
+    hash.addData( QByteArray::number( QFileInfo( path ).lastModified().toMSecsSinceEpoch() ) );
+  }
+
+  const QString layerHash = QString::fromLatin1( hash.result().toHex() );
+  mLayerTileHashes.insert( layer->id(), layerHash );
+  return layerHash;
+}
+
+QString QgsQuickMapCanvasMap::tileKeyPrefix( const QgsMapSettings &mapSettings )
+{
+  QStringList components;
+  components << mapSettings.destinationCrs().toWkt( Qgis::CrsWktVariant::Preferred )
+             << QString::number( mapSettings.mapUnitsPerPixel(), 'g', 12 )
+             << QString::number( mapSettings.outputDpi(), 'g', 6 )
+             << QString::number( TILE_SIZE )
+             << QString::number( TILE_LABEL_BUFFER )
+             << mapSettings.backgroundColor().name( QColor::HexArgb );
+
+  if ( mapSettings.isTemporal() )
+  {
+    components << mapSettings.temporalRange().begin().toString( Qt::ISODateWithMs ) << mapSettings.temporalRange().end().toString( Qt::ISODateWithMs );
+  }
+
+  const QList<QgsMapLayer *> layers = mapSettings.layers();
+  for ( QgsMapLayer *layer : layers )
+  {
+    components << layerTileHash( layer );
+  }
+
+  return components.join( ';' );
+}
+
+QgsMapSettings QgsQuickMapCanvasMap::overscanMapSettings( const QgsMapSettings &mapSettings, QSize &overscan ) const
+{
+  overscan = QSize( static_cast<int>( std::round( mapSettings.outputSize().width() * mOverscan ) ),
+                    static_cast<int>( std::round( mapSettings.outputSize().height() * mOverscan ) ) );
+  if ( overscan.isNull() )
+    return mapSettings;
+
+  // Keep the center and resolution while growing the output size by the overscan margins
+  const QSize outputSize = mapSettings.outputSize() + 2 * overscan;
+  const QgsPointXY center = mapSettings.visibleExtent().center();
+  const double mapUnitsPerPixel = mapSettings.mapUnitsPerPixel();
+
+  QgsMapSettings overscanSettings = mapSettings;
+  overscanSettings.setOutputSize( outputSize );
+  overscanSettings.setExtent( QgsRectangle( center.x() - outputSize.width() * mapUnitsPerPixel / 2,
+                                            center.y() - outputSize.height() * mapUnitsPerPixel / 2,
+                                            center.x() + outputSize.width() * mapUnitsPerPixel / 2,
+                                            center.y() + outputSize.height() * mapUnitsPerPixel / 2 ) );
+  return overscanSettings;
+}
+
+QgsQuickMapCanvasMap::TileRange QgsQuickMapCanvasMap::tileRange( const QgsMapSettings &mapSettings )
+{
+  // Tiles are aligned on a grid anchored at the map origin, their extent depends on the current scale
+  const QgsRectangle extent = mapSettings.visibleExtent();
+  const double tileExtentSize = TILE_SIZE * mapSettings.mapUnitsPerPixel();
+
+  TileRange range;
+  range.columnMin = static_cast<int>( std::floor( extent.xMinimum() / tileExtentSize ) );
+  range.columnMax = static_cast<int>( std::floor( extent.xMaximum() / tileExtentSize ) );
+  range.rowMin = static_cast<int>( std::floor( extent.yMinimum() / tileExtentSize ) );
+  range.rowMax = static_cast<int>( std::floor( extent.yMaximum() / tileExtentSize ) );
+  return range;
+}
+
+QgsQuickMapCanvasMap::TileRange QgsQuickMapCanvasMap::boundingTileRange( const QList<MapTile> &tiles )
+{
+  TileRange range { std::numeric_limits<int>::max(), std::numeric_limits<int>::lowest(), std::numeric_limits<int>::max(), std::numeric_limits<int>::lowest() };
+  for ( const MapTile &tile : tiles )
+  {
+    range.columnMin = std::min( range.columnMin, tile.column );
+    range.columnMax = std::max( range.columnMax, tile.column );
+    range.rowMin = std::min( range.rowMin, tile.row );
+    range.rowMax = std::max( range.rowMax, tile.row );
+  }
+  return range;
+}
+
+QgsMapSettings QgsQuickMapCanvasMap::tileRangeMapSettings( const QgsMapSettings &mapSettings, const TileRange &range )
+{
+  const double tileExtentSize = TILE_SIZE * mapSettings.mapUnitsPerPixel();
+  const double bufferExtentSize = TILE_LABEL_BUFFER * mapSettings.mapUnitsPerPixel();
+
+  QgsMapSettings rangeSettings = mapSettings;
+  rangeSettings.setOutputSize( QSize( ( range.columnMax - range.columnMin + 1 ) * TILE_SIZE + 2 * TILE_LABEL_BUFFER, ( range.rowMax - range.rowMin + 1 ) * TILE_SIZE + 2 * TILE_LABEL_BUFFER ) );
+  rangeSettings.setExtent( QgsRectangle( range.columnMin * tileExtentSize - bufferExtentSize, range.rowMin * tileExtentSize - bufferExtentSize, ( range.columnMax + 1 ) * tileExtentSize + bufferExtentSize, ( range.rowMax + 1 ) * tileExtentSize + bufferExtentSize ) );
+  return rangeSettings;
+}
+
+QList<QgsQuickMapCanvasMap::MapTile> QgsQuickMapCanvasMap::tiles( const QgsMapSettings &mapSettings, const TileRange &range )
+{
+  const QString prefix = tileKeyPrefix( mapSettings );
+
+  QList<MapTile> tiles;
+  for ( int column = range.columnMin; column <= range.columnMax; column++ )
+  {
+    for ( int row = range.rowMin; row <= range.rowMax; row++ )
+    {
+      QCryptographicHash hash( QCryptographicHash::Sha1 );
+      hash.addData( QStringLiteral( "%1;%2;%3" ).arg( prefix ).arg( column ).arg( row ).toUtf8() );
+      tiles << MapTile { column, row, QString::fromLatin1( hash.result().toHex() ) };
+    }
+  }
+  return tiles;
+}
+
+QPoint QgsQuickMapCanvasMap::tilePosition( int column, int row ) const
+{
+  return QPoint( mTileOrigin.x() + ( column - mTileRange.columnMin ) * TILE_SIZE,
+                 mTileOrigin.y() + ( mTileRange.rowMax - row ) * TILE_SIZE );
+}
+
+void QgsQuickMapCanvasMap::refreshTiledMap( const QgsMapSettings &mapSettings )
+{
+  QSize overscan;
+  mTiledMapSettings = overscanMapSettings( mapSettings, overscan );
+  mTiledLayerIds.clear();
+  const QList<QgsMapLayer *> layers = mTiledMapSettings.layers();
+  for ( QgsMapLayer *layer : layers )
+  {
+    mTiledLayerIds << layer->id();
+  }
+
+  const QgsRectangle extent = mTiledMapSettings.visibleExtent();
+  const double mapUnitsPerPixel = mTiledMapSettings.mapUnitsPerPixel();
+  const double tileExtentSize = TILE_SIZE * mapUnitsPerPixel;
+  mTileRange = tileRange( mTiledMapSettings );
+  mTileOrigin = QPoint( static_cast<int>( std::round( ( mTileRange.columnMin * tileExtentSize - extent.xMinimum() ) / mapUnitsPerPixel ) ),
+                        static_cast<int>( std::round( ( extent.yMaximum() - ( mTileRange.rowMax + 1 ) * tileExtentSize ) / mapUnitsPerPixel ) ) );
+
+  QImage tiledImage( mTiledMapSettings.outputSize(), QImage::Format_ARGB32_Premultiplied );
+  tiledImage.fill( Qt::transparent );
+
+  QStringList missingKeys;
+  mMissingTiles.clear();
+  {
+    QPainter painter( &tiledImage );
+
+    // Keep the previous image as a backdrop until the missing tiles are available
+    if ( !mImage.isNull() && mImageMapSettings.destinationCrs() == mTiledMapSettings.destinationCrs() && qgsDoubleNear( mImageMapSettings.rotation(), 0.0 ) )
+    {
+      const double previousMapUnitsPerPixel = mImageMapSettings.mapUnitsPerPixel();
+      const QgsRectangle visibleExtent = mImageMapSettings.visibleExtent();
+      const QgsRectangle previousExtent( visibleExtent.xMinimum() - mImageOverscan.width() * previousMapUnitsPerPixel,
+                                         visibleExtent.yMinimum() - mImageOverscan.height() * previousMapUnitsPerPixel,
+                                         visibleExtent.xMaximum() + mImageOverscan.width() * previousMapUnitsPerPixel,
+                                         visibleExtent.yMaximum() + mImageOverscan.height() * previousMapUnitsPerPixel );
+
+      painter.setRenderHint( QPainter::SmoothPixmapTransform );
+      painter.drawImage( QRectF( ( previousExtent.xMinimum() - extent.xMinimum() ) / mapUnitsPerPixel,
+                                 ( extent.yMaximum() - previousExtent.yMaximum() ) / mapUnitsPerPixel,
+                                 previousExtent.width() / mapUnitsPerPixel,
+                                 previousExtent.height() / mapUnitsPerPixel ),
+                         mImage );
+    }
+
+    // Tiles replace the backdrop, including where they are transparent
+    painter.setCompositionMode( QPainter::CompositionMode_Source );
+    const QList<MapTile> rangeTiles = tiles( mTiledMapSettings, mTileRange );
+    for ( const MapTile &tile : rangeTiles )
+    {
+      if ( const QImage *image = mTileMemoryCache.object( tile.key ) )
+      {
+        painter.drawImage( tilePosition( tile.column, tile.row ), *image );
+      }
+      else
+      {
+        mMissingTiles << tile;
+        missingKeys << tile.key;
+      }
+    }
+  }
+
+  mImage = tiledImage;
+  mImageMapSettings = mapSettings;
+  mImageOverscan = overscan;
+
+  mDirty = true;
+  if ( !mSilentRefresh )
+  {
+    emit renderStarting();
+  }
+
+  if ( mMissingTiles.isEmpty() )
+  {
+    completeRefresh();
+    return;
+  }
+
+  update();
+
+  mTileFetchPending = true;
+  mTileCache->fetchTiles( mTileRequestId, missingKeys );
+}
+
+void QgsQuickMapCanvasMap::onTilesFetched( int requestId, const QHash<QString, QImage> &tiles )
+{
+  if ( requestId == mPrefetchRequestId )
+  {
+    onPrefetchTilesFetched( tiles );
+    return;
+  }
+
+  if ( requestId != mTileRequestId || !mTileFetchPending )
+    return;
+
+  mTileFetchPending = false;
+
+  QList<MapTile> missingTiles;
+  {
+    QPainter painter( &mImage );
+    painter.setCompositionMode( QPainter::CompositionMode_Source );
+    for ( const MapTile &tile : std::as_const( mMissingTiles ) )
+    {
+      auto it = tiles.constFind( tile.key );
+      if ( it != tiles.constEnd() )
+      {
+        painter.drawImage( tilePosition( tile.column, tile.row ), it.value() );
+        insertMemoryTile( tile.key, it.value(), mTiledLayerIds );
+      }
+      else
+      {
+        missingTiles << tile;
+      }
+    }
+  }
+  mMissingTiles = missingTiles;
+  mDirty = true;
+
+  if ( mMissingTiles.isEmpty() )
+  {
+    completeRefresh();
+    return;
+  }
+
+  update();
+
+  // Render the smallest tile-aligned region covering all missing tiles
+  mRenderedTileRange = boundingTileRange( mMissingTiles );
+  mRenderingTiles = true;
+  startRenderJob( tileRangeMapSettings( mTiledMapSettings, mRenderedTileRange ) );
+}
+
+void QgsQuickMapCanvasMap::drawMissingTiles( const QImage &renderedImage )
+{
+  QRegion clipRegion;
+  for ( const MapTile &tile : std::as_const( mMissingTiles ) )
+  {
+    clipRegion += QRect( tilePosition( tile.column, tile.row ), QSize( TILE_SIZE, TILE_SIZE ) );
+  }
+
+  QPainter painter( &mImage );
+  painter.setClipRegion( clipRegion );
+  painter.setCompositionMode( QPainter::CompositionMode_Source );
+  // The rendered image is surrounded by the label buffer, cropped by the clip region
+  painter.drawImage( tilePosition( mRenderedTileRange.columnMin, mRenderedTileRange.rowMax ) - QPoint( TILE_LABEL_BUFFER, TILE_LABEL_BUFFER ), renderedImage );
+}
+
+void QgsQuickMapCanvasMap::storeTiles( const QImage &renderedImage, const TileRange &range, const QList<MapTile> &tiles, const QStringList &layerIds )
+{
+  for ( const MapTile &tile : tiles )
+  {
+    const QImage image = renderedImage.copy( TILE_LABEL_BUFFER + ( tile.column - range.columnMin ) * TILE_SIZE, TILE_LABEL_BUFFER + ( range.rowMax - tile.row ) * TILE_SIZE, TILE_SIZE, TILE_SIZE );
+    insertMemoryTile( tile.key, image, layerIds );
+    mTileCache->storeTile( tile.key, layerIds, image );
+  }
+}
+
+void QgsQuickMapCanvasMap::startPrefetching()
+{
+  if ( !mPrefetching || !mTileCache || mJob || mTileFetchPending )
+    return;
+
+  const QgsMapSettings mapSettings = mTiledMapSettings;
+  const QList<QgsMapLayer *> layers = mapSettings.layers();
+  for ( QgsMapLayer *layer : layers )
+  {
+    // Avoid fetching remote data for areas which may never be visited
+    if ( layer->dataProvider() && !layer->dataProvider()->renderInPreview( QgsDataProvider::PreviewContext() ) )
+      return;
+  }
+
+  // Prefetch the adjacent extents, followed by the next zoom level
+  const QgsRectangle extent = mapSettings.visibleExtent();
+  const QList<QgsVector> offsets { QgsVector( -extent.width(), 0 ), QgsVector( extent.width(), 0 ), QgsVector( 0, extent.height() ), QgsVector( 0, -extent.height() ) };
+  mPrefetchQueue.clear();
+  for ( const QgsVector &offset : offsets )
+  {
+    QgsMapSettings adjacentSettings = mapSettings;
+    adjacentSettings.setExtent( QgsRectangle( extent.xMinimum() + offset.x(), extent.yMinimum() + offset.y(), extent.xMaximum() + offset.x(), extent.yMaximum() + offset.y() ) );
+    mPrefetchQueue << adjacentSettings;
+  }
+
+  QgsMapSettings zoomedSettings = mapSettings;
+  QgsRectangle zoomedExtent = extent;
+  zoomedExtent.scale( 0.5 );
+  zoomedSettings.setExtent( zoomedExtent );
+  mPrefetchQueue << zoomedSettings;
+
+  prefetchNext();
+}
+
+void QgsQuickMapCanvasMap::prefetchNext()
+{
+  while ( !mPrefetchQueue.isEmpty() )
+  {
+    mPrefetchMapSettings = mPrefetchQueue.takeFirst();
+    mPrefetchLayerIds.clear();
+    const QList<QgsMapLayer *> layers = mPrefetchMapSettings.layers();
+    for ( QgsMapLayer *layer : layers )
+    {
+      mPrefetchLayerIds << layer->id();
+    }
+
+    mPrefetchTiles.clear();
+    QStringList keys;
+    const QList<MapTile> rangeTiles = tiles( mPrefetchMapSettings, tileRange( mPrefetchMapSettings ) );
+    for ( const MapTile &tile : rangeTiles )
+    {
+      if ( !mTileMemoryCache.contains( tile.key ) )
+      {
+        mPrefetchTiles << tile;
+        keys << tile.key;
+      }
+    }
+
+    if ( !keys.isEmpty() )
+    {
+      mPrefetchRequestId = ++mLastTileRequestId;
+      mTileCache->fetchTiles( mPrefetchRequestId, keys );
+      return;
+    }
+  }
+}
+
+void QgsQuickMapCanvasMap::onPrefetchTilesFetched( const QHash<QString, QImage> &tiles )
+{
+  mPrefetchRequestId = -1;
+
+  QList<MapTile> missingTiles;
+  for ( const MapTile &tile : std::as_const( mPrefetchTiles ) )
+  {
+    auto it = tiles.constFind( tile.key );
+    if ( it != tiles.constEnd() )
+    {
+      insertMemoryTile( tile.key, it.value(), mPrefetchLayerIds );
+    }
+    else
+    {
+      missingTiles << tile;
+    }
+  }
+  mPrefetchTiles = missingTiles;
+
+  if ( mPrefetchTiles.isEmpty() )
+  {
+    prefetchNext();
+    return;
+  }
+
+  // Prefetching relies on a sequential job to keep most of the resources available for user interactions
+  mPrefetchTileRange = boundingTileRange( mPrefetchTiles );
+  mPrefetchJob = new QgsMapRendererSequentialJob( tileRangeMapSettings( mPrefetchMapSettings, mPrefetchTileRange ) );
+  connect( mPrefetchJob, &QgsMapRendererJob::finished, this, &QgsQuickMapCanvasMap::prefetchJobFinished );
+  mPrefetchJob->start();
+}
+
+void QgsQuickMapCanvasMap::prefetchJobFinished()
+{
+  if ( !mPrefetchJob )
+    return;
+
+  if ( mPrefetchJob->errors().isEmpty() )
+  {
+    storeTiles( mPrefetchJob->renderedImage(), mPrefetchTileRange, mPrefetchTiles, mPrefetchLayerIds );
+  }
+
+  mPrefetchJob->deleteLater();
+  mPrefetchJob = nullptr;
+  mPrefetchTiles.clear();
+
+  prefetchNext();
+}
+
+void QgsQuickMapCanvasMap::stopPrefetching()
+{
+  mPrefetchTimer.stop();
+  mPrefetchQueue.clear();
+  mPrefetchTiles.clear();
+  mPrefetchRequestId = -1;
+
+  if ( mPrefetchJob )
+  {
+    disconnect( mPrefetchJob, &QgsMapRendererJob::finished, this, &QgsQuickMapCanvasMap::prefetchJobFinished );
+    if ( !mPrefetchJob->isActive() )
+      mPrefetchJob->deleteLater();
+    else
+      connect( mPrefetchJob, &QgsMapRendererJob::finished, mPrefetchJob, &QObject::deleteLater );
+    mPrefetchJob->cancelWithoutBlocking();
+    mPrefetchJob = nullptr;
+  }
+}
+
+void QgsQuickMapCanvasMap::invalidateTiles( QgsMapLayer *layer )
+{
+  mLayerTileHashes.remove( layer->id() );
+
+  // Tiles rendered while the layer was hidden remain valid
+  const QSet<QString> keys = mLayerMemoryTileKeys.take( layer->id() );
+  for ( const QString &key : keys )
+  {
+    mTileMemoryCache.remove( key );
+  }
+
+  if ( mTileCache )
+  {
+    mTileCache->invalidateLayer( layer->id() );
+  }
+}
+
+void QgsQuickMapCanvasMap::insertMemoryTile( const QString &key, const QImage &image, const QStringList &layerIds )
+{
+  mTileMemoryCache.insert( key, new QImage( image ), static_cast<int>( image.sizeInBytes() / 1024 ) );
+
+  for ( const QString &layerId : layerIds )
+  {
+    QSet<QString> &keys = mLayerMemoryTileKeys[layerId];
+    keys.insert( key );
+
+    // Forget the tiles evicted from the memory cache once they outnumber the cached ones
+    if ( keys.size() > 2 * mTileMemoryCache.count() )
+    {
+      keys.removeIf( [this]( const QString &cachedKey ) { return !mTileMemoryCache.contains( cachedKey ); } );
+    }
+  }
+}
@@ -18,8 +18,12 @@
 
 #include "qgsquickmapsettings.h"
 
+#include <QCache>
+#include <QDateTime>
+#include <QElapsedTimer>
 #include <QFutureSynchronizer>
 #include <QQuickItem>
+#include <QSet>
 #include <QTimer>
 #include <qgsmapsettings.h>
 #include <qgspoint.h>
@@ -27,8 +31,11 @@
 #include <memory>
 
 class QgsMapRendererParallelJob;
+class QgsMapRendererSequentialJob;
 class QgsMapRendererCache;
 class QgsLabelingResults;
+class QgsQuickMapTileCache;
+class RenderedFeatureCounter;
 
 /**
  * This class implements a visual Qt Quick Item that does map rendering
@@ -108,7 +115,82 @@ class QgsQuickMapCanvasMap : public QQuickItem
      */
     Q_PROPERTY( double forceDeferredLayersRepaint READ forceDeferredLayersRepaint WRITE setForceDeferredLayersRepaint NOTIFY forceDeferredLayersRepaintChanged )
 
+    /**
+     * When the tiledRendering property is set to true, the map is rendered into fixed-size tiles aligned
+     * on a scale-dependent grid. Rendered tiles are kept in a persistent on-disk cache, allowing for
+     * already rendered areas to be displayed instantly after panning or restarting. Only tiles missing
+     * from the cache or invalidated by a layer change are rendered.
+     *
+     * Tiled rendering is not used while the map is rotated.
+     */
+    Q_PROPERTY( bool tiledRendering READ tiledRendering WRITE setTiledRendering NOTIFY tiledRenderingChanged )
+
+    /**
+     * The maximum size in megabytes of the on-disk tile cache used when tiledRendering is enabled.
+     * Default is 256 [MB].
+     */
+    Q_PROPERTY( int tileCacheMaximumSize READ tileCacheMaximumSize WRITE setTileCacheMaximumSize NOTIFY tileCacheMaximumSizeChanged )
+
+    /**
+     * The overscan property defines a margin rendered around the visible extent, expressed as a ratio
+     * of the map canvas size. The overscan margin is shown when panning until a new rendering job
+     * finishes, avoiding blank edges.
+     *
+     * By default, the value is set to 0.0 (no overscan). The highest overscan value is 0.5.
+     */
+    Q_PROPERTY( double overscan READ overscan WRITE setOverscan NOTIFY overscanChanged )
+
+    /**
+     * When the prefetching property is set to true and tiledRendering is enabled, tiles covering the
+     * extents adjacent to the visible extent as well as the next zoom level are rendered in the background
+     * while the map is idle. Prefetching is cancelled as soon as the map is interacted with.
+     *
+     * Projects containing layers that should not be rendered in previews (e.g. remote layers) are not prefetched.
+     */
+    Q_PROPERTY( bool prefetching READ prefetching WRITE setPrefetching NOTIFY prefetchingChanged )
+
+    /**
+     * When the collectRenderStatistics property is set to true, per-layer timings and costs are
+     * collected from each render job and emitted through the renderStatisticsCollected() signal.
+     *
+     * Counting rendered features adds some overhead to vector layer rendering, the property should
+     * only be enabled while investigating rendering performance.
+     */
+    Q_PROPERTY( bool collectRenderStatistics READ collectRenderStatistics WRITE setCollectRenderStatistics NOTIFY collectRenderStatisticsChanged )
+
   public:
+    //! Statistics of a single layer collected from a render job
+    struct LayerRenderStatistics
+    {
+        //! The layer ID
+        QString layerId;
+        //! The layer name
+        QString layerName;
+        //! The time spent rendering the layer in milliseconds
+        int renderTime = 0;
+        //! The number of rendered features, -1 for non-vector layers and layers redrawn from the cache
+        long long featureCount = -1;
+        //! Whether the layer was redrawn from the render cache
+        bool cacheHit = false;
+    };
+
+    //! Statistics collected from a render job
+    struct RenderStatistics
+    {
+        //! The time at which the render job started
+        QDateTime startTime;
+        //! The time spent preparing the layer renderers in milliseconds
+        int preparationTime = 0;
+        //! The total time spent by the render job in milliseconds
+        int renderTime = 0;
+        //! The time spent labeling in milliseconds
+        int labelingTime = 0;
+        //! Whether the render job rendered missing map tiles
+        bool tiled = false;
+        //! The statistics of the rendered layers
+        QList<LayerRenderStatistics> layers;
+    };
+
     //! Create map canvas map
     explicit QgsQuickMapCanvasMap( QQuickItem *parent = nullptr );
     ~QgsQuickMapCanvasMap();
@@ -151,6 +233,36 @@ class QgsQuickMapCanvasMap : public QQuickItem
     //!\copydoc QgsQuickMapCanvasMap::forceDeferredLayersRepaint
     void setForceDeferredLayersRepaint( bool deferred );
 
+    //!\copydoc QgsQuickMapCanvasMap::tiledRendering
+    bool tiledRendering() const;
+
+    //!\copydoc QgsQuickMapCanvasMap::tiledRendering
+    void setTiledRendering( bool tiledRendering );
+
+    //!\copydoc QgsQuickMapCanvasMap::tileCacheMaximumSize
+    int tileCacheMaximumSize() const;
+
+    //!\copydoc QgsQuickMapCanvasMap::tileCacheMaximumSize
+    void setTileCacheMaximumSize( int tileCacheMaximumSize );
+
+    //!\copydoc QgsQuickMapCanvasMap::overscan
+    double overscan() const;
+
+    //!\copydoc QgsQuickMapCanvasMap::overscan
+    void setOverscan( double overscan );
+
+    //!\copydoc QgsQuickMapCanvasMap::prefetching
+    bool prefetching() const;
+
+    //!\copydoc QgsQuickMapCanvasMap::prefetching
+    void setPrefetching( bool prefetching );
+
+    //!\copydoc QgsQuickMapCanvasMap::collectRenderStatistics
+    bool collectRenderStatistics() const;
+
+    //!\copydoc QgsQuickMapCanvasMap::collectRenderStatistics
+    void setCollectRenderStatistics( bool collectRenderStatistics );
+
     //!\copydoc QgsQuickMapCanvasMap::bottomMargin
     double bottomMargin() const;
 
@@ -164,9 +276,10 @@ class QgsQuickMapCanvasMap : public QQuickItem
     void setRightMargin( double rightMargin );
 
     /**
-     * Returns an image of the last successful map canvas rendering
+     * Returns an image of the last successful map canvas rendering, cropped to the visible extent
+     * when an overscan margin was rendered around it
      */
-    QImage image() const { return mImage; }
+    QImage image() const;
 
   signals:
 
@@ -198,6 +311,27 @@ class QgsQuickMapCanvasMap : public QQuickItem
     //!\copydoc QgsQuickMapCanvasMap::forceDeferredLayersRepaint
     void forceDeferredLayersRepaintChanged();
 
+    //!\copydoc QgsQuickMapCanvasMap::tiledRendering
+    void tiledRenderingChanged();
+
+    //!\copydoc QgsQuickMapCanvasMap::tileCacheMaximumSize
+    void tileCacheMaximumSizeChanged();
+
+    //!\copydoc QgsQuickMapCanvasMap::overscan
+    void overscanChanged();
+
+    //!\copydoc QgsQuickMapCanvasMap::prefetching
+    void prefetchingChanged();
+
+    //!\copydoc QgsQuickMapCanvasMap::collectRenderStatistics
+    void collectRenderStatisticsChanged();
+
+    /**
+     * Emitted when a render job has finished and collectRenderStatistics is enabled.
+     * \param statistics the timings and costs collected from the render job
+     */
+    void renderStatisticsCollected( const QgsQuickMapCanvasMap::RenderStatistics &statistics );
+
     //!\copydoc QgsQuickMapCanvasMap::bottomMargin
     void bottomMarginChanged();
 
@@ -243,17 +377,76 @@ class QgsQuickMapCanvasMap : public QQuickItem
     void onRotationChanged();
     void onLayersChanged();
     void onTemporalStateChanged();
+    void onTilesFetched( int requestId, const QHash<QString, QImage> &tiles );
+    void startPrefetching();
+    void prefetchJobFinished();
 
   private:
+    struct MapTile
+    {
+        int column = 0;
+        int row = 0;
+        QString key;
+    };
+
+    struct TileRange
+    {
+        int columnMin = 0;
+        int columnMax = 0;
+        int rowMin = 0;
+        int rowMax = 0;
+    };
+
     /**
      * Should only be called by stopRendering()!
      */
     void destroyJob( QgsMapRendererJob *job );
     QgsMapSettings prepareMapSettings() const;
+    void startRenderJob( const QgsMapSettings &mapSettings );
+    void completeRefresh();
     void updateTransform();
     void zoomToFullExtent();
     void clearTemporalCache();
 
+    //! Returns a copy of \a mapSettings grown by the overscan margins, the margins in pixels are stored in \a overscan
+    QgsMapSettings overscanMapSettings( const QgsMapSettings &mapSettings, QSize &overscan ) const;
+
+    //! Composes the map image from cached tiles and fetches or renders the missing ones
+    void refreshTiledMap( const QgsMapSettings &mapSettings );
+    //! Draws the missing tiles from a \a renderedImage covering the rendered tile range
+    void drawMissingTiles( const QImage &renderedImage );
+    //! Slices a \a renderedImage covering a tile \a range and stores the given \a tiles
+    void storeTiles( const QImage &renderedImage, const TileRange &range, const QList<MapTile> &tiles, const QStringList &layerIds );
+    //! Returns the range of tiles covering the visible extent of \a mapSettings
+    static TileRange tileRange( const QgsMapSettings &mapSettings );
+    //! Returns the smallest range of tiles covering a list of \a tiles
+    static TileRange boundingTileRange( const QList<MapTile> &tiles );
+    /**
+     * Returns a copy of \a mapSettings covering a tile \a range surrounded by a buffer of TILE_LABEL_BUFFER pixels,
+     * letting labels crossing the range boundary be placed and drawn on the tiles they overlap.
+     */
+    static QgsMapSettings tileRangeMapSettings( const QgsMapSettings &mapSettings, const TileRange &range );
+    //! Returns the tiles within a \a range for given \a mapSettings
+    QList<MapTile> tiles( const QgsMapSettings &mapSettings, const TileRange &range );
+    //! Returns the top-left position within the map image of the tile at a given \a column and \a row
+    QPoint tilePosition( int column, int row ) const;
+    //! Returns the tile key prefix identifying the scale, CRS, and layers of given \a mapSettings
+    QString tileKeyPrefix( const QgsMapSettings &mapSettings );
+    //! Returns a hash identifying the style and data state of a \a layer
+    QString layerTileHash( QgsMapLayer *layer );
+    //! Removes the cached tiles depicting a \a layer
+    void invalidateTiles( QgsMapLayer *layer );
+    //! Inserts a tile \a image matching \a key in the memory cache, tracking the \a layerIds it depicts
+    void insertMemoryTile( const QString &key, const QImage &image, const QStringList &layerIds );
+
+    //! Fetches or renders the tiles of the next queued prefetch extent
+    void prefetchNext();
+    void onPrefetchTilesFetched( const QHash<QString, QImage> &tiles );
+    void stopPrefetching();
+
+    //! Collects the statistics of a finished render \a job and emits renderStatisticsCollected()
+    void collectJobStatistics( QgsMapRendererJob *job );
+
     std::unique_ptr<QgsQuickMapSettings> mMapSettings;
     bool mPinching = false;
     QPoint mPinchStartPoint;
@@ -261,7 +454,11 @@ class QgsQuickMapCanvasMap : public QQuickItem
     std::unique_ptr<QgsMapRendererCache> mCache;
     QgsLabelingResults *mLabelingResults = nullptr;
     QImage mImage;
+    QImage mUploadedImage;
     QgsMapSettings mImageMapSettings;
+    QSize mImageOverscan;
+    QgsMapSettings mJobMapSettings;
+    QSize mJobOverscan;
     QTimer mRefreshTimer;
     bool mDirty = false;
     bool mFreeze = false;
@@ -273,6 +470,46 @@ class QgsQuickMapCanvasMap : public QQuickItem
     double mQuality = 1.0;
     bool mForceDeferredLayersRepaint = false;
 
+    static constexpr int TILE_SIZE = 256;
+    static constexpr int TILE_LABEL_BUFFER = 64; // in pixels
+    static constexpr int TEXTURE_TILE_SIZE = 256;
+    static constexpr int TEXTURE_TILE_OVERLAP = 1; // in pixels
+    static constexpr int TILE_MEMORY_CACHE_SIZE = 64 * 1024; // in kilobytes
+
+    bool mTiledRendering = false;
+    int mTileCacheMaximumSize = 256;
+    std::unique_ptr<QgsQuickMapTileCache> mTileCache;
+    QCache<QString, QImage> mTileMemoryCache;
+    QHash<QString, QSet<QString>> mLayerMemoryTileKeys;
+    QHash<QString, QString> mLayerTileHashes;
+    QgsMapSettings mTiledMapSettings;
+    QStringList mTiledLayerIds;
+    TileRange mTileRange;
+    QPoint mTileOrigin;
+    QList<MapTile> mMissingTiles;
+    TileRange mRenderedTileRange;
+    int mLastTileRequestId = 0;
+    int mTileRequestId = 0;
+    bool mTileFetchPending = false;
+    bool mRenderingTiles = false;
+
+    double mOverscan = 0.0;
+    bool mPrefetching = false;
+    QTimer mPrefetchTimer;
+    QList<QgsMapSettings> mPrefetchQueue;
+    QgsMapSettings mPrefetchMapSettings;
+    QStringList mPrefetchLayerIds;
+    QList<MapTile> mPrefetchTiles;
+    TileRange mPrefetchTileRange;
+    int mPrefetchRequestId = -1;
+    QgsMapRendererSequentialJob *mPrefetchJob = nullptr;
+
+    bool mCollectRenderStatistics = false;
+    std::unique_ptr<RenderedFeatureCounter> mRenderedFeatureCounter;
+    RenderStatistics mRenderStatistics;
+    QElapsedTimer mRenderStatisticsTimer;
+    qint64 mLayersRenderedElapsed = -1;
+
     QQuickWindow *mWindow = nullptr;
 };
 
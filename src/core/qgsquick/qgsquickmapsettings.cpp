@@ -251,6 +251,34 @@ QPointF QgsQuickMapSettings::coordinateToScreen( const QgsPoint &point ) const
   return pp.toQPointF();
 }
 
+void QgsQuickMapSettings::coordinatesToScreen( const double *x, const double *y, qsizetype count, QPointF *points ) const
+{
+  transformCoordinates( screenTransform(), x, y, count, points );
+}
+
+QTransform QgsQuickMapSettings::screenTransform() const
+{
+  const qreal ratio = devicePixelRatio();
+  return mMapSettings.mapToPixel().transform() * QTransform::fromScale( 1.0 / ratio, 1.0 / ratio );
+}
+
+void QgsQuickMapSettings::transformCoordinates( const QTransform &transform, const double *x, const double *y, qsizetype count, QPointF *points )
+{
+  // Hoist the matrix into locals so the loop body is free of calls and branches and can be vectorized
+  const double m11 = transform.m11();
+  const double m12 = transform.m12();
+  const double m21 = transform.m21();
+  const double m22 = transform.m22();
+  const double dx = transform.dx();
+  const double dy = transform.dy();
+  for ( qsizetype i = 0; i < count; ++i )
+  {
+    const double px = x[i];
+    const double py = y[i];
+    points[i] = QPointF( m11 * px + m21 * py + dx, m12 * px + m22 * py + dy );
+  }
+}
+
 QgsPoint QgsQuickMapSettings::screenToCoordinate( const QPointF &point ) const
 {
   const QgsPointXY pp = mMapSettings.mapToPixel().toMapCoordinates( point.x() * devicePixelRatio(), point.y() * devicePixelRatio() );
@@ -19,6 +19,7 @@
 #include "qfield_core_export.h"
 
 #include <QObject>
+#include <QTransform>
 #include <qgscoordinatetransformcontext.h>
 #include <qgsmaplayer.h>
 #include <qgsmapsettings.h>
@@ -195,6 +196,27 @@ class QFIELD_CORE_EXPORT QgsQuickMapSettings : public QObject
      */
     Q_INVOKABLE QPointF coordinateToScreen( const QgsPoint &point ) const;
 
+    /**
+     * Convert \a count map coordinates stored in the contiguous \a x and \a y
+     * arrays to screen pixel coordinates written into \a points.
+     *
+     * This is much cheaper than calling coordinateToScreen() in a loop, the map to
+     * screen matrix being computed once for the whole batch.
+     */
+    void coordinatesToScreen( const double *x, const double *y, qsizetype count, QPointF *points ) const;
+
+    /**
+     * Returns the affine transform converting map coordinates to screen pixel
+     * coordinates, taking into account the map rotation and device pixel ratio.
+     */
+    QTransform screenTransform() const;
+
+    /**
+     * Transforms \a count coordinates stored in the contiguous \a x and \a y arrays
+     * through an affine \a transform, writing the results into \a points.
+     */
+    static void transformCoordinates( const QTransform &transform, const double *x, const double *y, qsizetype count, QPointF *points );
+
     /**
      * Convert a screen coordinate to a map coordinate
      *
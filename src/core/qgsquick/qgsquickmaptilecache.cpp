@@ -0,0 +1,366 @@
+/***************************************************************************
+  qgsquickmaptilecache.cpp
+  --------------------------------------
+  Date                 : 18.10.2026
+  Copyright            : (C) 2026 by OPENGIS.ch
+  Email                : info (at) opengis.ch
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "qgsquickmaptilecache.h"
+
+#include <QBuffer>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <qgsmessagelog.h>
+#include <qgssqliteutils.h>
+
+#include <sqlite3.h>
+
+//! The version of the tables layout, tiles stored with an older layout are dropped
+static const int TILE_CACHE_SCHEMA_VERSION = 1;
+
+class TileCacheWorker : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit TileCacheWorker( const QString &databasePath );
+
+  public slots:
+    /**
+     * Opens the database and creates the tiles table if needed.
+     */
+    void open();
+
+    /**
+     * Reads the tiles matching \a keys and emits tilesFetched().
+     */
+    void fetchTiles( int requestId, const QStringList &keys );
+
+    /**
+     * Encodes and stores a tile \a image, evicting old tiles if the cache grows beyond its maximum size.
+     */
+    void storeTile( const QString &key, const QStringList &layerIds, const QImage &image );
+
+    /**
+     * Removes all tiles depicting the layer matching \a layerId.
+     */
+    void invalidateLayer( const QString &layerId );
+
+    /**
+     * Removes all tiles.
+     */
+    void clear();
+
+    /**
+     * Sets the \a maximumSize in bytes and evicts tiles if needed.
+     */
+    void setMaximumSize( qint64 maximumSize );
+
+  signals:
+    void tilesFetched( int requestId, const QHash<QString, QImage> &tiles );
+
+  private:
+    //! Evicts the least recently accessed tiles until the cache size drops below 90% of its maximum size
+    void trim();
+
+    //! Removes the tile matching the UTF-8 encoded \a keyData alongside its layers
+    void removeTile( const QByteArray &keyData );
+
+    QString mDatabasePath;
+    sqlite3_database_unique_ptr mDatabase;
+    bool mIsValid = false;
+    qint64 mSize = 0;
+    qint64 mMaximumSize = 256 * 1024 * 1024;
+};
+
+QgsQuickMapTileCache::QgsQuickMapTileCache( const QString &databasePath, QObject *parent )
+  : QObject( parent )
+{
+  mWorker = new TileCacheWorker( databasePath );
+  mWorker->moveToThread( &mWorkerThread );
+  connect( &mWorkerThread, &QThread::started, mWorker, &TileCacheWorker::open );
+  connect( &mWorkerThread, &QThread::finished, mWorker, &QObject::deleteLater );
+  connect( this, &QgsQuickMapTileCache::requestFetchTiles, mWorker, &TileCacheWorker::fetchTiles );
+  connect( this, &QgsQuickMapTileCache::requestStoreTile, mWorker, &TileCacheWorker::storeTile );
+  connect( this, &QgsQuickMapTileCache::requestInvalidateLayer, mWorker, &TileCacheWorker::invalidateLayer );
+  connect( this, &QgsQuickMapTileCache::requestClear, mWorker, &TileCacheWorker::clear );
+  connect( this, &QgsQuickMapTileCache::requestMaximumSize, mWorker, &TileCacheWorker::setMaximumSize );
+  connect( mWorker, &TileCacheWorker::tilesFetched, this, &QgsQuickMapTileCache::tilesFetched );
+  mWorkerThread.start( QThread::LowPriority );
+}
+
+QgsQuickMapTileCache::~QgsQuickMapTileCache()
+{
+  mWorkerThread.quit();
+  mWorkerThread.wait();
+}
+
+void QgsQuickMapTileCache::setMaximumSize( qint64 maximumSize )
+{
+  if ( mMaximumSize == maximumSize )
+    return;
+
+  mMaximumSize = maximumSize;
+  emit requestMaximumSize( mMaximumSize );
+}
+
+void QgsQuickMapTileCache::fetchTiles( int requestId, const QStringList &keys )
+{
+  emit requestFetchTiles( requestId, keys );
+}
+
+void QgsQuickMapTileCache::storeTile( const QString &key, const QStringList &layerIds, const QImage &image )
+{
+  emit requestStoreTile( key, layerIds, image );
+}
+
+void QgsQuickMapTileCache::invalidateLayer( const QString &layerId )
+{
+  emit requestInvalidateLayer( layerId );
+}
+
+void QgsQuickMapTileCache::clear()
+{
+  emit requestClear();
+}
+
+TileCacheWorker::TileCacheWorker( const QString &databasePath )
+  : mDatabasePath( databasePath )
+{
+}
+
+void TileCacheWorker::open()
+{
+  QDir().mkpath( QFileInfo( mDatabasePath ).absolutePath() );
+
+  int status = mDatabase.open_v2( mDatabasePath, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr );
+  if ( status != SQLITE_OK )
+  {
+    QgsMessageLog::logMessage( QObject::tr( "There was an error opening the map tile cache database <b>%1</b>: %2" ).arg( mDatabasePath, mDatabase.errorMessage() ) );
+    return;
+  }
+
+  QString error;
+  mDatabase.exec( QStringLiteral( "PRAGMA journal_mode=WAL; PRAGMA synchronous=NORMAL;" ), error );
+
+  // Tiles cached by earlier versions can't be invalidated, drop them
+  sqlite3_statement_unique_ptr version = mDatabase.prepare( QStringLiteral( "PRAGMA user_version" ), status );
+  if ( status == SQLITE_OK && version.step() == SQLITE_ROW && version.columnAsInt64( 0 ) < TILE_CACHE_SCHEMA_VERSION )
+  {
+    version.reset();
+    mDatabase.exec( QStringLiteral( "DROP TABLE IF EXISTS tiles; DROP TABLE IF EXISTS tile_layers; PRAGMA user_version = %1;" ).arg( TILE_CACHE_SCHEMA_VERSION ), error );
+  }
+  version.reset();
+
+  mDatabase.exec( QStringLiteral( "CREATE TABLE IF NOT EXISTS tiles (key TEXT PRIMARY KEY, size INTEGER, accessed INTEGER, image BLOB)" ), error );
+  // The layers depicted by each tile, indexed both ways to invalidate layers and remove tiles without scanning
+  mDatabase.exec( QStringLiteral( "CREATE TABLE IF NOT EXISTS tile_layers (layer TEXT, key TEXT, PRIMARY KEY (layer, key)) WITHOUT ROWID" ), error );
+  if ( !error.isEmpty() )
+  {
+    QgsMessageLog::logMessage( QObject::tr( "Could not create the map tile cache tables: %1" ).arg( error ) );
+    return;
+  }
+  mDatabase.exec( QStringLiteral( "CREATE INDEX IF NOT EXISTS tiles_accessed ON tiles (accessed)" ), error );
+  mDatabase.exec( QStringLiteral( "CREATE INDEX IF NOT EXISTS tile_layers_key ON tile_layers (key)" ), error );
+
+  sqlite3_statement_unique_ptr statement = mDatabase.prepare( QStringLiteral( "SELECT COALESCE(SUM(size), 0) FROM tiles" ), status );
+  if ( status == SQLITE_OK && statement.step() == SQLITE_ROW )
+  {
+    mSize = statement.columnAsInt64( 0 );
+  }
+
+  mIsValid = true;
+  trim();
+}
+
+void TileCacheWorker::fetchTiles( int requestId, const QStringList &keys )
+{
+  QHash<QString, QImage> tiles;
+  if ( mIsValid )
+  {
+    int status = SQLITE_OK;
+    sqlite3_statement_unique_ptr select = mDatabase.prepare( QStringLiteral( "SELECT image FROM tiles WHERE key = ?" ), status );
+    sqlite3_statement_unique_ptr touch = mDatabase.prepare( QStringLiteral( "UPDATE tiles SET accessed = ? WHERE key = ?" ), status );
+    const qint64 accessed = QDateTime::currentSecsSinceEpoch();
+
+    QString error;
+    mDatabase.exec( QStringLiteral( "BEGIN" ), error );
+    for ( const QString &key : keys )
+    {
+      const QByteArray keyData = key.toUtf8();
+      sqlite3_reset( select.get() );
+      sqlite3_bind_text( select.get(), 1, keyData.constData(), static_cast<int>( keyData.size() ), SQLITE_TRANSIENT );
+      if ( select.step() != SQLITE_ROW )
+        continue;
+
+      const int blobSize = sqlite3_column_bytes( select.get(), 0 );
+      const uchar *blob = static_cast<const uchar *>( sqlite3_column_blob( select.get(), 0 ) );
+      QImage image;
+      if ( blob && image.loadFromData( blob, blobSize ) )
+      {
+        tiles.insert( key, image.convertToFormat( QImage::Format_ARGB32_Premultiplied ) );
+
+        sqlite3_reset( touch.get() );
+        sqlite3_bind_int64( touch.get(), 1, accessed );
+        sqlite3_bind_text( touch.get(), 2, keyData.constData(), static_cast<int>( keyData.size() ), SQLITE_TRANSIENT );
+        touch.step();
+      }
+    }
+    mDatabase.exec( QStringLiteral( "COMMIT" ), error );
+  }
+
+  emit tilesFetched( requestId, tiles );
+}
+
+void TileCacheWorker::storeTile( const QString &key, const QStringList &layerIds, const QImage &image )
+{
+  if ( !mIsValid )
+    return;
+
+  QByteArray data;
+  QBuffer buffer( &data );
+  buffer.open( QIODevice::WriteOnly );
+  if ( !image.save( &buffer, "PNG" ) )
+    return;
+
+  const QByteArray keyData = key.toUtf8();
+
+  QString error;
+  mDatabase.exec( QStringLiteral( "BEGIN" ), error );
+
+  // Replacing a tile drops its previous size and layers
+  removeTile( keyData );
+
+  int status = SQLITE_OK;
+  sqlite3_statement_unique_ptr insert = mDatabase.prepare( QStringLiteral( "INSERT INTO tiles (key, size, accessed, image) VALUES (?, ?, ?, ?)" ), status );
+  sqlite3_bind_text( insert.get(), 1, keyData.constData(), static_cast<int>( keyData.size() ), SQLITE_TRANSIENT );
+  sqlite3_bind_int64( insert.get(), 2, data.size() );
+  sqlite3_bind_int64( insert.get(), 3, QDateTime::currentSecsSinceEpoch() );
+  sqlite3_bind_blob( insert.get(), 4, data.constData(), static_cast<int>( data.size() ), SQLITE_TRANSIENT );
+  if ( insert.step() == SQLITE_DONE )
+  {
+    mSize += data.size();
+
+    sqlite3_statement_unique_ptr insertLayer = mDatabase.prepare( QStringLiteral( "INSERT OR IGNORE INTO tile_layers (layer, key) VALUES (?, ?)" ), status );
+    for ( const QString &layerId : layerIds )
+    {
+      const QByteArray layerIdData = layerId.toUtf8();
+      sqlite3_reset( insertLayer.get() );
+      sqlite3_bind_text( insertLayer.get(), 1, layerIdData.constData(), static_cast<int>( layerIdData.size() ), SQLITE_TRANSIENT );
+      sqlite3_bind_text( insertLayer.get(), 2, keyData.constData(), static_cast<int>( keyData.size() ), SQLITE_TRANSIENT );
+      insertLayer.step();
+    }
+  }
+  mDatabase.exec( QStringLiteral( "COMMIT" ), error );
+
+  if ( mSize > mMaximumSize )
+  {
+    trim();
+  }
+}
+
+void TileCacheWorker::invalidateLayer( const QString &layerId )
+{
+  if ( !mIsValid )
+    return;
+
+  const QByteArray layerIdData = layerId.toUtf8();
+
+  int status = SQLITE_OK;
+  sqlite3_statement_unique_ptr select = mDatabase.prepare( QStringLiteral( "SELECT key FROM tile_layers WHERE layer = ?" ), status );
+  sqlite3_bind_text( select.get(), 1, layerIdData.constData(), static_cast<int>( layerIdData.size() ), SQLITE_TRANSIENT );
+  QList<QByteArray> keys;
+  while ( select.step() == SQLITE_ROW )
+  {
+    keys << select.columnAsText( 0 ).toUtf8();
+  }
+  select.reset();
+
+  if ( keys.isEmpty() )
+    return;
+
+  QString error;
+  mDatabase.exec( QStringLiteral( "BEGIN" ), error );
+  for ( const QByteArray &keyData : std::as_const( keys ) )
+  {
+    removeTile( keyData );
+  }
+  mDatabase.exec( QStringLiteral( "COMMIT" ), error );
+}
+
+void TileCacheWorker::removeTile( const QByteArray &keyData )
+{
+  int status = SQLITE_OK;
+  sqlite3_statement_unique_ptr size = mDatabase.prepare( QStringLiteral( "SELECT size FROM tiles WHERE key = ?" ), status );
+  sqlite3_bind_text( size.get(), 1, keyData.constData(), static_cast<int>( keyData.size() ), SQLITE_TRANSIENT );
+  if ( size.step() != SQLITE_ROW )
+    return;
+
+  mSize -= size.columnAsInt64( 0 );
+  size.reset();
+
+  sqlite3_statement_unique_ptr remove = mDatabase.prepare( QStringLiteral( "DELETE FROM tiles WHERE key = ?" ), status );
+  sqlite3_bind_text( remove.get(), 1, keyData.constData(), static_cast<int>( keyData.size() ), SQLITE_TRANSIENT );
+  remove.step();
+
+  sqlite3_statement_unique_ptr removeLayers = mDatabase.prepare( QStringLiteral( "DELETE FROM tile_layers WHERE key = ?" ), status );
+  sqlite3_bind_text( removeLayers.get(), 1, keyData.constData(), static_cast<int>( keyData.size() ), SQLITE_TRANSIENT );
+  removeLayers.step();
+}
+
+void TileCacheWorker::clear()
+{
+  if ( !mIsValid )
+    return;
+
+  QString error;
+  mDatabase.exec( QStringLiteral( "DELETE FROM tiles; DELETE FROM tile_layers;" ), error );
+  mSize = 0;
+}
+
+void TileCacheWorker::setMaximumSize( qint64 maximumSize )
+{
+  mMaximumSize = maximumSize;
+  if ( mSize > mMaximumSize )
+  {
+    trim();
+  }
+}
+
+void TileCacheWorker::trim()
+{
+  if ( !mIsValid || mSize <= mMaximumSize )
+    return;
+
+  const qint64 targetSize = mMaximumSize * 9 / 10;
+
+  int status = SQLITE_OK;
+  sqlite3_statement_unique_ptr select = mDatabase.prepare( QStringLiteral( "SELECT key, size FROM tiles ORDER BY accessed ASC" ), status );
+  QList<QByteArray> keys;
+  qint64 evictedSize = 0;
+  while ( mSize - evictedSize > targetSize && select.step() == SQLITE_ROW )
+  {
+    keys << select.columnAsText( 0 ).toUtf8();
+    evictedSize += select.columnAsInt64( 1 );
+  }
+  select.reset();
+
+  QString error;
+  mDatabase.exec( QStringLiteral( "BEGIN" ), error );
+  for ( const QByteArray &keyData : std::as_const( keys ) )
+  {
+    removeTile( keyData );
+  }
+  mDatabase.exec( QStringLiteral( "COMMIT" ), error );
+}
+
+#include "qgsquickmaptilecache.moc"
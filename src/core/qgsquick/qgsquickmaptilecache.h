@@ -0,0 +1,106 @@
+/***************************************************************************
+  qgsquickmaptilecache.h
+  --------------------------------------
+  Date                 : 18.10.2026
+  Copyright            : (C) 2026 by OPENGIS.ch
+  Email                : info (at) opengis.ch
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef QGSQUICKMAPTILECACHE_H
+#define QGSQUICKMAPTILECACHE_H
+
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <QThread>
+
+class TileCacheWorker;
+
+/**
+ * The QgsQuickMapTileCache class is a size-bounded, persistent cache of rendered
+ * map tiles stored in a SQLite database.
+ *
+ * All database operations (including image encoding and decoding) are performed
+ * on a background thread. Tiles are fetched asynchronously and returned through the
+ * tilesFetched() signal. When the cache grows beyond its maximum size, the least
+ * recently accessed tiles are evicted.
+ *
+ * Each tile is stored alongside the IDs of the layers it depicts so tiles can be
+ * invalidated precisely when a layer changes.
+ *
+ * \ingroup core
+ */
+class QgsQuickMapTileCache : public QObject
+{
+    Q_OBJECT
+
+  public:
+    /**
+     * Creates a tile cache backed by the SQLite database at \a databasePath,
+     * the database will be created if it doesn't exist yet.
+     */
+    explicit QgsQuickMapTileCache( const QString &databasePath, QObject *parent = nullptr );
+    ~QgsQuickMapTileCache();
+
+    //! Returns the maximum size in bytes of the tiles stored in the cache
+    qint64 maximumSize() const { return mMaximumSize; }
+
+    //! Sets the maximum size in bytes of the tiles stored in the cache
+    void setMaximumSize( qint64 maximumSize );
+
+    /**
+     * Requests the tiles matching a list of \a keys. The found tiles will be
+     * returned through the tilesFetched() signal alongside the \a requestId.
+     */
+    void fetchTiles( int requestId, const QStringList &keys );
+
+    /**
+     * Stores a tile \a image identified by a \a key into the cache. The \a layerIds
+     * list is used to invalidate the tile when any of its layers change.
+     */
+    void storeTile( const QString &key, const QStringList &layerIds, const QImage &image );
+
+    //! Removes all tiles depicting the layer matching a given \a layerId
+    void invalidateLayer( const QString &layerId );
+
+    //! Removes all tiles from the cache
+    void clear();
+
+  signals:
+
+    /**
+     * Emitted when tiles requested via fetchTiles() have been read.
+     * \param requestId the request identifier passed on to fetchTiles()
+     * \param tiles the found tiles, missing tiles are omitted
+     */
+    void tilesFetched( int requestId, const QHash<QString, QImage> &tiles );
+
+    //! Requests the worker to fetch tiles
+    void requestFetchTiles( int requestId, const QStringList &keys );
+
+    //! Requests the worker to store a tile
+    void requestStoreTile( const QString &key, const QStringList &layerIds, const QImage &image );
+
+    //! Requests the worker to remove all tiles depicting a layer
+    void requestInvalidateLayer( const QString &layerId );
+
+    //! Requests the worker to remove all tiles
+    void requestClear();
+
+    //! Requests the worker to update its maximum size
+    void requestMaximumSize( qint64 maximumSize );
+
+  private:
+    QThread mWorkerThread;
+    TileCacheWorker *mWorker = nullptr;
+    qint64 mMaximumSize = 256 * 1024 * 1024;
+};
+
+#endif // QGSQUICKMAPTILECACHE_H
@@ -14,6 +14,7 @@
  *                                                                         *
  ***************************************************************************/
 
+#include "listmodelutils.h"
 #include "referencingfeaturelistmodel.h"
 
 #include <qgsmessagelog.h>
@@ -151,16 +152,72 @@ bool ReferencingFeatureListModel::parentPrimariesAvailable() const
   return mParentPrimariesAvailable;
 }
 
-void ReferencingFeatureListModel::updateModel()
+void ReferencingFeatureListModel::appendEntries( const QList<ReferencingFeatureListModel::Entry> &entries )
+{
+  if ( sender() != mGatherer )
+    return;
+
+  // The previous entries stay visible until the first batch of a reload comes in
+  if ( !mGathererCollectedEntries )
+  {
+    mGathererCollectedEntries = true;
+
+    QList<Entry> sortedEntries = entries;
+    std::stable_sort( sortedEntries.begin(), sortedEntries.end(), [this]( const Entry &e1, const Entry &e2 ) {
+      return entryLessThan( e1, e2 );
+    } );
+
+    beginResetModel();
+    mEntries = sortedEntries;
+    endResetModel();
+    return;
+  }
+
+  insertEntries( entries );
+}
+
+void ReferencingFeatureListModel::insertEntries( const QList<Entry> &entries )
 {
-  beginResetModel();
+  if ( entries.isEmpty() )
+    return;
 
-  if ( mGatherer )
-    mEntries = mGatherer->entries();
+  auto lessThan = [this]( const Entry &e1, const Entry &e2 ) {
+    return entryLessThan( e1, e2 );
+  };
+  ListModelUtils::MergedRows rows;
+  const QList<Entry> mergedEntries = ListModelUtils::mergeSortedEntries( mEntries, entries, lessThan, rows );
 
-  sortEntries();
+  if ( rows.contiguous )
+  {
+    beginInsertRows( QModelIndex(), rows.firstRow, rows.firstRow + static_cast<int>( entries.size() ) - 1 );
+    mEntries = mergedEntries;
+    endInsertRows();
+  }
+  else
+  {
+    emit layoutAboutToBeChanged();
+    const QModelIndexList persistentIndexes = persistentIndexList();
+    mEntries = mergedEntries;
+    for ( const QModelIndex &persistentIndex : persistentIndexes )
+    {
+      changePersistentIndex( persistentIndex, index( rows.previousRows.at( persistentIndex.row() ), persistentIndex.column(), QModelIndex() ) );
+    }
+    emit layoutChanged();
+  }
+}
+
+void ReferencingFeatureListModel::updateModel()
+{
+  if ( sender() != mGatherer )
+    return;
+
+  if ( !mGathererCollectedEntries )
+  {
+    beginResetModel();
+    mEntries.clear();
+    endResetModel();
+  }
 
-  endResetModel();
   emit modelUpdated();
 }
 
@@ -188,6 +245,7 @@ void ReferencingFeatureListModel::reload()
     {
       // Send the gatherer thread to the graveyard:
       //   forget about it, tell it to stop and delete when finished
+      disconnect( mGatherer, &FeatureGatherer::entriesCollected, this, &ReferencingFeatureListModel::appendEntries );
       disconnect( mGatherer, &FeatureGatherer::collectedValues, this, &ReferencingFeatureListModel::updateModel );
       disconnect( mGatherer, &FeatureGatherer::finished, this, &ReferencingFeatureListModel::gathererThreadFinished );
       connect( mGatherer, &FeatureGatherer::finished, mGatherer, &FeatureGatherer::deleteLater );
@@ -196,7 +254,9 @@ void ReferencingFeatureListModel::reload()
     }
 
     mGatherer = new FeatureGatherer( mFeature, mRelation, mNmRelation );
+    mGathererCollectedEntries = false;
 
+    connect( mGatherer, &FeatureGatherer::entriesCollected, this, &ReferencingFeatureListModel::appendEntries );
     connect( mGatherer, &FeatureGatherer::collectedValues, this, &ReferencingFeatureListModel::updateModel );
     connect( mGatherer, &FeatureGatherer::finished, this, &ReferencingFeatureListModel::gathererThreadFinished );
 
@@ -317,9 +377,7 @@ bool ReferencingFeatureListModel::beforeDeleteFeature( QgsVectorLayer *referenci
   return true;
 }
 
-void ReferencingFeatureListModel::sortEntries()
+bool ReferencingFeatureListModel::entryLessThan( const Entry &e1, const Entry &e2 ) const
 {
-  std::sort( mEntries.begin(), mEntries.end(), []( const Entry &e1, const Entry &e2 ) {
-    return e1.displayString < e2.displayString;
-  } );
+  return e1.displayString < e2.displayString;
 }
@@ -27,6 +27,8 @@
 
 #include <QThread>
 
+#include <atomic>
+
 class QgsVectorLayer;
 class FeatureGatherer;
 class OrderedRelationModel;
@@ -167,6 +169,7 @@ class QFIELD_CORE_EXPORT ReferencingFeatureListModel : public QAbstractItemModel
 
   private slots:
     void updateModel();
+    void appendEntries( const QList<ReferencingFeatureListModel::Entry> &entries );
     void gathererThreadFinished();
 
   private:
@@ -194,11 +197,17 @@ class QFIELD_CORE_EXPORT ReferencingFeatureListModel : public QAbstractItemModel
     bool mParentPrimariesAvailable = false;
 
     FeatureGatherer *mGatherer = nullptr;
+    bool mGathererCollectedEntries = false;
 
     //! Checks if the parent pk(s) is not null
     bool checkParentPrimaries();
     virtual bool beforeDeleteFeature( QgsVectorLayer *referencingLayer, QgsFeatureId referencingFeatureId );
-    virtual void sortEntries();
+
+    //! Returns TRUE if \a e1 is listed before \a e2, entries are sorted by display string by default
+    virtual bool entryLessThan( const Entry &e1, const Entry &e2 ) const;
+
+    //! Merges a batch of \a entries at their sorted rows without resetting the model
+    void insertEntries( const QList<Entry> &entries );
 
     friend class FeatureGatherer;
     friend class OrderedRelationModel;
@@ -243,6 +252,7 @@ class FeatureGatherer : public QThread
       QgsExpressionContext context = mRelation.referencingLayer()->createExpressionContext();
       QgsExpression expression( mRelation.referencingLayer()->displayExpression() );
 
+      QList<ReferencingFeatureListModel::Entry> entries;
       QgsFeature childFeature;
       QString displayString;
       while ( relatedFeaturesIt.nextFeature( childFeature ) )
@@ -263,12 +273,21 @@ class FeatureGatherer : public QThread
         }
 
         //test sleep(1);
-        mEntries.append( ReferencingFeatureListModel::Entry( displayString, childFeature, nmDisplayString, nmFeature ) );
+        entries.append( ReferencingFeatureListModel::Entry( displayString, childFeature, nmDisplayString, nmFeature ) );
 
         if ( mWasCanceled )
           return;
+
+        if ( entries.size() >= BATCH_SIZE )
+        {
+          emit entriesCollected( entries );
+          entries.clear();
+        }
       }
 
+      if ( !entries.isEmpty() )
+        emit entriesCollected( entries );
+
       emit collectedValues();
     }
 
@@ -281,26 +300,27 @@ class FeatureGatherer : public QThread
     //! \returns true if collection was canceled before completion
     bool wasCanceled() const { return mWasCanceled; }
 
-    //! \returns the list of entries
-    QList<ReferencingFeatureListModel::Entry> entries() const { return mEntries; }
-
   signals:
 
     /**
-     * Emitted when values have been collected
-     * \param values list of unique matching string values
+     * Emitted when a batch of \a entries has been collected, allowing for the model to be populated progressively
+     */
+    void entriesCollected( const QList<ReferencingFeatureListModel::Entry> &entries );
+
+    /**
+     * Emitted when all values have been collected, following the last entriesCollected() batch
      */
     void collectedValues();
 
   private:
-    QList<ReferencingFeatureListModel::Entry> mEntries;
+    static constexpr int BATCH_SIZE = 100;
 
     QgsFeature mFeature;
     QgsRelation mRelation;
     QgsRelation mNmRelation;
 
     QgsFeatureRequest mRequest;
-    bool mWasCanceled = false;
+    std::atomic<bool> mWasCanceled = false;
 };
 
 #endif // REFERENCINGFEATURELISTMODEL_H
@@ -20,6 +20,8 @@
 #include "rubberbandshape.h"
 #include "vertexmodel.h"
 
+#include <vector>
+
 RubberbandShape::RubberbandShape( QQuickItem *parent )
   : QQuickItem( parent )
 {
@@ -189,10 +191,20 @@ void RubberbandShape::createPolylines()
       geomType = mVertexModel->geometryType();
     }
   }
+
+  // Unrotated transform into item coordinates relative to the top left corner, the item itself handles the rotation
+  const QTransform transform( scaleFactor, 0, 0, -scaleFactor, -visibleExtent.xMinimum() * scaleFactor, visibleExtent.yMaximum() * scaleFactor );
+  std::vector<double> xCoordinates;
+  std::vector<double> yCoordinates;
+  xCoordinates.reserve( allVertices.size() );
+  yCoordinates.reserve( allVertices.size() );
   for ( const QgsPoint &point : std::as_const( allVertices ) )
   {
-    polyline << QPointF( ( point.x() - visibleExtent.xMinimum() ) * scaleFactor, ( point.y() - visibleExtent.yMaximum() ) * -scaleFactor );
+    xCoordinates.push_back( point.x() );
+    yCoordinates.push_back( point.y() );
   }
+  polyline.resize( allVertices.size() );
+  QgsQuickMapSettings::transformCoordinates( transform, xCoordinates.data(), yCoordinates.data(), polyline.size(), polyline.data() );
   mPolylines << polyline;
 
   if ( geomType != mPolylinesType )
@@ -0,0 +1,141 @@
+/***************************************************************************
+  thumbnailcache.cpp - ThumbnailCache
+
+ ---------------------
+ begin                : 18.10.2026
+ copyright            : (C) 2026 by OPENGIS.ch
+ email                : info@opengis.ch
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "thumbnailcache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QImageWriter>
+#include <QSaveFile>
+
+//! The suffix of cached thumbnails, whose format is detected from their content
+static const QString THUMBNAIL_SUFFIX = QStringLiteral( "thumbnail" );
+
+ThumbnailCache::ThumbnailCache( const QString &directory, qint64 maximumSize )
+  : mDirectory( directory )
+  , mMaximumSize( maximumSize )
+{
+}
+
+QString ThumbnailCache::key( const QString &path, const QSize &size )
+{
+  const QFileInfo fileInfo( path );
+  if ( !fileInfo.exists() )
+    return QString();
+
+  const QString keySource = QStringLiteral( "%1|%2|%3|%4x%5" ).arg( fileInfo.absoluteFilePath() ).arg( fileInfo.lastModified().toMSecsSinceEpoch() ).arg( fileInfo.size() ).arg( size.width() ).arg( size.height() );
+  return QStringLiteral( "%1.%2" ).arg( QString( QCryptographicHash::hash( keySource.toUtf8(), QCryptographicHash::Sha1 ).toHex() ), THUMBNAIL_SUFFIX );
+}
+
+QImage ThumbnailCache::thumbnail( const QString &path, const QSize &size, bool *found )
+{
+  if ( found )
+    *found = false;
+
+  const QString thumbnailKey = key( path, size );
+  if ( thumbnailKey.isEmpty() )
+    return QImage();
+
+  // An empty file records that no thumbnail could be rendered
+  const QString thumbnailPath = QDir( mDirectory ).filePath( thumbnailKey );
+  QFile file( thumbnailPath );
+  if ( !file.open( QIODevice::ReadWrite | QIODevice::ExistingOnly ) )
+    return QImage();
+
+  QImage image;
+  if ( file.size() > 0 && !image.load( &file, nullptr ) )
+    return QImage();
+
+  // Refresh the modification time, which trim() relies on to remove the least recently used thumbnails
+  file.setFileTime( QDateTime::currentDateTime(), QFileDevice::FileModificationTime );
+
+  if ( found )
+    *found = true;
+
+  return image;
+}
+
+void ThumbnailCache::insert( const QString &path, const QSize &size, const QImage &thumbnail )
+{
+  const QString thumbnailKey = key( path, size );
+  if ( thumbnailKey.isEmpty() )
+    return;
+
+  QDir dir( mDirectory );
+  if ( !dir.exists() && !dir.mkpath( QStringLiteral( "." ) ) )
+    return;
+
+  QSaveFile file( dir.filePath( thumbnailKey ) );
+  if ( !file.open( QIODevice::WriteOnly ) )
+    return;
+
+  if ( !thumbnail.isNull() )
+  {
+    // JPEG takes a fraction of the space and encoding time of PNG, images with an alpha channel need a format keeping it
+    static const bool sWebPSupported = QImageWriter::supportedImageFormats().contains( "webp" );
+    bool saved = false;
+    if ( !thumbnail.hasAlphaChannel() )
+      saved = thumbnail.save( &file, "JPEG", 85 );
+    else if ( sWebPSupported )
+      saved = thumbnail.save( &file, "WEBP", 100 ); // lossless at the highest quality
+    else
+      saved = thumbnail.save( &file, "PNG" );
+
+    if ( !saved )
+      return;
+  }
+
+  if ( !file.commit() )
+    return;
+
+  QMutexLocker locker( &mMutex );
+  if ( mSize >= 0 )
+    mSize += QFileInfo( dir.filePath( thumbnailKey ) ).size();
+  if ( mSize < 0 || mSize > mMaximumSize )
+    trim();
+}
+
+void ThumbnailCache::clear()
+{
+  QMutexLocker locker( &mMutex );
+  const QFileInfoList entries = QDir( mDirectory ).entryInfoList( { QStringLiteral( "*.%1" ).arg( THUMBNAIL_SUFFIX ) }, QDir::Files );
+  for ( const QFileInfo &entry : entries )
+    QFile::remove( entry.absoluteFilePath() );
+  mSize = 0;
+}
+
+void ThumbnailCache::trim()
+{
+  // Oldest first
+  const QFileInfoList entries = QDir( mDirectory ).entryInfoList( { QStringLiteral( "*.%1" ).arg( THUMBNAIL_SUFFIX ) }, QDir::Files, QDir::Time | QDir::Reversed );
+
+  mSize = 0;
+  for ( const QFileInfo &entry : entries )
+    mSize += entry.size();
+
+  // Trim below the maximum size to avoid trimming again on the very next insertions
+  const qint64 targetSize = mMaximumSize * 8 / 10;
+  for ( const QFileInfo &entry : entries )
+  {
+    if ( mSize <= targetSize )
+      break;
+
+    if ( QFile::remove( entry.absoluteFilePath() ) )
+      mSize -= entry.size();
+  }
+}
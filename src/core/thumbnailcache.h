@@ -0,0 +1,83 @@
+/***************************************************************************
+  thumbnailcache.h - ThumbnailCache
+
+ ---------------------
+ begin                : 18.10.2026
+ copyright            : (C) 2026 by OPENGIS.ch
+ email                : info@opengis.ch
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef THUMBNAILCACHE_H
+#define THUMBNAILCACHE_H
+
+#include "qfield_core_export.h"
+
+#include <QImage>
+#include <QMutex>
+#include <QString>
+
+/**
+ * A size-bounded on-disk cache of file thumbnails.
+ *
+ * Thumbnails are keyed on the file path, its last modification time and the requested
+ * size, a modified file therefore never hits stale thumbnails. When the cache grows
+ * beyond its maximum size, the least recently used thumbnails are removed.
+ *
+ * Opaque thumbnails are stored as JPEG, others as lossless WebP when supported. Files for
+ * which no thumbnail could be rendered are cached as well, sparing attempts to render them again.
+ *
+ * The cache can be used concurrently from multiple threads.
+ * \ingroup core
+ */
+class QFIELD_CORE_EXPORT ThumbnailCache
+{
+  public:
+    /**
+     * Creates a thumbnail cache storing its thumbnails in \a directory, using up to
+     * \a maximumSize bytes of storage.
+     */
+    explicit ThumbnailCache( const QString &directory, qint64 maximumSize = DEFAULT_MAXIMUM_SIZE );
+
+    //! Returns the directory in which thumbnails are stored
+    QString directory() const { return mDirectory; }
+
+    //! Returns the maximum size in bytes used by the cached thumbnails
+    qint64 maximumSize() const { return mMaximumSize; }
+
+    //! Returns the cache key of the \a path file thumbnail of \a size, an empty string if the file does not exist
+    static QString key( const QString &path, const QSize &size );
+
+    /**
+     * Returns the cached \a path file thumbnail of \a size, a null image if none is cached or if no thumbnail
+     * could be rendered. When given, \a found is set to TRUE if either of them is cached.
+     */
+    QImage thumbnail( const QString &path, const QSize &size, bool *found = nullptr );
+
+    //! Caches the \a path file \a thumbnail of \a size, a null \a thumbnail records that none could be rendered
+    void insert( const QString &path, const QSize &size, const QImage &thumbnail );
+
+    //! Removes all cached thumbnails
+    void clear();
+
+    static constexpr qint64 DEFAULT_MAXIMUM_SIZE = 50 * 1024 * 1024;
+
+  private:
+    //! Removes the least recently used thumbnails until the cache fits in its maximum size
+    void trim();
+
+    QString mDirectory;
+    qint64 mMaximumSize = DEFAULT_MAXIMUM_SIZE;
+
+    QMutex mMutex;
+    //! The size of the cached thumbnails, -1 until the directory got scanned
+    qint64 mSize = -1;
+};
+
+#endif // THUMBNAILCACHE_H
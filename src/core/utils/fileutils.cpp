@@ -14,20 +14,25 @@
  *                                                                         *
  ***************************************************************************/
 
+#include "etaghash.h"
 #include "fileutils.h"
 #include "gnsspositioninformation.h"
 
+#include <QBuffer>
 #include <QDebug>
 #include <QDir>
 #include <QDirIterator>
 #include <QFileInfo>
+#include <QFutureWatcher>
 #include <QImage>
 #include <QImageReader>
 #include <QMimeDatabase>
 #include <QPainter>
 #include <QPainterPath>
+#include <QSaveFile>
+#include <QtConcurrent>
+#include <exiv2/exiv2.hpp>
 #include <qgis.h>
-#include <qgsexiftools.h>
 #include <qgsfileutils.h>
 #include <qgsrendercontext.h>
 #include <qgstextformat.h>
@@ -180,62 +185,57 @@ QString FileUtils::fileEtag( const QString &fileName, int partSize )
   if ( !f.open( QFile::ReadOnly ) )
     return QString();
 
-  const qint64 fileSize = f.size();
-  QCryptographicHash hash( QCryptographicHash::Md5 );
-  if ( fileSize <= partSize )
+  EtagHash hash( partSize );
+  if ( !hash.addData( &f ) )
+    return QString();
+
+  return hash.result();
+}
+
+//! Returns the exiv2 string representation of a \a coordinate in degrees, minutes and seconds rationals
+static QString exifCoordinate( double coordinate )
+{
+  const double absolute = std::abs( coordinate );
+  const int degrees = static_cast<int>( absolute );
+  const int minutes = static_cast<int>( ( absolute - degrees ) * 60 );
+  const double seconds = ( absolute - degrees - minutes / 60.0 ) * 3600;
+  return QStringLiteral( "%1/1 %2/1 %3/1000" ).arg( degrees ).arg( minutes ).arg( static_cast<qlonglong>( std::round( seconds * 1000 ) ) );
+}
+
+//! Sets the metadata \a key to \a value, converting values the same way QgsExifTools::tagImage() does
+static void setImageMetadataValue( Exiv2::ExifData &exifData, Exiv2::XmpData &xmpData, const QString &key, const QVariant &value )
+{
+  const std::string tag = key.toStdString();
+  if ( key.startsWith( QLatin1String( "Xmp." ) ) )
   {
-    if ( hash.addData( &f ) )
-    {
-      return hash.result().toHex();
-    }
+    xmpData[tag] = value.toString().toStdString();
   }
-  else
+  else if ( key == QLatin1String( "Exif.GPSInfo.GPSLatitude" ) || key == QLatin1String( "Exif.GPSInfo.GPSLongitude" ) || key == QLatin1String( "Exif.GPSInfo.GPSDestLatitude" ) || key == QLatin1String( "Exif.GPSInfo.GPSDestLongitude" ) )
   {
-    QByteArray md5SumsData;
-    qint64 readSize = 0;
-    while ( readSize < fileSize )
-    {
-      hash.addData( f.read( partSize ) );
-      md5SumsData += hash.result();
-      hash.reset();
-      readSize += partSize;
-    }
-    hash.addData( md5SumsData );
-    return QStringLiteral( "%1-%2" ).arg( hash.result().toHex() ).arg( readSize / partSize );
+    exifData[tag] = exifCoordinate( value.toDouble() ).toStdString();
   }
-  return QString();
-}
-
-void FileUtils::restrictImageSize( const QString &imagePath, int maximumWidthHeight )
-{
-  if ( !QFileInfo::exists( imagePath ) )
+  else if ( key == QLatin1String( "Exif.GPSInfo.GPSTimeStamp" ) || key == QLatin1String( "Exif.Image.GPSTimeStamp" ) )
   {
-    return;
+    const QTime time = value.toTime();
+    exifData[tag] = QStringLiteral( "%1/1 %2/1 %3/1" ).arg( time.hour() ).arg( time.minute() ).arg( time.second() ).toStdString();
   }
-
-  QVariantMap metadata = QgsExifTools::readTags( imagePath );
-  QImage img( imagePath );
-  if ( !img.isNull() && ( img.width() > maximumWidthHeight || img.height() > maximumWidthHeight ) )
+  else if ( key == QLatin1String( "Exif.GPSInfo.GPSDateStamp" ) || key == QLatin1String( "Exif.Image.GPSDateStamp" ) )
   {
-    QImage scaledImage = img.width() > img.height()
-                           ? img.scaledToWidth( maximumWidthHeight, Qt::SmoothTransformation )
-                           : img.scaledToHeight( maximumWidthHeight, Qt::SmoothTransformation );
-    scaledImage.save( imagePath, nullptr, 90 );
-
-    for ( const QString &key : metadata.keys() )
-    {
-      QgsExifTools::tagImage( imagePath, key, metadata[key] );
-    }
+    exifData[tag] = value.toDate().toString( QStringLiteral( "yyyy:MM:dd" ) ).toStdString();
   }
-}
-
-void FileUtils::addImageMetadata( const QString &imagePath, const GnssPositionInformation &positionInformation )
-{
-  if ( !QFileInfo::exists( imagePath ) )
+  else if ( value.typeId() == QMetaType::Double || value.typeId() == QMetaType::Float )
   {
-    return;
+    exifData[tag] = Exiv2::floatToRationalCast( value.toFloat() );
   }
+  else
+  {
+    exifData[tag] = value.toString().toStdString();
+  }
+}
 
+//! Returns the geotagging metadata of a \a positionInformation
+static QVariantMap positionMetadata( const GnssPositionInformation &positionInformation )
+{
   QVariantMap metadata;
   if ( positionInformation.latitudeValid() && positionInformation.longitudeValid() )
   {
@@ -268,47 +268,156 @@ void FileUtils::addImageMetadata( const QString &imagePath, const GnssPositionIn
   metadata["Exif.Image.Make"] = QStringLiteral( "QField" );
   metadata["Xmp.tiff.Make"] = QStringLiteral( "QField" );
 
-  for ( const QString key : metadata.keys() )
-  {
-    QgsExifTools::tagImage( imagePath, key, metadata[key] );
-  }
+  return metadata;
 }
 
-void FileUtils::addImageStamp( const QString &imagePath, const QString &text )
+//! Draws the stamp \a text at the bottom of an \a image
+static void drawImageStamp( QImage &image, const QString &text )
+{
+  QPainter painter( &image );
+  painter.setRenderHint( QPainter::Antialiasing );
+
+  QFont font = painter.font();
+  font.setPixelSize( std::min( image.width(), image.height() ) / 40 );
+  font.setBold( true );
+
+  QgsRenderContext context = QgsRenderContext::fromQPainter( &painter );
+  QgsTextFormat format;
+  format.setFont( font );
+  format.setSize( font.pixelSize() );
+  format.setSizeUnit( Qgis::RenderUnit::Pixels );
+  format.setColor( Qt::white );
+  format.buffer().setColor( Qt::black );
+  format.buffer().setSize( 2 );
+  format.buffer().setSizeUnit( Qgis::RenderUnit::Pixels );
+  format.buffer().setEnabled( true );
+  QgsTextRenderer::drawText( QRectF( 10, 10, image.width() - 20, image.height() - 20 ), 0, Qgis::TextHorizontalAlignment::Left, text.split( QStringLiteral( "\n" ) ), context, format, true, Qgis::TextVerticalAlignment::Bottom, Qgis::TextRendererFlag::WrapLines );
+}
+
+bool FileUtils::processImageFile( const QString &imagePath, int maximumWidthHeight, const QString &stampText, const QVariantMap &metadata )
 {
-  if ( !QFileInfo::exists( imagePath ) || text.isEmpty() )
+  if ( !QFileInfo::exists( imagePath ) )
+  {
+    return false;
+  }
+
+  QImageReader reader( imagePath );
+  const QByteArray format = reader.format();
+  const QSize size = reader.size();
+  const bool resize = maximumWidthHeight > 0 && ( size.width() > maximumWidthHeight || size.height() > maximumWidthHeight );
+  const bool stamp = !stampText.isEmpty();
+  if ( !resize && !stamp && metadata.isEmpty() )
   {
-    return;
+    return true;
   }
 
-  QVariantMap metadata = QgsExifTools::readTags( imagePath );
-  QImage img( imagePath );
-  if ( !img.isNull() )
+  try
   {
-    QPainter painter( &img );
-    painter.setRenderHint( QPainter::Antialiasing );
-
-    QFont font = painter.font();
-    font.setPixelSize( std::min( img.width(), img.height() ) / 40 );
-    font.setBold( true );
-
-    QgsRenderContext context = QgsRenderContext::fromQPainter( &painter );
-    QgsTextFormat format;
-    format.setFont( font );
-    format.setSize( font.pixelSize() );
-    format.setSizeUnit( Qgis::RenderUnit::Pixels );
-    format.setColor( Qt::white );
-    format.buffer().setColor( Qt::black );
-    format.buffer().setSize( 2 );
-    format.buffer().setSizeUnit( Qgis::RenderUnit::Pixels );
-    format.buffer().setEnabled( true );
-    QgsTextRenderer::drawText( QRectF( 10, 10, img.width() - 20, img.height() - 20 ), 0, Qgis::TextHorizontalAlignment::Left, text.split( QStringLiteral( "\n" ) ), context, format, true, Qgis::TextVerticalAlignment::Bottom, Qgis::TextRendererFlag::WrapLines );
-
-    img.save( imagePath, nullptr, 90 );
-
-    for ( const QString &key : metadata.keys() )
+    auto sourceImage = Exiv2::ImageFactory::open( imagePath.toStdString() );
+    sourceImage->readMetadata();
+    Exiv2::ExifData exifData = sourceImage->exifData();
+    Exiv2::XmpData xmpData = sourceImage->xmpData();
+    for ( auto it = metadata.constBegin(); it != metadata.constEnd(); ++it )
     {
-      QgsExifTools::tagImage( imagePath, key, metadata[key] );
+      setImageMetadataValue( exifData, xmpData, it.key(), it.value() );
     }
+
+    if ( !resize && !stamp )
+    {
+      // The pixels are left untouched, a single metadata write is all there is to do
+      sourceImage->setExifData( exifData );
+      sourceImage->setXmpData( xmpData );
+      sourceImage->writeMetadata();
+      return true;
+    }
+
+    // Decode once, apply all pixel operations, and encode once into memory
+    QImage image = reader.read();
+    if ( image.isNull() )
+    {
+      return false;
+    }
+
+    if ( resize )
+    {
+      image = image.width() > image.height()
+                ? image.scaledToWidth( maximumWidthHeight, Qt::SmoothTransformation )
+                : image.scaledToHeight( maximumWidthHeight, Qt::SmoothTransformation );
+      exifData["Exif.Photo.PixelXDimension"] = static_cast<uint32_t>( image.width() );
+      exifData["Exif.Photo.PixelYDimension"] = static_cast<uint32_t>( image.height() );
+    }
+
+    if ( stamp )
+    {
+      drawImageStamp( image, stampText );
+    }
+
+    QByteArray encodedImage;
+    QBuffer buffer( &encodedImage );
+    buffer.open( QIODevice::WriteOnly );
+    if ( !image.save( &buffer, format.constData(), 90 ) )
+    {
+      return false;
+    }
+    buffer.close();
+
+    // Attach the metadata to the encoded image in memory, then write the file a single time
+    auto targetImage = Exiv2::ImageFactory::open( reinterpret_cast<const Exiv2::byte *>( encodedImage.constData() ), encodedImage.size() );
+    targetImage->setExifData( exifData );
+    targetImage->setXmpData( xmpData );
+    targetImage->setIptcData( sourceImage->iptcData() );
+    targetImage->writeMetadata();
+
+    Exiv2::BasicIo &io = targetImage->io();
+    io.open();
+    const QByteArray output( reinterpret_cast<const char *>( io.mmap() ), static_cast<qsizetype>( io.size() ) );
+    io.munmap();
+    io.close();
+
+    QSaveFile file( imagePath );
+    if ( !file.open( QIODevice::WriteOnly ) || file.write( output ) != output.size() )
+    {
+      return false;
+    }
+    return file.commit();
+  }
+  catch ( const std::exception &e )
+  {
+    qDebug() << QStringLiteral( "Failed to process image %1: %2" ).arg( imagePath, QString::fromStdString( e.what() ) );
+    return false;
   }
 }
+
+void FileUtils::processImage( const QString &imagePath, int maximumWidthHeight, const QString &stampText, const QVariant &positionInformation )
+{
+  QVariantMap metadata;
+  if ( positionInformation.canConvert<GnssPositionInformation>() )
+  {
+    metadata = positionMetadata( positionInformation.value<GnssPositionInformation>() );
+  }
+
+  // The XMP toolkit must be initialized from the main thread before being used from worker threads
+  Exiv2::XmpParser::initialize();
+
+  QFutureWatcher<bool> *watcher = new QFutureWatcher<bool>( this );
+  connect( watcher, &QFutureWatcher<bool>::finished, this, [this, watcher, imagePath] {
+    watcher->deleteLater();
+    emit imageProcessed( imagePath, watcher->result() );
+  } );
+  watcher->setFuture( QtConcurrent::run( &FileUtils::processImageFile, imagePath, maximumWidthHeight, stampText, metadata ) );
+}
+
+void FileUtils::restrictImageSize( const QString &imagePath, int maximumWidthHeight )
+{
+  processImageFile( imagePath, maximumWidthHeight, QString(), QVariantMap() );
+}
+
+void FileUtils::addImageMetadata( const QString &imagePath, const GnssPositionInformation &positionInformation )
+{
+  processImageFile( imagePath, 0, QString(), positionMetadata( positionInformation ) );
+}
+
+void FileUtils::addImageStamp( const QString &imagePath, const QString &text )
+{
+  processImageFile( imagePath, 0, text, QVariantMap() );
+}
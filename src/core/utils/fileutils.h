@@ -21,6 +21,7 @@
 
 #include <QCryptographicHash>
 #include <QObject>
+#include <QVariant>
 #include <qgsfeedback.h>
 
 class GnssPositionInformation;
@@ -60,6 +61,24 @@ class QFIELD_CORE_EXPORT FileUtils : public QObject
 
     Q_INVOKABLE void addImageStamp( const QString &imagePath, const QString &text );
 
+    /**
+     * Post-processes a captured image on a worker thread, emitting imageProcessed() once done.
+     * \param imagePath the image file path
+     * \param maximumWidthHeight the maximum width and height size, 0 to keep the image size
+     * \param stampText the text stamped on the image, an empty string to skip stamping
+     * \param positionInformation the GnssPositionInformation geotagging the image, a null value to skip geotagging
+     * \see processImageFile
+     */
+    Q_INVOKABLE void processImage( const QString &imagePath, int maximumWidthHeight, const QString &stampText, const QVariant &positionInformation = QVariant() );
+
+    /**
+     * Restricts the size, stamps and tags the image at \a imagePath in a single pass: the image is decoded
+     * at most once, encoded at most once and written with all its original and added \a metadata at once.
+     * When only \a metadata is given, the pixels are left untouched and only the metadata is rewritten.
+     * Returns TRUE on success.
+     */
+    static bool processImageFile( const QString &imagePath, int maximumWidthHeight, const QString &stampText, const QVariantMap &metadata );
+
     static bool copyRecursively( const QString &sourceFolder, const QString &destFolder, QgsFeedback *feedback = nullptr, bool wipeDestFolder = true );
 
     /**
@@ -78,6 +97,10 @@ class QFIELD_CORE_EXPORT FileUtils : public QObject
      */
     Q_INVOKABLE static QString fileEtag( const QString &fileName, int partSize = 8 * 1024 * 1024 );
 
+  signals:
+    //! Emitted when the processing of \a imagePath started by processImage() is done
+    void imageProcessed( const QString &imagePath, bool success );
+
   private:
     static int copyRecursivelyPrepare( const QString &sourceFolder, const QString &destFolder, QList<QPair<QString, QString>> &mapping );
 };
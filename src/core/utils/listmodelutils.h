@@ -0,0 +1,83 @@
+/***************************************************************************
+                        listmodelutils.h
+                        ---------------
+  begin                : Oct 2026
+  copyright            : (C) 2026 by OPENGIS.ch
+  email                : info@opengis.ch
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef LISTMODELUTILS_H
+#define LISTMODELUTILS_H
+
+#include <QList>
+#include <QVector>
+
+#include <algorithm>
+
+/**
+ * Helpers for list models populated with batches of entries streamed by background gatherers.
+ * \ingroup core
+ */
+class ListModelUtils
+{
+  public:
+    //! Rows of the entries merged by mergeSortedEntries()
+    struct MergedRows
+    {
+        //! The row of the first merged batch entry, the entries above it are left untouched
+        int firstRow = -1;
+        //! TRUE when the batch entries landed as a single run of consecutive rows
+        bool contiguous = false;
+        //! The new row of each of the previously listed entries
+        QVector<int> previousRows;
+    };
+
+    /**
+     * Returns the sorted \a entries merged in a single pass with a \a batch of entries sorted with \a lessThan.
+     * Batch entries comparing equal to listed entries are placed after them. The resulting \a rows
+     * allow for views to be notified with a single row insertion or layout change.
+     */
+    template<typename T, typename LessThan>
+    static QList<T> mergeSortedEntries( const QList<T> &entries, QList<T> batch, LessThan lessThan, MergedRows &rows )
+    {
+      std::stable_sort( batch.begin(), batch.end(), lessThan );
+
+      QList<T> mergedEntries;
+      mergedEntries.reserve( entries.size() + batch.size() );
+      rows = MergedRows();
+      rows.previousRows.reserve( entries.size() );
+
+      int lastRow = -1;
+      auto entryIt = entries.cbegin();
+      auto batchIt = batch.cbegin();
+      while ( entryIt != entries.cend() || batchIt != batch.cend() )
+      {
+        if ( batchIt != batch.cend() && ( entryIt == entries.cend() || lessThan( *batchIt, *entryIt ) ) )
+        {
+          lastRow = static_cast<int>( mergedEntries.size() );
+          if ( rows.firstRow < 0 )
+            rows.firstRow = lastRow;
+          mergedEntries.append( *batchIt++ );
+        }
+        else
+        {
+          rows.previousRows.append( static_cast<int>( mergedEntries.size() ) );
+          mergedEntries.append( *entryIt++ );
+        }
+      }
+
+      rows.contiguous = rows.firstRow >= 0 && lastRow - rows.firstRow + 1 == batch.size();
+      return mergedEntries;
+    }
+};
+
+#endif // LISTMODELUTILS_H
@@ -0,0 +1,111 @@
+/***************************************************************************
+                        profilerutils.cpp
+                        ---------------
+  begin                : Oct 2026
+  copyright            : (C) 2026 by OPENGIS.ch
+  email                : info@opengis.ch
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "profilerutils.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <qgsapplication.h>
+#include <qgsruntimeprofiler.h>
+
+//! Walks the profiler tasks below \a parentPath, calling \a visitor with each task path, name, depth, start and duration in seconds
+template<typename Visitor>
+static void visitProfilerTasks( const QString &group, const QString &parentPath, int depth, double start, const Visitor &visitor )
+{
+  QgsRuntimeProfiler *profiler = QgsApplication::profiler();
+  double childStart = start;
+  const QStringList children = profiler->childGroups( parentPath, group );
+  for ( const QString &child : children )
+  {
+    // Profiler paths are slash-separated task names
+    const QString path = parentPath.isEmpty() ? child : QStringLiteral( "%1/%2" ).arg( parentPath, child );
+    const double duration = profiler->profileTime( path, group );
+    visitor( child, depth, childStart, duration );
+    visitProfilerTasks( group, path, depth + 1, childStart, visitor );
+    childStart += duration;
+  }
+}
+
+ProfilerUtils::ProfilerUtils( QObject *parent )
+  : QObject( parent )
+{
+}
+
+QString ProfilerUtils::report( const QStringList &groups )
+{
+  QStringList lines;
+  for ( const QString &group : groups )
+  {
+    double total = 0.0;
+    QStringList groupLines;
+    visitProfilerTasks( group, QString(), 0, 0.0, [&groupLines, &total]( const QString &name, int depth, double, double duration ) {
+      groupLines << QStringLiteral( "%1%2: %3 ms" ).arg( QString( depth * 2, ' ' ), name, QString::number( duration * 1000.0, 'f', 1 ) );
+      if ( depth == 0 )
+        total += duration;
+    } );
+
+    if ( groupLines.isEmpty() )
+      continue;
+
+    lines << QStringLiteral( "[%1] %2 ms" ).arg( group, QString::number( total * 1000.0, 'f', 1 ) );
+    lines << groupLines;
+  }
+
+  return lines.join( '\n' );
+}
+
+QJsonArray ProfilerUtils::traceEvents( const QStringList &groups )
+{
+  QJsonArray events;
+  for ( int groupIndex = 0; groupIndex < groups.size(); ++groupIndex )
+  {
+    const QString group = groups.at( groupIndex );
+    events.append( QJsonObject( { { QStringLiteral( "name" ), QStringLiteral( "thread_name" ) },
+                                  { QStringLiteral( "ph" ), QStringLiteral( "M" ) },
+                                  { QStringLiteral( "pid" ), 1 },
+                                  { QStringLiteral( "tid" ), groupIndex + 1 },
+                                  { QStringLiteral( "args" ), QJsonObject( { { QStringLiteral( "name" ), group } } ) } } ) );
+
+    visitProfilerTasks( group, QString(), 0, 0.0, [&events, &group, groupIndex]( const QString &name, int, double start, double duration ) {
+      events.append( QJsonObject( { { QStringLiteral( "name" ), name },
+                                    { QStringLiteral( "cat" ), group },
+                                    { QStringLiteral( "ph" ), QStringLiteral( "X" ) },
+                                    { QStringLiteral( "ts" ), start * 1000000.0 },
+                                    { QStringLiteral( "dur" ), duration * 1000000.0 },
+                                    { QStringLiteral( "pid" ), 1 },
+                                    { QStringLiteral( "tid" ), groupIndex + 1 } } ) );
+    } );
+  }
+
+  return events;
+}
+
+bool ProfilerUtils::writeTrace( const QString &path, const QStringList &groups )
+{
+  QDir().mkpath( QFileInfo( path ).absolutePath() );
+
+  QFile file( path );
+  if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+    return false;
+
+  const QJsonObject trace( { { QStringLiteral( "traceEvents" ), traceEvents( groups ) },
+                             { QStringLiteral( "displayTimeUnit" ), QStringLiteral( "ms" ) } } );
+  return file.write( QJsonDocument( trace ).toJson( QJsonDocument::Compact ) ) > 0;
+}
@@ -0,0 +1,81 @@
+/***************************************************************************
+                        profilerutils.h
+                        ---------------
+  begin                : Oct 2026
+  copyright            : (C) 2026 by OPENGIS.ch
+  email                : info@opengis.ch
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef PROFILERUTILS_H
+#define PROFILERUTILS_H
+
+#include "qfield_core_export.h"
+
+#include <QJsonArray>
+#include <QObject>
+
+/**
+ * Utilities to report the timings recorded by the QGIS runtime profiler.
+ *
+ * QField records the application startup in the "startup" group, the stages of a project
+ * opening in the "projectopen" group and the time elapsed until the first map render of an
+ * opened project in the "projectrender" group, while QGIS records the per-layer provider
+ * creation and style loading of QgsProject::read() in the "projectload" group.
+ * \ingroup core
+ */
+class QFIELD_CORE_EXPORT ProfilerUtils : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit ProfilerUtils( QObject *parent = nullptr );
+
+    //! Returns the profiler group recording the application startup
+    static QString startupGroup() { return QStringLiteral( "startup" ); }
+
+    //! Returns the profiler group recording the QField stages of a project opening
+    static QString projectOpenGroup() { return QStringLiteral( "projectopen" ); }
+
+    /**
+     * Returns the profiler group recording the time to the first map render of an opened project.
+     * The time spans the whole project opening, it is kept apart from the project opening stages
+     * so that it is not added to their total.
+     */
+    static QString projectRenderGroup() { return QStringLiteral( "projectrender" ); }
+
+    //! Returns the profiler group recording the layers loaded by QgsProject::read()
+    static QString projectLoadGroup() { return QStringLiteral( "projectload" ); }
+
+    /**
+     * Returns a human readable report of the timings recorded in the profiler \a groups,
+     * one indented line per recorded task.
+     */
+    static QString report( const QStringList &groups );
+
+    /**
+     * Returns the timings recorded in the profiler \a groups as complete events of the
+     * Chrome trace event format, one thread lane per group.
+     *
+     * \note the profiler only records durations, event timestamps are reconstructed by
+     * laying out sibling tasks one after another.
+     */
+    static QJsonArray traceEvents( const QStringList &groups );
+
+    /**
+     * Writes the timings recorded in the profiler \a groups into a Chrome trace event
+     * JSON file at \a path, which can be opened with chrome://tracing or Perfetto.
+     * Returns TRUE on success.
+     */
+    static bool writeTrace( const QString &path, const QStringList &groups );
+};
+
+#endif // PROFILERUTILS_H
@@ -12,6 +12,9 @@ Rectangle {
 
   property alias text: busyMessage.text
   property alias progress: busyProgress.value
+  property bool cancelable: false
+
+  signal cancelRequested
 
   anchors.fill: parent
   color: Theme.darkGraySemiOpaque
@@ -83,6 +86,12 @@ Rectangle {
     }
   ]
 
+  MouseArea {
+    // Keep user input away from the project while it is being loaded, besides the cancel button
+    anchors.fill: parent
+    enabled: busyOverlay.visible && busyOverlay.cancelable
+  }
+
   BusyIndicator {
     id: busyIndicator
     anchors.centerIn: parent
@@ -129,6 +138,22 @@ Rectangle {
     }
   }
 
+  QfButton {
+    id: cancelButton
+    anchors.top: busyMessageShield.bottom
+    anchors.topMargin: 10
+    anchors.horizontalCenter: parent.horizontalCenter
+    visible: busyOverlay.cancelable
+    enabled: visible
+    bgcolor: "transparent"
+    text: qsTr("Cancel")
+
+    onClicked: {
+      busyOverlay.cancelable = false;
+      busyOverlay.cancelRequested();
+    }
+  }
+
   FontMetrics {
     id: busyMessageFontMetrics
     font: busyMessage.font
@@ -46,6 +46,10 @@ Drawer {
   onShowCloudMenu: qfieldCloudPopup.show()
 
   onActiveLayerChanged: {
+    if (activeLayer) {
+      // Layers which have not been loaded yet are loaded before being edited
+      deferredLayerLoader.load(activeLayer);
+    }
     if (activeLayer && activeLayer.readOnly && stateMachine.state == "digitize")
       displayToast(qsTr("The layer %1 is read only.").arg(activeLayer.name));
   }
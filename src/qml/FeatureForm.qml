@@ -493,6 +493,19 @@ Page {
             bottomPadding: 5
             opacity: (form.state === 'ReadOnly' || !AttributeEditable) || embedded && EditorWidget === 'RelationEditor' ? 0.45 : 1
             color: LabelOverrideColor ? LabelColor : Theme.mainTextColor
+            rightPadding: evaluationPendingIndicator.visible ? evaluationPendingIndicator.width : 0
+          }
+
+          BusyIndicator {
+            id: evaluationPendingIndicator
+            anchors {
+              right: parent.right
+              verticalCenter: fieldLabel.verticalCenter
+            }
+            width: 24
+            height: 24
+            visible: !!EvaluationPending
+            running: visible
           }
 
           Label {
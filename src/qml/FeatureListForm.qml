@@ -794,6 +794,17 @@ Rectangle {
     }
   }
 
+  Connections {
+    target: identifyTool
+
+    function onIdentifyFinished() {
+      if (!identifyTool.isMenuRequest && model.rowCount() === 0) {
+        showMessage(qsTr('No feature at this position'));
+        state = "Hidden";
+      }
+    }
+  }
+
   function show() {
     props.isVisible = true;
     focus = true;
@@ -213,7 +213,7 @@ ListView {
         Text {
           id: layerName
           width: rectangle.width - itemPadding - 46 // legend icon + right padding
-          - collapsedState.width - (layerVisibility.isVisible ? layerVisibility.width : 0) - (trackingBadge.isVisible ? trackingBadge.width + 5 : 0) - (lockedBadge.isVisible ? lockedBadge.width + 5 : 0) - (invalidBadge.isVisible ? invalidBadge.width + 5 : 0) - (snappingBadge.isVisible ? snappingBadge.width + 5 : 0)
+          - collapsedState.width - (layerVisibility.isVisible ? layerVisibility.width : 0) - (trackingBadge.isVisible ? trackingBadge.width + 5 : 0) - (lockedBadge.isVisible ? lockedBadge.width + 5 : 0) - (invalidBadge.isVisible ? invalidBadge.width + 5 : 0) - (notLoadedBadge.isVisible ? notLoadedBadge.width + 5 : 0) - (snappingBadge.isVisible ? snappingBadge.width + 5 : 0)
           padding: 3
           leftPadding: 0
           text: Name
@@ -287,6 +287,25 @@ ListView {
           }
         }
 
+        QfToolButton {
+          id: notLoadedBadge
+          property bool isVisible: Type === 'layer' && !IsLoaded
+          visible: isVisible
+          height: 24
+          width: 24
+          padding: 4
+          anchors.verticalCenter: parent.verticalCenter
+          enabled: isVisible
+          bgcolor: 'transparent'
+          opacity: 0.5
+          icon.source: Theme.getThemeVectorIcon('ic_pause_black_24dp')
+          icon.color: Theme.mainTextColor
+
+          onClicked: {
+            displayToast(qsTr('This layer has not been loaded yet. It will be loaded once it becomes visible on the map.'));
+          }
+        }
+
         QfToolButton {
           id: lockedBadge
           property bool isVisible: ReadOnly || GeometryLocked
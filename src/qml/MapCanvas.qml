@@ -24,12 +24,16 @@ import org.qgis
  */
 Item {
   id: mapArea
+  property alias canvasMap: mapCanvasWrapper
   property alias mapSettings: mapCanvasWrapper.mapSettings
   property alias bottomMargin: mapCanvasWrapper.bottomMargin
   property alias rightMargin: mapCanvasWrapper.rightMargin
   property alias isRendering: mapCanvasWrapper.isRendering
   property alias incrementalRendering: mapCanvasWrapper.incrementalRendering
   property alias quality: mapCanvasWrapper.quality
+  property alias tiledRendering: mapCanvasWrapper.tiledRendering
+  property alias overscan: mapCanvasWrapper.overscan
+  property alias prefetching: mapCanvasWrapper.prefetching
   property alias forceDeferredLayersRepaint: mapCanvasWrapper.forceDeferredLayersRepaint
 
   property bool interactive: true
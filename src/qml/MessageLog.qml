@@ -126,6 +126,16 @@ Page {
       }
     }
 
+    QfButton {
+      text: qsTr("Log map rendering statistics")
+      Layout.fillWidth: true
+      visible: qfieldSettings.renderStatistics
+
+      onClicked: {
+        mapRenderStatistics.logStatistics();
+      }
+    }
+
     QfButton {
       text: qsTr("Clear message log")
       Layout.fillWidth: true
@@ -20,6 +20,10 @@ Popup {
   property string currentPath: ''
   property var currentPosition: PositioningUtils.createEmptyGnssPositionInformation()
 
+  // The maximum width and height of captured photos, 0 keeps the captured size
+  property int maximumImageWidthHeight: 0
+  property bool isProcessing: false
+
   signal finished(string path)
   signal canceled
 
@@ -96,6 +100,21 @@ Popup {
     positionInformation: currentPosition
   }
 
+  Connections {
+    target: FileUtils
+
+    function onImageProcessed(imagePath, success) {
+      if (!cameraItem.isProcessing || imagePath !== currentPath) {
+        return;
+      }
+      cameraItem.isProcessing = false;
+      if (!success) {
+        displayToast(qsTr("Failed to process the captured photo"), "warning");
+      }
+      cameraItem.finished(currentPath);
+    }
+  }
+
   Page {
     width: parent.width
     height: parent.height
@@ -359,6 +378,13 @@ Popup {
             border.color: cameraItem.state == "VideoCapture" && captureSession.recorder.recorderState !== MediaRecorder.StoppedState ? "red" : "white"
             border.width: 2
 
+            BusyIndicator {
+              anchors.centerIn: parent
+              width: 64
+              height: 64
+              running: cameraItem.isProcessing
+            }
+
             QfToolButton {
               id: captureButton
 
@@ -393,12 +419,17 @@ Popup {
                     currentPath = filePos === 0 ? path.substring(7) : path;
                   }
                 } else if (cameraItem.state == "PhotoPreview" || cameraItem.state == "VideoPreview") {
+                  if (cameraItem.isProcessing) {
+                    return;
+                  }
                   if (cameraItem.state == "PhotoPreview") {
-                    if (cameraSettings.geoTagging && positionSource.active) {
-                      FileUtils.addImageMetadata(currentPath, currentPosition);
-                    }
-                    if (cameraSettings.stamping) {
-                      FileUtils.addImageStamp(currentPath, stampExpressionEvaluator.evaluate());
+                    const position = cameraSettings.geoTagging && positionSource.active ? currentPosition : null;
+                    const stampText = cameraSettings.stamping ? stampExpressionEvaluator.evaluate() : '';
+                    if (position || stampText !== '' || cameraItem.maximumImageWidthHeight > 0) {
+                      // Resizing, stamping and geotagging happen in a single pass off the UI thread, see onImageProcessed
+                      cameraItem.isProcessing = true;
+                      FileUtils.processImage(currentPath, cameraItem.maximumImageWidthHeight, stampText, position);
+                      return;
                     }
                   }
                   cameraItem.finished(currentPath);
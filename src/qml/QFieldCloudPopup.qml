@@ -196,6 +196,11 @@ Popup {
             } else {
               if (cloudProjectsModel.currentProjectData.PackagingStatus === QFieldCloudProjectsModel.PackagingFinishedStatus || cloudProjectsModel.currentProjectData.DownloadProgress > 0.0) {
                 if (cloudProjectsModel.currentProjectData.DownloadSize > 0) {
+                  const eta = cloudProjectsModel.currentProjectData.DownloadEta;
+                  if (eta > 0) {
+                    const remaining = eta < 60 ? qsTr('%n second(s)', '', eta) : qsTr('%n minute(s)', '', Math.ceil(eta / 60));
+                    return qsTr('Downloading, %1 of %2 fetched, about %3 remaining').arg(FileUtils.representFileSize(cloudProjectsModel.currentProjectData.DownloadBytesReceived)).arg(FileUtils.representFileSize(cloudProjectsModel.currentProjectData.DownloadSize)).arg(remaining);
+                  }
                   return qsTr('Downloading, %1% of %2 fetched').arg(Math.round(cloudProjectsModel.currentProjectData.DownloadProgress * 100)).arg(FileUtils.representFileSize(cloudProjectsModel.currentProjectData.DownloadSize));
                 } else {
                   return qsTr('Downloading, %1% fetched').arg(Math.round(cloudProjectsModel.currentProjectData.DownloadProgress * 100));
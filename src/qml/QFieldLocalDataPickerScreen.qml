@@ -317,6 +317,14 @@ Page {
         }
       }
 
+      BusyIndicator {
+        anchors.centerIn: parent
+        width: 48
+        height: 48
+        running: table.model.isLoading && table.count === 0
+        visible: running
+      }
+
       QfToolButton {
         id: actionButton
         round: true
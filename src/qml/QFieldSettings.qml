@@ -26,6 +26,11 @@ Page {
   property alias enableInfoCollection: registry.enableInfoCollection
   property alias enableMapRotation: registry.enableMapRotation
   property alias quality: registry.quality
+  property alias overscan: registry.overscan
+  property alias tiledRendering: registry.tiledRendering
+  property alias renderStatistics: registry.renderStatistics
+  property alias renderTrace: registry.renderTrace
+  property alias deferLayerLoading: registry.deferLayerLoading
 
   visible: false
   focus: visible
@@ -56,6 +61,11 @@ Page {
     property bool enableInfoCollection: true
     property bool enableMapRotation: true
     property double quality: 1.0
+    property double overscan: 0.1
+    property bool tiledRendering: false
+    property bool renderStatistics: false
+    property bool renderTrace: false
+    property bool deferLayerLoading: false
 
     onEnableInfoCollectionChanged: {
       if (enableInfoCollection) {
@@ -94,6 +104,12 @@ Page {
       settingAlias: "enableMapRotation"
       isVisible: true
     }
+    ListElement {
+      title: qsTr("Cache rendered map tiles")
+      description: qsTr("When switched on, the map is rendered in tiles which are kept in a cache on the device, allowing for previously visited areas to be displayed instantly. Tiled rendering is disabled while the map is rotated.")
+      settingAlias: "tiledRendering"
+      isVisible: true
+    }
   }
 
   ListModel {
@@ -169,6 +185,24 @@ Page {
       settingAlias: "enableInfoCollection"
       isVisible: true
     }
+    ListElement {
+      title: qsTr("Collect map rendering statistics")
+      description: qsTr("If enabled, the rendering time, feature count, and cache usage of each layer is collected. The statistics can be written to the message log to find out which layers slow down the map rendering.")
+      settingAlias: "renderStatistics"
+      isVisible: true
+    }
+    ListElement {
+      title: qsTr("Write map rendering trace")
+      description: qsTr("If enabled, each map rendering is written to a trace file saved in the application data directory. A new trace file is created for every session.")
+      settingAlias: "renderTrace"
+      isVisible: true
+    }
+    ListElement {
+      title: qsTr("Load hidden layers on demand")
+      description: qsTr("If enabled, layers which are hidden or outside of their visibility scale range when opening a project are only loaded once they become visible, identified, searched or edited. This speeds up the opening of large projects.")
+      settingAlias: "deferLayerLoading"
+      isVisible: true
+    }
     Component.onCompleted: {
       for (var i = 0; i < count; i++) {
         if (get(i).settingAlias === 'nativeCamera2') {
@@ -395,6 +429,69 @@ Page {
                 }
               }
 
+              Label {
+                Layout.fillWidth: true
+                Layout.columnSpan: 2
+                Layout.topMargin: 5
+                text: qsTr("Map canvas rendered margin:")
+                font: Theme.defaultFont
+                color: Theme.mainTextColor
+
+                wrapMode: Text.WordWrap
+              }
+
+              ComboBox {
+                id: renderingOverscanComboBox
+                enabled: true
+                Layout.fillWidth: true
+                Layout.columnSpan: 2
+                Layout.alignment: Qt.AlignVCenter
+                font: Theme.defaultFont
+
+                popup.font: Theme.defaultFont
+                popup.topMargin: mainWindow.sceneTopMargin
+                popup.bottomMargin: mainWindow.sceneTopMargin
+
+                model: ListModel {
+                  ListElement {
+                    name: qsTr('No margin')
+                    value: 0.0
+                  }
+                  ListElement {
+                    name: qsTr('Small margin')
+                    value: 0.1
+                  }
+                  ListElement {
+                    name: qsTr('Large margin')
+                    value: 0.25
+                  }
+                }
+                textRole: "name"
+                valueRole: "value"
+
+                property bool initialized: false
+
+                onCurrentValueChanged: {
+                  if (initialized) {
+                    overscan = currentValue;
+                  }
+                }
+
+                Component.onCompleted: {
+                  currentIndex = indexOfValue(overscan);
+                  initialized = true;
+                }
+              }
+
+              Label {
+                text: qsTr("A margin rendered around the visible map is shown while panning until the map is rendered again, at the cost of memory usage and rendering time.")
+                font: Theme.tipFont
+                color: Theme.secondaryTextColor
+                wrapMode: Text.WordWrap
+                Layout.fillWidth: true
+                Layout.columnSpan: 2
+              }
+
               Label {
                 text: qsTr('Digitizing & Editing')
                 font: Theme.strongFont
@@ -19,6 +19,7 @@ Item {
   property var relation: undefined
 
   Component.onCompleted: {
+    comboBox._cachedCurrentValue = value;
     comboBox.currentIndex = featureListModel.findKey(value);
     invalidWarning.visible = relation !== undefined ? !(relation.isValid) : false;
   }
@@ -277,6 +278,10 @@ Item {
         function onModelReset() {
           comboBox.currentIndex = featureListModel.findKey(comboBox._cachedCurrentValue);
         }
+
+        function onKeyPinned(key) {
+          comboBox.currentIndex = featureListModel.findKey(comboBox._cachedCurrentValue);
+        }
       }
 
       MouseArea {
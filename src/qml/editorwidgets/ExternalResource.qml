@@ -225,6 +225,10 @@ EditorWidgetBase {
       height: hasImage ? parent.height : 24
       opacity: 0.25
       autoTransform: true
+      asynchronous: true
+      // Decode attachments at the displayed size rather than at their full resolution
+      sourceSize.width: width * Screen.devicePixelRatio
+      sourceSize.height: height * Screen.devicePixelRatio
       fillMode: Image.PreserveAspectFit
       horizontalAlignment: Image.AlignHCenter
       verticalAlignment: Image.AlignVCenter
@@ -563,6 +567,8 @@ EditorWidgetBase {
       id: qfieldCamera
       visible: false
 
+      maximumImageWidthHeight: iface.readProjectNumEntry("qfieldsync", "maximumImageWidthHeight", 0)
+
       Component.onCompleted: {
         if (isVideo) {
           qfieldCamera.state = 'VideoCapture';
@@ -578,12 +584,6 @@ EditorWidgetBase {
         filepath = filepath.replace('{filename}', FileUtils.fileName(path));
         filepath = filepath.replace('{extension}', FileUtils.fileSuffix(path));
         platformUtilities.renameFile(path, prefixToRelativePath + filepath);
-        if (!cameraLoader.isVideo) {
-          var maximumWidhtHeight = iface.readProjectNumEntry("qfieldsync", "maximumImageWidthHeight", 0);
-          if (maximumWidhtHeight > 0) {
-            FileUtils.restrictImageSize(prefixToRelativePath + filepath, maximumWidhtHeight);
-          }
-        }
         valueChangeRequested(filepath, false);
         close();
       }
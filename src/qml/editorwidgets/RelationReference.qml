@@ -27,6 +27,8 @@ EditorWidgetBase {
     currentFormFeature: currentFeature
     filterExpression: ""
     allowMulti: false
+    // large referenced layers are fetched page by page as the list is scrolled
+    pageSize: 1000
 
     // passing "" instead of undefined, so the model is cleared on adding new features
     // attributeValue has to be the last one set to make sure the property’s value is handled properly (e.g. allow multiple)
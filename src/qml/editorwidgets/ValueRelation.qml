@@ -35,6 +35,8 @@ EditorWidgetBase {
     addNull: config['AllowNull'] ? config['AllowNull'] : ""
     orderByValue: config['OrderByValue'] ? config['OrderByValue'] : ""
     filterExpression: config['FilterExpression'] ? config['FilterExpression'] : ""
+    // large layers are fetched page by page, the multiple selection list needs every value to show checked ones
+    pageSize: allowMulti ? 0 : 1000
 
     // passing "" instead of undefined, so the model is cleared on adding new features
     // attributeValue has to be the last property set to make sure its given value is handled properly (e.g. allow multiple)
@@ -94,6 +94,7 @@ ApplicationWindow {
     navigation: navigation
     locatorHighlightGeometry: locatorHighlightItem.geometryWrapper
     keepScale: qfieldSettings.locatorKeepScale
+    searchIndex: featuresSearchIndex
 
     onMessageEmitted: {
       displayToast(text);
@@ -582,6 +583,9 @@ ApplicationWindow {
       isMapRotationEnabled: qfieldSettings.enableMapRotation
       incrementalRendering: true
       quality: qfieldSettings.quality
+      tiledRendering: qfieldSettings.tiledRendering
+      overscan: qfieldSettings.overscan
+      prefetching: qfieldSettings.tiledRendering
       forceDeferredLayersRepaint: trackings.count > 0
       freehandDigitizing: freehandButton.freehandDigitizing && freehandHandler.active
 
@@ -3553,6 +3557,8 @@ ApplicationWindow {
   Timer {
     id: readProjectTimer
 
+    property string projectName: ''
+
     interval: 250
     repeat: false
     onTriggered: iface.readProject()
@@ -3615,15 +3621,37 @@ ApplicationWindow {
         changelogPopup.close();
       dashBoard.layerTree.freeze();
       mapCanvasMap.freeze('projectload');
-      busyOverlay.text = qsTr("Loading %1").arg(name !== '' ? name : path);
+      readProjectTimer.projectName = name !== '' ? name : path;
+      busyOverlay.text = qsTr("Loading %1").arg(readProjectTimer.projectName);
+      busyOverlay.cancelable = true;
       busyOverlay.state = "visible";
       navigation.clearDestinationFeature();
       projectInfo.filePath = '';
       readProjectTimer.start();
     }
 
+    function onLoadProjectProgress(progress, stage) {
+      busyOverlay.text = qsTr("Loading %1").arg(readProjectTimer.projectName) + "\n" + stage;
+      busyOverlay.progress = progress;
+    }
+
+    function onLoadProjectCanceled(path, name) {
+      mapCanvasMap.unfreeze('projectload');
+      busyOverlay.cancelable = false;
+      busyOverlay.state = "hidden";
+      dashBoard.layerTree.unfreeze(true);
+      messageLogModel.unsuppress({
+          "WFS": [],
+          "WMS": [],
+          "PostGIS": []
+        });
+      welcomeScreen.visible = true;
+      welcomeScreen.focus = true;
+    }
+
     function onLoadProjectEnded(path, name) {
       mapCanvasMap.unfreeze('projectload');
+      busyOverlay.cancelable = false;
       busyOverlay.state = "hidden";
       dashBoard.layerTree.unfreeze(true);
       if (qfieldAuthRequestHandler.hasPendingAuthRequest) {
@@ -3784,6 +3812,13 @@ ApplicationWindow {
     property bool editRights: hasEditRights
   }
 
+  MapRenderStatisticsModel {
+    id: mapRenderStatistics
+    mapCanvas: mapCanvasMap.canvasMap
+    enabled: qfieldSettings.renderStatistics
+    traceEnabled: qfieldSettings.renderTrace
+  }
+
   MessageLog {
     id: messageLog
     objectName: 'messageLog'
@@ -4148,6 +4183,8 @@ ApplicationWindow {
   BusyOverlay {
     id: busyOverlay
     state: iface.hasProjectOnLaunch() ? "visible" : "hidden"
+
+    onCancelRequested: iface.cancelProjectLoad()
   }
 
   property bool closeAlreadyRequested: false
@@ -0,0 +1,119 @@
+/***************************************************************************
+                        benchmark_projectload.cpp
+                        --------------------
+  begin                : Oct 2026
+  copyright            : (C) 2026 by OPENGIS.ch
+  email                : info@opengis.ch
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/*
+ * Headless project load benchmark.
+ *
+ * Reads a project a number of times and prints the load time percentiles, e.g.:
+ *   projectloadbenchmark -n 20 --trace projectload.json --max-p90 1500 project.qgz
+ *
+ * When --max-p90 is given, the benchmark exits with a non-zero code if the 90th
+ * percentile load time exceeds the given number of milliseconds, allowing CI to
+ * gate on project load regressions.
+ */
+
+#include "utils/profilerutils.h"
+
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <qgsapplication.h>
+#include <qgsproject.h>
+#include <qgsruntimeprofiler.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+//! Returns the \a percentile (0 to 100) of the sorted \a values using the nearest rank method
+static double percentile( const QList<double> &values, double percentile )
+{
+  const int rank = static_cast<int>( std::ceil( percentile / 100.0 * values.size() ) );
+  return values.at( std::clamp( rank - 1, 0, static_cast<int>( values.size() ) - 1 ) );
+}
+
+int main( int argc, char *argv[] )
+{
+  QgsApplication app( argc, argv, false );
+  app.setPrefixPath( QGIS_PREFIX_PATH, true );
+  app.initQgis();
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription( QStringLiteral( "Measures the time needed to read a QGIS project." ) );
+  parser.addHelpOption();
+  parser.addPositionalArgument( QStringLiteral( "project" ), QStringLiteral( "The project file to read." ) );
+  const QCommandLineOption iterationsOption( { QStringLiteral( "n" ), QStringLiteral( "iterations" ) }, QStringLiteral( "Number of times the project is read." ), QStringLiteral( "iterations" ), QStringLiteral( "10" ) );
+  const QCommandLineOption traceOption( QStringLiteral( "trace" ), QStringLiteral( "Writes the layer timings of the last read into a Chrome trace file." ), QStringLiteral( "file" ) );
+  const QCommandLineOption maxP90Option( QStringLiteral( "max-p90" ), QStringLiteral( "Fails when the 90th percentile read time exceeds the given milliseconds." ), QStringLiteral( "milliseconds" ) );
+  parser.addOption( iterationsOption );
+  parser.addOption( traceOption );
+  parser.addOption( maxP90Option );
+  parser.process( app );
+
+  const QStringList positionalArguments = parser.positionalArguments();
+  if ( positionalArguments.size() != 1 || !QFileInfo::exists( positionalArguments.at( 0 ) ) )
+  {
+    std::cerr << "A single existing project file is required" << std::endl;
+    return 2;
+  }
+
+  const QString projectPath = positionalArguments.at( 0 );
+  const int iterations = std::max( 1, parser.value( iterationsOption ).toInt() );
+
+  QList<double> times;
+  for ( int i = 0; i < iterations; ++i )
+  {
+    // A fresh project each time avoids measuring the clearing of the previous read
+    QgsProject project;
+    QElapsedTimer timer;
+    timer.start();
+    if ( !project.read( projectPath, Qgis::ProjectReadFlag::DontLoadProjectStyles | Qgis::ProjectReadFlag::DontLoad3DViews ) )
+    {
+      std::cerr << "Could not read project: " << project.error().toStdString() << std::endl;
+      return 2;
+    }
+    times << timer.nsecsElapsed() / 1000000.0;
+
+    // The layer timings of the read are only kept until the next read clears them
+    if ( i == iterations - 1 )
+    {
+      std::cout << ProfilerUtils::report( { ProfilerUtils::projectLoadGroup() } ).toStdString() << std::endl;
+      if ( parser.isSet( traceOption ) && !ProfilerUtils::writeTrace( parser.value( traceOption ), { ProfilerUtils::projectLoadGroup() } ) )
+      {
+        std::cerr << "Could not write trace file" << std::endl;
+      }
+    }
+  }
+
+  std::sort( times.begin(), times.end() );
+  const double p90 = percentile( times, 90 );
+  std::cout << "iterations: " << iterations << std::endl
+            << "p50: " << percentile( times, 50 ) << " ms" << std::endl
+            << "p90: " << p90 << " ms" << std::endl
+            << "p95: " << percentile( times, 95 ) << " ms" << std::endl
+            << "max: " << times.last() << " ms" << std::endl;
+
+  app.exitQgis();
+
+  if ( parser.isSet( maxP90Option ) && p90 > parser.value( maxP90Option ).toDouble() )
+  {
+    std::cerr << "p90 of " << p90 << " ms exceeds the maximum of " << parser.value( maxP90Option ).toStdString() << " ms" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -21,6 +21,18 @@
 #include "featuremodel.h"
 
 #include <QAbstractItemModelTester>
+#include <QElapsedTimer>
+
+//! Processes events until the background evaluations of the field at \a row are done, returns FALSE on timeout
+static bool waitForEvaluation( AttributeFormModel *model, int row )
+{
+  QElapsedTimer timer;
+  timer.start();
+  while ( model->data( model->index( row, 0 ), AttributeFormModel::EvaluationPending ).toBool() && timer.elapsed() < 10000 )
+    QCoreApplication::processEvents( QEventLoop::AllEvents, 50 );
+
+  return !model->data( model->index( row, 0 ), AttributeFormModel::EvaluationPending ).toBool();
+}
 
 TEST_CASE( "AttributeFormModel" )
 {
@@ -81,6 +93,116 @@ TEST_CASE( "AttributeFormModel" )
     REQUIRE( feature.attributes().at( 2 ) == QStringLiteral( "edit_feature__" ) );
   }
 
+  SECTION( "ChainedDefaultValues" )
+  {
+    // The default value of "c" depends on "b", which comes later in the field order and itself depends on "a"
+    std::unique_ptr<QgsVectorLayer> chainedLayer = std::make_unique<QgsVectorLayer>( QStringLiteral( "Point?crs=EPSG:3857&field=a:string&field=c:string&field=b:string" ), QStringLiteral( "Chained Layer" ), QStringLiteral( "memory" ) );
+    REQUIRE( chainedLayer->isValid() );
+    chainedLayer->setDefaultValueDefinition( 1, QgsDefaultValue( QStringLiteral( "coalesce(\"b\",'') || '!'" ), true ) );
+    chainedLayer->setDefaultValueDefinition( 2, QgsDefaultValue( QStringLiteral( "coalesce(\"a\",'') || '_'" ), true ) );
+
+    std::unique_ptr<AttributeFormModel> chainedFormModel = std::make_unique<AttributeFormModel>();
+    std::unique_ptr<FeatureModel> chainedFeatureModel = std::make_unique<FeatureModel>();
+    chainedFormModel->setFeatureModel( chainedFeatureModel.get() );
+    chainedFeatureModel->setCurrentLayer( chainedLayer.get() );
+    chainedFeatureModel->resetFeature();
+    chainedFeatureModel->resetAttributes();
+
+    chainedFormModel->setData( chainedFormModel->index( 0, 0 ), QString( "value" ), AttributeFormModel::AttributeValue );
+    REQUIRE( chainedFormModel->attribute( QStringLiteral( "b" ) ) == QStringLiteral( "value_" ) );
+    REQUIRE( chainedFormModel->attribute( QStringLiteral( "c" ) ) == QStringLiteral( "value_!" ) );
+  }
+
+  SECTION( "BackgroundEvaluations" )
+  {
+    // Aggregates are evaluated in the background, the form stays responsive while typing
+    std::unique_ptr<QgsVectorLayer> expensiveLayer = std::make_unique<QgsVectorLayer>( QStringLiteral( "Point?crs=EPSG:3857&field=fid:integer&field=name:string&field=summary:string" ), QStringLiteral( "Expensive Layer" ), QStringLiteral( "memory" ) );
+    REQUIRE( expensiveLayer->isValid() );
+
+    QgsFeature feature;
+    feature.setAttributes( QgsAttributes() << 1 << QStringLiteral( "good" ) << QString() );
+    expensiveLayer->startEditing();
+    expensiveLayer->addFeature( feature );
+    expensiveLayer->commitChanges();
+
+    expensiveLayer->setDefaultValueDefinition( 2, QgsDefaultValue( QStringLiteral( "\"name\" || '/' || to_string(count(\"fid\"))" ), true ) );
+    expensiveLayer->setConstraintExpression( 1, QStringLiteral( "\"name\" <> 'bad' AND count(\"fid\") > 0" ) );
+    expensiveLayer->setFieldConstraint( 1, QgsFieldConstraints::ConstraintExpression, QgsFieldConstraints::ConstraintStrengthHard );
+
+    std::unique_ptr<AttributeFormModel> expensiveFormModel = std::make_unique<AttributeFormModel>();
+    std::unique_ptr<FeatureModel> expensiveFeatureModel = std::make_unique<FeatureModel>();
+    expensiveFormModel->setFeatureModel( expensiveFeatureModel.get() );
+    expensiveFeatureModel->setCurrentLayer( expensiveLayer.get() );
+    expensiveFeatureModel->setFeature( expensiveLayer->getFeature( 1 ) );
+    REQUIRE( waitForEvaluation( expensiveFormModel.get(), 1 ) );
+    REQUIRE( waitForEvaluation( expensiveFormModel.get(), 2 ) );
+    REQUIRE( expensiveFormModel->constraintsHardValid() );
+
+    SECTION( "DefaultValue" )
+    {
+      expensiveFormModel->setData( expensiveFormModel->index( 1, 0 ), QString( "renamed" ), AttributeFormModel::AttributeValue );
+      REQUIRE( expensiveFormModel->data( expensiveFormModel->index( 2, 0 ), AttributeFormModel::EvaluationPending ).toBool() );
+
+      REQUIRE( waitForEvaluation( expensiveFormModel.get(), 2 ) );
+      REQUIRE( expensiveFormModel->attribute( QStringLiteral( "summary" ) ) == QStringLiteral( "renamed/1" ) );
+      REQUIRE( expensiveFormModel->data( expensiveFormModel->index( 2, 0 ), AttributeFormModel::AttributeValue ) == QStringLiteral( "renamed/1" ) );
+    }
+
+    SECTION( "Constraint" )
+    {
+      expensiveFormModel->setData( expensiveFormModel->index( 1, 0 ), QString( "bad" ), AttributeFormModel::AttributeValue );
+      REQUIRE( expensiveFormModel->data( expensiveFormModel->index( 1, 0 ), AttributeFormModel::EvaluationPending ).toBool() );
+
+      REQUIRE( waitForEvaluation( expensiveFormModel.get(), 1 ) );
+      REQUIRE( !expensiveFormModel->data( expensiveFormModel->index( 1, 0 ), AttributeFormModel::ConstraintHardValid ).toBool() );
+      REQUIRE( !expensiveFormModel->constraintsHardValid() );
+
+      expensiveFormModel->setData( expensiveFormModel->index( 1, 0 ), QString( "good again" ), AttributeFormModel::AttributeValue );
+      REQUIRE( waitForEvaluation( expensiveFormModel.get(), 1 ) );
+      REQUIRE( expensiveFormModel->constraintsHardValid() );
+    }
+
+    SECTION( "FlushBeforeSave" )
+    {
+      // Saving right away applies the pending evaluations first
+      expensiveFormModel->setData( expensiveFormModel->index( 1, 0 ), QString( "saved" ), AttributeFormModel::AttributeValue );
+      REQUIRE( expensiveFormModel->data( expensiveFormModel->index( 2, 0 ), AttributeFormModel::EvaluationPending ).toBool() );
+      REQUIRE( expensiveFormModel->save() );
+      REQUIRE( !expensiveFormModel->data( expensiveFormModel->index( 2, 0 ), AttributeFormModel::EvaluationPending ).toBool() );
+      REQUIRE( expensiveLayer->getFeature( 1 ).attribute( 2 ) == QStringLiteral( "saved/1" ) );
+
+      // A hard constraint still pending when saving is enforced once evaluated
+      expensiveFormModel->setData( expensiveFormModel->index( 1, 0 ), QString( "bad" ), AttributeFormModel::AttributeValue );
+      REQUIRE( expensiveFormModel->constraintsHardValid() );
+      REQUIRE( !expensiveFormModel->save() );
+      REQUIRE( !expensiveFormModel->constraintsHardValid() );
+      REQUIRE( expensiveLayer->getFeature( 1 ).attribute( 1 ) == QStringLiteral( "saved" ) );
+    }
+  }
+
+  SECTION( "FormTemplate" )
+  {
+    // A second form on the same layer is instantiated from the cached form structure
+    std::unique_ptr<AttributeFormModel> secondFormModel = std::make_unique<AttributeFormModel>();
+    std::unique_ptr<FeatureModel> secondFeatureModel = std::make_unique<FeatureModel>();
+    secondFormModel->setFeatureModel( secondFeatureModel.get() );
+    secondFeatureModel->setCurrentLayer( layer.get() );
+    secondFeatureModel->setFeature( layer->getFeature( 2 ) );
+
+    REQUIRE( secondFormModel->rowCount() == attributeFormModel->rowCount() );
+    REQUIRE( secondFormModel->data( secondFormModel->index( 1, 0 ), AttributeFormModel::Name ) == attributeFormModel->data( attributeFormModel->index( 1, 0 ), AttributeFormModel::Name ) );
+    REQUIRE( secondFormModel->attribute( QStringLiteral( "str" ) ) == QStringLiteral( "string_a2" ) );
+
+    // Field changes invalidate the cached form structure
+    layer->setFieldAlias( 1, QStringLiteral( "aliased" ) );
+
+    std::unique_ptr<AttributeFormModel> thirdFormModel = std::make_unique<AttributeFormModel>();
+    std::unique_ptr<FeatureModel> thirdFeatureModel = std::make_unique<FeatureModel>();
+    thirdFormModel->setFeatureModel( thirdFeatureModel.get() );
+    thirdFeatureModel->setCurrentLayer( layer.get() );
+    REQUIRE( thirdFormModel->data( thirdFormModel->index( 1, 0 ), AttributeFormModel::Name ) == QStringLiteral( "aliased" ) );
+  }
+
   SECTION( "QAbstractItemModelTester" )
   {
     std::unique_ptr<AttributeFormModel> modelTest = std::make_unique<AttributeFormModel>();
@@ -0,0 +1,146 @@
+/***************************************************************************
+                        test_barcodedecoder.cpp
+                        --------------------
+  begin                : October 2026
+  copyright            : (C) 2026 by OPENGIS.ch
+  email                : info@opengis.ch
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#define QFIELDTEST_MAIN
+#include "barcodedecoder.h"
+#include "catch2.h"
+
+#include <QSignalSpy>
+#include <QVideoFrame>
+#include <cstring>
+
+
+//! Returns a 640 by 160 pixels image with the EAN-8 barcode 96385074 drawn on its right half
+static QImage barcodeImage()
+{
+  const QStringList leftCodes = { QStringLiteral( "0001101" ), QStringLiteral( "0011001" ), QStringLiteral( "0010011" ), QStringLiteral( "0111101" ), QStringLiteral( "0100011" ), QStringLiteral( "0110001" ), QStringLiteral( "0101111" ), QStringLiteral( "0111011" ), QStringLiteral( "0110111" ), QStringLiteral( "0001011" ) };
+  const QString digits = QStringLiteral( "96385074" );
+
+  QString modules = QStringLiteral( "101" );
+  for ( int i = 0; i < 8; i++ )
+  {
+    if ( i == 4 )
+      modules += QStringLiteral( "01010" );
+
+    const QString code = leftCodes.at( digits.at( i ).digitValue() );
+    if ( i < 4 )
+    {
+      modules += code;
+    }
+    else
+    {
+      // Right hand digits are the complement of the left hand ones
+      for ( const QChar &module : code )
+        modules += module == '0' ? QChar( '1' ) : QChar( '0' );
+    }
+  }
+  modules += QStringLiteral( "101" );
+
+  QImage image( 640, 160, QImage::Format_Grayscale8 );
+  image.fill( Qt::white );
+  for ( int i = 0; i < modules.size(); i++ )
+  {
+    if ( modules.at( i ) == '1' )
+    {
+      for ( int y = 40; y < 120; y++ )
+        std::memset( image.scanLine( y ) + 340 + i * 4, 0, 4 );
+    }
+  }
+  return image;
+}
+
+//! Returns a luminance video frame holding the \a image pixels
+static QVideoFrame luminanceFrame( const QImage &image )
+{
+  QVideoFrame frame( QVideoFrameFormat( image.size(), QVideoFrameFormat::Format_Y8 ) );
+  REQUIRE( frame.map( QVideoFrame::WriteOnly ) );
+  for ( int y = 0; y < image.height(); y++ )
+    std::memcpy( frame.bits( 0 ) + y * frame.bytesPerLine( 0 ), image.constScanLine( y ), image.width() );
+  frame.unmap();
+  return frame;
+}
+
+
+TEST_CASE( "BarcodeDecoder" )
+{
+  const QImage image = barcodeImage();
+  BarcodeDecoder decoder;
+
+  SECTION( "Image" )
+  {
+    decoder.decodeImage( image );
+    REQUIRE( decoder.decodedString() == QStringLiteral( "96385074" ) );
+  }
+
+  SECTION( "Image region of interest" )
+  {
+    decoder.setRegionOfInterest( QRectF( 0.0, 0.0, 0.5, 1.0 ) );
+    decoder.decodeImage( image );
+    REQUIRE( decoder.decodedString().isEmpty() );
+
+    decoder.setRegionOfInterest( QRectF( 0.5, 0.0, 0.5, 1.0 ) );
+    decoder.decodeImage( image );
+    REQUIRE( decoder.decodedString() == QStringLiteral( "96385074" ) );
+  }
+
+  SECTION( "Rotated frame region of interest" )
+  {
+    // Once rotated, the barcode is presented on the left half of the frame
+    QVideoFrame frame = luminanceFrame( image );
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 7, 0 )
+    frame.setRotation( QtVideo::Rotation::Clockwise180 );
+#else
+    frame.setRotationAngle( QVideoFrame::Rotation180 );
+#endif
+
+    QSignalSpy spy( &decoder, &BarcodeDecoder::decodedStringChanged );
+    decoder.setRegionOfInterest( QRectF( 0.0, 0.0, 0.5, 1.0 ) );
+    decoder.decodeVideoFrame( frame );
+    REQUIRE( spy.wait() );
+    REQUIRE( decoder.decodedString() == QStringLiteral( "96385074" ) );
+  }
+
+  SECTION( "Mirrored frame region of interest" )
+  {
+    // Once mirrored, the barcode is presented on the left half of the frame
+    QVideoFrame frame = luminanceFrame( image );
+    frame.setMirrored( true );
+
+    QSignalSpy spy( &decoder, &BarcodeDecoder::decodedStringChanged );
+    decoder.setRegionOfInterest( QRectF( 0.0, 0.0, 0.5, 1.0 ) );
+    decoder.decodeVideoFrame( frame );
+    REQUIRE( spy.wait() );
+    REQUIRE( decoder.decodedString() == QStringLiteral( "96385074" ) );
+  }
+
+  SECTION( "Quarter turned frame region of interest" )
+  {
+    // Once turned clockwise, the barcode is presented on the bottom half of the frame
+    QVideoFrame frame = luminanceFrame( image );
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 7, 0 )
+    frame.setRotation( QtVideo::Rotation::Clockwise90 );
+#else
+    frame.setRotationAngle( QVideoFrame::Rotation90 );
+#endif
+
+    QSignalSpy spy( &decoder, &BarcodeDecoder::decodedStringChanged );
+    decoder.setRegionOfInterest( QRectF( 0.0, 0.5, 1.0, 0.5 ) );
+    decoder.decodeVideoFrame( frame );
+    REQUIRE( spy.wait() );
+    REQUIRE( decoder.decodedString() == QStringLiteral( "96385074" ) );
+  }
+}
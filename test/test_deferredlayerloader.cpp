@@ -0,0 +1,151 @@
+/***************************************************************************
+                        test_deferredlayerloader.cpp
+                        --------------------
+  begin                : October 2026
+  copyright            : (C) 2026 by OPENGIS.ch
+  email                : info@opengis.ch
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#define QFIELDTEST_MAIN
+#include "catch2.h"
+#include "deferredlayerloader.h"
+#include "qgsquickmapsettings.h"
+
+#include <QSettings>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+#include <qgslayertree.h>
+#include <qgsproject.h>
+#include <qgsvectorlayer.h>
+
+
+TEST_CASE( "DeferredLayerLoader" )
+{
+  QTemporaryDir dir;
+  REQUIRE( dir.isValid() );
+  const QString projectPath = dir.filePath( QStringLiteral( "deferred.qgs" ) );
+
+  {
+    QgsProject project;
+    project.setCrs( QgsCoordinateReferenceSystem::fromEpsgId( 2056 ) );
+
+    QgsVectorLayer *visibleLayer = new QgsVectorLayer( QStringLiteral( "Point?crs=EPSG:2056&field=id:integer" ), QStringLiteral( "visible" ), QStringLiteral( "memory" ) );
+    QgsVectorLayer *hiddenLayer = new QgsVectorLayer( QStringLiteral( "Point?crs=EPSG:2056&field=id:integer&field=lookup:integer" ), QStringLiteral( "hidden" ), QStringLiteral( "memory" ) );
+    QgsVectorLayer *valuesLayer = new QgsVectorLayer( QStringLiteral( "Point?crs=EPSG:2056&field=id:integer" ), QStringLiteral( "values" ), QStringLiteral( "memory" ) );
+    QgsVectorLayer *scaledLayer = new QgsVectorLayer( QStringLiteral( "Point?crs=EPSG:2056&field=id:integer" ), QStringLiteral( "scaled" ), QStringLiteral( "memory" ) );
+    QgsVectorLayer *tableLayer = new QgsVectorLayer( QStringLiteral( "NoGeometry?field=id:integer" ), QStringLiteral( "table" ), QStringLiteral( "memory" ) );
+
+    // The hidden layer values come from another hidden layer
+    hiddenLayer->setEditorWidgetSetup( 1, QgsEditorWidgetSetup( QStringLiteral( "ValueRelation" ), QVariantMap( { { QStringLiteral( "Layer" ), valuesLayer->id() } } ) ) );
+
+    scaledLayer->setScaleBasedVisibility( true );
+    scaledLayer->setMinimumScale( 100000 );
+    scaledLayer->setMaximumScale( 100 );
+
+    project.addMapLayers( { visibleLayer, hiddenLayer, valuesLayer, scaledLayer, tableLayer } );
+    project.layerTreeRoot()->findLayer( hiddenLayer )->setItemVisibilityChecked( false );
+    project.layerTreeRoot()->findLayer( valuesLayer )->setItemVisibilityChecked( false );
+    REQUIRE( project.write( projectPath ) );
+  }
+
+  QgsProject project;
+  REQUIRE( project.read( projectPath, Qgis::ProjectReadFlag::DontResolveLayers ) );
+
+  auto layer = [&project]( const QString &name ) -> QgsMapLayer * {
+    const QList<QgsMapLayer *> layers = project.mapLayersByName( name );
+    return layers.isEmpty() ? nullptr : layers.first();
+  };
+  REQUIRE( layer( QStringLiteral( "visible" ) ) );
+  REQUIRE( !layer( QStringLiteral( "visible" ) )->isValid() );
+
+  // The map has no size nor extent yet
+  QgsQuickMapSettings mapSettings;
+  mapSettings.setDestinationCrs( QgsCoordinateReferenceSystem::fromEpsgId( 2056 ) );
+  mapSettings.setProject( &project );
+
+  DeferredLayerLoader *loader = DeferredLayerLoader::instance();
+  QSignalSpy loadedSpy( loader, &DeferredLayerLoader::layerLoaded );
+  loader->setup( &project, &mapSettings );
+
+  SECTION( "Setup" )
+  {
+    REQUIRE( layer( QStringLiteral( "visible" ) )->isValid() );
+    REQUIRE( !DeferredLayerLoader::isDeferred( layer( QStringLiteral( "visible" ) ) ) );
+    REQUIRE( layer( QStringLiteral( "table" ) )->isValid() );
+
+    REQUIRE( loader->deferredLayerCount() == 3 );
+    REQUIRE( DeferredLayerLoader::isDeferred( layer( QStringLiteral( "hidden" ) ) ) );
+    REQUIRE( DeferredLayerLoader::isDeferred( layer( QStringLiteral( "values" ) ) ) );
+    REQUIRE( DeferredLayerLoader::isDeferred( layer( QStringLiteral( "scaled" ) ) ) );
+    REQUIRE( !layer( QStringLiteral( "hidden" ) )->isValid() );
+    REQUIRE( loadedSpy.count() == 2 );
+  }
+
+  SECTION( "Load" )
+  {
+    // Loading a layer loads the layers its forms rely on
+    REQUIRE( loader->load( layer( QStringLiteral( "hidden" ) ) ) );
+    REQUIRE( !DeferredLayerLoader::isDeferred( layer( QStringLiteral( "hidden" ) ) ) );
+    REQUIRE( layer( QStringLiteral( "values" ) )->isValid() );
+    REQUIRE( !DeferredLayerLoader::isDeferred( layer( QStringLiteral( "values" ) ) ) );
+    REQUIRE( loader->deferredLayerCount() == 1 );
+
+    // Loaded layers are not loaded again
+    const int loadedCount = loadedSpy.count();
+    REQUIRE( loader->load( layer( QStringLiteral( "hidden" ) ) ) );
+    REQUIRE( loadedSpy.count() == loadedCount );
+    REQUIRE( !loader->load( nullptr ) );
+  }
+
+  SECTION( "Remembered fields" )
+  {
+    // Fields of deferred layers are unknown when the project settings are restored
+    QgsVectorLayer *hiddenLayer = qobject_cast<QgsVectorLayer *>( layer( QStringLiteral( "hidden" ) ) );
+    const QString settingsKey = QStringLiteral( "/qgis/projectInfo/%1/layerFields/::%2/remembered" ).arg( project.fileName(), hiddenLayer->id() );
+    QSettings().setValue( settingsKey, QVariantMap( { { QStringLiteral( "lookup" ), true } } ) );
+
+    REQUIRE( loader->load( hiddenLayer ) );
+    QSettings().remove( settingsKey );
+    REQUIRE( hiddenLayer->editFormConfig().reuseLastValue( hiddenLayer->fields().indexFromName( QStringLiteral( "lookup" ) ) ) );
+    REQUIRE( !hiddenLayer->editFormConfig().reuseLastValue( hiddenLayer->fields().indexFromName( QStringLiteral( "id" ) ) ) );
+  }
+
+  SECTION( "Visibility" )
+  {
+    project.layerTreeRoot()->findLayer( layer( QStringLiteral( "values" ) )->id() )->setItemVisibilityChecked( true );
+    REQUIRE( layer( QStringLiteral( "values" ) )->isValid() );
+    REQUIRE( DeferredLayerLoader::isDeferred( layer( QStringLiteral( "hidden" ) ) ) );
+    REQUIRE( loader->deferredLayerCount() == 2 );
+  }
+
+  SECTION( "Scale range" )
+  {
+    // Far out of the layer scale range
+    mapSettings.setOutputSize( QSize( 400, 300 ) );
+    mapSettings.setExtent( QgsRectangle( 2400000, 1000000, 2800000, 1300000 ) );
+    REQUIRE( DeferredLayerLoader::isDeferred( layer( QStringLiteral( "scaled" ) ) ) );
+
+    // Panning at the same scale does not check the layers again
+    mapSettings.setExtent( QgsRectangle( 2400100, 1000000, 2800100, 1300000 ) );
+    QTest::qWait( 500 );
+    REQUIRE( DeferredLayerLoader::isDeferred( layer( QStringLiteral( "scaled" ) ) ) );
+
+    // Layers entering their scale range are loaded once the scale settles
+    mapSettings.setExtent( QgsRectangle( 2600000, 1200000, 2600400, 1200300 ) );
+    REQUIRE( DeferredLayerLoader::isDeferred( layer( QStringLiteral( "scaled" ) ) ) );
+    REQUIRE( QTest::qWaitFor( [&layer] { return !DeferredLayerLoader::isDeferred( layer( QStringLiteral( "scaled" ) ) ); } ) );
+    REQUIRE( layer( QStringLiteral( "scaled" ) )->isValid() );
+    REQUIRE( !DeferredLayerLoader::isDeferred( layer( QStringLiteral( "scaled" ) ) ) );
+    REQUIRE( DeferredLayerLoader::isDeferred( layer( QStringLiteral( "hidden" ) ) ) );
+  }
+}
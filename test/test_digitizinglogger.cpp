@@ -65,4 +65,43 @@ TEST_CASE( "DigitizingLogger" )
     REQUIRE( feature.attributes().at( 3 ) == layer->id() );
     REQUIRE( feature.attributes().at( 4 ).toDateTime().isValid() == true );
   }
+
+  SECTION( "ConfigurationChangesBetweenPoints" )
+  {
+    const long long featureCount = logsLayer->featureCount();
+    digitizingLogger->clearCoordinates();
+    digitizingLogger->addCoordinate( QgsPoint( 1, 1 ) );
+    digitizingLogger->setType( QStringLiteral( "stone" ) );
+    digitizingLogger->addCoordinate( QgsPoint( 2, 2 ) );
+    digitizingLogger->writeCoordinates();
+    REQUIRE( logsLayer->featureCount() == featureCount + 2 );
+
+    QStringList types;
+    QgsFeature feature;
+    QgsFeatureIterator it = logsLayer->getFeatures();
+    while ( it.nextFeature( feature ) )
+    {
+      types << feature.attribute( 1 ).toString();
+    }
+    REQUIRE( types.contains( QStringLiteral( "rock" ) ) );
+    REQUIRE( types.contains( QStringLiteral( "stone" ) ) );
+  }
+
+  SECTION( "KeepQueuedPointsUntilWritten" )
+  {
+    const long long featureCount = logsLayer->featureCount();
+    digitizingLogger->clearCoordinates();
+
+    // Points which could not be written stay queued
+    logsLayer->setReadOnly( true );
+    digitizingLogger->addCoordinate( QgsPoint( 1, 1 ) );
+    digitizingLogger->addCoordinate( QgsPoint( 2, 2 ) );
+    digitizingLogger->writeCoordinates();
+    REQUIRE( logsLayer->featureCount() == featureCount );
+
+    // Queued points are written before the logs layer is removed from the project
+    logsLayer->setReadOnly( false );
+    QgsProject::instance()->takeMapLayer( logsLayer.get() );
+    REQUIRE( logsLayer->featureCount() == featureCount + 2 );
+  }
 }
@@ -0,0 +1,112 @@
+/***************************************************************************
+                        test_etaghash.cpp
+                        --------------------
+  begin                : October 2026
+  copyright            : (C) 2026 by OPENGIS.ch
+  email                : info@opengis.ch
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "catch2.h"
+#include "etaghash.h"
+#include "utils/fileutils.h"
+
+#include <QBuffer>
+#include <QFile>
+#include <QTemporaryDir>
+
+
+TEST_CASE( "EtagHash" )
+{
+  SECTION( "Single part" )
+  {
+    EtagHash hash;
+    REQUIRE( hash.result() == QStringLiteral( "d41d8cd98f00b204e9800998ecf8427e" ) );
+
+    hash.addData( QByteArray( "cont" ) );
+    hash.addData( QByteArray( "ent" ) );
+    REQUIRE( hash.size() == 7 );
+    REQUIRE( hash.result() == QStringLiteral( "9a0364b9e99bb480dd25e1f0284c8555" ) );
+
+    hash.reset();
+    REQUIRE( hash.size() == 0 );
+    hash.addData( QByteArray( "content" ) );
+    REQUIRE( hash.result() == QStringLiteral( "9a0364b9e99bb480dd25e1f0284c8555" ) );
+  }
+
+  SECTION( "Exactly one part" )
+  {
+    EtagHash hash( 4 );
+    hash.addData( QByteArray( "abcd" ) );
+    REQUIRE( hash.result() == QStringLiteral( "e2fc714c4727ee9395f324cd2e7f331f" ) );
+  }
+
+  SECTION( "Multiple parts" )
+  {
+    EtagHash hash( 4 );
+    hash.addData( QByteArray( "abcdefgh" ) );
+    REQUIRE( hash.result() == QStringLiteral( "cb93ad6c9c920e2602b79a11ded63ddb-2" ) );
+
+    // Chunks not aligned on parts give the same result
+    EtagHash chunkedHash( 4 );
+    chunkedHash.addData( QByteArray( "abc" ) );
+    chunkedHash.addData( QByteArray( "defgh" ) );
+    chunkedHash.addData( QByteArray( "ij" ) );
+    REQUIRE( chunkedHash.result() == QStringLiteral( "446feba4c1b5cc7ad93bf4d44a0e36ac-3" ) );
+  }
+
+  SECTION( "Device" )
+  {
+    QByteArray data( "abcdefghij" );
+    QBuffer buffer( &data );
+    REQUIRE( buffer.open( QIODevice::ReadOnly ) );
+
+    EtagHash hash( 4 );
+    REQUIRE( hash.addData( &buffer, 8 ) );
+    REQUIRE( hash.result() == QStringLiteral( "cb93ad6c9c920e2602b79a11ded63ddb-2" ) );
+    REQUIRE( hash.addData( &buffer ) );
+    REQUIRE( hash.result() == QStringLiteral( "446feba4c1b5cc7ad93bf4d44a0e36ac-3" ) );
+
+    // Less content than required
+    REQUIRE( !hash.addData( &buffer, 1 ) );
+  }
+
+  SECTION( "Comparable" )
+  {
+    REQUIRE( EtagHash::isComparable( QStringLiteral( "9a0364b9e99bb480dd25e1f0284c8555" ), 4, 4 ) );
+    REQUIRE( !EtagHash::isComparable( QStringLiteral( "cb93ad6c9c920e2602b79a11ded63ddb-1" ), 4, 4 ) );
+
+    REQUIRE( EtagHash::isComparable( QStringLiteral( "cb93ad6c9c920e2602b79a11ded63ddb-2" ), 8, 4 ) );
+    REQUIRE( EtagHash::isComparable( QStringLiteral( "446feba4c1b5cc7ad93bf4d44a0e36ac-3" ), 10, 4 ) );
+
+    // Uploaded in a single part, or with another part size
+    REQUIRE( !EtagHash::isComparable( QStringLiteral( "9a0364b9e99bb480dd25e1f0284c8555" ), 10, 4 ) );
+    REQUIRE( !EtagHash::isComparable( QStringLiteral( "446feba4c1b5cc7ad93bf4d44a0e36ac-2" ), 10, 4 ) );
+    REQUIRE( !EtagHash::isComparable( QStringLiteral( "446feba4c1b5cc7ad93bf4d44a0e36ac-x" ), 10, 4 ) );
+  }
+
+  SECTION( "Matches file ETag" )
+  {
+    QTemporaryDir dir;
+    REQUIRE( dir.isValid() );
+
+    QFile file( dir.filePath( QStringLiteral( "file.bin" ) ) );
+    REQUIRE( file.open( QIODevice::WriteOnly ) );
+    file.write( QByteArray( 1000, 'x' ) );
+    file.close();
+
+    EtagHash hash( 300 );
+    for ( int i = 0; i < 10; i++ )
+      hash.addData( QByteArray( 100, 'x' ) );
+
+    REQUIRE( hash.result() == FileUtils::fileEtag( file.fileName(), 300 ) );
+  }
+}
@@ -0,0 +1,119 @@
+/***************************************************************************
+                        test_featurelistcache.cpp
+                        --------------------
+  begin                : October 2026
+  copyright            : (C) 2026 by OPENGIS.ch
+  email                : info@opengis.ch
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "catch2.h"
+#include "featurelistcache.h"
+
+#include <qgsvectorlayer.h>
+
+
+TEST_CASE( "FeatureListCache" )
+{
+  std::unique_ptr<QgsVectorLayer> vl = std::make_unique<QgsVectorLayer>( QStringLiteral( "NoGeometry?field=id:integer&field=name:string&field=note:string" ), QStringLiteral( "vl" ), QStringLiteral( "memory" ) );
+  REQUIRE( vl->isValid() );
+
+  QgsFeature feature( vl->fields() );
+  feature.setAttributes( QgsAttributes() << 1 << QStringLiteral( "Oak" ) << QString() );
+  vl->dataProvider()->addFeature( feature );
+
+  FeatureListCache *cache = FeatureListCache::instance();
+  cache->clear();
+
+  const QString key = FeatureListCache::cacheKey( vl.get(), QStringLiteral( "\"name\"" ), QgsFeatureRequest(), QStringList() << QStringLiteral( "id" ) << QString() );
+  const QVector<FeatureExpressionValuesGatherer::Entry> entries { FeatureExpressionValuesGatherer::Entry( QVariantList() << 1 << QVariant(), QStringLiteral( "Oak" ), 1 ) };
+  const QSet<QString> referencedFields { QStringLiteral( "id" ), QStringLiteral( "name" ) };
+
+  auto insert = [&] {
+    cache->insert( vl.get(), key, entries, referencedFields, cache->generation( vl.get() ) );
+  };
+
+  SECTION( "Lookup" )
+  {
+    QVector<FeatureExpressionValuesGatherer::Entry> cachedEntries;
+    REQUIRE( !cache->entries( key, cachedEntries ) );
+
+    insert();
+    REQUIRE( cache->entries( key, cachedEntries ) );
+    REQUIRE( cachedEntries.size() == 1 );
+    REQUIRE( cachedEntries.at( 0 ).value == QStringLiteral( "Oak" ) );
+
+    const QString otherKey = FeatureListCache::cacheKey( vl.get(), QStringLiteral( "\"name\"" ), QgsFeatureRequest( QgsExpression( QStringLiteral( "\"id\" > 0" ) ) ), QStringList() << QStringLiteral( "id" ) << QString() );
+    REQUIRE( otherKey != key );
+    REQUIRE( !cache->entries( otherKey, cachedEntries ) );
+  }
+
+  SECTION( "Invalidation" )
+  {
+    QVector<FeatureExpressionValuesGatherer::Entry> cachedEntries;
+    insert();
+
+    // Changing a field the list does not depend on keeps the entries
+    REQUIRE( vl->startEditing() );
+    vl->changeAttributeValue( 1, 2, QStringLiteral( "Tall" ) );
+    REQUIRE( cache->entries( key, cachedEntries ) );
+
+    vl->changeAttributeValue( 1, 1, QStringLiteral( "Elm" ) );
+    REQUIRE( !cache->entries( key, cachedEntries ) );
+
+    insert();
+    feature.setAttributes( QgsAttributes() << 2 << QStringLiteral( "Ash" ) << QString() );
+    vl->addFeature( feature );
+    REQUIRE( !cache->entries( key, cachedEntries ) );
+    vl->rollBack();
+  }
+
+  SECTION( "Stale entries" )
+  {
+    QVector<FeatureExpressionValuesGatherer::Entry> cachedEntries;
+    const int generation = cache->generation( vl.get() );
+    cache->invalidate( vl.get() );
+
+    // Entries gathered before the layer changed are discarded
+    cache->insert( vl.get(), key, entries, referencedFields, generation );
+    REQUIRE( !cache->entries( key, cachedEntries ) );
+  }
+
+  SECTION( "Edited while gathering" )
+  {
+    QVector<FeatureExpressionValuesGatherer::Entry> cachedEntries;
+    std::unique_ptr<QgsVectorLayer> otherLayer = std::make_unique<QgsVectorLayer>( QStringLiteral( "NoGeometry?field=id:integer&field=name:string&field=note:string" ), QStringLiteral( "other" ), QStringLiteral( "memory" ) );
+    const QString otherKey = FeatureListCache::cacheKey( otherLayer.get(), QStringLiteral( "\"name\"" ), QgsFeatureRequest(), QStringList() << QStringLiteral( "id" ) << QString() );
+
+    // The first gathering of a layer is already watched for changes
+    const int generation = cache->generation( otherLayer.get() );
+    REQUIRE( otherLayer->startEditing() );
+    QgsFeature otherFeature( otherLayer->fields() );
+    otherFeature.setAttributes( QgsAttributes() << 1 << QStringLiteral( "Birch" ) << QString() );
+    otherLayer->addFeature( otherFeature );
+    otherLayer->rollBack();
+
+    cache->insert( otherLayer.get(), otherKey, entries, referencedFields, generation );
+    REQUIRE( !cache->entries( otherKey, cachedEntries ) );
+  }
+
+  SECTION( "Memory cap" )
+  {
+    QVector<FeatureExpressionValuesGatherer::Entry> cachedEntries;
+    const int maximumEntries = cache->maximumEntries();
+    cache->setMaximumEntries( 0 );
+    insert();
+    REQUIRE( !cache->entries( key, cachedEntries ) );
+    cache->setMaximumEntries( maximumEntries );
+  }
+
+  cache->clear();
+}
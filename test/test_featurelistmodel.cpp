@@ -0,0 +1,237 @@
+/***************************************************************************
+                        test_featurelistmodel.cpp
+                        --------------------
+  begin                : October 2026
+  copyright            : (C) 2026 by OPENGIS.ch
+  email                : info@opengis.ch
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#define QFIELDTEST_MAIN
+#include "catch2.h"
+#include "featurelistmodel.h"
+
+#include <QAbstractItemModelTester>
+#include <QSignalSpy>
+#include <QTest>
+#include <qgsvectorlayer.h>
+
+
+TEST_CASE( "FeatureListModel" )
+{
+  std::unique_ptr<QgsVectorLayer> vl = std::make_unique<QgsVectorLayer>( QStringLiteral( "NoGeometry?field=id:integer&field=name:string" ), QStringLiteral( "vl" ), QStringLiteral( "memory" ) );
+  REQUIRE( vl->isValid() );
+
+  // The display values are not ordered like the keys
+  QgsFeatureList features;
+  for ( int i = 0; i < 25; i++ )
+  {
+    QgsFeature feature( vl->fields() );
+    feature.setAttributes( QgsAttributes() << i << QStringLiteral( "Value %1" ).arg( ( i * 7 ) % 25, 2, 10, QChar( '0' ) ) );
+    features << feature;
+  }
+  REQUIRE( vl->dataProvider()->addFeatures( features ) );
+  REQUIRE( vl->featureCount() == 25 );
+
+  FeatureListModel model;
+  QAbstractItemModelTester modelTester( &model, QAbstractItemModelTester::FailureReportingMode::Fatal );
+  model.setKeyField( QStringLiteral( "id" ) );
+  model.setDisplayValueField( QStringLiteral( "name" ) );
+  model.setOrderByValue( true );
+
+  auto displayStrings = [&model] {
+    QStringList strings;
+    for ( int row = 0; row < model.rowCount(); row++ )
+      strings << model.dataFromRowIndex( row, FeatureListModel::DisplayStringRole ).toString();
+    return strings;
+  };
+
+  SECTION( "Paged" )
+  {
+    model.setPageSize( 10 );
+    model.setCurrentLayer( vl.get() );
+    REQUIRE( QTest::qWaitFor( [&model] { return model.rowCount() == 10 && model.canFetchMore( QModelIndex() ); } ) );
+    REQUIRE( displayStrings().first() == QStringLiteral( "Value 00" ) );
+    REQUIRE( displayStrings().last() == QStringLiteral( "Value 09" ) );
+
+    model.fetchMore( QModelIndex() );
+    REQUIRE( QTest::qWaitFor( [&model] { return model.rowCount() == 20 && model.canFetchMore( QModelIndex() ); } ) );
+    REQUIRE( displayStrings().at( 10 ) == QStringLiteral( "Value 10" ) );
+
+    model.fetchMore( QModelIndex() );
+    REQUIRE( QTest::qWaitFor( [&model] { return model.rowCount() == 25; } ) );
+    REQUIRE( displayStrings().last() == QStringLiteral( "Value 24" ) );
+
+    QStringList sortedStrings = displayStrings();
+    std::sort( sortedStrings.begin(), sortedStrings.end() );
+    REQUIRE( sortedStrings == displayStrings() );
+    REQUIRE( QTest::qWaitFor( [&model] { return !model.canFetchMore( QModelIndex() ); } ) );
+  }
+
+  SECTION( "Gathered batches" )
+  {
+    // More features than a gathered batch
+    std::unique_ptr<QgsVectorLayer> largeLayer = std::make_unique<QgsVectorLayer>( QStringLiteral( "NoGeometry?field=id:integer&field=name:string" ), QStringLiteral( "large" ), QStringLiteral( "memory" ) );
+    QgsFeatureList largeFeatures;
+    for ( int i = 0; i < 2500; i++ )
+    {
+      QgsFeature feature( largeLayer->fields() );
+      feature.setAttributes( QgsAttributes() << i << QStringLiteral( "Value %1" ).arg( ( i * 7 ) % 2500, 4, 10, QChar( '0' ) ) );
+      largeFeatures << feature;
+    }
+    REQUIRE( largeLayer->dataProvider()->addFeatures( largeFeatures ) );
+
+    QSignalSpy resetSpy( &model, &FeatureListModel::modelReset );
+    QSignalSpy insertSpy( &model, &FeatureListModel::rowsInserted );
+    QSignalSpy layoutSpy( &model, &FeatureListModel::layoutChanged );
+
+    model.setAddNull( true );
+    model.setCurrentLayer( largeLayer.get() );
+    REQUIRE( QTest::qWaitFor( [&model] { return model.rowCount() == 2501; } ) );
+    QTest::qWait( 100 );
+
+    // The first batch resets the model, further batches are each merged at their sorted rows with a single notification
+    REQUIRE( resetSpy.count() == 1 );
+    REQUIRE( insertSpy.count() + layoutSpy.count() > 0 );
+    REQUIRE( insertSpy.count() + layoutSpy.count() < 2500 / 100 );
+    REQUIRE( model.dataFromRowIndex( 0, FeatureListModel::KeyFieldRole ).isNull() );
+
+    QStringList sortedStrings = displayStrings().mid( 1 );
+    std::sort( sortedStrings.begin(), sortedStrings.end() );
+    REQUIRE( sortedStrings == displayStrings().mid( 1 ) );
+    REQUIRE( model.findKey( 1 ) == 8 );
+  }
+
+  SECTION( "Refined search" )
+  {
+    std::unique_ptr<QgsVectorLayer> searchLayer = std::make_unique<QgsVectorLayer>( QStringLiteral( "NoGeometry?field=id:integer&field=name:string" ), QStringLiteral( "search" ), QStringLiteral( "memory" ) );
+    QgsFeatureList searchFeatures;
+    const QStringList names = { QStringLiteral( "50% off" ), QStringLiteral( "5000 off" ), QStringLiteral( "road_a" ), QStringLiteral( "roadxa" ), QStringLiteral( "Élan" ), QStringLiteral( "élan" ) };
+    for ( int i = 0; i < names.size(); i++ )
+    {
+      QgsFeature feature( searchLayer->fields() );
+      feature.setAttributes( QgsAttributes() << i << names.at( i ) );
+      searchFeatures << feature;
+    }
+    REQUIRE( searchLayer->dataProvider()->addFeatures( searchFeatures ) );
+
+    model.setCurrentLayer( searchLayer.get() );
+    REQUIRE( QTest::qWaitFor( [&model, &names] { return model.rowCount() == names.size(); } ) );
+
+    // Results refined in memory from the gathered entries match the ones of a fresh provider query
+    for ( const QString &searchTerm : { QStringLiteral( "50%" ), QStringLiteral( "d_a" ), QStringLiteral( "OFF" ), QStringLiteral( "élan" ) } )
+    {
+      model.setSearchTerm( QString() );
+      REQUIRE( QTest::qWaitFor( [&model, &names] { return model.rowCount() == names.size(); } ) );
+      model.setSearchTerm( searchTerm );
+      QTest::qWait( 100 );
+      QStringList refinedStrings = displayStrings();
+      refinedStrings.sort();
+
+      FeatureListModel freshModel;
+      freshModel.setKeyField( QStringLiteral( "id" ) );
+      freshModel.setDisplayValueField( QStringLiteral( "name" ) );
+      freshModel.setSearchTerm( searchTerm );
+      QSignalSpy resetSpy( &freshModel, &FeatureListModel::modelReset );
+      freshModel.setCurrentLayer( searchLayer.get() );
+      REQUIRE( QTest::qWaitFor( [&resetSpy] { return resetSpy.count() > 0; } ) );
+      QTest::qWait( 100 );
+      QStringList freshStrings;
+      for ( int row = 0; row < freshModel.rowCount(); row++ )
+        freshStrings << freshModel.dataFromRowIndex( row, FeatureListModel::DisplayStringRole ).toString();
+      freshStrings.sort();
+
+      CAPTURE( searchTerm );
+      REQUIRE( refinedStrings == freshStrings );
+    }
+
+    model.setSearchTerm( QStringLiteral( "50%" ) );
+    QTest::qWait( 100 );
+    REQUIRE( displayStrings() == QStringList( { QStringLiteral( "50% off" ) } ) );
+  }
+
+  SECTION( "Paged with NULL values" )
+  {
+    // Pages resume after NULL and duplicated display values
+    std::unique_ptr<QgsVectorLayer> nullLayer = std::make_unique<QgsVectorLayer>( QStringLiteral( "NoGeometry?field=id:integer&field=name:string" ), QStringLiteral( "null" ), QStringLiteral( "memory" ) );
+    QgsFeatureList nullFeatures;
+    for ( int i = 0; i < 25; i++ )
+    {
+      QgsFeature feature( nullLayer->fields() );
+      feature.setAttributes( QgsAttributes() << i << ( i % 5 == 0 ? QVariant() : QVariant( QStringLiteral( "Value %1" ).arg( i % 3 ) ) ) );
+      nullFeatures << feature;
+    }
+    REQUIRE( nullLayer->dataProvider()->addFeatures( nullFeatures ) );
+
+    model.setPageSize( 4 );
+    model.setCurrentLayer( nullLayer.get() );
+    REQUIRE( QTest::qWaitFor( [&model] { return model.rowCount() == 4; } ) );
+    while ( model.rowCount() < 25 )
+    {
+      REQUIRE( QTest::qWaitFor( [&model] { return model.canFetchMore( QModelIndex() ); } ) );
+      const int rowCount = model.rowCount();
+      model.fetchMore( QModelIndex() );
+      REQUIRE( QTest::qWaitFor( [&model, rowCount] { return model.rowCount() > rowCount; } ) );
+    }
+    QTest::qWait( 100 );
+    REQUIRE( model.rowCount() == 25 );
+    REQUIRE( !model.canFetchMore( QModelIndex() ) );
+
+    QSet<int> keys;
+    for ( int row = 0; row < model.rowCount(); row++ )
+      keys << model.dataFromRowIndex( row, FeatureListModel::KeyFieldRole ).toInt();
+    REQUIRE( keys.size() == 25 );
+  }
+
+  SECTION( "Keyset expression" )
+  {
+    REQUIRE( FeatureListModel::keysetExpression( { qMakePair( QStringLiteral( "\"name\"" ), QVariant( QStringLiteral( "a" ) ) ), qMakePair( QStringLiteral( "\"id\"" ), QVariant( 3 ) ) } ) == QStringLiteral( "((\"name\") > 'a' OR ((\"name\") = 'a' AND (\"id\") > 3))" ) );
+    REQUIRE( FeatureListModel::keysetExpression( { qMakePair( QStringLiteral( "\"group\"" ), QVariant() ), qMakePair( QStringLiteral( "\"id\"" ), QVariant( 3 ) ) } ) == QStringLiteral( "((\"group\") IS NOT NULL OR ((\"group\") IS NULL AND (\"id\") > 3))" ) );
+  }
+
+  SECTION( "Layer fitting in a page" )
+  {
+    model.setPageSize( 100 );
+    model.setCurrentLayer( vl.get() );
+    REQUIRE( QTest::qWaitFor( [&model] { return model.rowCount() == 25; } ) );
+    REQUIRE( !model.canFetchMore( QModelIndex() ) );
+  }
+
+  SECTION( "Key of a page not fetched yet" )
+  {
+    model.setAddNull( true );
+    model.setPageSize( 10 );
+    model.setCurrentLayer( vl.get() );
+    REQUIRE( QTest::qWaitFor( [&model] { return model.rowCount() == 11 && model.canFetchMore( QModelIndex() ); } ) );
+
+    // Feature 5 is displayed as "Value 10", on the second page, it is looked up in the background
+    QSignalSpy pinnedSpy( &model, &FeatureListModel::keyPinned );
+    REQUIRE( model.findKey( 5 ) == 0 );
+    REQUIRE( pinnedSpy.wait() );
+    REQUIRE( pinnedSpy.first().first() == 5 );
+    REQUIRE( model.rowCount() == 12 );
+    REQUIRE( model.dataFromRowIndex( 1, FeatureListModel::DisplayStringRole ).toString() == QStringLiteral( "Value 10" ) );
+    REQUIRE( model.findKey( 5 ) == 1 );
+    REQUIRE( model.findKey( 0 ) == 2 );
+
+    // Keys matching no feature are not pinned
+    REQUIRE( model.findKey( 100 ) == 0 );
+    REQUIRE( !pinnedSpy.wait( 500 ) );
+    REQUIRE( model.rowCount() == 12 );
+
+    // Pinned entries are not listed again when their page is fetched
+    model.fetchMore( QModelIndex() );
+    REQUIRE( QTest::qWaitFor( [&model] { return model.rowCount() == 21 && model.canFetchMore( QModelIndex() ); } ) );
+    model.fetchMore( QModelIndex() );
+    REQUIRE( QTest::qWaitFor( [&model] { return model.rowCount() == 26; } ) );
+    REQUIRE( displayStrings().count( QStringLiteral( "Value 10" ) ) == 1 );
+  }
+}
@@ -0,0 +1,167 @@
+/***************************************************************************
+                        test_featuressearchindex.cpp
+                        --------------------
+  begin                : October 2026
+  copyright            : (C) 2026 by OPENGIS.ch
+  email                : info@opengis.ch
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#define QFIELDTEST_MAIN
+#include "catch2.h"
+#include "featuressearchindex.h"
+#include "layerobserver.h"
+
+#include <QFile>
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QTest>
+#include <qgsproject.h>
+#include <qgsvectorfilewriter.h>
+#include <qgsvectorlayer.h>
+
+
+static void writeFile( const QString &path, const QByteArray &content )
+{
+  QFile file( path );
+  REQUIRE( file.open( QIODevice::WriteOnly | QIODevice::Truncate ) );
+  file.write( content );
+  file.close();
+}
+
+TEST_CASE( "FeaturesSearchIndex" )
+{
+  QTemporaryDir dir;
+  REQUIRE( dir.isValid() );
+
+  const QString csvPath = dir.filePath( QStringLiteral( "trees.csv" ) );
+  writeFile( csvPath, QByteArray( "id,name\n1,Oak\n2,Elm\n" ) );
+
+  std::unique_ptr<QgsVectorLayer> fileLayer = std::make_unique<QgsVectorLayer>( csvPath, QStringLiteral( "trees" ), QStringLiteral( "ogr" ) );
+  REQUIRE( fileLayer->isValid() );
+  fileLayer->setFlags( fileLayer->flags() | QgsMapLayer::Searchable );
+  fileLayer->setDisplayExpression( QStringLiteral( "\"name\"" ) );
+
+  SECTION( "Indexable" )
+  {
+    REQUIRE( FeaturesSearchIndex::isIndexable( fileLayer.get() ) );
+
+    fileLayer->setFlags( fileLayer->flags() & ~QgsMapLayer::Searchable );
+    REQUIRE( !FeaturesSearchIndex::isIndexable( fileLayer.get() ) );
+
+    // Layers not backed by a local file are searched through their provider
+    std::unique_ptr<QgsVectorLayer> memoryLayer = std::make_unique<QgsVectorLayer>( QStringLiteral( "NoGeometry?field=name:string" ), QStringLiteral( "memory" ), QStringLiteral( "memory" ) );
+    REQUIRE( memoryLayer->isValid() );
+    memoryLayer->setFlags( memoryLayer->flags() | QgsMapLayer::Searchable );
+    REQUIRE( !FeaturesSearchIndex::isIndexable( memoryLayer.get() ) );
+
+    REQUIRE( !FeaturesSearchIndex::isIndexable( nullptr ) );
+  }
+
+  SECTION( "Signature" )
+  {
+    const QString signature = FeaturesSearchIndex::layerSignature( fileLayer.get() );
+    REQUIRE( !signature.isEmpty() );
+    REQUIRE( FeaturesSearchIndex::layerSignature( fileLayer.get() ) == signature );
+
+    fileLayer->setDisplayExpression( QStringLiteral( "\"id\"" ) );
+    REQUIRE( FeaturesSearchIndex::layerSignature( fileLayer.get() ) != signature );
+    fileLayer->setDisplayExpression( QStringLiteral( "\"name\"" ) );
+    REQUIRE( FeaturesSearchIndex::layerSignature( fileLayer.get() ) == signature );
+
+    // Edits keeping the feature count are detected
+    writeFile( csvPath, QByteArray( "id,name\n1,Birch\n2,Elm\n" ) );
+    const QString editedSignature = FeaturesSearchIndex::layerSignature( fileLayer.get() );
+    REQUIRE( editedSignature != signature );
+
+    // Pending write-ahead log content is taken into account
+    writeFile( QStringLiteral( "%1-wal" ).arg( csvPath ), QByteArray( "wal" ) );
+    REQUIRE( FeaturesSearchIndex::layerSignature( fileLayer.get() ) != editedSignature );
+  }
+
+  SECTION( "Search" )
+  {
+    // The index databases are stored in the application data location
+    QStandardPaths::setTestModeEnabled( true );
+
+    std::unique_ptr<QgsVectorLayer> memoryLayer = std::make_unique<QgsVectorLayer>( QStringLiteral( "Point?crs=EPSG:4326&field=name:string" ), QStringLiteral( "trees" ), QStringLiteral( "memory" ) );
+    QgsFeatureList features;
+    for ( const QString &name : { QStringLiteral( "Oak" ), QStringLiteral( "Elm" ), QStringLiteral( "Red Oak" ) } )
+    {
+      QgsFeature feature( memoryLayer->fields() );
+      feature.setAttributes( QgsAttributes() << name );
+      features << feature;
+    }
+    REQUIRE( memoryLayer->dataProvider()->addFeatures( features ) );
+
+    const QString gpkgPath = dir.filePath( QStringLiteral( "trees.gpkg" ) );
+    QgsVectorFileWriter::SaveVectorOptions options;
+    options.driverName = QStringLiteral( "GPKG" );
+    options.layerName = QStringLiteral( "trees" );
+    REQUIRE( QgsVectorFileWriter::writeAsVectorFormatV3( memoryLayer.get(), gpkgPath, QgsCoordinateTransformContext(), options ) == QgsVectorFileWriter::NoError );
+
+    const QString projectPath = dir.filePath( QStringLiteral( "trees.qgs" ) );
+    QgsProject project;
+    project.setFileName( projectPath );
+    QgsVectorLayer *gpkgLayer = new QgsVectorLayer( QStringLiteral( "%1|layername=trees" ).arg( gpkgPath ), QStringLiteral( "trees" ), QStringLiteral( "ogr" ) );
+    REQUIRE( gpkgLayer->isValid() );
+    gpkgLayer->setFlags( gpkgLayer->flags() | QgsMapLayer::Searchable );
+    gpkgLayer->setDisplayExpression( QStringLiteral( "\"name\"" ) );
+    const QString layerId = gpkgLayer->id();
+    project.addMapLayer( gpkgLayer );
+    REQUIRE( project.write() );
+
+    LayerObserver layerObserver( &project );
+    FeaturesSearchIndex index( &project, &layerObserver );
+    QSignalSpy indexedSpy( &index, &FeaturesSearchIndex::layerIndexed );
+    REQUIRE( project.read( projectPath ) );
+    REQUIRE( ( indexedSpy.count() > 0 || indexedSpy.wait() ) );
+    REQUIRE( index.isLayerIndexed( layerId ) );
+
+    auto searchDisplayStrings = [&index, &layerId]( const QString &string ) {
+      QStringList displayStrings;
+      const QList<FeaturesSearchIndex::Result> results = FeaturesSearchIndex::search( index.databasePath(), string, { layerId }, 10, 10 );
+      for ( const FeaturesSearchIndex::Result &result : results )
+      {
+        REQUIRE( result.layerId == layerId );
+        displayStrings << result.displayString;
+      }
+      displayStrings.sort();
+      return displayStrings;
+    };
+
+    REQUIRE( searchDisplayStrings( QStringLiteral( "oak" ) ) == QStringList( { QStringLiteral( "Oak" ), QStringLiteral( "Red Oak" ) } ) );
+    REQUIRE( searchDisplayStrings( QStringLiteral( "red oak" ) ) == QStringList( { QStringLiteral( "Red Oak" ) } ) );
+    REQUIRE( searchDisplayStrings( QStringLiteral( "elm" ) ) == QStringList( { QStringLiteral( "Elm" ) } ) );
+    REQUIRE( searchDisplayStrings( QStringLiteral( "pine" ) ).isEmpty() );
+    REQUIRE( FeaturesSearchIndex::search( index.databasePath(), QStringLiteral( "oak" ), { QStringLiteral( "other" ) }, 10, 10 ).isEmpty() );
+
+    // Committed features are indexed incrementally
+    QgsVectorLayer *layer = qobject_cast<QgsVectorLayer *>( project.mapLayer( layerId ) );
+    REQUIRE( layer );
+    QgsFeature feature( layer->fields() );
+    feature.setAttribute( QStringLiteral( "name" ), QStringLiteral( "Cork Oak" ) );
+    REQUIRE( layer->startEditing() );
+    REQUIRE( layer->addFeature( feature ) );
+    REQUIRE( layer->commitChanges() );
+    REQUIRE( QTest::qWaitFor( [&searchDisplayStrings] { return searchDisplayStrings( QStringLiteral( "oak" ) ).size() == 3; } ) );
+    REQUIRE( searchDisplayStrings( QStringLiteral( "cork" ) ) == QStringList( { QStringLiteral( "Cork Oak" ) } ) );
+
+    // Committed removals are dropped from the index
+    QgsFeature elm;
+    REQUIRE( layer->getFeatures( QStringLiteral( "\"name\" = 'Elm'" ) ).nextFeature( elm ) );
+    REQUIRE( layer->startEditing() );
+    REQUIRE( layer->deleteFeature( elm.id() ) );
+    REQUIRE( layer->commitChanges() );
+    REQUIRE( QTest::qWaitFor( [&searchDisplayStrings] { return searchDisplayStrings( QStringLiteral( "elm" ) ).isEmpty(); } ) );
+  }
+}
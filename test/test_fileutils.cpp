@@ -18,7 +18,12 @@
 #include "catch2.h"
 #include "utils/fileutils.h"
 
+#include <QImage>
+#include <QImageReader>
+#include <QTemporaryDir>
 #include <QTemporaryFile>
+#include <qgis.h>
+#include <qgsexiftools.h>
 
 TEST_CASE( "FileUtils" )
 {
@@ -62,4 +67,36 @@ TEST_CASE( "FileUtils" )
     delete f;
     REQUIRE( !FileUtils::fileExists( fileName ) );
   }
+
+
+  SECTION( "ProcessImageFile" )
+  {
+    QTemporaryDir dir;
+    REQUIRE( dir.isValid() );
+    const QString imagePath = dir.filePath( QStringLiteral( "photo.jpg" ) );
+    QImage image( 400, 200, QImage::Format_RGB32 );
+    image.fill( Qt::red );
+    REQUIRE( image.save( imagePath, "JPG" ) );
+
+    QVariantMap metadata;
+    metadata[QStringLiteral( "Exif.Image.Make" )] = QStringLiteral( "QField" );
+    metadata[QStringLiteral( "Exif.GPSInfo.GPSLatitude" )] = 46.5;
+    metadata[QStringLiteral( "Exif.GPSInfo.GPSLatitudeRef" )] = QStringLiteral( "N" );
+    REQUIRE( FileUtils::processImageFile( imagePath, 100, QString(), metadata ) );
+
+    // The image is resized and tagged in one go
+    REQUIRE( QImageReader( imagePath ).size() == QSize( 100, 50 ) );
+    REQUIRE( QgsExifTools::readTag( imagePath, QStringLiteral( "Exif.Image.Make" ) ).toString() == QStringLiteral( "QField" ) );
+    REQUIRE( qgsDoubleNear( QgsExifTools::readTag( imagePath, QStringLiteral( "Exif.GPSInfo.GPSLatitude" ) ).toDouble(), 46.5, 0.0001 ) );
+
+    // Metadata of previous passes is kept when only tagging
+    metadata.clear();
+    metadata[QStringLiteral( "Exif.GPSInfo.GPSSatellites" )] = QStringLiteral( "08" );
+    REQUIRE( FileUtils::processImageFile( imagePath, 0, QString(), metadata ) );
+    REQUIRE( QImageReader( imagePath ).size() == QSize( 100, 50 ) );
+    REQUIRE( QgsExifTools::readTag( imagePath, QStringLiteral( "Exif.Image.Make" ) ).toString() == QStringLiteral( "QField" ) );
+    REQUIRE( QgsExifTools::readTag( imagePath, QStringLiteral( "Exif.GPSInfo.GPSSatellites" ) ).toString() == QStringLiteral( "08" ) );
+
+    REQUIRE( !FileUtils::processImageFile( dir.filePath( QStringLiteral( "missing.jpg" ) ), 100, QString(), metadata ) );
+  }
 }
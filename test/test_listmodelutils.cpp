@@ -0,0 +1,68 @@
+/***************************************************************************
+                        test_listmodelutils.cpp
+                        --------------------
+  begin                : Oct 2026
+  copyright            : (C) 2026 by OPENGIS.ch
+  email                : info@opengis.ch
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "catch2.h"
+#include "utils/listmodelutils.h"
+
+#include <QPair>
+
+
+TEST_CASE( "ListModelUtils" )
+{
+  // Entries are sorted by their first member, the second one tells equal entries apart
+  using Entry = QPair<int, char>;
+  auto lessThan = []( const Entry &entry1, const Entry &entry2 ) { return entry1.first < entry2.first; };
+  const QList<Entry> entries = { { 1, 'a' }, { 3, 'a' }, { 5, 'a' }, { 7, 'a' } };
+  ListModelUtils::MergedRows rows;
+
+  SECTION( "Interleaved batch" )
+  {
+    const QList<Entry> mergedEntries = ListModelUtils::mergeSortedEntries( entries, QList<Entry>( { { 6, 'b' }, { 0, 'b' }, { 3, 'b' } } ), lessThan, rows );
+    REQUIRE( mergedEntries == QList<Entry>( { { 0, 'b' }, { 1, 'a' }, { 3, 'a' }, { 3, 'b' }, { 5, 'a' }, { 6, 'b' }, { 7, 'a' } } ) );
+    REQUIRE( rows.firstRow == 0 );
+    REQUIRE( !rows.contiguous );
+    REQUIRE( rows.previousRows == QVector<int>( { 1, 2, 4, 6 } ) );
+  }
+
+  SECTION( "Batch runs" )
+  {
+    const QList<Entry> mergedEntries = ListModelUtils::mergeSortedEntries( entries, QList<Entry>( { { 5, 'b' }, { 4, 'b' } } ), lessThan, rows );
+    REQUIRE( mergedEntries == QList<Entry>( { { 1, 'a' }, { 3, 'a' }, { 4, 'b' }, { 5, 'a' }, { 5, 'b' }, { 7, 'a' } } ) );
+    REQUIRE( rows.firstRow == 2 );
+    REQUIRE( !rows.contiguous );
+
+    const QList<Entry> appendedEntries = ListModelUtils::mergeSortedEntries( entries, QList<Entry>( { { 9, 'b' }, { 7, 'b' }, { 8, 'b' } } ), lessThan, rows );
+    REQUIRE( appendedEntries == QList<Entry>( { { 1, 'a' }, { 3, 'a' }, { 5, 'a' }, { 7, 'a' }, { 7, 'b' }, { 8, 'b' }, { 9, 'b' } } ) );
+    REQUIRE( rows.firstRow == 4 );
+    REQUIRE( rows.contiguous );
+    REQUIRE( rows.previousRows == QVector<int>( { 0, 1, 2, 3 } ) );
+  }
+
+  SECTION( "Empty entries" )
+  {
+    const QList<Entry> mergedEntries = ListModelUtils::mergeSortedEntries( QList<Entry>(), QList<Entry>( { { 2, 'b' }, { 1, 'b' } } ), lessThan, rows );
+    REQUIRE( mergedEntries == QList<Entry>( { { 1, 'b' }, { 2, 'b' } } ) );
+    REQUIRE( rows.firstRow == 0 );
+    REQUIRE( rows.contiguous );
+    REQUIRE( rows.previousRows.isEmpty() );
+
+    const QList<Entry> unchangedEntries = ListModelUtils::mergeSortedEntries( entries, QList<Entry>(), lessThan, rows );
+    REQUIRE( unchangedEntries == entries );
+    REQUIRE( rows.firstRow == -1 );
+    REQUIRE( !rows.contiguous );
+  }
+}
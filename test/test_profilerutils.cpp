@@ -0,0 +1,89 @@
+/***************************************************************************
+                        test_profilerutils.cpp
+                        --------------------
+  begin                : Oct 2026
+  copyright            : (C) 2026 by OPENGIS.ch
+  email                : info@opengis.ch
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#define QFIELDTEST_MAIN
+#include "catch2.h"
+#include "utils/profilerutils.h"
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <qgsapplication.h>
+#include <qgsruntimeprofiler.h>
+
+
+TEST_CASE( "ProfilerUtils" )
+{
+  const QString group = QStringLiteral( "profilerutilstest" );
+  QgsRuntimeProfiler *profiler = QgsApplication::profiler();
+  profiler->clear( group );
+
+  profiler->record( QStringLiteral( "Scan datasets" ), 0.25, group );
+  profiler->start( QStringLiteral( "Read project" ), group );
+  profiler->start( QStringLiteral( "Create provider" ), group );
+  profiler->end( group );
+  profiler->end( group );
+
+  SECTION( "report" )
+  {
+    const QStringList lines = ProfilerUtils::report( { group } ).split( '\n' );
+    REQUIRE( lines.size() == 4 );
+    REQUIRE( lines.at( 0 ).startsWith( QStringLiteral( "[profilerutilstest] " ) ) );
+    REQUIRE( lines.at( 1 ) == QStringLiteral( "Scan datasets: 250.0 ms" ) );
+    REQUIRE( lines.at( 2 ).startsWith( QStringLiteral( "Read project: " ) ) );
+    REQUIRE( lines.at( 3 ).startsWith( QStringLiteral( "  Create provider: " ) ) );
+
+    REQUIRE( ProfilerUtils::report( { QStringLiteral( "profilerutilsemptygroup" ) } ).isEmpty() );
+  }
+
+  SECTION( "traceEvents" )
+  {
+    const QJsonArray events = ProfilerUtils::traceEvents( { group } );
+    REQUIRE( events.size() == 4 );
+
+    REQUIRE( events.at( 0 ).toObject().value( QStringLiteral( "ph" ) ).toString() == QStringLiteral( "M" ) );
+
+    const QJsonObject scanEvent = events.at( 1 ).toObject();
+    REQUIRE( scanEvent.value( QStringLiteral( "name" ) ).toString() == QStringLiteral( "Scan datasets" ) );
+    REQUIRE( scanEvent.value( QStringLiteral( "ph" ) ).toString() == QStringLiteral( "X" ) );
+    REQUIRE( scanEvent.value( QStringLiteral( "cat" ) ).toString() == group );
+    REQUIRE( scanEvent.value( QStringLiteral( "ts" ) ).toDouble() == 0.0 );
+    REQUIRE( scanEvent.value( QStringLiteral( "dur" ) ).toDouble() == 250000.0 );
+
+    // Sibling tasks are laid out one after another, children start with their parent
+    const QJsonObject readEvent = events.at( 2 ).toObject();
+    const QJsonObject providerEvent = events.at( 3 ).toObject();
+    REQUIRE( readEvent.value( QStringLiteral( "ts" ) ).toDouble() == 250000.0 );
+    REQUIRE( providerEvent.value( QStringLiteral( "ts" ) ).toDouble() == 250000.0 );
+    REQUIRE( providerEvent.value( QStringLiteral( "dur" ) ).toDouble() <= readEvent.value( QStringLiteral( "dur" ) ).toDouble() );
+  }
+
+  SECTION( "writeTrace" )
+  {
+    QTemporaryDir dir;
+    const QString path = dir.filePath( QStringLiteral( "profiling/trace.json" ) );
+    REQUIRE( ProfilerUtils::writeTrace( path, { group } ) );
+
+    QFile file( path );
+    REQUIRE( file.open( QIODevice::ReadOnly ) );
+    const QJsonObject trace = QJsonDocument::fromJson( file.readAll() ).object();
+    REQUIRE( trace.value( QStringLiteral( "traceEvents" ) ).toArray().size() == 4 );
+  }
+
+  profiler->clear( group );
+}
@@ -0,0 +1,135 @@
+/***************************************************************************
+                        test_qfieldcloudprojectsmodel.cpp
+                        --------------------
+  begin                : October 2026
+  copyright            : (C) 2026 by OPENGIS.ch
+  email                : info@opengis.ch
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "catch2.h"
+#include "qfieldcloudprojectsmodel.h"
+
+
+TEST_CASE( "QFieldCloudProjectsModel partial downloads" )
+{
+  using Action = QFieldCloudProjectsModel::PartialDownloadAction;
+
+  constexpr long long partSize = EtagHash::DEFAULT_PART_SIZE;
+  const QString singlePartEtag = QStringLiteral( "9a0364b9e99bb480dd25e1f0284c8555" );
+  const QString multiPartEtag = QStringLiteral( "cb93ad6c9c920e2602b79a11ded63ddb-3" );
+
+  SECTION( "No partial download" )
+  {
+    REQUIRE( QFieldCloudProjectsModel::partialDownloadAction( 0, 1000, singlePartEtag ) == Action::Download );
+    REQUIRE( QFieldCloudProjectsModel::partialDownloadAction( 0, 0, singlePartEtag ) == Action::Download );
+  }
+
+  SECTION( "Resume" )
+  {
+    REQUIRE( QFieldCloudProjectsModel::partialDownloadAction( 500, 1000, singlePartEtag ) == Action::Resume );
+    REQUIRE( QFieldCloudProjectsModel::partialDownloadAction( partSize, 2 * partSize + 1, multiPartEtag ) == Action::Resume );
+  }
+
+  SECTION( "Verify" )
+  {
+    REQUIRE( QFieldCloudProjectsModel::partialDownloadAction( 1000, 1000, singlePartEtag ) == Action::Verify );
+    REQUIRE( QFieldCloudProjectsModel::partialDownloadAction( 2 * partSize + 1, 2 * partSize + 1, multiPartEtag ) == Action::Verify );
+  }
+
+  SECTION( "Discard" )
+  {
+    // Larger than the file
+    REQUIRE( QFieldCloudProjectsModel::partialDownloadAction( 1001, 1000, singlePartEtag ) == Action::Discard );
+    REQUIRE( QFieldCloudProjectsModel::partialDownloadAction( 1, 0, singlePartEtag ) == Action::Discard );
+
+    // ETags the resumed content could not be verified against
+    REQUIRE( QFieldCloudProjectsModel::partialDownloadAction( 500, 1000, multiPartEtag ) == Action::Discard );
+    REQUIRE( QFieldCloudProjectsModel::partialDownloadAction( partSize, 2 * partSize + 1, singlePartEtag ) == Action::Discard );
+    REQUIRE( QFieldCloudProjectsModel::partialDownloadAction( partSize, 4 * partSize, multiPartEtag ) == Action::Discard );
+  }
+}
+
+TEST_CASE( "QFieldCloudProjectsModel active downloads" )
+{
+  SECTION( "Already complete file" )
+  {
+    // The first file was verified without a network reply while the second one is still downloading
+    QStringList activeFileNames = { QStringLiteral( "project.qgs" ), QStringLiteral( "data.gpkg" ) };
+    QStringList queuedFileNames;
+    QFieldCloudProjectsModel::updateActiveDownloads( activeFileNames, queuedFileNames, { QStringLiteral( "project.qgs" ) }, 2 );
+    REQUIRE( activeFileNames == QStringList( { QStringLiteral( "data.gpkg" ) } ) );
+
+    // The completed file is not started again
+    QFieldCloudProjectsModel::updateActiveDownloads( activeFileNames, queuedFileNames, { QStringLiteral( "project.qgs" ) }, 2 );
+    REQUIRE( activeFileNames == QStringList( { QStringLiteral( "data.gpkg" ) } ) );
+
+    QFieldCloudProjectsModel::updateActiveDownloads( activeFileNames, queuedFileNames, { QStringLiteral( "data.gpkg" ) }, 2 );
+    REQUIRE( activeFileNames.isEmpty() );
+  }
+}
+
+TEST_CASE( "QFieldCloudProjectsModel download scheduling" )
+{
+  SECTION( "Priority" )
+  {
+    REQUIRE( QFieldCloudProjectsModel::downloadPriority( QStringLiteral( "project.qgz" ) ) == 0 );
+    REQUIRE( QFieldCloudProjectsModel::downloadPriority( QStringLiteral( "project.QGS" ) ) == 0 );
+    REQUIRE( QFieldCloudProjectsModel::downloadPriority( QStringLiteral( "data.gpkg" ) ) == 1 );
+    REQUIRE( QFieldCloudProjectsModel::downloadPriority( QStringLiteral( "styles.qml" ) ) == 2 );
+    REQUIRE( QFieldCloudProjectsModel::downloadPriority( QStringLiteral( "ortho.tif" ) ) == 3 );
+    REQUIRE( QFieldCloudProjectsModel::downloadPriority( QStringLiteral( "DCIM/notes.txt" ) ) == 3 );
+  }
+
+  SECTION( "Order" )
+  {
+    const QMap<QString, long long> fileSizes = {
+      { QStringLiteral( "DCIM/photo.jpg" ), 10 },
+      { QStringLiteral( "large.gpkg" ), 5000 },
+      { QStringLiteral( "ortho.tif" ), 1000 },
+      { QStringLiteral( "project.qgz" ), 100 },
+      { QStringLiteral( "small.gpkg" ), 50 },
+      { QStringLiteral( "styles.qml" ), 20 },
+    };
+
+    REQUIRE( QFieldCloudProjectsModel::downloadOrder( fileSizes ) == QStringList( { QStringLiteral( "project.qgz" ), QStringLiteral( "small.gpkg" ), QStringLiteral( "large.gpkg" ), QStringLiteral( "styles.qml" ), QStringLiteral( "DCIM/photo.jpg" ), QStringLiteral( "ortho.tif" ) } ) );
+  }
+
+  SECTION( "Concurrency window" )
+  {
+    QStringList activeFileNames;
+    QStringList queuedFileNames = { QStringLiteral( "a" ), QStringLiteral( "b" ), QStringLiteral( "c" ), QStringLiteral( "d" ) };
+
+    QFieldCloudProjectsModel::updateActiveDownloads( activeFileNames, queuedFileNames, {}, 2 );
+    REQUIRE( activeFileNames == QStringList( { QStringLiteral( "a" ), QStringLiteral( "b" ) } ) );
+    REQUIRE( queuedFileNames == QStringList( { QStringLiteral( "c" ), QStringLiteral( "d" ) } ) );
+
+    // Only freed slots get filled, in the queue order
+    QFieldCloudProjectsModel::updateActiveDownloads( activeFileNames, queuedFileNames, { QStringLiteral( "b" ) }, 2 );
+    REQUIRE( activeFileNames == QStringList( { QStringLiteral( "a" ), QStringLiteral( "c" ) } ) );
+    REQUIRE( queuedFileNames == QStringList( { QStringLiteral( "d" ) } ) );
+
+    // Files retried after a failure are queued ahead of the others
+    activeFileNames.removeOne( QStringLiteral( "a" ) );
+    queuedFileNames.prepend( QStringLiteral( "a" ) );
+    QFieldCloudProjectsModel::updateActiveDownloads( activeFileNames, queuedFileNames, {}, 2 );
+    REQUIRE( activeFileNames == QStringList( { QStringLiteral( "c" ), QStringLiteral( "a" ) } ) );
+    REQUIRE( queuedFileNames == QStringList( { QStringLiteral( "d" ) } ) );
+  }
+
+  SECTION( "Retry delay" )
+  {
+    REQUIRE( QFieldCloudProjectsModel::downloadRetryDelay( 0 ) == 1000 );
+    REQUIRE( QFieldCloudProjectsModel::downloadRetryDelay( 1 ) == 2000 );
+    REQUIRE( QFieldCloudProjectsModel::downloadRetryDelay( 2 ) == 4000 );
+    REQUIRE( QFieldCloudProjectsModel::downloadRetryDelay( 3 ) == -1 );
+  }
+}
@@ -0,0 +1,87 @@
+/***************************************************************************
+                        test_qgsquickmapsettings.cpp
+                        --------------------
+  begin                : Oct 2026
+  copyright            : (C) 2026 by OPENGIS.ch
+  email                : info@opengis.ch
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "catch2.h"
+#include "qgsquickmapsettings.h"
+
+#include <vector>
+
+using Catch::Approx;
+
+TEST_CASE( "QgsQuickMapSettings" )
+{
+  QgsQuickMapSettings mapSettings;
+  mapSettings.setDestinationCrs( QgsCoordinateReferenceSystem::fromEpsgId( 2056 ) );
+  mapSettings.setDevicePixelRatio( 2.0 );
+  mapSettings.setOutputSize( QSize( 400, 300 ) );
+  mapSettings.setExtent( QgsRectangle( 2600000, 1200000, 2600400, 1200300 ) );
+
+  SECTION( "CoordinatesToScreen" )
+  {
+    const std::vector<double> x { 2600000, 2600200, 2600400, 2600123.45 };
+    const std::vector<double> y { 1200300, 1200150, 1200000, 1200234.56 };
+
+    for ( const double rotation : { 0.0, 30.0, -135.0 } )
+    {
+      mapSettings.setRotation( rotation );
+
+      std::vector<QPointF> points( x.size() );
+      mapSettings.coordinatesToScreen( x.data(), y.data(), static_cast<qsizetype>( x.size() ), points.data() );
+
+      for ( std::size_t i = 0; i < x.size(); ++i )
+      {
+        const QPointF expected = mapSettings.coordinateToScreen( QgsPoint( x[i], y[i] ) );
+        REQUIRE( points[i].x() == Approx( expected.x() ).margin( 1e-6 ) );
+        REQUIRE( points[i].y() == Approx( expected.y() ).margin( 1e-6 ) );
+      }
+    }
+  }
+}
+
+TEST_CASE( "QgsQuickMapSettings batch transform benchmark", "[.][benchmark]" )
+{
+  QgsQuickMapSettings mapSettings;
+  mapSettings.setDestinationCrs( QgsCoordinateReferenceSystem::fromEpsgId( 2056 ) );
+  mapSettings.setOutputSize( QSize( 1080, 1920 ) );
+  mapSettings.setExtent( QgsRectangle( 2600000, 1200000, 2610000, 1210000 ) );
+  mapSettings.setRotation( 15 );
+
+  constexpr qsizetype count = 100000;
+  std::vector<double> x( count );
+  std::vector<double> y( count );
+  for ( qsizetype i = 0; i < count; ++i )
+  {
+    x[i] = 2600000 + ( i % 1000 ) * 10.0;
+    y[i] = 1200000 + ( i / 1000 ) * 100.0;
+  }
+  std::vector<QPointF> points( count );
+
+  BENCHMARK( "coordinateToScreen 100k vertices" )
+  {
+    for ( qsizetype i = 0; i < count; ++i )
+    {
+      points[i] = mapSettings.coordinateToScreen( QgsPoint( x[i], y[i] ) );
+    }
+    return points.back();
+  };
+
+  BENCHMARK( "coordinatesToScreen 100k vertices" )
+  {
+    mapSettings.coordinatesToScreen( x.data(), y.data(), count, points.data() );
+    return points.back();
+  };
+}
@@ -323,6 +323,66 @@ TEST_CASE( "ReferencingFeatureListModel" )
     REQUIRE( mModel->rowCount() == 4 );
   }
 
+  /*
+      InsertCollectedBatches
+      - create a parent with more children than a gathered batch
+      - load the children
+      - the model is reset once and further batches are merged at their sorted rows
+    */
+  SECTION( "InsertCollectedBatches" )
+  {
+    std::unique_ptr<QgsVectorLayer> mL_Tree( new QgsVectorLayer( QStringLiteral( "NoGeometry?field=id:int" ), QStringLiteral( "tree" ), QStringLiteral( "memory" ) ) );
+    REQUIRE( mL_Tree->isValid() );
+    QgsProject::instance()->addMapLayer( mL_Tree.get(), false, false );
+
+    std::unique_ptr<QgsVectorLayer> mL_Leaf( new QgsVectorLayer( QStringLiteral( "NoGeometry?field=id:int&field=name:string&field=tree_id:int" ), QStringLiteral( "leaf" ), QStringLiteral( "memory" ) ) );
+    mL_Leaf->setDisplayExpression( "name" );
+    REQUIRE( mL_Leaf->isValid() );
+    QgsProject::instance()->addMapLayer( mL_Leaf.get(), false, false );
+
+    QgsRelation mR_Leafofonetree;
+    mR_Leafofonetree.setId( QStringLiteral( "leaf.tree" ) );
+    mR_Leafofonetree.setName( QStringLiteral( "leaf.tree" ) );
+    mR_Leafofonetree.setReferencingLayer( mL_Leaf->id() );
+    mR_Leafofonetree.setReferencedLayer( mL_Tree->id() );
+    mR_Leafofonetree.addFieldPair( QStringLiteral( "tree_id" ), QStringLiteral( "id" ) );
+    REQUIRE( mR_Leafofonetree.isValid() );
+
+    QgsFeature tree_ft0( mL_Tree->fields() );
+    tree_ft0.setAttribute( QStringLiteral( "id" ), 0 );
+    REQUIRE( mL_Tree->dataProvider()->addFeature( tree_ft0 ) );
+
+    // leaves are not added in the order of their names
+    QgsFeatureList leaves;
+    for ( int i = 0; i < 250; i++ )
+    {
+      QgsFeature leaf_ft( mL_Leaf->fields() );
+      leaf_ft.setAttributes( QgsAttributes() << i << QStringLiteral( "Leaf %1" ).arg( ( i * 7 ) % 250, 3, 10, QChar( '0' ) ) << 0 );
+      leaves << leaf_ft;
+    }
+    REQUIRE( mL_Leaf->dataProvider()->addFeatures( leaves ) );
+
+    QSignalSpy resetSpy( mModel.get(), &ReferencingFeatureListModel::modelReset );
+    QSignalSpy insertSpy( mModel.get(), &ReferencingFeatureListModel::rowsInserted );
+    QSignalSpy layoutSpy( mModel.get(), &ReferencingFeatureListModel::layoutChanged );
+
+    mModel->setRelation( mR_Leafofonetree );
+    mModel->setNmRelation( QgsRelation() );
+    mModel->setFeature( mL_Tree->getFeature( 1 ) );
+    REQUIRE( QSignalSpy( mModel.get(), &ReferencingFeatureListModel::modelUpdated ).wait( 1000 ) );
+    REQUIRE( mModel->rowCount() == 250 );
+    REQUIRE( resetSpy.count() == 1 );
+    REQUIRE( insertSpy.count() + layoutSpy.count() > 0 );
+
+    for ( int row = 0; row < 250; row++ )
+    {
+      REQUIRE( mModel->data( mModel->index( row, 0 ), ReferencingFeatureListModel::DisplayString ).toString() == QStringLiteral( "Leaf %1" ).arg( row, 3, 10, QChar( '0' ) ) );
+    }
+
+    QgsProject::instance()->removeMapLayer( mL_Leaf.get() );
+    QgsProject::instance()->removeMapLayer( mL_Tree.get() );
+  }
+
   SECTION( "QAbstractItemModelTester" )
   {
     std::unique_ptr<ReferencingFeatureListModel> modelTest = std::make_unique<ReferencingFeatureListModel>();
@@ -0,0 +1,112 @@
+/***************************************************************************
+                        test_thumbnailcache.cpp
+                        --------------------
+  begin                : October 2026
+  copyright            : (C) 2026 by OPENGIS.ch
+  email                : info@opengis.ch
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "catch2.h"
+#include "thumbnailcache.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+
+TEST_CASE( "ThumbnailCache" )
+{
+  QTemporaryDir dir;
+  REQUIRE( dir.isValid() );
+
+  const QString filePath = dir.filePath( QStringLiteral( "file.txt" ) );
+  QFile file( filePath );
+  REQUIRE( file.open( QIODevice::WriteOnly ) );
+  file.write( "content" );
+  file.close();
+
+  QImage thumbnail( 64, 32, QImage::Format_ARGB32 );
+  thumbnail.fill( Qt::red );
+
+  ThumbnailCache cache( dir.filePath( QStringLiteral( "thumbnails" ) ) );
+
+  SECTION( "Keys" )
+  {
+    REQUIRE( ThumbnailCache::key( dir.filePath( QStringLiteral( "missing.txt" ) ), QSize( 64, 64 ) ).isEmpty() );
+    REQUIRE( ThumbnailCache::key( filePath, QSize( 64, 64 ) ) == ThumbnailCache::key( filePath, QSize( 64, 64 ) ) );
+    REQUIRE( ThumbnailCache::key( filePath, QSize( 64, 64 ) ) != ThumbnailCache::key( filePath, QSize( 128, 128 ) ) );
+  }
+
+  SECTION( "Lookup" )
+  {
+    REQUIRE( cache.thumbnail( filePath, QSize( 64, 64 ) ).isNull() );
+
+    cache.insert( filePath, QSize( 64, 64 ), thumbnail );
+    const QImage cachedThumbnail = cache.thumbnail( filePath, QSize( 64, 64 ) );
+    REQUIRE( cachedThumbnail.size() == thumbnail.size() );
+    REQUIRE( cachedThumbnail.pixelColor( 0, 0 ) == QColor( Qt::red ) );
+    REQUIRE( cache.thumbnail( filePath, QSize( 128, 128 ) ).isNull() );
+
+    // A modified file does not hit its previous thumbnail
+    REQUIRE( file.open( QIODevice::ReadWrite ) );
+    REQUIRE( file.setFileTime( QDateTime::currentDateTime().addSecs( 60 ), QFileDevice::FileModificationTime ) );
+    file.close();
+    REQUIRE( cache.thumbnail( filePath, QSize( 64, 64 ) ).isNull() );
+
+    cache.insert( filePath, QSize( 64, 64 ), thumbnail );
+    REQUIRE( !cache.thumbnail( filePath, QSize( 64, 64 ) ).isNull() );
+    cache.clear();
+    REQUIRE( cache.thumbnail( filePath, QSize( 64, 64 ) ).isNull() );
+  }
+
+  SECTION( "Failed renders" )
+  {
+    bool found = true;
+    REQUIRE( cache.thumbnail( filePath, QSize( 64, 64 ), &found ).isNull() );
+    REQUIRE( !found );
+
+    // No thumbnail could be rendered
+    cache.insert( filePath, QSize( 64, 64 ), QImage() );
+    REQUIRE( cache.thumbnail( filePath, QSize( 64, 64 ), &found ).isNull() );
+    REQUIRE( found );
+
+    cache.insert( filePath, QSize( 64, 64 ), thumbnail );
+    REQUIRE( !cache.thumbnail( filePath, QSize( 64, 64 ), &found ).isNull() );
+    REQUIRE( found );
+  }
+
+  SECTION( "Opaque thumbnails" )
+  {
+    QImage opaqueThumbnail( 256, 256, QImage::Format_RGB32 );
+    opaqueThumbnail.fill( Qt::blue );
+    cache.insert( filePath, QSize( 256, 256 ), opaqueThumbnail );
+
+    QFile cachedFile( QDir( cache.directory() ).filePath( ThumbnailCache::key( filePath, QSize( 256, 256 ) ) ) );
+    REQUIRE( cachedFile.open( QIODevice::ReadOnly ) );
+    REQUIRE( cachedFile.read( 2 ) == QByteArray( "\xff\xd8" ) );
+    cachedFile.close();
+
+    const QImage cachedThumbnail = cache.thumbnail( filePath, QSize( 256, 256 ) );
+    REQUIRE( cachedThumbnail.size() == opaqueThumbnail.size() );
+  }
+
+  SECTION( "Trimming" )
+  {
+    ThumbnailCache smallCache( dir.filePath( QStringLiteral( "small_thumbnails" ) ), 1 );
+    smallCache.insert( filePath, QSize( 64, 64 ), thumbnail );
+
+    // Thumbnails exceeding the maximum size are trimmed away
+    REQUIRE( smallCache.thumbnail( filePath, QSize( 64, 64 ) ).isNull() );
+    REQUIRE( QDir( smallCache.directory() ).entryList( QDir::Files ).isEmpty() );
+  }
+}